@@ -242,7 +242,10 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <deque>
 #include <map>
+#include <unordered_map>
+#include <algorithm>
 
 // ---------------------------------------
 // Windows Win32API header
@@ -251,6 +254,8 @@
 #include <tchar.h>
 #include <commctrl.h>
 #include <tlhelp32.h>
+#include <psapi.h>
+#include <shlwapi.h>
 #include <timeapi.h>
 #include "axeen_undef.hh"
 
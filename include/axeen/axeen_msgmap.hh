@@ -0,0 +1,447 @@
+﻿/**************************************************************************//**
+ * @file	axeen_msgmap.hh
+ * @brief	編譯期訊息映射表 (Message map)
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *
+ * 以樣板於編譯期產生訊息分派表, 取代 MessageDispose / WndProc 中的 switch. \n
+ * 訊息碼分布密集時使用直接索引表, 否則於編譯期搜尋完美雜湊 (multiplicative hash). \n
+ * 分派只需一次索引計算與一次比對, 未處理的訊息直接返回 FALSE, 由調用者交給預設處理函數. \n
+ * 搜尋超過比對次數上限仍找不到完美雜湊時 (處理項目很多), 改用依訊息碼排序的表, 以二分搜尋分派.
+ * DmWindow 衍生類別於覆寫的 WndProc 中以相同方式使用, 未處理的訊息交給 DefaultWindowProc.
+ *
+ * @code
+ *	class CxMyWindow : public CxFrameWindow
+ *	{
+ *	protected:
+ *		virtual	LRESULT MessageDispose(UINT uMessage, WPARAM wParam, LPARAM lParam) override;
+ *		void	OnSize(UINT uType, int cx, int cy);
+ *		void	OnCommand(UINT uID, UINT uCode, HWND hCtrl);
+ *		void	OnClose();
+ *
+ *		typedef CxMsgMap<CxMyWindow
+ *			, AXEEN_MSGHANDLER(WM_SIZE, &CxMyWindow::OnSize)
+ *			, AXEEN_MSGHANDLER(WM_COMMAND, &CxMyWindow::OnCommand)
+ *			, AXEEN_MSGHANDLER(WM_CLOSE, &CxMyWindow::OnClose)
+ *		> MessageMap;
+ *	};
+ *
+ *	LRESULT CxMyWindow::MessageDispose(UINT uMessage, WPARAM wParam, LPARAM lParam)
+ *	{
+ *		LRESULT lResult;
+ *		if (MessageMap::Dispatch(this, uMessage, wParam, lParam, &lResult))
+ *			return lResult;
+ *		return this->DefaultWindowProc(uMessage, wParam, lParam);
+ *	}
+ * @endcode
+ *****************************************************************************/
+#ifndef __AXEEN_AXEENMSGMAP_HH__
+#define __AXEEN_AXEENMSGMAP_HH__
+#include "axeen_ement.hh"
+
+/**
+ * @brief	宣告訊息處理項目
+ * @param	uMsg		訊息碼
+ * @param	fnMember	成員函數位址 (&Class::Function)
+ */
+#define AXEEN_MSGHANDLER(uMsg, fnMember)	CxMsgHandler<(uMsg), decltype(fnMember), (fnMember)>
+
+/**
+ * @struct	CxMsgCrackBase
+ * @brief	訊息參數拆解 : 通用型式
+ *
+ * 全部訊息皆可使用的處理函數型式: \n
+ * - void / R Handler()
+ * - void / R Handler(WPARAM wParam, LPARAM lParam)
+ *
+ * 返回 void 的處理函數, 訊息處理結果為零(zero).
+ */
+struct CxMsgCrackBase
+{
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(), WPARAM, LPARAM) { (objPtr->*fnPtr)(); return 0; }
+
+	template<typename T, typename C, typename R>
+	static LRESULT Call(T* objPtr, R (C::*fnPtr)(), WPARAM, LPARAM) { return static_cast<LRESULT>((objPtr->*fnPtr)()); }
+
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(WPARAM, LPARAM), WPARAM wParam, LPARAM lParam) { (objPtr->*fnPtr)(wParam, lParam); return 0; }
+
+	template<typename T, typename C, typename R>
+	static LRESULT Call(T* objPtr, R (C::*fnPtr)(WPARAM, LPARAM), WPARAM wParam, LPARAM lParam) { return static_cast<LRESULT>((objPtr->*fnPtr)(wParam, lParam)); }
+
+protected:
+	static int LowInt(LPARAM lParam) { return static_cast<int>(static_cast<short>(LOWORD(lParam))); }
+	static int HighInt(LPARAM lParam) { return static_cast<int>(static_cast<short>(HIWORD(lParam))); }
+};
+
+/**
+ * @struct	CxMsgCrack
+ * @brief	訊息參數拆解 : 依訊息碼特化, 提供具型別的處理函數型式
+ */
+template<UINT MSG>
+struct CxMsgCrack : public CxMsgCrackBase { };
+
+/**
+ * @struct	CxMsgCrackMouse
+ * @brief	訊息參數拆解 : 滑鼠訊息, void Handler(UINT uKeys, int x, int y)
+ */
+struct CxMsgCrackMouse : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(UINT, int, int), WPARAM wParam, LPARAM lParam) { (objPtr->*fnPtr)(static_cast<UINT>(wParam), LowInt(lParam), HighInt(lParam)); return 0; }
+};
+
+/**
+ * @struct	CxMsgCrackKey
+ * @brief	訊息參數拆解 : 按鍵訊息, void Handler(UINT uVKey, UINT nRepeat, UINT uFlags)
+ */
+struct CxMsgCrackKey : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(UINT, UINT, UINT), WPARAM wParam, LPARAM lParam) { (objPtr->*fnPtr)(static_cast<UINT>(wParam), LOWORD(lParam), HIWORD(lParam)); return 0; }
+};
+
+//! WM_CREATE : R Handler(LPCREATESTRUCT csPtr)
+template<>
+struct CxMsgCrack<WM_CREATE> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C, typename R>
+	static LRESULT Call(T* objPtr, R (C::*fnPtr)(LPCREATESTRUCT), WPARAM, LPARAM lParam) { return static_cast<LRESULT>((objPtr->*fnPtr)(reinterpret_cast<LPCREATESTRUCT>(lParam))); }
+};
+
+//! WM_INITDIALOG : R Handler(HWND hFocus, LPARAM lParam)
+template<>
+struct CxMsgCrack<WM_INITDIALOG> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C, typename R>
+	static LRESULT Call(T* objPtr, R (C::*fnPtr)(HWND, LPARAM), WPARAM wParam, LPARAM lParam) { return static_cast<LRESULT>((objPtr->*fnPtr)(reinterpret_cast<HWND>(wParam), lParam)); }
+};
+
+//! WM_SIZE : void Handler(UINT uType, int cx, int cy)
+template<>
+struct CxMsgCrack<WM_SIZE> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(UINT, int, int), WPARAM wParam, LPARAM lParam) { (objPtr->*fnPtr)(static_cast<UINT>(wParam), LowInt(lParam), HighInt(lParam)); return 0; }
+};
+
+//! WM_MOVE : void Handler(int x, int y)
+template<>
+struct CxMsgCrack<WM_MOVE> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(int, int), WPARAM, LPARAM lParam) { (objPtr->*fnPtr)(LowInt(lParam), HighInt(lParam)); return 0; }
+};
+
+//! WM_COMMAND : void Handler(UINT uID, UINT uCode, HWND hCtrl)
+template<>
+struct CxMsgCrack<WM_COMMAND> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(UINT, UINT, HWND), WPARAM wParam, LPARAM lParam) { (objPtr->*fnPtr)(LOWORD(wParam), HIWORD(wParam), reinterpret_cast<HWND>(lParam)); return 0; }
+};
+
+//! WM_NOTIFY : R Handler(LPNMHDR nmPtr)
+template<>
+struct CxMsgCrack<WM_NOTIFY> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C, typename R>
+	static LRESULT Call(T* objPtr, R (C::*fnPtr)(LPNMHDR), WPARAM, LPARAM lParam) { return static_cast<LRESULT>((objPtr->*fnPtr)(reinterpret_cast<LPNMHDR>(lParam))); }
+};
+
+//! WM_TIMER : void Handler(UINT_PTR idTimer)
+template<>
+struct CxMsgCrack<WM_TIMER> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(UINT_PTR), WPARAM wParam, LPARAM) { (objPtr->*fnPtr)(static_cast<UINT_PTR>(wParam)); return 0; }
+};
+
+//! WM_ERASEBKGND : R Handler(HDC hDC)
+template<>
+struct CxMsgCrack<WM_ERASEBKGND> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C, typename R>
+	static LRESULT Call(T* objPtr, R (C::*fnPtr)(HDC), WPARAM wParam, LPARAM) { return static_cast<LRESULT>((objPtr->*fnPtr)(reinterpret_cast<HDC>(wParam))); }
+};
+
+//! WM_GETMINMAXINFO : void Handler(LPMINMAXINFO mmiPtr)
+template<>
+struct CxMsgCrack<WM_GETMINMAXINFO> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(LPMINMAXINFO), WPARAM, LPARAM lParam) { (objPtr->*fnPtr)(reinterpret_cast<LPMINMAXINFO>(lParam)); return 0; }
+};
+
+//! WM_CHAR : void Handler(TCHAR chCode, UINT nRepeat)
+template<>
+struct CxMsgCrack<WM_CHAR> : public CxMsgCrackBase
+{
+	using CxMsgCrackBase::Call;
+	template<typename T, typename C>
+	static LRESULT Call(T* objPtr, void (C::*fnPtr)(TCHAR, UINT), WPARAM wParam, LPARAM lParam) { (objPtr->*fnPtr)(static_cast<TCHAR>(wParam), LOWORD(lParam)); return 0; }
+};
+
+template<> struct CxMsgCrack<WM_MOUSEMOVE> : public CxMsgCrackMouse { };		//!< WM_MOUSEMOVE
+template<> struct CxMsgCrack<WM_LBUTTONDOWN> : public CxMsgCrackMouse { };		//!< WM_LBUTTONDOWN
+template<> struct CxMsgCrack<WM_LBUTTONUP> : public CxMsgCrackMouse { };		//!< WM_LBUTTONUP
+template<> struct CxMsgCrack<WM_LBUTTONDBLCLK> : public CxMsgCrackMouse { };	//!< WM_LBUTTONDBLCLK
+template<> struct CxMsgCrack<WM_RBUTTONDOWN> : public CxMsgCrackMouse { };		//!< WM_RBUTTONDOWN
+template<> struct CxMsgCrack<WM_RBUTTONUP> : public CxMsgCrackMouse { };		//!< WM_RBUTTONUP
+template<> struct CxMsgCrack<WM_KEYDOWN> : public CxMsgCrackKey { };			//!< WM_KEYDOWN
+template<> struct CxMsgCrack<WM_KEYUP> : public CxMsgCrackKey { };				//!< WM_KEYUP
+
+/**
+ * @struct	CxMsgHandler
+ * @brief	訊息處理項目 (以 AXEEN_MSGHANDLER 宣告)
+ * @tparam	MSG		訊息碼
+ * @tparam	FN		成員函數型別
+ * @tparam	fnPtr	成員函數位址
+ */
+template<UINT MSG, typename FN, FN fnPtr>
+struct CxMsgHandler
+{
+	static constexpr UINT uMessage = MSG;	//!< 訊息碼
+
+	//! 拆解訊息參數並調用成員函數
+	template<typename T>
+	static LRESULT Invoke(T* objPtr, WPARAM wParam, LPARAM lParam) { return CxMsgCrack<MSG>::Call(objPtr, fnPtr, wParam, lParam); }
+};
+
+/**
+ * @struct	CxMsgLayout
+ * @brief	訊息分派表配置 (編譯期計算)
+ * @tparam	MSGS	全部訊息碼
+ */
+template<UINT... MSGS>
+struct CxMsgLayout
+{
+	static constexpr size_t nCount = sizeof...(MSGS);	//!< 訊息數量
+	static constexpr size_t nDenseMax = 64;				//!< 直接索引表最大長度 (或 nCount 的四倍)
+	static constexpr size_t nHashTries = 16;			//!< 每個雜湊表長度嘗試的乘數數量
+	static constexpr size_t nHashBudget = 16384;		//!< 搜尋完美雜湊的比對次數上限, 避免超過編譯器 constexpr 步數限制 (MSVC /constexpr:steps)
+
+	//! 最小訊息碼
+	static constexpr UINT Min()
+	{
+		const UINT aMsg[] = { MSGS... };
+		UINT uMin = aMsg[0];
+		for (size_t i = 1; i < nCount; ++i)
+			if (aMsg[i] < uMin) uMin = aMsg[i];
+		return uMin;
+	}
+
+	//! 最大訊息碼
+	static constexpr UINT Max()
+	{
+		const UINT aMsg[] = { MSGS... };
+		UINT uMax = aMsg[0];
+		for (size_t i = 1; i < nCount; ++i)
+			if (aMsg[i] > uMax) uMax = aMsg[i];
+		return uMax;
+	}
+
+	//! 訊息碼是否沒有重複
+	static constexpr bool IsUnique()
+	{
+		const UINT aMsg[] = { MSGS... };
+		for (size_t i = 0; i < nCount; ++i)
+			for (size_t j = i + 1; j < nCount; ++j)
+				if (aMsg[i] == aMsg[j]) return false;
+		return true;
+	}
+
+	//! 是否使用直接索引表
+	static constexpr bool IsDense()
+	{
+		return static_cast<size_t>(Max() - Min()) < nDenseMax || static_cast<size_t>(Max() - Min()) < nCount * 4;
+	}
+
+	/**
+	 * @brief	搜尋完美雜湊參數
+	 * @return	@c 型別: ULONGLONG, 高 32 位元為雜湊位元數, 低 32 位元為乘數; 找不到返回零
+	 * @remark	表長度由 2 * nCount 開始, 每個長度嘗試 nHashTries 個奇數乘數 (以 LCG 產生, 相鄰乘數的雜湊結果不相關). \n
+	 *			訊息碼兩兩比對的總次數超過 nHashBudget 即停止搜尋並返回零.
+	 */
+	static constexpr ULONGLONG HashParam()
+	{
+		const UINT aMsg[] = { MSGS... };
+		size_t nSteps = 0;
+		UINT uBits = 1;
+		while ((static_cast<size_t>(1) << uBits) < nCount * 2)
+			++uBits;
+
+		for (; uBits <= 16; ++uBits) {
+			UINT uMul = 0x9E3779B1u;
+			for (size_t n = 0; n < nHashTries; ++n, uMul = (uMul * 1664525u + 1013904223u) | 1u) {
+				// 每個訊息碼與之前的訊息碼比對, 碰撞時盡早結束
+				bool bPerfect = true;
+				for (size_t j = 1; j < nCount && bPerfect; ++j) {
+					for (size_t i = 0; i < j && bPerfect; ++i) {
+						if (++nSteps > nHashBudget) return 0;
+						if (((aMsg[i] * uMul) >> (32 - uBits)) == ((aMsg[j] * uMul) >> (32 - uBits))) bPerfect = false;
+					}
+				}
+				if (bPerfect)
+					return (static_cast<ULONGLONG>(uBits) << 32) | uMul;
+			}
+		}
+		return 0;
+	}
+};
+
+/**
+ * @class	CxMsgMap
+ * @brief	編譯期訊息映射表
+ * @tparam	T			處理訊息的類別
+ * @tparam	HANDLERS	訊息處理項目 (AXEEN_MSGHANDLER)
+ *
+ * 分派表於編譯期建立 (constexpr), 不需執行期初始化. \n
+ * 空白欄位存放第一個處理項目的訊息碼, 該訊息碼不會索引到空白欄位, 因此只需比對訊息碼. \n
+ * 排序表 (bSorted) 沒有空白欄位, 以二分搜尋取得索引.
+ */
+template<typename T, typename... HANDLERS>
+class CxMsgMap
+{
+public:
+	typedef LRESULT (*LPFNINVOKE)(T* objPtr, WPARAM wParam, LPARAM lParam);	//!< 分派函數型別
+	typedef CxMsgLayout<HANDLERS::uMessage...> Layout;						//!< 分派表配置
+
+	static_assert(sizeof...(HANDLERS) > 0, "CxMsgMap requires at least one handler");
+	static_assert(Layout::IsUnique(), "CxMsgMap has duplicate message handlers");
+
+	static constexpr bool		bDense = Layout::IsDense();					//!< 是否為直接索引表
+	static constexpr UINT		uBase = Layout::Min();						//!< 直接索引表起始訊息碼
+	static constexpr ULONGLONG	ullHash = bDense ? 0 : Layout::HashParam();	//!< 雜湊參數
+	static constexpr bool		bSorted = !bDense && ullHash == 0;			//!< 是否為排序表 (找不到完美雜湊)
+	static constexpr UINT		uMul = static_cast<UINT>(ullHash);			//!< 雜湊乘數
+	static constexpr UINT		uShift = bSorted ? 0 : 32 - static_cast<UINT>(ullHash >> 32);	//!< 雜湊位移
+	static constexpr size_t		nSize = bDense ? static_cast<size_t>(Layout::Max() - Layout::Min()) + 1
+										: bSorted ? sizeof...(HANDLERS) : static_cast<size_t>(1) << (32 - uShift);	//!< 分派表長度
+
+	/**
+	 * @brief	分派訊息
+	 * @param	[in] objPtr		處理訊息的物件
+	 * @param	[in] uMessage	訊息碼
+	 * @param	[in] wParam		參數 1
+	 * @param	[in] lParam		參數 2
+	 * @param	[out] lResultPtr	訊息處理結果
+	 * @return	@c 型別: BOOL \n
+	 *			訊息已處理返回非零值(non-zero) \n
+	 *			沒有對應的處理項目返回零(zero), 由調用者交給預設處理函數
+	 */
+	static BOOL Dispatch(T* objPtr, UINT uMessage, WPARAM wParam, LPARAM lParam, LRESULT* lResultPtr)
+	{
+		const size_t idx = Index(uMessage);
+
+		if (idx >= nSize || s_table.aSlot[idx].uMessage != uMessage)
+			return FALSE;
+		*lResultPtr = s_table.aSlot[idx].fnInvoke(objPtr, wParam, lParam);
+		return TRUE;
+	}
+
+	/**
+	 * @brief	是否有對應的處理項目
+	 * @param	[in] uMessage	訊息碼
+	 * @return	@c 型別: BOOL \n 有對應的處理項目返回非零值(non-zero)
+	 */
+	static BOOL IsHandled(UINT uMessage)
+	{
+		const size_t idx = Index(uMessage);
+		return idx < nSize && s_table.aSlot[idx].uMessage == uMessage;
+	}
+
+private:
+	/**
+	 * @struct	SSSLOT
+	 * @brief	分派表欄位
+	 */
+	struct SSSLOT {
+		UINT		uMessage;	//!< 訊息碼
+		LPFNINVOKE	fnInvoke;	//!< 分派函數
+	};
+
+	/**
+	 * @struct	SSTABLE
+	 * @brief	分派表
+	 */
+	struct SSTABLE {
+		SSSLOT		aSlot[nSize];	//!< 分派表欄位
+	};
+
+	//! 計算訊息碼於直接索引表或雜湊表的索引
+	static constexpr size_t Slot(UINT uMessage)
+	{
+		return bDense ? static_cast<size_t>(uMessage - uBase) : static_cast<size_t>((uMessage * uMul) >> uShift);
+	}
+
+	//! 取得訊息碼於分派表的索引, 排序表返回第一個不小於訊息碼的欄位
+	static size_t Index(UINT uMessage)
+	{
+		if (!bSorted)
+			return Slot(uMessage);
+
+		size_t idxLow = 0;
+		size_t idxHigh = nSize;
+		while (idxLow < idxHigh) {
+			size_t idxMid = (idxLow + idxHigh) / 2;
+			if (s_table.aSlot[idxMid].uMessage < uMessage)
+				idxLow = idxMid + 1;
+			else
+				idxHigh = idxMid;
+		}
+		return idxLow;
+	}
+
+	//! 建立分派表 (編譯期)
+	static constexpr SSTABLE Build()
+	{
+		const UINT aMsg[] = { HANDLERS::uMessage... };
+		const LPFNINVOKE aInvoke[] = { &HANDLERS::template Invoke<T>... };
+		SSTABLE table = {};
+
+		if (bSorted) {
+			// 依訊息碼插入排序
+			for (size_t i = 0; i < nSize; ++i) {
+				size_t j = i;
+				for (; j > 0 && table.aSlot[j - 1].uMessage > aMsg[i]; --j) {
+					table.aSlot[j].uMessage = table.aSlot[j - 1].uMessage;
+					table.aSlot[j].fnInvoke = table.aSlot[j - 1].fnInvoke;
+				}
+				table.aSlot[j].uMessage = aMsg[i];
+				table.aSlot[j].fnInvoke = aInvoke[i];
+			}
+			return table;
+		}
+
+		for (size_t i = 0; i < nSize; ++i) {
+			table.aSlot[i].uMessage = aMsg[0];
+			table.aSlot[i].fnInvoke = NULL;
+		}
+		for (size_t i = 0; i < sizeof...(HANDLERS); ++i) {
+			table.aSlot[Slot(aMsg[i])].uMessage = aMsg[i];
+			table.aSlot[Slot(aMsg[i])].fnInvoke = aInvoke[i];
+		}
+		return table;
+	}
+
+	static constexpr SSTABLE s_table = Build();	//!< 分派表
+};
+
+template<typename T, typename... HANDLERS>
+constexpr typename CxMsgMap<T, HANDLERS...>::SSTABLE CxMsgMap<T, HANDLERS...>::s_table;
+
+#endif	// !__AXEEN_AXEENMSGMAP_HH__
@@ -0,0 +1,574 @@
+﻿/**************************************************************************//**
+ * @file	axeen_profile.hh
+ * @brief	視窗訊息分派效能量測 (Message dispatch profiling)
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *
+ * 量測每個視窗訊息的分派次數、累計時間與延遲分布 (HDR histogram), 分別以訊息碼及視窗類別統計. \n
+ * 統計資料存放於執行緒區域儲存區 (thread_local), 分派時不需與其他執行緒同步. \n
+ * - 編譯期: axeen_setup.hh 中 __AXEEN_PROFILE__ 設為 0 時, AXEEN_PROFILE_MESSAGE 展開為空, 完全移除
+ * - 執行期: 預設停用, CxMsgProfiler::Enable(TRUE) 後開始量測, 停用時每個訊息只多一次旗標判斷
+ * - 報告: CxMsgProfiler::GetReport 依累計時間排序; 以 RegisterHotKey 註冊的熱鍵輸出至偵錯器 (OutputDebugString)
+ *
+ * 時間為包含巢狀分派的總時間 (如處理函數中 SendMessage 的時間亦計入).
+ *
+ * @code
+ *	LRESULT CALLBACK MyWndProc(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam)
+ *	{
+ *		AXEEN_PROFILE_MESSAGE(hWnd, uMessage, wParam);
+ *		...
+ *	}
+ *
+ *	CxMsgProfiler::Enable(TRUE);
+ *	CxMsgProfiler::RegisterHotKey(hWnd, 1, MOD_CONTROL | MOD_SHIFT, VK_F12);
+ * @endcode
+ *****************************************************************************/
+#ifndef __AXEEN_AXEENPROFILE_HH__
+#define __AXEEN_AXEENPROFILE_HH__
+#include "axeen_setup.hh"
+#include "axeen_ement.hh"
+
+#if (__AXEEN_PROFILE__ == 1)
+#include <intrin.h>
+
+#define PROFILE_HIST_SUB		32			//!< 延遲分布: 線性區間上限, 以上每個二的冪次分為一半 (16) 個子區間 (精確度約 1/16)
+#define PROFILE_HIST_BUCKETS	592			//!< 延遲分布: 區間數量 (涵蓋 0 ~ 2^40 ns)
+#define PROFILE_HIST_LIMIT		0xFFFFFFFFFFULL	//!< 延遲分布: 記錄上限 (in ns, 約 18 分鐘)
+#define PROFILE_REPORT_TOP		32			//!< 報告預設列出的項目數量
+#define PROFILE_CLASS_NAME		64			//!< 視窗類別名稱長度上限
+
+/**
+ * @class	CxMsgHistogram
+ * @brief	延遲分布 (HDR histogram, log-linear)
+ *
+ * 小於 PROFILE_HIST_SUB 的數值各佔一個區間, 其餘每個二的冪次分為 PROFILE_HIST_SUB / 2 個等寬區間, \n
+ * 相對誤差不超過 1/16. 記錄為固定時間的陣列索引, 不配置記憶體.
+ */
+class CxMsgHistogram
+{
+public:
+	CxMsgHistogram() { this->Reset(); }
+
+	//! 清除全部記錄
+	void Reset()
+	{
+		::memset(m_aCount, 0, sizeof(m_aCount));
+		m_nTotal = 0;
+	}
+
+	/**
+	 * @brief	記錄數值
+	 * @param	[in] ullValue	數值 (in ns), 超過 PROFILE_HIST_LIMIT 以上限記錄
+	 */
+	void Record(ULONGLONG ullValue)
+	{
+		++m_aCount[GetIndex(ullValue < PROFILE_HIST_LIMIT ? ullValue : PROFILE_HIST_LIMIT)];
+		++m_nTotal;
+	}
+
+	/**
+	 * @brief	合併其他延遲分布
+	 * @param	[in] histogram	延遲分布
+	 */
+	void Merge(const CxMsgHistogram& histogram)
+	{
+		for (size_t i = 0; i < PROFILE_HIST_BUCKETS; ++i)
+			m_aCount[i] += histogram.m_aCount[i];
+		m_nTotal += histogram.m_nTotal;
+	}
+
+	/**
+	 * @brief	取得百分位數
+	 * @param	[in] dPercent	百分比 (0.0 ~ 100.0)
+	 * @return	@c 型別: ULONGLONG, 百分位數所在區間的上限 (in ns), 沒有記錄返回零(zero)
+	 */
+	ULONGLONG GetPercentile(double dPercent) const
+	{
+		ULONGLONG nTarget = static_cast<ULONGLONG>(m_nTotal * dPercent / 100.0 + 0.5);
+		ULONGLONG nSum = 0;
+
+		if (m_nTotal == 0)
+			return 0;
+		if (nTarget == 0)
+			nTarget = 1;
+		for (size_t i = 0; i < PROFILE_HIST_BUCKETS; ++i) {
+			nSum += m_aCount[i];
+			if (nSum >= nTarget)
+				return GetUpper(i);
+		}
+		return PROFILE_HIST_LIMIT;
+	}
+
+	//! 取得記錄數量
+	ULONGLONG GetCount() const { return m_nTotal; }
+
+private:
+	/**
+	 * @brief	取得數值所在區間
+	 * @param	[in] ullValue	數值, 不超過 PROFILE_HIST_LIMIT
+	 * @return	@c 型別: size_t, 區間索引
+	 */
+	static size_t GetIndex(ULONGLONG ullValue)
+	{
+		unsigned long uBit;
+
+		if (ullValue < PROFILE_HIST_SUB)
+			return static_cast<size_t>(ullValue);
+		if (!_BitScanReverse(&uBit, static_cast<unsigned long>(ullValue >> 32)))
+			_BitScanReverse(&uBit, static_cast<unsigned long>(ullValue));
+		else
+			uBit += 32;
+
+		// 保留最高 5 個位元: 區間 = 位移量 * 16 + (16 ~ 31)
+		size_t nShift = uBit - 4;
+		return nShift * (PROFILE_HIST_SUB / 2) + static_cast<size_t>(ullValue >> nShift);
+	}
+
+	/**
+	 * @brief	取得區間上限
+	 * @param	[in] idx	區間索引
+	 * @return	@c 型別: ULONGLONG, 區間內的最大數值
+	 */
+	static ULONGLONG GetUpper(size_t idx)
+	{
+		if (idx < PROFILE_HIST_SUB)
+			return idx;
+
+		size_t nShift = idx / (PROFILE_HIST_SUB / 2) - 1;
+		ULONGLONG ullBase = idx - nShift * (PROFILE_HIST_SUB / 2);
+		return ((ullBase + 1) << nShift) - 1;
+	}
+
+private:
+	ULONG		m_aCount[PROFILE_HIST_BUCKETS];	//!< 各區間記錄數量
+	ULONGLONG	m_nTotal;						//!< 記錄總數
+};
+
+/**
+ * @struct	SSMSGPROFILE
+ * @brief	訊息分派統計項目
+ */
+struct SSMSGPROFILE {
+	UINT			uKey;		//!< 訊息碼或視窗類別 ATOM
+	TCHAR			szName[PROFILE_CLASS_NAME];	//!< 視窗類別名稱 (訊息項目不使用)
+	ULONGLONG		nCount;		//!< 分派次數
+	ULONGLONG		ullTotal;	//!< 累計時間 (in ns)
+	ULONGLONG		ullMax;		//!< 最大時間 (in ns)
+	CxMsgHistogram	histogram;	//!< 延遲分布 (in ns)
+};
+typedef SSMSGPROFILE*	LPSSMSGPROFILE;	//!< SSMSGPROFILE 結構指標型別
+
+/**
+ * @class	CxMsgProfileStore
+ * @brief	單一執行緒的訊息分派統計
+ *
+ * 由 CxMsgProfiler 以 thread_local 建立, 建立時加入全域清單, 執行緒結束時合併至已結束執行緒的統計. \n
+ * 擁有的執行緒寫入與報告讀取以 SRW lock 保護, 未產生報告時不會競爭.
+ */
+class CxMsgProfileStore
+{
+public:
+	typedef std::unordered_map<UINT, SSMSGPROFILE>	PROFILEMAP;	//!< 鍵值 → 統計項目
+
+	CxMsgProfileStore(BOOL bRegister = TRUE)
+		: m_bRegister(bRegister)
+		, m_hLast(NULL)
+		, m_atomLast(0)
+	{
+		::InitializeSRWLock(&m_srwLock);
+		if (m_bRegister)
+			Attach(this);
+	}
+
+	~CxMsgProfileStore()
+	{
+		if (m_bRegister)
+			Detach(this);
+	}
+
+	/**
+	 * @brief	記錄一次分派
+	 * @param	[in] hWnd		視窗 Handle
+	 * @param	[in] uMessage	視窗訊息
+	 * @param	[in] ullTime	分派時間 (in ns)
+	 */
+	void Record(HWND hWnd, UINT uMessage, ULONGLONG ullTime)
+	{
+		// 同一視窗連續分派時不重新查詢類別
+		if (hWnd != m_hLast) {
+			m_hLast = hWnd;
+			m_atomLast = hWnd != NULL ? static_cast<UINT>(::GetClassLongPtr(hWnd, GCW_ATOM)) : 0;
+		}
+
+		::AcquireSRWLockExclusive(&m_srwLock);
+		Add(m_mapMessage, uMessage, ullTime, NULL);
+		Add(m_mapClass, m_atomLast, ullTime, hWnd);
+		::ReleaseSRWLockExclusive(&m_srwLock);
+	}
+
+	/**
+	 * @brief	合併至其他統計
+	 * @param	[in] storePtr	合併目標
+	 */
+	void MergeTo(CxMsgProfileStore* storePtr)
+	{
+		::AcquireSRWLockShared(&m_srwLock);
+		MergeMap(storePtr->m_mapMessage, m_mapMessage);
+		MergeMap(storePtr->m_mapClass, m_mapClass);
+		::ReleaseSRWLockShared(&m_srwLock);
+	}
+
+	//! 清除統計
+	void Reset()
+	{
+		::AcquireSRWLockExclusive(&m_srwLock);
+		m_mapMessage.clear();
+		m_mapClass.clear();
+		::ReleaseSRWLockExclusive(&m_srwLock);
+	}
+
+	const PROFILEMAP& GetMessageMap() const { return m_mapMessage; }	//!< 取得訊息統計
+	const PROFILEMAP& GetClassMap() const { return m_mapClass; }		//!< 取得視窗類別統計
+
+	template<typename FN> static void ForEach(FN fnVisit);
+
+private:
+	struct SSREGISTRY;
+
+	static SSREGISTRY& GetRegistry();
+	static void Attach(CxMsgProfileStore* storePtr);
+	static void Detach(CxMsgProfileStore* storePtr);
+
+	//! 累計一次分派
+	static void Add(PROFILEMAP& mapProfile, UINT uKey, ULONGLONG ullTime, HWND hWnd)
+	{
+		auto it = mapProfile.find(uKey);
+
+		if (it == mapProfile.end()) {
+			SSMSGPROFILE profile;
+			profile.uKey = uKey;
+			profile.szName[0] = 0;
+			if (hWnd != NULL)
+				::GetClassName(hWnd, profile.szName, PROFILE_CLASS_NAME);
+			profile.nCount = 0;
+			profile.ullTotal = 0;
+			profile.ullMax = 0;
+			it = mapProfile.insert(std::make_pair(uKey, profile)).first;
+		}
+
+		SSMSGPROFILE& profile = it->second;
+		++profile.nCount;
+		profile.ullTotal += ullTime;
+		if (ullTime > profile.ullMax)
+			profile.ullMax = ullTime;
+		profile.histogram.Record(ullTime);
+	}
+
+	//! 合併統計項目
+	static void MergeMap(PROFILEMAP& mapTarget, const PROFILEMAP& mapSource)
+	{
+		for (auto it = mapSource.begin(); it != mapSource.end(); ++it) {
+			auto itTarget = mapTarget.find(it->first);
+			if (itTarget == mapTarget.end()) {
+				mapTarget.insert(*it);
+				continue;
+			}
+
+			SSMSGPROFILE& profile = itTarget->second;
+			profile.nCount += it->second.nCount;
+			profile.ullTotal += it->second.ullTotal;
+			if (it->second.ullMax > profile.ullMax)
+				profile.ullMax = it->second.ullMax;
+			profile.histogram.Merge(it->second.histogram);
+		}
+	}
+
+private:
+	SRWLOCK		m_srwLock;		//!< 保護統計資料
+	BOOL		m_bRegister;	//!< 是否加入全域清單
+	HWND		m_hLast;		//!< 上一次分派的視窗
+	UINT		m_atomLast;		//!< 上一次分派視窗的類別 ATOM
+	PROFILEMAP	m_mapMessage;	//!< 訊息碼 → 統計項目
+	PROFILEMAP	m_mapClass;		//!< 視窗類別 ATOM → 統計項目
+};
+
+/**
+ * @struct	CxMsgProfileStore::SSREGISTRY
+ * @brief	全部執行緒的統計清單
+ */
+struct CxMsgProfileStore::SSREGISTRY {
+	SRWLOCK							srwLock;	//!< 保護清單
+	std::vector<CxMsgProfileStore*>	aStore;		//!< 執行中執行緒的統計
+	CxMsgProfileStore				retired;	//!< 已結束執行緒的統計 (寫入時持有 srwLock 獨佔)
+
+	SSREGISTRY() : retired(FALSE) { ::InitializeSRWLock(&srwLock); }
+};
+
+/**
+ * @brief	對全部執行緒的統計執行操作 (static)
+ * @param	[in] fnVisit	以 fnVisit(CxMsgProfileStore*) 調用, 包含已結束執行緒的統計
+ */
+template<typename FN>
+inline void CxMsgProfileStore::ForEach(FN fnVisit)
+{
+	SSREGISTRY& registry = GetRegistry();
+
+	::AcquireSRWLockShared(&registry.srwLock);
+	for (size_t i = 0; i < registry.aStore.size(); ++i)
+		fnVisit(registry.aStore[i]);
+	fnVisit(&registry.retired);
+	::ReleaseSRWLockShared(&registry.srwLock);
+}
+
+//! 取得全部執行緒的統計清單
+inline CxMsgProfileStore::SSREGISTRY& CxMsgProfileStore::GetRegistry()
+{
+	static SSREGISTRY s_registry;
+	return s_registry;
+}
+
+//! 加入全域清單
+inline void CxMsgProfileStore::Attach(CxMsgProfileStore* storePtr)
+{
+	SSREGISTRY& registry = GetRegistry();
+
+	::AcquireSRWLockExclusive(&registry.srwLock);
+	registry.aStore.push_back(storePtr);
+	::ReleaseSRWLockExclusive(&registry.srwLock);
+}
+
+//! 合併至已結束執行緒的統計並自全域清單移除
+inline void CxMsgProfileStore::Detach(CxMsgProfileStore* storePtr)
+{
+	SSREGISTRY& registry = GetRegistry();
+
+	::AcquireSRWLockExclusive(&registry.srwLock);
+	storePtr->MergeTo(&registry.retired);
+	registry.aStore.erase(std::remove(registry.aStore.begin(), registry.aStore.end(), storePtr), registry.aStore.end());
+	::ReleaseSRWLockExclusive(&registry.srwLock);
+}
+
+/**
+ * @class	CxMsgProfiler
+ * @brief	視窗訊息分派效能量測介面 (全部為靜態函數)
+ */
+class CxMsgProfiler
+{
+public:
+	/**
+	 * @brief	啟用或停用量測
+	 * @param	[in] bEnable	TRUE = 啟用, FALSE = 停用
+	 */
+	static void Enable(BOOL bEnable) { ::InterlockedExchange(&GetState().bEnable, bEnable ? TRUE : FALSE); }
+
+	//! 是否已啟用量測
+	static BOOL IsEnabled() { return GetState().bEnable; }
+
+	//! 清除全部執行緒的統計
+	static void Reset() { CxMsgProfileStore::ForEach([](CxMsgProfileStore* storePtr) { storePtr->Reset(); }); }
+
+	//! 取得目前時間 (QueryPerformanceCounter)
+	static LONGLONG Now()
+	{
+		LARGE_INTEGER liNow;
+		::QueryPerformanceCounter(&liNow);
+		return liNow.QuadPart;
+	}
+
+	/**
+	 * @brief	記錄一次分派 (由 CxMsgProfileScope 調用)
+	 * @param	[in] hWnd		視窗 Handle
+	 * @param	[in] uMessage	視窗訊息
+	 * @param	[in] llStart	開始時間 (QueryPerformanceCounter)
+	 */
+	static void Record(HWND hWnd, UINT uMessage, LONGLONG llStart)
+	{
+		thread_local CxMsgProfileStore t_store;
+		LONGLONG llFrequency = GetState().llFrequency;
+		ULONGLONG ullTicks = static_cast<ULONGLONG>(Now() - llStart);
+		ULONGLONG ullTime = ullTicks / llFrequency * 1000000000ULL + ullTicks % llFrequency * 1000000000ULL / llFrequency;
+
+		t_store.Record(hWnd, uMessage, ullTime);
+	}
+
+	/**
+	 * @brief	註冊輸出報告的熱鍵
+	 * @param	[in] hWnd			接收 WM_HOTKEY 的視窗, 其視窗處理函數必須使用 AXEEN_PROFILE_MESSAGE
+	 * @param	[in] idHotKey		熱鍵 ID
+	 * @param	[in] fsModifiers	修飾鍵 (MOD_ALT, MOD_CONTROL, MOD_SHIFT ...)
+	 * @param	[in] vk				虛擬鍵碼
+	 * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+	 * @remark	按下熱鍵時以 OutputDebugString 輸出報告.
+	 */
+	static BOOL RegisterHotKey(HWND hWnd, int idHotKey, UINT fsModifiers, UINT vk)
+	{
+		if (hWnd == NULL || !::RegisterHotKey(hWnd, idHotKey, fsModifiers, vk))
+			return FALSE;
+		GetState().idHotKey = idHotKey;
+		GetState().hHotKey = hWnd;
+		return TRUE;
+	}
+
+	/**
+	 * @brief	取消註冊熱鍵
+	 */
+	static void UnregisterHotKey()
+	{
+		if (GetState().hHotKey != NULL)
+			::UnregisterHotKey(GetState().hHotKey, GetState().idHotKey);
+		GetState().hHotKey = NULL;
+	}
+
+	/**
+	 * @brief	檢查是否為輸出報告的熱鍵 (由 CxMsgProfileScope 調用)
+	 * @param	[in] hWnd		視窗 Handle
+	 * @param	[in] wParam		WM_HOTKEY 的熱鍵 ID
+	 */
+	static void CheckHotKey(HWND hWnd, WPARAM wParam)
+	{
+		if (hWnd != NULL && hWnd == GetState().hHotKey && static_cast<int>(wParam) == GetState().idHotKey)
+			DumpReport();
+	}
+
+	/**
+	 * @brief	產生報告
+	 * @param	[out] strReport	報告內容
+	 * @param	[in] nTop		每個分類列出的項目數量
+	 * @remark	合併全部執行緒的統計 (含已結束的執行緒), 依累計時間排序. \n
+	 *			時間單位為 µs, 百分位數為所在區間上限 (誤差約 1/16).
+	 */
+	static void GetReport(std::basic_string<TCHAR>& strReport, size_t nTop = PROFILE_REPORT_TOP)
+	{
+		CxMsgProfileStore storeTotal(FALSE);
+
+		CxMsgProfileStore::ForEach([&storeTotal](CxMsgProfileStore* storePtr) { storePtr->MergeTo(&storeTotal); });
+		strReport.clear();
+		AppendReport(strReport, TEXT("message"), storeTotal.GetMessageMap(), nTop, FALSE);
+		AppendReport(strReport, TEXT("window class"), storeTotal.GetClassMap(), nTop, TRUE);
+	}
+
+	//! 輸出報告至偵錯器 (OutputDebugString)
+	static void DumpReport()
+	{
+		std::basic_string<TCHAR> strReport;
+		GetReport(strReport);
+		::OutputDebugString(strReport.c_str());
+	}
+
+private:
+	/**
+	 * @struct	SSSTATE
+	 * @brief	量測全域狀態
+	 */
+	struct SSSTATE {
+		volatile LONG	bEnable;		//!< 是否啟用
+		LONGLONG		llFrequency;	//!< QueryPerformanceFrequency
+		HWND			hHotKey;		//!< 接收熱鍵的視窗
+		int				idHotKey;		//!< 熱鍵 ID
+
+		SSSTATE() : bEnable(FALSE), llFrequency(1), hHotKey(NULL), idHotKey(0)
+		{
+			LARGE_INTEGER liFrequency;
+			if (::QueryPerformanceFrequency(&liFrequency) && liFrequency.QuadPart != 0)
+				llFrequency = liFrequency.QuadPart;
+		}
+	};
+
+	//! 取得量測全域狀態
+	static SSSTATE& GetState()
+	{
+		static SSSTATE s_state;
+		return s_state;
+	}
+
+	//! 加入一個分類的報告
+	static void AppendReport(std::basic_string<TCHAR>& strReport, LPCTSTR szTitle, const CxMsgProfileStore::PROFILEMAP& mapProfile, size_t nTop, BOOL bClass)
+	{
+		std::vector<const SSMSGPROFILE*> aSorted;
+		TCHAR szLine[256];
+
+		for (auto it = mapProfile.begin(); it != mapProfile.end(); ++it)
+			aSorted.push_back(&it->second);
+		std::sort(aSorted.begin(), aSorted.end(), [](const SSMSGPROFILE* a, const SSMSGPROFILE* b) { return a->ullTotal > b->ullTotal; });
+		if (aSorted.size() > nTop)
+			aSorted.resize(nTop);
+
+		::_stprintf(szLine, TEXT("---- %s (%u) ----\n%-24s %10s %10s %8s %8s %8s %8s %8s\n"), szTitle, static_cast<UINT>(mapProfile.size()),
+			TEXT("key"), TEXT("count"), TEXT("total ms"), TEXT("avg"), TEXT("p50"), TEXT("p99"), TEXT("p99.9"), TEXT("max"));
+		strReport += szLine;
+		for (size_t i = 0; i < aSorted.size(); ++i) {
+			const SSMSGPROFILE* profilePtr = aSorted[i];
+			TCHAR szKey[PROFILE_CLASS_NAME + 16];
+
+			if (bClass)
+				::_stprintf(szKey, TEXT("%s"), profilePtr->szName[0] != 0 ? profilePtr->szName : TEXT("(none)"));
+			else if (profilePtr->uKey >= WM_APP)
+				::_stprintf(szKey, TEXT("WM_APP+0x%04X"), profilePtr->uKey - WM_APP);
+			else if (profilePtr->uKey >= WM_USER)
+				::_stprintf(szKey, TEXT("WM_USER+0x%04X"), profilePtr->uKey - WM_USER);
+			else
+				::_stprintf(szKey, TEXT("0x%04X"), profilePtr->uKey);
+
+			::_stprintf(szLine, TEXT("%-24s %10I64u %10.3f %8I64u %8I64u %8I64u %8I64u %8I64u\n"), szKey, profilePtr->nCount,
+				profilePtr->ullTotal / 1000000.0,
+				profilePtr->nCount != 0 ? profilePtr->ullTotal / profilePtr->nCount / 1000 : 0,
+				profilePtr->histogram.GetPercentile(50.0) / 1000,
+				profilePtr->histogram.GetPercentile(99.0) / 1000,
+				profilePtr->histogram.GetPercentile(99.9) / 1000,
+				profilePtr->ullMax / 1000);
+			strReport += szLine;
+		}
+	}
+};
+
+/**
+ * @class	CxMsgProfileScope
+ * @brief	量測一次訊息分派 (RAII)
+ *
+ * 建構時記錄開始時間, 解構時記錄分派時間; 停用量測時只判斷一次旗標.
+ */
+class CxMsgProfileScope
+{
+public:
+	CxMsgProfileScope(HWND hWnd, UINT uMessage, WPARAM wParam)
+		: m_hWnd(hWnd)
+		, m_uMessage(uMessage)
+		, m_llStart(0)
+	{
+		if (uMessage == WM_HOTKEY)
+			CxMsgProfiler::CheckHotKey(hWnd, wParam);
+		if (CxMsgProfiler::IsEnabled())
+			m_llStart = CxMsgProfiler::Now();
+	}
+
+	~CxMsgProfileScope()
+	{
+		if (m_llStart != 0)
+			CxMsgProfiler::Record(m_hWnd, m_uMessage, m_llStart);
+	}
+
+private:
+	HWND		m_hWnd;		//!< 視窗 Handle
+	UINT		m_uMessage;	//!< 視窗訊息
+	LONGLONG	m_llStart;	//!< 開始時間, 零(zero) 表示未量測
+
+	CxMsgProfileScope(const CxMsgProfileScope&) = delete;
+	CxMsgProfileScope& operator=(const CxMsgProfileScope&) = delete;
+};
+
+/**
+ * @brief	量測目前視窗處理函數的分派 (置於函數開頭)
+ * @param	hWnd		視窗 Handle
+ * @param	uMessage	視窗訊息
+ * @param	wParam		參數 1 (用於判斷 WM_HOTKEY)
+ */
+#define AXEEN_PROFILE_MESSAGE(hWnd, uMessage, wParam)	CxMsgProfileScope axeenProfileScope((hWnd), (uMessage), (wParam))
+
+#else	// (__AXEEN_PROFILE__ != 1)
+
+#define AXEEN_PROFILE_MESSAGE(hWnd, uMessage, wParam)	((void)0)
+
+#endif	// (__AXEEN_PROFILE__ == 1)
+
+#endif // !__AXEEN_AXEENPROFILE_HH__
@@ -24,4 +24,8 @@
 #define __XPP_STYLE__		1		//<! 使用 XP-STYLE 編譯 具備 GUI 類型的的程式。
 #endif
 
+#ifndef __AXEEN_PROFILE__
+#define __AXEEN_PROFILE__	1		//!< 編譯視窗訊息分派效能量測 (axeen_profile.hh), 設為 0 完全移除
+#endif
+
 #endif // !__AXEEN_AXEENSETUP_HH__
@@ -0,0 +1,41 @@
+﻿/**************************************************************************//**
+ * @file	dmc_cancel.hh
+ * @brief	取消標記類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_DMCFRAME_CANCEL_HH__
+#define __AXEEN_DMCFRAME_CANCEL_HH__
+#include "dmc_object.hh"
+
+/**
+ * @class	DmCancelToken
+ * @brief	取消標記 (參考計數)
+ *
+ * 由擁有者 (如 DmWindow) 建立並於結束時調用 Cancel, 非同步工作持有參考並於恢復前檢查 IsCancelled. \n
+ * 標記本身以參考計數管理, 擁有者已經解構後仍可安全查詢. \n
+ * 此類別為執行緒安全.
+ */
+class DmCancelToken
+{
+public:
+	static DmCancelToken* Create();
+
+	LONG	AddRef();
+	LONG	Release();
+	void	Cancel();
+	BOOL	IsCancelled() const;
+
+private:
+	DmCancelToken();
+	~DmCancelToken();
+	DmCancelToken(const DmCancelToken&) = delete;				// Disable copy construction
+	DmCancelToken& operator=(const DmCancelToken&) = delete;	// Disable assignment operator
+
+private:
+	volatile LONG	m_nRef;		//!< 參考計數
+	volatile LONG	m_bCancel;	//!< 是否已取消
+};
+
+#endif // !__AXEEN_DMCFRAME_CANCEL_HH__
@@ -0,0 +1,279 @@
+﻿/**************************************************************************//**
+ * @file	dmc_coroutine.hh
+ * @brief	協程 (coroutine) 支援: 於 UI 執行緒與背景執行緒之間切換
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_DMCFRAME_COROUTINE_HH__
+#define __AXEEN_DMCFRAME_COROUTINE_HH__
+#include "dmc_winapp.hh"
+#include "dmc_window.hh"
+
+// 編譯器支援協程時 __DMC_COROUTINE__ 為 1 (C++20 或 Visual C++ /await)
+#if defined(__cpp_impl_coroutine)
+#	include <coroutine>
+#	define __DMC_COROUTINE__	1
+namespace dmcoro = std;
+#elif defined(_RESUMABLE_FUNCTIONS_SUPPORTED) || defined(__cpp_coroutines)
+#	include <experimental/coroutine>
+#	define __DMC_COROUTINE__	1
+namespace dmcoro = std::experimental;
+#else
+#	define __DMC_COROUTINE__	0
+#endif
+
+/**
+ * @class	DmCoroFramePool
+ * @brief	協程框架配置 (static)
+ *
+ * 框架依尺寸分級 (COROFRAME_MIN_SIZE 起每級加倍) 保留於無鎖可用清單 (SLIST), \n
+ * 協程結束後框架回到可用清單, 重複使用時不需配置堆積. \n
+ * 超過最大分級的框架直接配置堆積. 此類別為執行緒安全.
+ */
+class DmCoroFramePool
+{
+public:
+	static LPVOID	Alloc(size_t uSize);
+	static void		Free(LPVOID framePtr, size_t uSize);
+	static void		Flush();
+	static void		NoteCancelled();
+	static void		GetStats(LPSSCOROSTAT statPtr);
+
+private:
+	DmCoroFramePool() = delete;
+	static int			GetClass(size_t uSize);
+	static PSLIST_HEADER	GetList(int idxClass);
+};
+
+#if __DMC_COROUTINE__
+
+/**
+ * @class	DmTask
+ * @brief	不等待結果 (fire-and-forget) 的協程返回型別
+ *
+ * 協程於調用者執行緒開始執行, 直到第一個 co_await 才交出控制權, 結束後框架自動釋放. \n
+ * 協程為 DmWindow (或衍生類別) 的成員函數, 或第一個參數為 DmWindow 參考時, 框架與該視窗綁定: \n
+ * 視窗結束 (DeathOfWindow) 後, 框架在下一個恢復點直接銷毀, 不會繼續執行. \n
+ * 框架由 DmCoroFramePool 配置; 協程內不可拋出例外.
+ *
+ * @code
+ *	DmTask CxMyDialog::LoadAsync(std::wstring path)
+ *	{
+ *		co_await ResumeOnPool();			// 背景執行緒
+ *		auto data = LoadFile(path);
+ *		co_await ResumeOnUi(*this);			// UI 執行緒, 視窗已結束則不會到達此處
+ *		this->ShowData(data);
+ *		co_await Delay(3000);
+ *		this->SetDlgItemText(IDC_STATUS, TEXT(""));
+ *	}
+ * @endcode
+ */
+class DmTask
+{
+public:
+	struct promise_type;
+	typedef dmcoro::coroutine_handle<promise_type>	CORO_HANDLE;	//!< 協程操作碼
+
+	static void Resume(CORO_HANDLE hCoro);
+
+private:
+	template<typename T> static DmCancelToken* TokenOf(T& obj, std::true_type) { return static_cast<DmWindow&>(obj).GetCancelToken(); }
+	template<typename T> static DmCancelToken* TokenOf(T&, std::false_type) { return NULL; }
+};
+
+/**
+ * @struct	DmTask::promise_type
+ * @brief	DmTask 協程的 promise
+ */
+struct DmTask::promise_type
+{
+	DmCancelToken*	tokenPtr;	//!< 綁定的取消標記, 未綁定為 NULL
+
+	promise_type() : tokenPtr(NULL) { }
+
+	//! 協程參數 (成員函數為 *this) 的第一個為 DmWindow 時綁定視窗的取消標記 (const 成員函數不綁定)
+	template<typename T, typename... ARGS>
+	promise_type(T& obj, ARGS&...) : tokenPtr(NULL) { this->Bind(DmTask::TokenOf(obj, std::integral_constant<bool, std::is_base_of<DmWindow, T>::value && !std::is_const<T>::value>())); }
+
+	~promise_type() { if (tokenPtr != NULL) tokenPtr->Release(); }
+
+	DmTask	get_return_object() { return DmTask(); }
+	static DmTask get_return_object_on_allocation_failure() { return DmTask(); }
+	dmcoro::suspend_never	initial_suspend() { return dmcoro::suspend_never(); }
+	dmcoro::suspend_never	final_suspend() noexcept { return dmcoro::suspend_never(); }
+	void	return_void() { }
+	void	unhandled_exception() { std::terminate(); }
+
+	//! 綁定取消標記 (已綁定時忽略)
+	void	Bind(DmCancelToken* bindPtr) { if (tokenPtr == NULL && bindPtr != NULL) { bindPtr->AddRef(); tokenPtr = bindPtr; } }
+	//! 綁定的取消標記是否已取消
+	BOOL	IsCancelled() const { return tokenPtr != NULL && tokenPtr->IsCancelled(); }
+
+	static void* operator new(size_t uSize) noexcept { return DmCoroFramePool::Alloc(uSize); }
+	static void operator delete(void* framePtr, size_t uSize) { DmCoroFramePool::Free(framePtr, uSize); }
+};
+
+/**
+ * @brief	恢復協程, 綁定的視窗已結束時改為銷毀框架 (static)
+ * @param	[in] hCoro	暫停中的協程操作碼
+ */
+inline void DmTask::Resume(CORO_HANDLE hCoro)
+{
+	if (hCoro.promise().IsCancelled()) {
+		DmCoroFramePool::NoteCancelled();
+		hCoro.destroy();
+	}
+	else {
+		hCoro.resume();
+	}
+}
+
+/**
+ * @class	DmCoroResume
+ * @brief	持有暫停中協程的可呼叫物件 (只能移動)
+ * @remark	以 operator() 恢復協程; 未調用即解構 (如事件迴圈或執行緒池關閉) 時銷毀框架.
+ */
+class DmCoroResume
+{
+public:
+	explicit DmCoroResume(DmTask::CORO_HANDLE hCoro) : m_hCoro(hCoro) { }
+	DmCoroResume(DmCoroResume&& other) : m_hCoro(other.m_hCoro) { other.m_hCoro = nullptr; }
+	~DmCoroResume() { if (m_hCoro) m_hCoro.destroy(); }
+
+	void operator()()
+	{
+		DmTask::CORO_HANDLE hCoro = m_hCoro;
+		m_hCoro = nullptr;
+		DmTask::Resume(hCoro);
+	}
+
+private:
+	DmCoroResume(const DmCoroResume&) = delete;				// Disable copy construction
+	DmCoroResume& operator=(const DmCoroResume&) = delete;	// Disable assignment operator
+
+	DmTask::CORO_HANDLE	m_hCoro;	//!< 暫停中的協程
+};
+
+/**
+ * @class	DmAwaitPool
+ * @brief	於執行緒池恢復協程的等待物件 (ResumeOnPool)
+ * @remark	執行緒池無法建立時不暫停, 於目前執行緒繼續執行.
+ */
+class DmAwaitPool
+{
+public:
+	explicit DmAwaitPool(CxFrameTaskPool* poolPtr) : m_poolPtr(poolPtr) { }
+
+	bool await_ready() const { return m_poolPtr == NULL; }
+	void await_suspend(DmTask::CORO_HANDLE hCoro)
+	{
+		// 投遞後協程可能已在其他執行緒恢復, 不可再存取成員
+		CxFrameTaskPool* poolPtr = m_poolPtr;
+		poolPtr->Submit(DmCoroResume(hCoro));
+	}
+	void await_resume() const { }
+
+private:
+	CxFrameTaskPool*	m_poolPtr;	//!< 目標執行緒池
+};
+
+/**
+ * @class	DmAwaitLoop
+ * @brief	於事件迴圈執行緒恢復協程的等待物件 (ResumeOnUi, ResumeOnThread)
+ */
+class DmAwaitLoop
+{
+public:
+	DmAwaitLoop(DmLoopCore* loopPtr, DmWindow* windowPtr) : m_loopPtr(loopPtr), m_windowPtr(windowPtr) { }
+
+	bool await_ready() const { return false; }
+	void await_suspend(DmTask::CORO_HANDLE hCoro)
+	{
+		DmLoopCore* loopPtr = m_loopPtr;
+
+		if (m_windowPtr != NULL && hCoro.promise().tokenPtr == NULL) {
+			DmCancelToken* tokenPtr = m_windowPtr->GetCancelToken();
+
+			// 視窗已結束 (沒有標記), 不恢復
+			if (tokenPtr == NULL) {
+				DmCoroFramePool::NoteCancelled();
+				hCoro.destroy();
+				return;
+			}
+			hCoro.promise().Bind(tokenPtr);
+		}
+		loopPtr->PostTask(DmCoroResume(hCoro));
+	}
+	void await_resume() const { }
+
+private:
+	DmLoopCore*	m_loopPtr;		//!< 目標事件迴圈
+	DmWindow*	m_windowPtr;	//!< 綁定的視窗, NULL 表示不綁定
+};
+
+/**
+ * @class	DmAwaitDelay
+ * @brief	經過指定時間後於事件迴圈執行緒恢復協程的等待物件 (Delay)
+ * @remark	以事件迴圈的計時器實作, 不佔用執行緒; 事件迴圈關閉時尚未到期的框架不會釋放.
+ */
+class DmAwaitDelay
+{
+public:
+	DmAwaitDelay(DmLoopCore* loopPtr, DWORD dwDelay) : m_loopPtr(loopPtr), m_dwDelay(dwDelay) { }
+
+	bool await_ready() const { return false; }
+	void await_suspend(DmTask::CORO_HANDLE hCoro)
+	{
+		DmLoopCore* loopPtr = m_loopPtr;
+		DWORD dwDelay = m_dwDelay;
+
+		// SetTimer 只能由迴圈執行緒調用, 先投遞至迴圈再設定計時器
+		loopPtr->PostTask([loopPtr, dwDelay, resume = DmCoroResume(hCoro)]() mutable {
+			DmCoroResume* resumePtr = new (std::nothrow) DmCoroResume(std::move(resume));
+			if (resumePtr != NULL && loopPtr->SetTimer(dwDelay, 0, &DmAwaitDelay::OnTimer, resumePtr) == 0)
+				delete resumePtr;
+		});
+	}
+	void await_resume() const { }
+
+private:
+	//! 計時器到期, 恢復協程
+	static void CALLBACK OnTimer(LPVOID aParamPtr)
+	{
+		DmCoroResume* resumePtr = static_cast<DmCoroResume*>(aParamPtr);
+		(*resumePtr)();
+		delete resumePtr;
+	}
+
+private:
+	DmLoopCore*	m_loopPtr;	//!< 目標事件迴圈
+	DWORD		m_dwDelay;	//!< 延遲時間 (in ms)
+};
+
+//! 切換至應用程式的背景執行緒池 (DmWinApp::GetPool)
+inline DmAwaitPool ResumeOnPool() { return DmAwaitPool(GetAPP().GetPool()); }
+//! 切換至指定的執行緒池
+inline DmAwaitPool ResumeOnPool(CxFrameTaskPool* poolPtr) { return DmAwaitPool(poolPtr); }
+//! 切換至 UI 執行緒 (DmWinApp 事件迴圈)
+inline DmAwaitLoop ResumeOnUi() { return DmAwaitLoop(GetAPP().GetLoop(), NULL); }
+
+/**
+ * @brief	切換至 UI 執行緒, 並將協程與視窗綁定
+ * @param	[in] window	綁定的視窗, 協程已綁定時忽略
+ * @return	@c 型別: DmAwaitLoop, 以 co_await 等待
+ * @remark	視窗在切換完成前結束時協程不會恢復; 視窗已經結束時立即銷毀協程. \n
+ *			協程尚未綁定時會調用 window.GetCancelToken() 綁定目前的視窗實體, 此時視窗物件必須仍然存在.
+ */
+inline DmAwaitLoop ResumeOnUi(DmWindow& window) { return DmAwaitLoop(GetAPP().GetLoop(), &window); }
+
+//! 切換至指定 DmThread 的事件迴圈執行緒
+inline DmAwaitLoop ResumeOnThread(DmThread& thread) { return DmAwaitLoop(thread.GetLoop(), NULL); }
+//! 經過 dwDelay (in ms) 後於 UI 執行緒恢復
+inline DmAwaitDelay Delay(DWORD dwDelay) { return DmAwaitDelay(GetAPP().GetLoop(), dwDelay); }
+//! 經過 dwDelay (in ms) 後於指定 DmThread 的事件迴圈執行緒恢復
+inline DmAwaitDelay Delay(DWORD dwDelay, DmThread& thread) { return DmAwaitDelay(thread.GetLoop(), dwDelay); }
+
+#endif // __DMC_COROUTINE__
+
+#endif // !__AXEEN_DMCFRAME_COROUTINE_HH__
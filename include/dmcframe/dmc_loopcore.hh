@@ -0,0 +1,246 @@
+﻿/**************************************************************************//**
+ * @file	dmc_loopcore.hh
+ * @brief	DMC Frame 事件迴圈核心類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_DMCFRAME_LOOPCORE_HH__
+#define __AXEEN_DMCFRAME_LOOPCORE_HH__
+#include "dmc_object.hh"
+
+/**
+ * @class	DmLoopCore
+ * @brief	事件迴圈核心類別
+ *
+ * 以單一 API 處理: 投遞工作 (PostTask), 計時器 (SetTimer), 核心物件等待 (AddWait), 結束 (Quit). \n
+ * 迴圈以 MsgWaitForMultipleObjectsEx 同時等待視窗訊息與核心物件; \n
+ * 建立時指定不處理視窗訊息 (headless) 則改用 WaitForMultipleObjectsEx, 可於沒有視窗的環境下量測分派效能.
+ *
+ * 投遞工作佇列為無鎖多生產者單一消費者佇列 (intrusive MPSC, Vyukov): \n
+ * - 投遞只需一次 InterlockedExchangePointer, 不受視窗訊息佇列數量上限 (10000) 限制
+ * - 每次處理佇列前最多觸發一次喚醒事件, 而非每個工作一次
+ * - 每輪最多執行 SetTaskBatch 個工作, 避免大量投遞時訊息與計時器無法處理
+ *
+ * PostCoalesced 以 (目標, 種類) 為合併鍵值投遞: 同鍵值尚未執行的項目會被取代, 只執行最後一次投遞的內容. \n
+ * 適用於高頻率的重複更新, 如同一控制項的 SetText, 進度通知等.
+ *
+ * 閒置處理函數 (AddIdle) 於處理完事件後, 在 SetIdleBudget 指定的時間內輪流執行; \n
+ * 全部閒置處理函數返回 FALSE (沒有剩餘工作) 後迴圈進入等待, 直到下一個事件發生, 閒置時不佔用 CPU.
+ *
+ * PostTask, PostCoalesced, Quit 與 GetTaskStats 可由任何執行緒調用, 其餘函數只能由執行迴圈的執行緒調用.
+ */
+class DmLoopCore : public DmObject
+{
+public:
+	typedef void (CALLBACK* LPFNLOOPTASK)(LPVOID aParamPtr);					//!< 工作 / 計時器處理函數
+	typedef void (CALLBACK* LPFNLOOPWAIT)(LPVOID aParamPtr, HANDLE hObject);	//!< 核心物件觸發處理函數
+	typedef BOOL (CALLBACK* LPFNLOOPFILTER)(LPVOID aParamPtr, MSG* msgPtr);		//!< 訊息前置處理函數, 返回 TRUE 表示已處理
+	typedef BOOL (CALLBACK* LPFNLOOPIDLE)(LPVOID aParamPtr, DWORD dwBudget);	//!< 閒置處理函數, dwBudget 為剩餘時間 (in µs), 返回 TRUE 表示尚有工作
+
+public:
+	DmLoopCore();
+	virtual ~DmLoopCore();
+
+	BOOL	Create(BOOL bMessage = TRUE);
+	void	Close();
+
+	int		Run();
+	BOOL	RunOnce(DWORD dwTimeout);
+	void	Quit(int iExitCode);
+	BOOL	IsQuit() const;
+	int		GetExitCode() const;
+
+	BOOL	PostTask(LPFNLOOPTASK fnTaskPtr, LPVOID aParamPtr);
+	template<typename FN> BOOL PostTask(FN fnTask);
+	BOOL	PostCoalesced(LPCVOID aTargetPtr, UINT uKind, LPFNLOOPTASK fnTaskPtr, LPVOID aParamPtr, LPFNLOOPTASK fnFreePtr = NULL);
+	template<typename FN> BOOL PostCoalesced(LPCVOID aTargetPtr, UINT uKind, FN fnTask);
+	BOOL	PostCoalescedMessage(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam);
+	void	SetTaskBatch(size_t nBatch);
+	void	GetTaskStats(LPSSLOOPSTAT statPtr);
+	void	ResetTaskStats();
+	UINT	SetTimer(DWORD dwDelay, DWORD dwPeriod, LPFNLOOPTASK fnTaskPtr, LPVOID aParamPtr);
+	BOOL	KillTimer(UINT idTimer);
+	UINT	AddWait(HANDLE hObject, LPFNLOOPWAIT fnWaitPtr, LPVOID aParamPtr);
+	BOOL	RemoveWait(UINT idWait);
+	void	SetMessageFilter(LPFNLOOPFILTER fnFilterPtr, LPVOID aParamPtr);
+	UINT	AddIdle(LPFNLOOPIDLE fnIdlePtr, LPVOID aParamPtr);
+	BOOL	RemoveIdle(UINT idIdle);
+	void	SetIdleBudget(DWORD dwBudget);
+
+private:
+	/**
+	 * @struct	SSTASK
+	 * @brief	投遞的工作 (佇列節點)
+	 */
+	struct SSTASK {
+		SSTASK* volatile	nextPtr;	//!< 下一個節點
+		LPFNLOOPTASK		fnTaskPtr;	//!< 處理函數
+		LPFNLOOPTASK		fnFreePtr;	//!< 未執行即捨棄時的釋放函數
+		LPVOID				aParamPtr;	//!< 處理函數參數
+		LONGLONG			llPost;		//!< 投遞時間 (QueryPerformanceCounter)
+	};
+
+	/**
+	 * @struct	SSCOALESCE
+	 * @brief	以合併鍵值投遞, 尚未執行的項目
+	 */
+	struct SSCOALESCE {
+		DmLoopCore*		loopPtr;	//!< 所屬事件迴圈
+		LPCVOID			aTargetPtr;	//!< 合併鍵值: 目標
+		UINT			uKind;		//!< 合併鍵值: 種類
+		LPFNLOOPTASK	fnTaskPtr;	//!< 處理函數 (最後一次投遞)
+		LPFNLOOPTASK	fnFreePtr;	//!< 未執行即捨棄時的釋放函數
+		LPVOID			aParamPtr;	//!< 處理函數參數
+	};
+	typedef std::pair<LPCVOID, UINT>	COALESCEKEY;	//!< 合併鍵值 (目標, 種類)
+
+	/**
+	 * @struct	SSTIMER
+	 * @brief	計時器 (以到期時間排列為最小堆積)
+	 */
+	struct SSTIMER {
+		ULONGLONG		ullDue;		//!< 到期時間 (GetTickCount64)
+		DWORD			dwPeriod;	//!< 週期 (in ms), 零(zero) 表示只觸發一次
+		UINT			idTimer;	//!< 計時器 ID
+		LPFNLOOPTASK	fnTaskPtr;	//!< 處理函數
+		LPVOID			aParamPtr;	//!< 處理函數參數
+	};
+
+	/**
+	 * @struct	SSIDLE
+	 * @brief	閒置處理項目
+	 */
+	struct SSIDLE {
+		UINT			idIdle;		//!< 閒置處理 ID
+		LPFNLOOPIDLE	fnIdlePtr;	//!< 處理函數
+		LPVOID			aParamPtr;	//!< 處理函數參數
+		BOOL			bMore;		//!< 是否尚有工作
+	};
+
+	/**
+	 * @struct	SSWAIT
+	 * @brief	等待中的核心物件
+	 */
+	struct SSWAIT {
+		UINT			idWait;		//!< 等待 ID
+		LPFNLOOPWAIT	fnWaitPtr;	//!< 處理函數
+		LPVOID			aParamPtr;	//!< 處理函數參數
+	};
+
+	BOOL	PushTask(LPFNLOOPTASK fnTaskPtr, LPFNLOOPTASK fnFreePtr, LPVOID aParamPtr);
+	void	PushNode(SSTASK* taskPtr);
+	SSTASK*	PopNode();
+	BOOL	IsTaskEmpty() const;
+	void	FreeTasks();
+	DWORD	NextTimeout(DWORD dwTimeout);
+	BOOL	DispatchMessages();
+	BOOL	DispatchTimers();
+	void	DispatchTasks();
+	void	DispatchIdle();
+
+	static bool TimerLater(const SSTIMER& a, const SSTIMER& b);
+	static void CALLBACK RunCoalesced(LPVOID aParamPtr);
+	static void CALLBACK FreeCoalesced(LPVOID aParamPtr);
+	template<typename FN> static void CALLBACK InvokeTask(LPVOID aParamPtr);
+	template<typename FN> static void CALLBACK DeleteTask(LPVOID aParamPtr);
+
+private:
+	BOOL				m_bMessage;		//!< 是否處理視窗訊息
+	HANDLE				m_hWake;		//!< 喚醒事件 (投遞工作或結束時觸發)
+	SSTASK* volatile	m_headPtr;		//!< 佇列頭 (生產者端, 最後投遞的節點)
+	SSTASK*				m_tailPtr;		//!< 佇列尾 (消費者端, 下一個執行的節點)
+	SSTASK				m_stub;			//!< 佇列虛節點
+	size_t				m_nBatch;		//!< 每輪最多執行的工作數量
+	CRITICAL_SECTION	m_csCoalesce;	//!< 保護 m_mapCoalesce
+	std::map<COALESCEKEY, SSCOALESCE>	m_mapCoalesce;	//!< 尚未執行的合併項目
+	std::vector<SSTIMER>	m_aTimer;	//!< 計時器堆積
+	std::vector<HANDLE>	m_aHandle;		//!< 等待的核心物件 (第一個為喚醒事件)
+	std::vector<SSWAIT>	m_aWait;		//!< 等待處理項目 (與 m_aHandle[1...] 對應)
+	std::vector<SSIDLE>	m_aIdle;		//!< 閒置處理項目
+	size_t				m_idxIdle;		//!< 下一輪第一個執行的閒置處理項目 (輪流)
+	DWORD				m_dwIdleBudget;	//!< 每輪閒置處理時間上限 (in µs)
+	BOOL				m_bIdleMore;	//!< 是否有閒置處理項目尚有工作
+	LPFNLOOPFILTER		m_fnFilterPtr;	//!< 訊息前置處理函數
+	LPVOID				m_aFilterPtr;	//!< 訊息前置處理函數參數
+	UINT				m_idNext;		//!< 下一個計時器 / 等待 / 閒置處理 ID
+	volatile LONG		m_bSignal;		//!< 喚醒事件是否已觸發尚未處理
+	volatile LONG		m_bQuit;		//!< 是否結束
+	int					m_iExitCode;	//!< 結束碼
+
+	volatile LONG64		m_nPosted;		//!< 統計: 投遞工作總數
+	volatile LONG64		m_nWakeups;		//!< 統計: 觸發喚醒事件次數
+	LONG64				m_nExecuted;	//!< 統計: 已執行工作總數
+	LONG64				m_nMaxDepth;	//!< 統計: 最大佇列深度
+	LONG64				m_nDrains;		//!< 統計: 處理佇列次數
+	LONGLONG			m_llLatency;	//!< 統計: 延遲總和 (QueryPerformanceCounter 單位)
+	LONGLONG			m_llLatencyMax;	//!< 統計: 最大延遲 (QueryPerformanceCounter 單位)
+	volatile LONG64		m_nCoalesced;	//!< 統計: 以合併鍵值投遞總數
+	volatile LONG64		m_nMerged;		//!< 統計: 合併數量
+	LONGLONG			m_llFrequency;	//!< QueryPerformanceFrequency
+
+	DmLoopCore(const DmLoopCore&) = delete;				// Disable copy construction
+	DmLoopCore& operator=(const DmLoopCore&) = delete;	// Disable assignment operator
+};
+
+/**
+ * @brief	投遞可呼叫物件 (lambda, 函數物件)
+ * @param	[in] fnTask	可呼叫物件, 以 fnTask() 調用
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			配置記憶體失敗或迴圈未建立返回零(zero)
+ * @remark	可呼叫物件會被複製至堆積, 執行後或迴圈關閉時釋放.
+ */
+template<typename FN>
+BOOL DmLoopCore::PostTask(FN fnTask)
+{
+	FN* fnPtr = new (std::nothrow) FN(std::move(fnTask));
+
+	if (fnPtr == NULL)
+		return FALSE;
+	if (this->PushTask(&DmLoopCore::InvokeTask<FN>, &DmLoopCore::DeleteTask<FN>, fnPtr))
+		return TRUE;
+	delete fnPtr;
+	return FALSE;
+}
+
+/**
+ * @brief	以合併鍵值投遞可呼叫物件 (lambda, 函數物件)
+ * @param	[in] aTargetPtr	合併鍵值: 目標 (如控制項或物件指標)
+ * @param	[in] uKind		合併鍵值: 種類 (如訊息或更新種類)
+ * @param	[in] fnTask		可呼叫物件, 以 fnTask() 調用
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			配置記憶體失敗或迴圈未建立返回零(zero)
+ * @remark	被取代的可呼叫物件不會執行, 直接釋放.
+ */
+template<typename FN>
+BOOL DmLoopCore::PostCoalesced(LPCVOID aTargetPtr, UINT uKind, FN fnTask)
+{
+	FN* fnPtr = new (std::nothrow) FN(std::move(fnTask));
+
+	if (fnPtr == NULL)
+		return FALSE;
+	if (this->PostCoalesced(aTargetPtr, uKind, &DmLoopCore::InvokeTask<FN>, fnPtr, &DmLoopCore::DeleteTask<FN>))
+		return TRUE;
+	delete fnPtr;
+	return FALSE;
+}
+
+//! 執行並釋放可呼叫物件
+template<typename FN>
+void CALLBACK DmLoopCore::InvokeTask(LPVOID aParamPtr)
+{
+	FN* fnPtr = static_cast<FN*>(aParamPtr);
+	(*fnPtr)();
+	delete fnPtr;
+}
+
+//! 釋放未執行的可呼叫物件
+template<typename FN>
+void CALLBACK DmLoopCore::DeleteTask(LPVOID aParamPtr)
+{
+	delete static_cast<FN*>(aParamPtr);
+}
+
+#endif // !__AXEEN_DMCFRAME_LOOPCORE_HH__
@@ -28,7 +28,60 @@ enum class DMCERR : DWORD
 	, ERR_ENDVALUE				//!< 不是錯誤!!! 錯誤碼結尾識別碼
 };
 
+/**
+ * @struct	SSLOOPSTAT
+ * @brief	事件迴圈投遞工作統計資訊
+ */
+typedef struct SSLOOPSTAT {
+	LONG64		nPosted;		//!< 投遞工作總數
+	LONG64		nExecuted;		//!< 已執行工作總數
+	LONG64		nDepth;			//!< 目前佇列中的工作數量
+	LONG64		nMaxDepth;		//!< 開始處理時最大佇列深度
+	LONG64		nWakeups;		//!< 投遞工作觸發喚醒事件次數
+	LONG64		nDrains;		//!< 處理佇列次數
+	LONG64		llLatencyAvg;	//!< 平均投遞至執行延遲 (in µs)
+	LONG64		llLatencyMax;	//!< 最大投遞至執行延遲 (in µs)
+	LONG64		nCoalesced;		//!< 以合併鍵值投遞的總數 (PostCoalesced)
+	LONG64		nMerged;		//!< 取代尚未執行項目而合併的數量
+} *LPSSLOOPSTAT;
+
+#define LOOPCORE_TASK_BATCH		256		//!< 事件迴圈每輪最多執行的投遞工作數量 (預設值)
+#define LOOPCORE_IDLE_BUDGET	4000	//!< 事件迴圈每輪閒置處理時間上限 (預設值, in µs)
+
+/**
+ * @struct	SSCOROSTAT
+ * @brief	協程 (DmTask) 框架配置統計資訊
+ */
+struct SSCOROSTAT {
+	LONG64		nFrames;		//!< 配置框架總數
+	LONG64		nPooled;		//!< 由可用清單取得 (未配置堆積) 的數量
+	LONG64		nHeap;			//!< 超過最大尺寸直接配置堆積的數量
+	LONG64		nCached;		//!< 目前可用清單中的框架數量
+	LONG64		nCancelled;		//!< 因取消而未恢復即銷毀的框架數量
+};
+typedef SSCOROSTAT*		LPSSCOROSTAT;	//!< SSCOROSTAT 結構指標型別
+
+#define COROFRAME_MIN_SIZE		128		//!< 協程框架最小尺寸分級 (in Byte)
+#define COROFRAME_CLASSES		6		//!< 協程框架尺寸分級數量 (128 ~ 4096 Byte)
+#define COROFRAME_CACHE_DEPTH	64		//!< 每個尺寸分級保留的可用框架上限
+
+/**
+ * @struct	SSWHEELSTAT
+ * @brief	階層式計時輪統計資訊
+ */
+struct SSWHEELSTAT {
+	LONG64		nActive;		//!< 目前計時器數量
+	LONG64		nSet;			//!< 設定計時器總數
+	LONG64		nKilled;		//!< 移除計時器總數
+	LONG64		nFired;			//!< 觸發次數
+	LONG64		nCascaded;		//!< 由上層移至下層的次數
+	LONG64		nWakeups;		//!< 系統計時器喚醒次數
+};
+typedef SSWHEELSTAT*	LPSSWHEELSTAT;	//!< SSWHEELSTAT 結構指標型別
 
+#define TIMERWHEEL_SLOT_BITS	6		//!< 計時輪每層槽位數量的位元數 (64 槽)
+#define TIMERWHEEL_LEVELS		11		//!< 計時輪層數 (每層 6 位元, 涵蓋 64 位元的毫秒時間)
+#define TIMERWHEEL_INDEX_BITS	20		//!< 計時器 ID 中節點索引的位元數, 其餘為世代編號
 
 
 #endif // !__AXEEN_DMCFRAME_STRUCT_HH__
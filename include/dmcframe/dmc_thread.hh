@@ -7,7 +7,8 @@
  *****************************************************************************/
 #ifndef __AXEEN_DMCFRAME_THREAD_HH__
 #define __AXEEN_DMCFRAME_THREAD_HH__
-#include "dmc_object.hh"
+#include "dmc_loopcore.hh"
+#include "dmc_timerwheel.hh"
 
 class DmThread : public DmObject
 {
@@ -18,12 +19,25 @@ public:
 	// Overridables
 	virtual int	MessageLoop(int bPreek);
 
+	DmLoopCore*	GetLoop();
+	DmTimerWheel*	GetTimerWheel();
+	BOOL	PostTask(DmLoopCore::LPFNLOOPTASK fnTaskPtr, LPVOID aParamPtr);
+	template<typename FN> BOOL PostTask(FN fnTask) { return m_loop.PostTask(std::move(fnTask)); }
+	template<typename FN> BOOL PostCoalesced(LPCVOID aTargetPtr, UINT uKind, FN fnTask) { return m_loop.PostCoalesced(aTargetPtr, uKind, std::move(fnTask)); }
+	BOOL	PostCoalescedMessage(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam);
+
 protected:
 	// These virtual functions can be overridden
 	virtual int MessageLoopNormal();
 	virtual int MessageLoopPeek();
+	virtual BOOL PreTranslateMessage(MSG* msgPtr);
 
 private:
+	static BOOL CALLBACK MessageFilter(LPVOID aParamPtr, MSG* msgPtr);
+
+	DmLoopCore	m_loop;		//!< 事件迴圈核心
+	DmTimerWheel	m_wheel;	//!< 計時輪 (首次取得時建立, 須先於 m_loop 解構)
+
 	DmThread(const DmThread&) = delete;				// Disable copy construction
 	DmThread& operator=(const DmThread&) = delete;	// Disable assignment operator
 };
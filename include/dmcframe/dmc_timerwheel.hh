@@ -0,0 +1,155 @@
+﻿/**************************************************************************//**
+ * @file	dmc_timerwheel.hh
+ * @brief	階層式計時輪類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_DMCFRAME_TIMERWHEEL_HH__
+#define __AXEEN_DMCFRAME_TIMERWHEEL_HH__
+#include "dmc_loopcore.hh"
+
+/**
+ * @class	DmTimerWheel
+ * @brief	階層式計時輪 (hierarchical timing wheel)
+ *
+ * 將任意數量的單次與週期計時器集中於一個系統可等待計時器 (waitable timer), 以 DmLoopCore::AddWait 等待. \n
+ * 時間單位為毫秒 (QueryPerformanceCounter), 共 TIMERWHEEL_LEVELS 層, 每層 64 槽: \n
+ * - 計時器依到期時間與目前時間最高的相異位元群組放入對應層, 設定與移除皆為 O(1)
+ * - 到達上層槽位的起點時, 該槽的計時器移至下層 (cascade), 最後於第 0 層到期
+ * - 各層以 64 位元遮罩記錄非空槽位, 可直接跳至下一個事件, 不逐毫秒前進
+ *
+ * 容許延遲 (dwTolerance) 大於零時, 到期時間對齊至不超過容許延遲的 2 的次方邊界, \n
+ * 相近的計時器於同一次喚醒觸發, 減少喚醒次數. \n
+ * 系統支援時使用高解析度計時器 (CREATE_WAITABLE_TIMER_HIGH_RESOLUTION), 不受 WM_TIMER 約 15 ms 精度的限制. \n
+ * 除 GetStats 以外的函數只能由執行迴圈的執行緒調用.
+ */
+class DmTimerWheel : public DmObject
+{
+public:
+	typedef DmLoopCore::LPFNLOOPTASK	LPFNTIMER;	//!< 計時器處理函數
+
+public:
+	DmTimerWheel();
+	virtual ~DmTimerWheel();
+
+	BOOL	Create(DmLoopCore* loopPtr);
+	void	Close();
+	BOOL	IsCreated() const;
+
+	UINT	SetTimer(DWORD dwDelay, DWORD dwPeriod, LPFNTIMER fnTimerPtr, LPVOID aParamPtr, DWORD dwTolerance = 0);
+	template<typename FN> UINT SetTimer(DWORD dwDelay, DWORD dwPeriod, FN fnTimer, DWORD dwTolerance = 0);
+	BOOL	ResetTimer(UINT idTimer, DWORD dwDelay);
+	BOOL	KillTimer(UINT idTimer);
+	size_t	GetCount() const;
+	void	GetStats(LPSSWHEELSTAT statPtr);
+
+private:
+	enum : WORD {
+		LIST_NONE = 0xFFFF,		//!< 不在任何串列
+		LIST_EXPIRED = 0xFFFE,	//!< 在到期串列, 等待執行
+	};
+
+	enum : BYTE {
+		STATE_FREE = 0,		//!< 未使用
+		STATE_ACTIVE,		//!< 等待到期
+		STATE_RUNNING,		//!< 正在執行處理函數
+		STATE_KILLED,		//!< 執行處理函數期間被移除
+	};
+
+	/**
+	 * @struct	SSNODE
+	 * @brief	計時器節點 (以索引連結, 節點陣列擴充時不受影響)
+	 */
+	struct SSNODE {
+		DWORD		idxPrev;		//!< 串列中的上一個節點, 零(zero) 表示沒有
+		DWORD		idxNext;		//!< 串列中的下一個節點, 零(zero) 表示沒有; 未使用時為可用清單的下一個
+		WORD		wList;			//!< 所在串列: 層 * 64 + 槽, LIST_NONE 或 LIST_EXPIRED
+		WORD		wGen;			//!< 世代編號, 釋放時遞增, 避免誤移除重複使用的節點
+		BYTE		byState;		//!< 節點狀態
+		BYTE		byRearm;		//!< 執行期間調用 ResetTimer, 結束後重新排程
+		DWORD		dwPeriod;		//!< 週期 (in ms), 零(zero) 表示只觸發一次
+		DWORD		dwTolerance;	//!< 容許延遲 (in ms)
+		ULONGLONG	ullDue;			//!< 預定時間 (in ms), 週期計時器以此計算下一次
+		ULONGLONG	ullExpire;		//!< 對齊容許延遲後的到期時間 (in ms)
+		LPFNTIMER	fnTimerPtr;		//!< 處理函數
+		LPFNTIMER	fnFreePtr;		//!< 計時器移除後的釋放函數
+		LPVOID		aParamPtr;		//!< 處理函數參數
+	};
+
+	UINT	AddTimer(DWORD dwDelay, DWORD dwPeriod, LPFNTIMER fnTimerPtr, LPFNTIMER fnFreePtr, LPVOID aParamPtr, DWORD dwTolerance);
+	DWORD	FindNode(UINT idTimer) const;
+	DWORD	AllocNode();
+	void	ReleaseNode(DWORD idxNode);
+	void	Schedule(DWORD idxNode, ULONGLONG ullDue);
+	void	Place(DWORD idxNode);
+	void	LinkNode(DWORD idxNode, WORD wList);
+	void	UnlinkNode(DWORD idxNode);
+	void	Advance(ULONGLONG ullNow);
+	void	Cascade(int iLevel, int iSlot);
+	void	RunExpired();
+	BOOL	NextEvent(ULONGLONG* ullTickPtr) const;
+	void	Arm();
+	ULONGLONG	GetNow() const;
+
+	static void CALLBACK OnSignal(LPVOID aParamPtr, HANDLE hObject);
+	template<typename FN> static void CALLBACK InvokeTimer(LPVOID aParamPtr);
+	template<typename FN> static void CALLBACK DeleteTimer(LPVOID aParamPtr);
+
+	DmTimerWheel(const DmTimerWheel&) = delete;				// Disable copy construction
+	DmTimerWheel& operator=(const DmTimerWheel&) = delete;	// Disable assignment operator
+
+private:
+	DmLoopCore*			m_loopPtr;		//!< 所屬事件迴圈
+	HANDLE				m_hTimer;		//!< 系統可等待計時器
+	UINT				m_idWait;		//!< DmLoopCore 等待 ID
+	LONGLONG			m_llFreq;		//!< QueryPerformanceFrequency
+	ULONGLONG			m_ullCurrent;	//!< 下一個待處理的時間 (in ms), 之前的時間已處理完畢
+	ULONGLONG			m_ullArmed;		//!< 系統計時器設定的觸發時間, 全為 1 表示未設定
+	std::vector<SSNODE>	m_aNode;		//!< 節點陣列, 索引零(zero) 不使用
+	DWORD				m_idxFree;		//!< 可用節點清單
+	DWORD				m_idxExpired;	//!< 到期串列
+	DWORD				m_aHead[TIMERWHEEL_LEVELS][1 << TIMERWHEEL_SLOT_BITS];	//!< 各層各槽的串列開頭
+	ULONGLONG			m_aMask[TIMERWHEEL_LEVELS];	//!< 各層非空槽位遮罩
+	size_t				m_nCount;		//!< 計時器數量
+	SSWHEELSTAT			m_stat;			//!< 統計資訊
+};
+
+/**
+ * @brief	設定計時器, 處理函數為可呼叫物件 (lambda, 函數物件)
+ * @param	[in] dwDelay		第一次觸發的延遲 (in ms)
+ * @param	[in] dwPeriod		週期 (in ms), 零(zero) 表示只觸發一次
+ * @param	[in] fnTimer		可呼叫物件, 以 fnTimer() 調用
+ * @param	[in] dwTolerance	容許延遲 (in ms)
+ * @return	@c 型別: UINT \n 計時器 ID, 失敗返回零(zero)
+ * @remark	可呼叫物件會被複製至堆積, 單次計時器觸發後或計時器移除時釋放.
+ */
+template<typename FN>
+UINT DmTimerWheel::SetTimer(DWORD dwDelay, DWORD dwPeriod, FN fnTimer, DWORD dwTolerance)
+{
+	FN* fnPtr = new (std::nothrow) FN(std::move(fnTimer));
+	UINT idTimer;
+
+	if (fnPtr == NULL)
+		return 0;
+	if ((idTimer = this->AddTimer(dwDelay, dwPeriod, &DmTimerWheel::InvokeTimer<FN>, &DmTimerWheel::DeleteTimer<FN>, fnPtr, dwTolerance)) != 0)
+		return idTimer;
+	delete fnPtr;
+	return 0;
+}
+
+//! 執行可呼叫物件
+template<typename FN>
+void CALLBACK DmTimerWheel::InvokeTimer(LPVOID aParamPtr)
+{
+	(*static_cast<FN*>(aParamPtr))();
+}
+
+//! 釋放可呼叫物件
+template<typename FN>
+void CALLBACK DmTimerWheel::DeleteTimer(LPVOID aParamPtr)
+{
+	delete static_cast<FN*>(aParamPtr);
+}
+
+#endif // !__AXEEN_DMCFRAME_TIMERWHEEL_HH__
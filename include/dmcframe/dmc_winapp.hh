@@ -8,6 +8,38 @@
 #ifndef __AXEEN_DMCFRAME_WINAPP_HH__
 #define __AXEEN_DMCFRAME_WINAPP_HH__
 #include "dmc_thread.hh"
+#include "win32frame/wframe_taskpool.hh"
+
+/**
+ * @struct	DmAsyncThen
+ * @brief	執行背景工作, 並將結果投遞至事件迴圈執行後續處理
+ * @tparam	R	背景工作返回型別
+ */
+template<typename R>
+struct DmAsyncThen
+{
+	template<typename FNWORK, typename FNTHEN>
+	static void Run(DmLoopCore* loopPtr, FNWORK& fnWork, FNTHEN& fnThen)
+	{
+		R result = fnWork();
+		loopPtr->PostTask([fnThen = std::move(fnThen), result = std::move(result)]() mutable { fnThen(std::move(result)); });
+	}
+};
+
+/**
+ * @struct	DmAsyncThen<void>
+ * @brief	執行沒有返回值的背景工作, 完成後投遞至事件迴圈執行後續處理
+ */
+template<>
+struct DmAsyncThen<void>
+{
+	template<typename FNWORK, typename FNTHEN>
+	static void Run(DmLoopCore* loopPtr, FNWORK& fnWork, FNTHEN& fnThen)
+	{
+		fnWork();
+		loopPtr->PostTask([fnThen = std::move(fnThen)]() mutable { fnThen(); });
+	}
+};
 
 /**
  * @class DmWinApp
@@ -26,6 +58,9 @@ public:
 	HINSTANCE GetInstanceHandle() const;
 	HINSTANCE GetResourceHandle() const;
 
+	CxFrameTaskPool* GetPool();
+	template<typename FNWORK, typename FNTHEN> BOOL Async(FNWORK fnWork, FNTHEN fnThen);
+
 private:
 	DmWinApp(const DmWinApp&) = delete;				// Disable copy construction
 	DmWinApp& operator=(const DmWinApp&) = delete;	// Disable assignment operator
@@ -37,7 +72,36 @@ private:
 	HINSTANCE	m_hInstance;
 	HINSTANCE	m_hResource;
 	WNDPROC		m_fnCallback;
+	CxFrameTaskPool	m_pool;	//!< 背景工作執行緒池 (第一次調用 GetPool 時建立)
 };
 
+/**
+ * @brief	於背景執行緒池執行工作, 完成後於 UI 執行緒執行後續處理
+ * @param	[in] fnWork	背景工作, 以 fnWork() 調用, 可返回結果
+ * @param	[in] fnThen	後續處理, 以 fnThen(結果) 或 fnThen() 調用, 於此物件的事件迴圈 (UI 執行緒) 執行
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			無法建立執行緒池或配置記憶體失敗返回零(zero)
+ * @remark	背景工作不可存取視窗, 結果應以值傳遞; 後續處理中可直接更新視窗. \n
+ *			事件迴圈已關閉時後續處理不會執行.
+ * @code
+ *	GetAPP().Async([path]() { return LoadFile(path); },
+ *		[this](std::vector<BYTE> data) { this->ShowData(data); });
+ * @endcode
+ */
+template<typename FNWORK, typename FNTHEN>
+BOOL DmWinApp::Async(FNWORK fnWork, FNTHEN fnThen)
+{
+	CxFrameTaskPool* poolPtr = this->GetPool();
+	DmLoopCore* loopPtr = this->GetLoop();
+
+	if (poolPtr == NULL)
+		return FALSE;
+
+	return poolPtr->Submit([loopPtr, fnWork = std::move(fnWork), fnThen = std::move(fnThen)]() mutable {
+		DmAsyncThen<decltype(fnWork())>::Run(loopPtr, fnWork, fnThen);
+	});
+}
+
 
 #endif // !__AXEEN_DMCFRAME_WINAPP_HH__
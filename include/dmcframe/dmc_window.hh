@@ -8,6 +8,7 @@
 #ifndef __AXEEN_DMCFRAME_WINDOW_HH__
 #define __AXEEN_DMCFRAME_WINDOW_HH__
 #include "dmc_object.hh"
+#include "dmc_cancel.hh"
 
 /**
  * @class DmWindow
@@ -29,6 +30,10 @@ public:
 	virtual HWND CreateEx();
 	virtual void Destroy();
 
+	BOOL	SetThunkMode(BOOL bThunk);
+	BOOL	IsThunkMode() const;
+	DmCancelToken*	GetCancelToken();
+
 	// 包裝 Win32 API 函數, 此區函數不要進行覆蓋
 	LRESULT SendMessage(UINT uMessage, WPARAM wParam, LPARAM lParam) const;
 	BOOL	PostMessage(UINT uMessage, WPARAM wParam, LPARAM lParam) const;
@@ -131,13 +136,20 @@ private:
 	DmWindow(HWND hWnd);							// Private constructor used internally
 
 	void AttachToClass(HWND hWnd);
+	void RenewCancelToken();
+	BOOL InstallThunk(HWND hWnd);
+	void RemoveThunk(HWND hWnd);
 	static LRESULT CALLBACK StaticWindowProc(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam);
+	static LRESULT CALLBACK ThunkWindowProc(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam);
 	
 
 protected:
 	HWND	m_hWnd;				//!< 視窗(控制項)操作碼
 	WNDPROC	m_fnPrevWndProc;	//!< 視窗訊息處理 Callback function 位址
 	BOOL	m_bAttach;			//!< 是否使用 Attach 連接
+	BOOL	m_bThunk;			//!< 是否使用跳板 (thunk) 分派訊息
+	LPVOID	m_thunkPtr;			//!< 使用中的跳板, 取代 WNDPROC
+	DmCancelToken*	m_tokenPtr;	//!< 目前視窗的取消標記, 建立視窗時建立, 視窗結束時取消並釋放
 };
 
 #endif // !__AXEEN_DMCFRAME_WINDOW_HH__
@@ -24,6 +24,8 @@ public:
 	// --- 標示為尚未實作
 
 	int  AddItem(LPCTSTR szPtr);								// CB_ADDSTRING
+	int  AddItems(const LPCTSTR* aTextPtr, int nCount);
+	template<typename IT> int AddItems(IT itFirst, IT itLast);
 	int  DeleteItem(int nIndex);								// CB_DELETESTRING
 	// --- CB_DIR
 	// --- CB_FINDSTRING
@@ -45,7 +47,7 @@ public:
 	// --- CB_GETLOCALE
 	// --- CB_GETMINVISIBLE
 	// --- CB_GETTOPINDEX
-	// --- CB_INITSTORAGE
+	int  InitStorage(int nItems, DWORD cbBytes);				// CB_INITSTORAGE
 	int  InsertItem(int index, LPCTSTR szPtr);					// CB_INSERTSTRING
 	void SetLimitText(int ccLimit);								// CB_LIMITTEXT
 	void ResetContent();										// CB_RESETCONTENT
@@ -73,4 +75,21 @@ protected:
 
 };
 
+/**
+ * @brief	批次加入範圍內的字串項目
+ * @param	[in] itFirst	範圍開頭
+ * @param	[in] itLast		範圍結尾
+ * @return	@c 型別: int \n 成功加入的項目數量
+ * @remark	元素可為字串指標或 std::basic_string<TCHAR>, 範圍內的字串在加入完成前必須保持有效.
+ */
+template<typename IT>
+int CxFrameCombo::AddItems(IT itFirst, IT itLast)
+{
+	std::vector<LPCTSTR> aText;
+
+	for (; itFirst != itLast; ++itFirst)
+		aText.push_back(CxFrameControl::ItemTextOf(*itFirst));
+	return aText.empty() ? 0 : this->AddItems(aText.data(), static_cast<int>(aText.size()));
+}
+
 #endif	// !__AXEEN_WIN32FRAME_COMBO_HH__
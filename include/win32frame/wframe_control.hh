@@ -25,9 +25,46 @@ public:
 	BOOL	CreateController(HINSTANCE hInst, HWND hCtrl, int idItem, WNDPROC fnWndProc = NULL);
 	BOOL	CreateControllerEx(HINSTANCE hInst, HWND hWndParent, int idItem, WNDPROC fnWndProc = NULL);
 
+	void	BeginUpdate();
+	void	EndUpdate();
+	BOOL	IsUpdating() const;
+
 protected:
 	virtual void  WindowInTheEnd() override;
 	LPCTSTR GetControlClassName(EECTRLTYPE index);
+
+	//! 取得批次加入項目的字串位址 (AddItems 範圍元素可為字串指標或 std::basic_string<TCHAR>)
+	static LPCTSTR ItemTextOf(LPCTSTR szTextPtr) { return szTextPtr; }
+	static LPCTSTR ItemTextOf(const std::basic_string<TCHAR>& strText) { return strText.c_str(); }
+
+protected:
+	int		m_nUpdateLock;	//!< BeginUpdate 巢狀深度, 大於零時暫停重繪
+};
+
+/**
+ * @class	CxFrameUpdateScope
+ * @brief	控制項批次更新範圍 (RAII)
+ * @remark	建構時調用 BeginUpdate, 解構時調用 EndUpdate, 離開範圍時只重繪一次.
+ *
+ * @code
+ *	{
+ *		CxFrameUpdateScope scope(m_combo);
+ *		m_combo.InitStorage(nCount, cbTotal);
+ *		for (...) m_combo.AddItem(szPtr);
+ *	}	// 此處重繪
+ * @endcode
+ */
+class CxFrameUpdateScope
+{
+public:
+	explicit CxFrameUpdateScope(CxFrameControl& ctrl) : m_ctrl(ctrl) { m_ctrl.BeginUpdate(); }
+	~CxFrameUpdateScope() { m_ctrl.EndUpdate(); }
+
+private:
+	CxFrameUpdateScope(const CxFrameUpdateScope&) = delete;				// Disable copy construction
+	CxFrameUpdateScope& operator=(const CxFrameUpdateScope&) = delete;	// Disable assignment operator
+
+	CxFrameControl&	m_ctrl;	//!< 批次更新的控制項
 };
 
 #endif  // !__AXEEN_WIN32FRAME_CONTROL_HH__
@@ -2,7 +2,7 @@
  * @file	wframe_define.hh
  * @brief	Win32 Frame library 先行編譯檔
  * @date	2018-03-31
- * @date	2018-07-24
+ * @date	2026-10-17
  * @author	Swang
  *****************************************************************************/
 #ifndef __AXEEN_WIN32FRAME_DEFINE_HH__
@@ -31,6 +31,7 @@
 	#pragma comment(lib, "comctl32.lib")
 	#pragma comment(lib, "winmm.lib")
 	#pragma comment(lib, "shlwapi.lib")
+	#pragma comment(lib, "psapi.lib")
 
 	// win32frame library
 	#ifdef __WIN64__
@@ -25,6 +25,8 @@ public:
 
 	int AddFile(LPTSTR szFilePtr);									// LB_ADDFILE
 	int	AddItem(TCHAR* szTextPtr);									// LB_ADDSTRING
+	int	AddItems(const LPCTSTR* aTextPtr, int nCount);
+	template<typename IT> int AddItems(IT itFirst, IT itLast);
 	int DeleateItem(int nIndex);									// LB_DELETESTRING
 	int AddDir(int nAttrib, LPTSTR szPathPtr);						// LB_DIR
 	int FindItem(int nIndex, LPTSTR szTextPtr);						// LB_FINDSTRING
@@ -45,7 +47,7 @@ public:
 	int GetItemText(int nIndex, LPTSTR szTextPtr);					// LB_GETTEXT
 	int GetItemTextLength(int nIndex);								// LB_GETTEXTLEN
 	// --- LB_GETTOPINDEX
-	// --- LB_INITSTORAGE
+	int InitStorage(int nItems, DWORD cbBytes);						// LB_INITSTORAGE
 	int InsertItem(int nIndex, LPTSTR szTextPtr);					// LB_INSERTSTRING
 	// --- LB_ITEMFROMPOINT
 	// --- LB_RESETCONTENT
@@ -72,4 +74,21 @@ protected:
 	virtual void WindowInTheEnd() override;
 };
 
+/**
+ * @brief	批次加入範圍內的字串項目
+ * @param	[in] itFirst	範圍開頭
+ * @param	[in] itLast		範圍結尾
+ * @return	@c 型別: int \n 成功加入的項目數量
+ * @remark	元素可為字串指標或 std::basic_string<TCHAR>; 先收集字串位址再以 AddItems(const LPCTSTR*, int) 一次加入.
+ */
+template<typename IT>
+int CxFrameListbox::AddItems(IT itFirst, IT itLast)
+{
+	std::vector<LPCTSTR> aText;
+
+	for (; itFirst != itLast; ++itFirst)
+		aText.push_back(CxFrameControl::ItemTextOf(*itFirst));
+	return aText.empty() ? 0 : this->AddItems(aText.data(), static_cast<int>(aText.size()));
+}
+
 #endif // !__AXEEN_WIN32FRAME_LISTBOX_HH__
@@ -0,0 +1,106 @@
+﻿/**************************************************************************//**
+ * @file	wframe_listfilter.hh
+ * @brief	Win32 視窗操作 : ListView 資料即時篩選索引類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_LISTFILTER_HH__
+#define __AXEEN_WIN32FRAME_LISTFILTER_HH__
+#include "wframe_listsource.hh"
+
+/**
+ * @class	CxFrameListFilter
+ * @brief	資料來源子字串篩選索引類別 (三字元組倒排索引)
+ *
+ * Build 取得指定欄位的文字轉為小寫 (不區分大小寫) 保存, 並建立三字元組 → 列索引的倒排索引. \n
+ * 查詢時取各三字元組的列表求交集得到候選列, 再以子字串比對確認; 少於三個字元的查詢直接比對. \n
+ * 新查詢包含上一次的查詢時 (輸入時附加字元), 結果必為上一次結果的子集, 只需篩選上一次的結果. \n
+ * 結果為遞增的來源列索引, 可再以 CxFrameListSort 排序, 交給 CxFrameListRowMap 顯示.
+ *
+ * 非同步模式 (Start) 於執行緒池執行篩選, 同一時間只有一個篩選執行:
+ * - Query 只記錄最新的查詢並返回, 執行中的篩選發現有更新的查詢即放棄, 過時的結果不會送出
+ * - 篩選完成時 PostMessage(hWnd, uMessage, nSerial, 0) 通知視窗, 視窗以 GetResult 取出結果
+ *
+ * @code
+ *	// 編輯框 EN_CHANGE
+ *	m_edit.GetText(szText, MAX_PATH);
+ *	m_filter.Query(szText);
+ *
+ *	// WM_APP + 1 (Start 指定的訊息)
+ *	std::vector<int> aRow;
+ *	if (m_filter.GetResult(&aRow)) {
+ *		m_rowmap.SetRows(&aRow);
+ *		m_listview.UpdateDataSource();
+ *	}
+ * @endcode
+ *
+ * 建立索引期間資料來源不可變更; 資料變更後須重新 Build.
+ */
+class CxFrameListFilter
+{
+public:
+	CxFrameListFilter();
+	virtual ~CxFrameListFilter();
+
+	BOOL	Build(CxFrameListSource* srcPtr, const int* aColumnPtr, int nColumns);
+	void	Clear();
+	BOOL	Search(LPCTSTR szQueryPtr, std::vector<int>* aRowPtr);
+
+	BOOL	Start(HWND hWnd, UINT uMessage);
+	void	Stop();
+	BOOL	IsRunning();
+	BOOL	Query(LPCTSTR szQueryPtr);
+	BOOL	GetResult(std::vector<int>* aRowPtr);
+
+	int		GetRowCount();
+	size_t	GetTrigramCount();
+
+private:
+	typedef std::basic_string<TCHAR> TSTRING;
+
+	/**
+	 * @struct	SSPOSTING
+	 * @brief	三字元組的列索引列表 (位於 m_aPosting)
+	 */
+	struct SSPOSTING {
+		size_t	nStart;		//!< 起始位置
+		size_t	nCount;		//!< 列數
+	};
+
+	BOOL	SearchCore(const TSTRING& strQuery, std::vector<int>* aRowPtr, LONG nSerial);
+	BOOL	IsCancel(LONG nSerial);
+	void	WorkProc();
+
+	static void	FoldText(TSTRING* strTextPtr);
+	static void	CollectTrigram(LPCTSTR szTextPtr, std::vector<ULONGLONG>* aGramPtr);
+	static void	Intersect(std::vector<int>* aRowPtr, const int* aListPtr, size_t nCount);
+	static ULONGLONG	MakeTrigram(LPCTSTR szTextPtr);
+	static void CALLBACK StaticWorkProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_WORK tpWork);
+
+	CxFrameListFilter(const CxFrameListFilter&) = delete;				// Disable copy construction
+	CxFrameListFilter& operator=(const CxFrameListFilter&) = delete;	// Disable assignment operator
+
+private:
+	CRITICAL_SECTION	m_csSearch;		//!< 序列化篩選 (保護索引與上一次的結果)
+	CRITICAL_SECTION	m_csLock;		//!< 保護查詢與結果
+	std::vector<TCHAR>	m_aText;		//!< 各列小寫文字, 欄位以 LISTFILTER_SEPARATOR 分隔, 每列以 0 結尾
+	std::vector<size_t>	m_aOffset;		//!< 各列文字於 m_aText 的位置
+	std::vector<int>	m_aPosting;		//!< 全部三字元組的列索引列表 (各列表遞增)
+	std::unordered_map<ULONGLONG, SSPOSTING>	m_mapTrigram;	//!< 三字元組 → 列索引列表
+	TSTRING				m_strLast;		//!< 上一次完成的查詢 (小寫)
+	std::vector<int>	m_aLast;		//!< 上一次完成的結果
+	BOOL				m_bLastValid;	//!< 上一次的結果是否有效
+	TSTRING				m_strPending;	//!< 最新的查詢 (非同步模式)
+	volatile LONG		m_nPending;		//!< 最新查詢的序號
+	LONG				m_nDone;		//!< 已處理查詢的序號
+	std::vector<int>	m_aResult;		//!< 待取出的結果
+	BOOL				m_bResult;		//!< 是否有待取出的結果
+	PTP_WORK			m_tpWork;		//!< 執行緒池工作物件
+	HWND				m_hWnd;			//!< 結果通知視窗
+	UINT				m_uMessage;		//!< 結果通知訊息
+	BOOL				m_bBusy;		//!< 篩選工作是否已提交或執行中
+	BOOL				m_bRunning;		//!< 是否為非同步模式
+};
+
+#endif // !__AXEEN_WIN32FRAME_LISTFILTER_HH__
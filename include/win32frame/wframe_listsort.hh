@@ -0,0 +1,80 @@
+﻿/**************************************************************************//**
+ * @file	wframe_listsort.hh
+ * @brief	Win32 視窗操作 : ListView 資料多欄排序類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_LISTSORT_HH__
+#define __AXEEN_WIN32FRAME_LISTSORT_HH__
+#include "wframe_listsource.hh"
+#include "wframe_workpool.hh"
+
+/**
+ * @class	CxFrameListSort
+ * @brief	資料來源多欄穩定排序類別
+ *
+ * 排序資料來源 (CxFrameListSource) 的列, 結果為列索引排列, 不移動資料, 交給 CxFrameListRowMap 顯示. \n
+ * 與 LVM_SORTITEMS 每次比較都回呼不同, 排序分為三個階段:
+ * - 取得排序鍵: 每列每個排序鍵只取得一次; 文字以 LCMapStringEx 轉為排序鍵 (位元組陣列), 之後以 memcmp 比較
+ * - 分段排序: 列分為與工作執行緒數量相同的區段, 各自以 std::stable_sort 排序
+ * - 合併: 相鄰區段兩兩合併 (std::merge), 相同時保留前段, 整體維持穩定
+ *
+ * 各階段可交由 CxFrameWorkPool 平行處理; 排序鍵緩衝區保留至下次排序重複使用.
+ */
+class CxFrameListSort
+{
+public:
+	CxFrameListSort();
+	virtual ~CxFrameListSort();
+
+	BOOL	Sort(CxFrameListSource* srcPtr, const SSSORTKEY* aKeyPtr, int nKeys, std::vector<int>* aRowPtr, CxFrameWorkPool* poolPtr = NULL);
+	BOOL	SortAll(CxFrameListSource* srcPtr, const SSSORTKEY* aKeyPtr, int nKeys, std::vector<int>* aRowPtr, CxFrameWorkPool* poolPtr = NULL);
+	void	Clear();
+
+private:
+	/**
+	 * @struct	SSCOLUMN
+	 * @brief	一個排序鍵的全部列數值 (依排序前的位置存放)
+	 */
+	struct SSCOLUMN {
+		SSSORTKEY					key;		//!< 排序鍵
+		std::vector<double>			aNumber;	//!< ESortNumber: 數值
+		std::vector<ULONGLONG>		aTime;		//!< ESortTime: 時間
+		std::vector<const BYTE*>	aTextPtr;	//!< ESortText: 排序鍵位址 (位於區塊緩衝區)
+		std::vector<DWORD>			aTextLen;	//!< ESortText: 排序鍵長度 (in Byte)
+	};
+
+	/**
+	 * @struct	SSCHUNK
+	 * @brief	取得排序鍵的工作區塊 (LISTSORT_CHUNK 列)
+	 */
+	struct SSCHUNK {
+		std::vector<std::vector<BYTE>>	aKey;	//!< 各排序鍵的文字排序鍵緩衝區
+		std::vector<DWORD>				aOff;	//!< 排序鍵於緩衝區中的位置
+	};
+
+	void	ExtractChunk(size_t idxChunk);
+	void	SortRun(size_t idxRun);
+	void	MergeRun(size_t idxPair);
+	int		Compare(int idxA, int idxB) const;
+
+	static void CALLBACK StaticExtractProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker);
+	static void CALLBACK StaticSortProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker);
+	static void CALLBACK StaticMergeProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker);
+
+	CxFrameListSort(const CxFrameListSort&) = delete;				// Disable copy construction
+	CxFrameListSort& operator=(const CxFrameListSort&) = delete;	// Disable assignment operator
+
+private:
+	CxFrameListSource*		m_srcPtr;		//!< 目前排序的資料來源
+	const int*				m_aSourcePtr;	//!< 排序前的列索引
+	size_t					m_nRows;		//!< 排序列數
+	std::vector<SSCOLUMN>	m_aColumn;		//!< 排序鍵數值
+	std::vector<SSCHUNK>	m_aChunk;		//!< 取得排序鍵的工作區塊
+	std::vector<int>		m_aPerm;		//!< 排序中的位置排列
+	std::vector<int>		m_aTemp;		//!< 合併緩衝區
+	std::vector<size_t>		m_aBound;		//!< 區段邊界, 第 n 段為 [m_aBound[n], m_aBound[n+1])
+};
+
+#endif // !__AXEEN_WIN32FRAME_LISTSORT_HH__
@@ -0,0 +1,84 @@
+﻿/**************************************************************************//**
+ * @file	wframe_listsource.hh
+ * @brief	Win32 視窗操作 : ListView 虛擬模式資料來源類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_LISTSOURCE_HH__
+#define __AXEEN_WIN32FRAME_LISTSOURCE_HH__
+#include "wframe_define.hh"
+
+/**
+ * @class	CxFrameListSource
+ * @brief	ListView 虛擬模式 (LVS_OWNERDATA) 資料來源基底類別
+ *
+ * 衍生類別提供列數與各欄位內容, 控制項只在顯示時以 LVN_GETDISPINFO 取得可見的欄位, \n
+ * 資料不必複製至控制項, 列數變更只需 LVM_SETITEMCOUNT. \n
+ * 以 CxFrameListview::SetDataSource 綁定; 控制項通知皆於 UI 執行緒調用. \n
+ * CxFrameListSort 以工作執行緒池排序時, GetCellText, GetCellNumber 與 GetCellTime 會由多個執行緒同時調用, \n
+ * 排序期間 (同步執行) 資料不會變更, 這些函數只需支援同時讀取.
+ */
+class CxFrameListSource
+{
+public:
+	CxFrameListSource();
+	virtual ~CxFrameListSource();
+
+	// Overridables
+	virtual int		GetRowCount() = 0;
+	virtual BOOL	GetCellText(int nRow, int nCol, LPTSTR szTextPtr, int ccMax) = 0;
+	virtual int		GetCellImage(int nRow, int nCol);
+	virtual BOOL	GetCellNumber(int nRow, int nCol, double* dValuePtr);
+	virtual BOOL	GetCellTime(int nRow, int nCol, ULONGLONG* ullTimePtr);
+	virtual void	PrepareRows(int nFrom, int nTo);
+	virtual int		FindRow(int nStart, LPCTSTR szTextPtr, BOOL bPartial);
+
+private:
+	CxFrameListSource(const CxFrameListSource&) = delete;				// Disable copy construction
+	CxFrameListSource& operator=(const CxFrameListSource&) = delete;	// Disable assignment operator
+};
+
+/**
+ * @class	CxFrameListRowMap
+ * @brief	以列索引對照表包裝另一個資料來源 (排序、篩選結果)
+ *
+ * 第 n 列顯示來源的第 GetRows()[n] 列; 排序或篩選只產生對照表, 不移動來源資料. \n
+ * 以 SetRows 交換對照表後調用 CxFrameListview::UpdateDataSource 即可顯示新的結果.
+ *
+ * @code
+ *	std::vector<int> aRow;
+ *	m_sort.SortAll(&m_model, aKey, 2, &aRow, &m_pool);	// 排序篩選結果時改用 Sort
+ *	m_rowmap.SetRows(&aRow);
+ *	m_listview.UpdateDataSource();
+ * @endcode
+ */
+class CxFrameListRowMap : public CxFrameListSource
+{
+public:
+	CxFrameListRowMap();
+	virtual ~CxFrameListRowMap();
+
+	void	SetSource(CxFrameListSource* srcPtr);
+	CxFrameListSource*	GetSource();
+	void	SetRows(std::vector<int>* aRowPtr);
+	void	ResetRows();
+	const std::vector<int>& GetRows() const;
+	int		MapRow(int nRow) const;
+	BOOL	IsIdentity() const;
+
+	// CxFrameListSource
+	virtual int		GetRowCount() override;
+	virtual BOOL	GetCellText(int nRow, int nCol, LPTSTR szTextPtr, int ccMax) override;
+	virtual int		GetCellImage(int nRow, int nCol) override;
+	virtual BOOL	GetCellNumber(int nRow, int nCol, double* dValuePtr) override;
+	virtual BOOL	GetCellTime(int nRow, int nCol, ULONGLONG* ullTimePtr) override;
+	virtual void	PrepareRows(int nFrom, int nTo) override;
+
+private:
+	CxFrameListSource*	m_srcPtr;		//!< 來源 (不擁有)
+	std::vector<int>	m_aRow;			//!< 列索引對照表
+	BOOL				m_bIdentity;	//!< 未設定對照表, 直接對應來源
+};
+
+#endif // !__AXEEN_WIN32FRAME_LISTSOURCE_HH__
@@ -8,12 +8,15 @@
 #ifndef __AXEEN_WIN32FRAME_LISTVIEW_HH__
 #define __AXEEN_WIN32FRAME_LISTVIEW_HH__
 #include "wframe_control.hh"
+#include "wframe_listsource.hh"
 
 /**
  * @class	CxFrameListview
  * @brief	ListView 控制項操作類別
  *
- *	繼承 CxFrameControl, 控制項 ListView 操作類別
+ *	繼承 CxFrameControl, 控制項 ListView 操作類別 \n
+ *	以 CreateVirtualListview 建立 (LVS_OWNERDATA) 並綁定 CxFrameListSource 時為虛擬模式, \n
+ *	內容由資料來源提供, 父視窗須將 WM_NOTIFY 轉交 NotifyDataSource.
  */
 class CxFrameListview : public CxFrameControl
 {
@@ -70,7 +73,10 @@ public:
 	// --- LVM_HITTEST
 	BOOL	InsertColumn(int nIndex, int wd, int nAlign, LPTSTR szTextPtr);// LVM_INSERTCOLUMN
 	BOOL	InsertItem(int nIndex, int nSub, LPTSTR szTextPtr);			// LVM_INSERTITEM
-	// --- LVM_REDRAWITEMS
+	int		AddItems(const LPCTSTR* aTextPtr, int nCount);
+	template<typename IT> int AddItems(IT itFirst, IT itLast);
+	BOOL	InitStorage(int nItems);
+	BOOL	RedrawItems(int nFirst, int nLast);							// LVM_REDRAWITEMS
 	// --- LVM_SCROLL
 	BOOL	SetBkColor(COLORREF dwColor);								// LVM_SETBKCOLOR
 	// --- LVM_SETCALLBACKMASK
@@ -81,7 +87,7 @@ public:
 	// --- LVM_SETICONSPACING
 	// --- LVM_SETIMAGELIST
 	// --- LVM_SETITEM
-	// --- LVM_SETITEMCOUNT
+	BOOL	SetItemCount(int nCount, DWORD dwFlags = LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL);	// LVM_SETITEMCOUNT
 	// --- LVM_SETITEMPOSITION
 	// --- LVM_SETITEMPOSITION32
 	BOOL	SetItemState(int nIndex, LPLVITEM lvitemPtr);				// LVM_SETITEMSTATE
@@ -98,6 +104,14 @@ public:
 	BOOL CreateListview(LPCTSTR szCaptionPtr, int x, int y, int wd, int ht, HWND hParent, int idItem, HINSTANCE hInst, WNDPROC fnWndProc = NULL);
 	BOOL CreateListview(HINSTANCE hInst, HWND hListv, int idItem, WNDPROC fnWndProc = NULL);
 	BOOL CreateListviewEx(HINSTANCE hInst, HWND hParent, int idItem, WNDPROC fnWndProc = NULL);
+	BOOL CreateVirtualListview(int x, int y, int wd, int ht, HWND hParent, int idItem, HINSTANCE hInst, WNDPROC fnWndProc = NULL);
+
+	// 虛擬模式 (LVS_OWNERDATA)
+	BOOL	IsVirtual();
+	BOOL	SetDataSource(CxFrameListSource* srcPtr);
+	CxFrameListSource* GetDataSource();
+	BOOL	UpdateDataSource();
+	BOOL	NotifyDataSource(LPNMHDR nmPtr, LRESULT* resultPtr);
 
 protected:
 	virtual void DefaultReportStyle();
@@ -105,11 +119,13 @@ protected:
 	COLORREF ColorShade(COLORREF c, float fPercent);
 
 private:
+	BOOL CreateReportView(int x, int y, int wd, int ht, HWND hParent, int idItem, DWORD dwStyle, WNDPROC fnWndProc);
 	void Example1(WPARAM wParam, LPARAM lParam);
 
 protected:
 	int m_nSelectItemCount;		//!< 被選取項目總數
 	int m_nSelectItemIndex;		//!< 當前選取的索引
+	CxFrameListSource* m_srcPtr;	//!< 虛擬模式資料來源 (不擁有)
 };
 
 
@@ -127,4 +143,21 @@ inline COLORREF CxFrameListview::ColorShade(COLORREF c, float fPercent)
 		(BYTE)((float)GetBValue(c) * fPercent / 100.0));
 }
 
+/**
+ * @brief	批次加入範圍內的字串項目
+ * @param	[in] itFirst	範圍開頭
+ * @param	[in] itLast		範圍結尾
+ * @return	@c 型別: int \n 成功加入的項目數量
+ * @remark	元素可為字串指標或 std::basic_string<TCHAR>, 每個字串於結尾加入為新的一列 (第一欄).
+ */
+template<typename IT>
+int CxFrameListview::AddItems(IT itFirst, IT itLast)
+{
+	std::vector<LPCTSTR> aText;
+
+	for (; itFirst != itLast; ++itFirst)
+		aText.push_back(CxFrameControl::ItemTextOf(*itFirst));
+	return aText.empty() ? 0 : this->AddItems(aText.data(), static_cast<int>(aText.size()));
+}
+
 #endif	// !__AXEEN_WIN32FRAME_LISTVIEW_HH__
@@ -0,0 +1,87 @@
+﻿/**************************************************************************//**
+ * @file	wframe_memcache.hh
+ * @brief	程序記憶體頁快取類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_MEMCACHE_HH__
+#define __AXEEN_WIN32FRAME_MEMCACHE_HH__
+#include "wframe_process.hh"
+
+/**
+ * @class	CxFrameMemoryCache
+ * @brief	程序記憶體頁快取類別
+ *
+ * 以 MEMCACHE_PAGE_SIZE 為單位快取 CxFrameProcess::ReadMemory 讀取結果, 依 LRU 淘汰, 總容量不超過設定值. \n
+ * - NewEpoch: 開始新的一輪 (如每個畫面更新), 全部快取頁立即失效, 不必逐頁清除
+ * - AddBypass: 指定經常變動的位址範圍, 讀取時略過快取
+ * - 連續未命中的頁面合併為一次 ReadMemory
+ *
+ * 此類別非執行緒安全, 同一物件只能由單一執行緒使用.
+ */
+class CxFrameMemoryCache
+{
+public:
+	CxFrameMemoryCache();
+	virtual ~CxFrameMemoryCache();
+
+	BOOL	Create(CxFrameProcess* procPtr, SIZE_T cbBudget = MEMCACHE_BUDGET);
+	void	Close();
+
+	SIZE_T	ReadMemory(LPCVOID aBasePtr, LPVOID aBuffPtr, SIZE_T uSize);
+	void	NewEpoch();
+	void	Invalidate(LPCVOID aBasePtr, SIZE_T uSize);
+
+	void	AddBypass(LPCVOID aBasePtr, SIZE_T uSize);
+	void	RemoveBypass(LPCVOID aBasePtr);
+	void	ClearBypass();
+
+	void	GetStats(LPSSMEMCACHESTAT statPtr);
+	void	ResetStats();
+
+private:
+	/**
+	 * @struct	SSPAGE
+	 * @brief	快取頁項目, 以陣列索引串成 LRU 雙向串列
+	 */
+	struct SSPAGE {
+		ULONG_PTR	uPage;		//!< 頁起始位址
+		DWORD		dwEpoch;	//!< 讀取時的世代
+		DWORD		idxPrev;	//!< 前一項 (較近期使用)
+		DWORD		idxNext;	//!< 後一項 (較久未使用)
+	};
+
+	/**
+	 * @struct	SSBYPASS
+	 * @brief	略過快取的位址範圍
+	 */
+	struct SSBYPASS {
+		ULONG_PTR	uBase;		//!< 起始位址
+		ULONG_PTR	uEnd;		//!< 結束位址 (不包含)
+	};
+
+	BOOL	IsBypass(ULONG_PTR uStart, ULONG_PTR uEnd);
+	DWORD	Lookup(ULONG_PTR uPage);
+	DWORD	Acquire(ULONG_PTR uPage);
+	SIZE_T	FillPages(ULONG_PTR uPage, size_t nPages);
+	void	Unlink(DWORD idx);
+	void	LinkFront(DWORD idx);
+	BYTE*	PageData(DWORD idx);
+
+private:
+	CxFrameProcess*		m_procPtr;		//!< 目標程序物件
+	std::vector<SSPAGE>	m_aPage;		//!< 快取頁項目
+	std::vector<BYTE>	m_aData;		//!< 快取頁資料 (每頁 MEMCACHE_PAGE_SIZE)
+	std::vector<BYTE>	m_aStage;		//!< 合併讀取暫存區
+	std::unordered_map<ULONG_PTR, DWORD>	m_mapPage;	//!< 頁起始位址 → 項目索引
+	std::vector<SSBYPASS>	m_aBypass;	//!< 略過快取的位址範圍
+
+	DWORD			m_idxHead;		//!< LRU 串列首 (最近使用)
+	DWORD			m_idxTail;		//!< LRU 串列尾 (最久未使用)
+	DWORD			m_nUsed;		//!< 已使用項目數量
+	DWORD			m_dwEpoch;		//!< 目前世代
+	SSMEMCACHESTAT	m_stat;			//!< 統計資訊
+};
+
+#endif // !__AXEEN_WIN32FRAME_MEMCACHE_HH__
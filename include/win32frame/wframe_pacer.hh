@@ -0,0 +1,65 @@
+﻿/**************************************************************************//**
+ * @file	wframe_pacer.hh
+ * @brief	固定步進訊框節拍類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_PACER_HH__
+#define __AXEEN_WIN32FRAME_PACER_HH__
+#include "wframe_object.hh"
+
+/**
+ * @class	CxFramePacer
+ * @brief	固定步進訊框節拍類別
+ *
+ * 以 QueryPerformanceCounter 計時, 提供固定步進更新與可變頻率繪製的節拍: \n
+ * - BeginFrame 依經過時間返回本訊框需執行的固定步進更新次數, GetAlpha 為繪製內插比例
+ * - WaitFrame 等待至下一個訊框期限, 先休眠 (timeBeginPeriod(1)) 再於最後 PACER_SPIN_MARGIN 忙等
+ * - 保留最近 PACER_HISTORY 個訊框時間, GetStats 取得 p50 / p99 / max 與錯過期限次數
+ *
+ * 此類別非執行緒安全, 應由執行訊框迴圈的執行緒調用.
+ */
+class CxFramePacer
+{
+public:
+	CxFramePacer();
+	virtual ~CxFramePacer();
+
+	BOOL	Create(DWORD nUpdateHz, DWORD nRenderHz = 0);
+	void	Start();
+	void	Stop();
+
+	DWORD	BeginFrame();
+	BOOL	WaitFrame(BOOL bMessage);
+	BOOL	IsWaiting() const;
+	double	GetStep() const;
+	double	GetAlpha() const;
+
+	void	GetStats(LPSSFRAMESTAT statPtr);
+	void	ResetStats();
+
+private:
+	LONGLONG	Now() const;
+	void	EndFrame(LONGLONG llNow);
+
+private:
+	LONGLONG	m_llFrequency;	//!< QueryPerformanceFrequency
+	LONGLONG	m_llStep;		//!< 固定步進時間 (QueryPerformanceCounter 單位)
+	LONGLONG	m_llPeriod;		//!< 訊框期限間隔 (QueryPerformanceCounter 單位)
+	LONGLONG	m_llSpin;		//!< 忙等時間 (QueryPerformanceCounter 單位)
+	LONGLONG	m_llPrev;		//!< 上一次 BeginFrame 時間
+	LONGLONG	m_llAccum;		//!< 尚未更新的累積時間
+	LONGLONG	m_llLast;		//!< 上一個訊框結束時間
+	LONGLONG	m_llNext;		//!< 下一個訊框期限
+	BOOL		m_bWaiting;		//!< 是否正在等待訊框期限
+	BOOL		m_bLate;		//!< 本訊框工作完成時是否已超過期限
+	BOOL		m_bPeriod;		//!< 是否已調用 timeBeginPeriod
+
+	std::vector<DWORD>	m_aHistory;	//!< 最近的訊框時間 (in µs, 環狀緩衝區)
+	std::vector<DWORD>	m_aSorted;	//!< 計算百分位數的暫存區
+	size_t		m_idxHistory;	//!< 下一個寫入位置
+	SSFRAMESTAT	m_stat;			//!< 統計資訊 (百分位數於 GetStats 計算)
+};
+
+#endif // !__AXEEN_WIN32FRAME_PACER_HH__
@@ -2,7 +2,7 @@
  * @file	wframe_process.hh
  * @brief	程序操作基底類別
  * @date	2002-01-15
- * @date	2018-04-02
+ * @date	2026-10-17
  * @author	Swang
  *****************************************************************************/
 #ifndef __AXEEN_WIN32FRAME_PROCESS_HH__
@@ -25,6 +25,8 @@ public:
 
 	SIZE_T	ReadMemory(LPCVOID aBasePtr, LPVOID aBuffPtr, SIZE_T uSize);
 	SIZE_T	WriteMemory(LPVOID aBasePtr, LPCVOID aBuffPtr, SIZE_T uSize);
+	SIZE_T	ReadMemoryV(LPSSMEMRANGE aRangePtr, size_t nCount);
+	SIZE_T	WriteMemoryV(LPSSMEMRANGE aRangePtr, size_t nCount);
 	
 	HANDLE	GetProcessHandle();
 	DWORD	GetProcessID();
@@ -36,10 +38,15 @@ private:
 	BOOL StrCompare(LPCTSTR szDstPtr, LPCTSTR szSrcPtr, BOOL bCase);
 	void StrUpper(LPTSTR szPtr);
 	void StrLower(LPTSTR szPtr);
+	void ReadRangeSplit(LPSSMEMRANGE aRangePtr, const size_t* aIndexPtr, size_t nCount, SIZE_T cbReads);
 
 protected:
     HANDLE  m_hProcess;		//!< Handle of Process
     DWORD   m_idProcess;	//!< ProcessID
+
+private:
+	std::vector<size_t>	m_aOrder;	//!< 批次讀寫排序用索引
+	std::vector<BYTE>	m_aScratch;	//!< 批次讀寫合併用緩衝區
 };
 
 
@@ -0,0 +1,72 @@
+﻿/**************************************************************************//**
+ * @file	wframe_procgroup.hh
+ * @brief	多程序群組讀取類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_PROCGROUP_HH__
+#define __AXEEN_WIN32FRAME_PROCGROUP_HH__
+#include "wframe_process.hh"
+#include "wframe_workpool.hh"
+
+/**
+ * @class	CxFrameProcessGroup
+ * @brief	多程序群組讀取類別
+ *
+ * 同時開啟多個程序, 每個程序讀取相同欄位配置 (各程序位址可不同), 讀取工作交由 CxFrameWorkPool 平行處理. \n
+ * 每個程序的全部欄位以一次 CxFrameProcess::ReadMemoryV 讀取.
+ *
+ * 讀取結果以 "欄位優先" (struct-of-arrays) 連續存放: \n
+ * GetField(f) 返回 GetCount() 個欄位 f 數值的連續陣列, 第 p 個程序的數值位於 GetField(f) + p * 欄位大小. \n
+ * 每個程序的讀取長度與讀取時間 (QueryPerformanceCounter) 亦以陣列返回.
+ *
+ * 欄位與位址設定, Attach/Detach 不可與 Read 同時調用.
+ */
+class CxFrameProcessGroup
+{
+public:
+	CxFrameProcessGroup();
+	virtual ~CxFrameProcessGroup();
+
+	size_t	Attach(const DWORD* aPidPtr, size_t nCount, CxFrameWorkPool* poolPtr = NULL);
+	BOOL	Detach(size_t idxProcess);
+	void	Clear();
+
+	BOOL	SetFields(const SIZE_T* aSizePtr, size_t nFields);
+	BOOL	SetAddress(size_t idxProcess, size_t idxField, ULONG_PTR uAddress);
+	BOOL	Read(CxFrameWorkPool* poolPtr = NULL);
+
+	size_t	GetCount();
+	size_t	GetFieldCount();
+	DWORD	GetProcessID(size_t idxProcess);
+	CxFrameProcess*	GetProcess(size_t idxProcess);
+	const BYTE*		GetField(size_t idxField);
+	const SIZE_T*	GetReadSizes();
+	const DWORD*	GetLatency();
+
+private:
+	void	OpenOne(size_t idxItem);
+	void	ReadOne(size_t idxProcess, DWORD idxWorker);
+	void	Layout();
+
+	static void CALLBACK StaticOpenProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker);
+	static void CALLBACK StaticReadProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker);
+
+private:
+	std::vector<CxFrameProcess*>	m_aProcess;		//!< 程序物件 (每個程序一個, ReadMemoryV 不可跨執行緒共用)
+	std::vector<DWORD>		m_aPid;			//!< 程序 ID
+	std::vector<SIZE_T>		m_aDone;		//!< 每個程序最近一次讀取長度 (in Byte)
+	std::vector<DWORD>		m_aLatency;		//!< 每個程序最近一次讀取時間 (in μs)
+	std::vector<SIZE_T>		m_aFieldSize;	//!< 欄位大小 (in Byte)
+	std::vector<SIZE_T>		m_aFieldOffset;	//!< 欄位陣列於 m_aData 的起始位置
+	std::vector<ULONG_PTR>	m_aAddress;		//!< 欄位位址 (程序 × 欄位)
+	std::vector<BYTE>		m_aData;		//!< 讀取結果 (欄位 × 程序)
+	std::vector<std::vector<SSMEMRANGE>>	m_aRange;	//!< 各工作執行緒的讀取範圍
+	std::vector<CxFrameProcess*>	m_aOpen;	//!< Attach 平行開啟暫存
+	const DWORD*			m_aOpenPidPtr;	//!< Attach 平行開啟的程序 ID
+	BOOL					m_bDirty;		//!< 結果緩衝區是否需要重新配置
+	LONGLONG				m_llFrequency;	//!< QueryPerformanceCounter 頻率
+};
+
+#endif // !__AXEEN_WIN32FRAME_PROCGROUP_HH__
@@ -0,0 +1,57 @@
+﻿/**************************************************************************//**
+ * @file	wframe_procindex.hh
+ * @brief	程序名稱索引類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_PROCINDEX_HH__
+#define __AXEEN_WIN32FRAME_PROCINDEX_HH__
+#include "wframe_define.hh"
+
+/**
+ * @class	CxFrameProcessIndex
+ * @brief	程序名稱索引類別
+ *
+ * 以一次程序快照建立 "名稱(不分大小寫) → 程序 ID" 雜湊索引, 查詢為 O(1) \n
+ * 調用 Refresh 更新索引時, 只處理新增與已結束的程序, 既有項目不會重新轉換名稱.
+ */
+class CxFrameProcessIndex
+{
+public:
+	CxFrameProcessIndex();
+	virtual ~CxFrameProcessIndex();
+
+	BOOL	Refresh(std::vector<DWORD>* aStartPtr = NULL, std::vector<DWORD>* aExitPtr = NULL);
+	DWORD	Search(LPCTSTR szModulePtr);
+	size_t	Search(LPCTSTR szModulePtr, std::vector<DWORD>* aPidPtr);
+	BOOL	GetModuleName(DWORD dwProcessID, LPTSTR szPtr, size_t ccLen);
+	size_t	GetCount();
+	void	Clear();
+
+private:
+	typedef std::basic_string<TCHAR> TSTRING;
+
+	/**
+	 * @struct	SSENTRY
+	 * @brief	索引內的程序項目
+	 */
+	struct SSENTRY {
+		TSTRING	strName;		//!< 原始程序名稱 (快照中的 szExeFile)
+		TSTRING	strKey;			//!< 轉換大寫後的名稱 (索引鍵)
+		DWORD	idParent;		//!< 父程序 ID, 用於辨識程序 ID 被重複使用
+		DWORD	dwGeneration;	//!< 最後一次於快照中出現的世代
+	};
+
+	void FoldName(LPCTSTR szPtr, TSTRING* strPtr);
+	void InsertEntry(DWORD dwProcessID, LPCTSTR szNamePtr, DWORD idParent);
+	void RemoveEntry(DWORD dwProcessID, const SSENTRY& entry);
+
+private:
+	std::unordered_map<TSTRING, std::vector<DWORD>>	m_mapName;		//!< 名稱 → 程序 ID 列表
+	std::unordered_map<DWORD, SSENTRY>				m_mapProcess;	//!< 程序 ID → 程序項目
+	TSTRING	m_strFold;			//!< 查詢名稱轉換用緩衝區
+	DWORD	m_dwGeneration;		//!< 快照世代計數
+};
+
+#endif // !__AXEEN_WIN32FRAME_PROCINDEX_HH__
@@ -0,0 +1,95 @@
+﻿/**************************************************************************//**
+ * @file	wframe_procwatch.hh
+ * @brief	程序啟動/結束監看類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_PROCWATCH_HH__
+#define __AXEEN_WIN32FRAME_PROCWATCH_HH__
+#include "wframe_procindex.hh"
+
+#define PROCWATCH_INTERVAL		500		//!< 預設檢查新程序間隔時間 (in ms)
+
+/**
+ * @class	CxFrameProcessWatch
+ * @brief	程序啟動/結束監看類別
+ *
+ * 依名稱樣式 (PathMatchSpec 萬用字元, 不區分大小寫) 監看程序啟動與結束, 不需由調用端反覆調用 SearchProcess. \n
+ * - 結束: 以 SYNCHRONIZE 權限開啟程序, 交由執行緒池等待程序物件, 結束時立即通知
+ * - 啟動: 以執行緒池計時器定時更新 CxFrameProcessIndex, 只處理新增的程序
+ *
+ * 事件傳遞方式 (擇一):
+ * - 回呼函數: 於執行緒池執行緒調用, 同一時間只有一個回呼執行
+ * - 事件佇列: 事件存入佇列, 佇列由空變為非空時 PostMessage 通知視窗, 視窗以 GetEvents 取出全部事件
+ */
+class CxFrameProcessWatch
+{
+public:
+	/**
+	 * @brief	事件處理函數型別
+	 * @param	[in] aParamPtr	調用 Start 時傳入的參數
+	 * @param	[in] eventPtr	事件內容
+	 * @remark	回呼函數內不可調用 Stop.
+	 */
+	typedef void (CALLBACK* LPFNPROCWATCHPROC)(LPVOID aParamPtr, const SSPROCEVENT* eventPtr);
+
+public:
+	CxFrameProcessWatch();
+	virtual ~CxFrameProcessWatch();
+
+	BOOL	AddPattern(LPCTSTR szPatternPtr);
+	void	ClearPattern();
+
+	BOOL	Start(LPFNPROCWATCHPROC fnWatchPtr, LPVOID aParamPtr, DWORD dwInterval = PROCWATCH_INTERVAL);
+	BOOL	Start(HWND hWnd, UINT uMessage, DWORD dwInterval = PROCWATCH_INTERVAL);
+	void	Stop();
+	BOOL	IsRunning();
+
+	size_t	GetEvents(std::vector<SSPROCEVENT>* aEventPtr);
+	size_t	GetWatchCount();
+
+private:
+	typedef std::basic_string<TCHAR> TSTRING;
+
+	/**
+	 * @struct	SSWATCH
+	 * @brief	監看中的程序
+	 */
+	struct SSWATCH {
+		CxFrameProcessWatch*	thisPtr;	//!< 所屬物件
+		DWORD		dwProcessID;	//!< 程序 ID
+		HANDLE		hProcess;		//!< 程序 Handle (無法開啟時為 NULL)
+		PTP_WAIT	tpWait;			//!< 執行緒池等待物件
+		TSTRING		strName;		//!< 程序名稱
+	};
+
+	BOOL	StartWatch(DWORD dwInterval);
+	void	Refresh();
+	BOOL	IsMatch(LPCTSTR szNamePtr);
+	void	AddWatch(DWORD dwProcessID, LPCTSTR szNamePtr, std::vector<SSPROCEVENT>* aEventPtr, std::vector<SSWATCH*>* aArmPtr);
+	void	CloseWatch(SSWATCH* watchPtr);
+	void	Deliver(std::vector<SSPROCEVENT>* aEventPtr);
+
+	static void	MakeEvent(EEPROCEVENT eEvent, DWORD dwProcessID, DWORD dwExitCode, LPCTSTR szNamePtr, SSPROCEVENT* eventPtr);
+	static void CALLBACK StaticTimerProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_TIMER tpTimer);
+	static void CALLBACK StaticWaitProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_WAIT tpWait, TP_WAIT_RESULT tpResult);
+
+private:
+	CRITICAL_SECTION	m_csLock;		//!< 保護監看狀態
+	CRITICAL_SECTION	m_csNotify;		//!< 序列化事件傳遞
+	CxFrameProcessIndex	m_index;		//!< 程序名稱索引, 用於找出新增與已結束程序
+	std::vector<TSTRING>	m_aPattern;	//!< 名稱樣式
+	std::unordered_map<DWORD, SSWATCH*>	m_mapWatch;	//!< 程序 ID → 監看項目
+	std::vector<SSPROCEVENT>	m_aQueue;	//!< 事件佇列 (佇列模式)
+	PTP_CLEANUP_GROUP	m_tpGroup;		//!< 執行緒池清理群組 (計時器與全部等待物件)
+	TP_CALLBACK_ENVIRON	m_tpEnv;		//!< 執行緒池回呼環境
+	PTP_TIMER			m_tpTimer;		//!< 新程序檢查計時器
+	LPFNPROCWATCHPROC	m_fnWatchPtr;	//!< 事件處理函數 (回呼模式)
+	LPVOID				m_aParamPtr;	//!< 事件處理函數參數
+	HWND				m_hWnd;			//!< 事件通知視窗 (佇列模式)
+	UINT				m_uMessage;		//!< 事件通知訊息 (佇列模式)
+	BOOL				m_bRunning;		//!< 是否監看中
+};
+
+#endif // !__AXEEN_WIN32FRAME_PROCWATCH_HH__
@@ -0,0 +1,93 @@
+﻿/**************************************************************************//**
+ * @file	wframe_ptrchain.hh
+ * @brief	多層指標路徑解析類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_PTRCHAIN_HH__
+#define __AXEEN_WIN32FRAME_PTRCHAIN_HH__
+#include "wframe_process.hh"
+
+/**
+ * @class	CxFramePointerChain
+ * @brief	多層指標路徑解析類別
+ *
+ * 指標路徑由起始位址與偏移量陣列 { o0, o1, ... , oN } 組成, 解析結果為 \n
+ * [[[base + o0] + o1] + ...] + oN 的位址 ([x] 表示讀取位址 x 的指標值). \n
+ *
+ * Resolve 逐層解析全部路徑, 每一層的指標 (去除重複位址) 以一次 CxFrameProcess::ReadMemoryV 讀取. \n
+ * - 中間指標快取 SetCacheTicks 次 Resolve, 期間不再讀取; 路徑經由快取指標中斷時, 清除相關快取並於下次重新解析
+ * - 中斷的路徑 (讀取失敗或指標為零) 於 SetRetryTicks 次 Resolve 內不再解析
+ *
+ * 此類別非執行緒安全.
+ */
+class CxFramePointerChain
+{
+public:
+	CxFramePointerChain();
+	virtual ~CxFramePointerChain();
+
+	BOOL	Create(CxFrameProcess* procPtr, SIZE_T uPtrSize = sizeof(ULONG_PTR));
+	void	Close();
+
+	size_t	AddPath(ULONG_PTR uBase, const LONG_PTR* aOffsetPtr, size_t nOffsets);
+	BOOL	RemovePath(size_t idxPath);
+	void	ClearPath();
+
+	size_t	Resolve();
+	ULONG_PTR	GetAddress(size_t idxPath);
+	int		GetStatus(size_t idxPath);
+	size_t	GetBroken(std::vector<size_t>* aPathPtr);
+	void	RetryBroken();
+
+	void	SetCacheTicks(DWORD nTicks);
+	void	SetRetryTicks(DWORD nTicks);
+	void	Invalidate();
+	void	Invalidate(ULONG_PTR uBase, SIZE_T uSize);
+
+	void	GetStats(LPSSPTRCHAINSTAT statPtr);
+	void	ResetStats();
+
+private:
+	/**
+	 * @struct	SSCACHE
+	 * @brief	中間指標快取項目
+	 */
+	struct SSCACHE {
+		ULONG_PTR	uValue;		//!< 指標值
+		DWORD		dwTick;		//!< 讀取時的 Resolve 次數
+	};
+
+	void	ReadLevel();
+	void	BreakPath(size_t idxPath, int iLevel);
+
+private:
+	CxFrameProcess*			m_procPtr;		//!< 目標程序物件
+	SIZE_T					m_uPtrSize;		//!< 目標程序指標大小 (4 或 8)
+
+	std::vector<ULONG_PTR>	m_aBase;		//!< 各路徑起始位址
+	std::vector<size_t>		m_aFirst;		//!< 各路徑第一個偏移量於 m_aOffset 的索引
+	std::vector<size_t>		m_aDepth;		//!< 各路徑偏移量數量
+	std::vector<LONG_PTR>	m_aOffset;		//!< 全部路徑的偏移量
+	std::vector<ULONG_PTR>	m_aTrail;		//!< 最近一次解析各層讀取的位址 (與 m_aOffset 對應)
+	std::vector<ULONG_PTR>	m_aResult;		//!< 各路徑解析結果
+	std::vector<ULONG_PTR>	m_aCursor;		//!< 解析中各路徑目前的指標值
+	std::vector<int>		m_aStatus;		//!< 各路徑狀態 (PTRCHAIN_OK, PTRCHAIN_REMOVED 或中斷的層)
+	std::vector<DWORD>		m_aRetry;		//!< 中斷路徑可重試的 Resolve 次數
+	std::vector<BYTE>		m_aCached;		//!< 解析中路徑是否使用快取指標
+
+	std::vector<size_t>		m_aActive;		//!< 本層解析中的路徑
+	std::vector<size_t>		m_aPending;		//!< 本層等待讀取的路徑
+	std::vector<ULONG_PTR>	m_aRequest;		//!< 本層讀取位址 (已排序去除重複)
+	std::vector<ULONG_PTR>	m_aValue;		//!< 本層讀取結果
+	std::vector<SSMEMRANGE>	m_aRange;		//!< 本層讀取範圍
+
+	std::unordered_map<ULONG_PTR, SSCACHE>	m_mapCache;	//!< 讀取位址 → 中間指標
+	DWORD				m_dwTick;			//!< Resolve 次數
+	DWORD				m_nCacheTicks;		//!< 中間指標快取有效次數
+	DWORD				m_nRetryTicks;		//!< 中斷路徑重試間隔
+	SSPTRCHAINSTAT		m_stat;				//!< 統計資訊
+};
+
+#endif // !__AXEEN_WIN32FRAME_PTRCHAIN_HH__
@@ -0,0 +1,57 @@
+﻿/**************************************************************************//**
+ * @file	wframe_regionmap.hh
+ * @brief	程序記憶體區域對照表類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_REGIONMAP_HH__
+#define __AXEEN_WIN32FRAME_REGIONMAP_HH__
+#include "wframe_process.hh"
+
+/**
+ * @class	CxFrameRegionMap
+ * @brief	程序記憶體區域對照表類別
+ *
+ * 一次取得目標程序全部記憶體區域, 依起始位址排序存放於連續陣列, \n
+ * 以二元搜尋查詢位址所在區域 O(log n), 不必每次讀取前調用 VirtualQueryEx. \n
+ * 區域配置改變時, 可調用 Refresh 只更新指定位址範圍.
+ */
+class CxFrameRegionMap
+{
+public:
+	CxFrameRegionMap();
+	virtual ~CxFrameRegionMap();
+
+	BOOL	Load(CxFrameProcess* procPtr);
+	BOOL	Load(HANDLE hProcess);
+	BOOL	Refresh(ULONG_PTR uStart, ULONG_PTR uEnd);
+	void	Clear();
+
+	const SSMEMREGION*	Find(ULONG_PTR uAddress);
+	BOOL	IsReadable(ULONG_PTR uAddress, SIZE_T uSize);
+	size_t	GetReadable(std::vector<SSMEMREGION>* aRegionPtr, ULONG_PTR uStart = 0, ULONG_PTR uEnd = static_cast<ULONG_PTR>(-1));
+
+	size_t	GetCount();
+	const SSMEMREGION*	GetRegion(size_t idx);
+	LPCTSTR	GetModulePath(int idxModule);
+	LPCTSTR	GetModuleName(int idxModule);
+
+	static BOOL IsReadableRegion(const SSMEMREGION* rgPtr);
+	static BOOL IsWritableRegion(const SSMEMREGION* rgPtr);
+
+private:
+	typedef std::basic_string<TCHAR> TSTRING;
+
+	size_t	LowerIndex(ULONG_PTR uAddress);
+	BOOL	QueryRange(ULONG_PTR uStart, ULONG_PTR uEnd, std::vector<SSMEMREGION>* aRegionPtr);
+	int		QueryModule(ULONG_PTR uAllocBase);
+
+private:
+	HANDLE							m_hProcess;		//!< 目標程序 handle (不擁有)
+	std::vector<SSMEMREGION>		m_aRegion;		//!< 記憶體區域 (依起始位址排序)
+	std::vector<TSTRING>			m_aModule;		//!< 模組路徑
+	std::unordered_map<ULONG_PTR, int>	m_mapModule;	//!< 配置起始位址 → 模組索引
+};
+
+#endif // !__AXEEN_WIN32FRAME_REGIONMAP_HH__
@@ -0,0 +1,100 @@
+﻿/**************************************************************************//**
+ * @file	wframe_scanner.hh
+ * @brief	程序記憶體特徵碼 (AOB) 搜尋類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_SCANNER_HH__
+#define __AXEEN_WIN32FRAME_SCANNER_HH__
+#include "wframe_regionmap.hh"
+#include "wframe_workpool.hh"
+
+#define PATTERN_SCAN_CHUNK		(1 << 20)	//!< 每個搜尋區塊大小 (in Byte)
+#define PATTERN_SCAN_MAXLEN		256			//!< 特徵碼最大長度 (in Byte)
+
+/**
+ * @class	CxFramePatternScan
+ * @brief	程序記憶體特徵碼 (AOB) 搜尋類別
+ *
+ * 特徵碼使用 IDA 格式, 每個位元組以空白分隔, 如: "48 8B ?? ?5 E8" \n
+ * - "??" 或 "?" 為任意位元組
+ * - "?5", "4?" 為半位元組遮罩, 只比對指定的半位元組
+ *
+ * 搜尋時先以 SIMD (AVX2/SSE2, 執行時期偵測) 尋找錨點位元組, 再比對完整特徵碼. \n
+ * 可讀取的記憶體區域 (由 CxFrameRegionMap 取得) 會切割為固定大小區塊 (相鄰區塊重疊 特徵碼長度-1), 交由 CxFrameWorkPool 平行處理.
+ */
+class CxFramePatternScan
+{
+public:
+	/**
+	 * @brief	找到符合特徵碼時的回呼函數型別
+	 * @param	[in] aParamPtr	調用 Scan 時傳入的參數
+	 * @param	[in] uAddress	目標程序中符合的位址
+	 * @return	@c 型別: BOOL \n 返回非零值(non-zero) 繼續搜尋, 返回零(zero) 停止搜尋
+	 * @remark	回呼函數會依序調用 (不會同時進入), 但位址順序不保證由低至高.
+	 */
+	typedef BOOL (CALLBACK* LPFNSCANPROC)(LPVOID aParamPtr, ULONG_PTR uAddress);
+
+public:
+	CxFramePatternScan();
+	virtual ~CxFramePatternScan();
+
+	BOOL	SetPattern(LPCTSTR szPatternPtr);
+	BOOL	SetPattern(const BYTE* aValuePtr, const BYTE* aMaskPtr, size_t uSize);
+	size_t	GetPatternSize();
+	void	SetRegionMap(CxFrameRegionMap* mapPtr);
+
+	size_t	Scan(CxFrameProcess* procPtr, LPFNSCANPROC fnScanPtr, LPVOID aParamPtr, CxFrameWorkPool* poolPtr = NULL,
+				ULONG_PTR uStart = 0, ULONG_PTR uEnd = static_cast<ULONG_PTR>(-1));
+
+private:
+	typedef const BYTE* (*LPFNFINDBYTE)(const BYTE* aBeginPtr, const BYTE* aEndPtr, BYTE chValue);
+
+	/**
+	 * @struct	SSCHUNK
+	 * @brief	搜尋區塊
+	 */
+	struct SSCHUNK {
+		ULONG_PTR	uBase;		//!< 區塊起始位址
+		SIZE_T		uSize;		//!< 區塊讀取長度 (含重疊部分)
+		SIZE_T		uStarts;	//!< 區塊內可作為起始位置的長度 (不含重疊部分)
+	};
+
+	void	SelectAnchor();
+	BOOL	LoadChunks(CxFrameRegionMap* mapPtr, ULONG_PTR uStart, ULONG_PTR uEnd);
+	void	AppendChunks(ULONG_PTR uBase, ULONG_PTR uEnd);
+	void	ScanChunk(size_t idxChunk, DWORD idxWorker);
+	void	ScanBlock(const BYTE* aBuffPtr, SIZE_T uSize, SIZE_T uStarts, ULONG_PTR uBase);
+	BOOL	Compare(const BYTE* aDataPtr);
+	BOOL	Emit(ULONG_PTR uAddress);
+
+	static void CALLBACK StaticScanProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker);
+	static LPFNFINDBYTE SelectFindByte();
+	static const BYTE* FindByteScalar(const BYTE* aBeginPtr, const BYTE* aEndPtr, BYTE chValue);
+	static const BYTE* FindByteSSE2(const BYTE* aBeginPtr, const BYTE* aEndPtr, BYTE chValue);
+	static const BYTE* FindByteAVX2(const BYTE* aBeginPtr, const BYTE* aEndPtr, BYTE chValue);
+
+private:
+	std::vector<BYTE>	m_aValue;		//!< 特徵碼數值 (已套用遮罩)
+	std::vector<BYTE>	m_aMask;		//!< 特徵碼遮罩
+	size_t				m_idxAnchor;	//!< 錨點位元組索引
+	BOOL				m_bAnchor;		//!< 是否有可用的錨點位元組 (完整遮罩)
+	LPFNFINDBYTE		m_fnFindPtr;	//!< 錨點搜尋函數 (執行時期選擇)
+
+	CxFrameRegionMap				m_regionMap;	//!< 內部區域對照表 (未指定外部對照表時使用)
+	CxFrameRegionMap*				m_mapPtr;		//!< 外部區域對照表
+	std::vector<SSMEMREGION>		m_aReadable;	//!< 可讀取區域暫存
+	std::vector<SSCHUNK>			m_aChunk;	//!< 搜尋區塊列表
+	std::vector<std::vector<BYTE>>	m_aBuffer;	//!< 各工作執行緒讀取緩衝區
+
+	HANDLE				m_hProcess;		//!< 目前搜尋的程序 handle
+	CxFrameWorkPool*	m_poolPtr;		//!< 目前使用的工作執行緒池
+	LPFNSCANPROC		m_fnScanPtr;	//!< 目前使用的回呼函數
+	LPVOID				m_aParamPtr;	//!< 目前使用的回呼參數
+	CRITICAL_SECTION	m_csEmit;		//!< 回呼函數同步
+	volatile LONG64		m_nMatch;		//!< 符合數量
+	volatile LONG		m_bStop;		//!< 停止搜尋旗標
+};
+
+#endif // !__AXEEN_WIN32FRAME_SCANNER_HH__
@@ -0,0 +1,99 @@
+﻿/**************************************************************************//**
+ * @file	wframe_snapshot.hh
+ * @brief	程序記憶體快照檔案類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_SNAPSHOT_HH__
+#define __AXEEN_WIN32FRAME_SNAPSHOT_HH__
+#include "wframe_regionmap.hh"
+
+/**
+ * @class	CxFrameSnapshotWriter
+ * @brief	程序記憶體快照擷取類別
+ *
+ * 將目標程序全部可讀取區域經 CxFrameProcess::ReadMemory 寫入快照檔案 (格式參考 SSSNAPHEADER). \n
+ * 使用兩個緩衝區交替: 一個緩衝區由執行緒池執行緒寫入檔案時, 另一個緩衝區讀取目標程序記憶體. \n
+ * 寫入不直接依賴 overlapped WriteFile 的非同步完成: 寫入超出有效資料長度 (valid data length) 時 \n
+ * NTFS 會同步完成, 即使預先設定檔案大小也一樣; 改由工作執行緒等待寫入完成, 擷取與寫入才能同時進行.
+ */
+class CxFrameSnapshotWriter
+{
+public:
+	CxFrameSnapshotWriter();
+	virtual ~CxFrameSnapshotWriter();
+
+	BOOL	Capture(CxFrameProcess* procPtr, LPCTSTR szFilePtr, BOOL bHash = TRUE, CxFrameRegionMap* mapPtr = NULL);
+	ULONGLONG	GetPayloadSize();
+
+private:
+	/**
+	 * @struct	SSSLOT
+	 * @brief	寫入緩衝區與其寫入工作
+	 */
+	struct SSSLOT {
+		CxFrameSnapshotWriter*	thisPtr;	//!< 所屬物件
+		BYTE*		aBuffPtr;		//!< 寫入緩衝區
+		OVERLAPPED	overlap;		//!< 寫入位置與完成事件
+		PTP_WORK	tpWork;			//!< 執行緒池寫入工作
+		DWORD		cbSize;			//!< 寫入長度 (in Byte)
+		BOOL		bPending;		//!< 是否寫入中
+		BOOL		bResult;		//!< 寫入結果
+	};
+
+	BOOL	CreateBuffers();
+	void	FreeBuffers();
+	BOOL	WaitBuffer(int idx);
+	BOOL	WriteBuffer(int idx, ULONGLONG uOffset, DWORD cbSize);
+	BOOL	WriteSync(ULONGLONG uOffset, LPCVOID aBuffPtr, DWORD cbSize);
+	BOOL	WriteAt(OVERLAPPED* ovPtr, ULONGLONG uOffset, LPCVOID aBuffPtr, DWORD cbSize);
+	void	FillBuffer(CxFrameProcess* procPtr, ULONGLONG uBase, BYTE* aBuffPtr, SIZE_T uSize);
+
+	static void CALLBACK StaticWriteProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_WORK tpWork);
+
+private:
+	HANDLE		m_hFile;			//!< 快照檔案 Handle (overlapped)
+	SSSLOT		m_aSlot[2];			//!< 交替使用的寫入緩衝區
+	ULONGLONG	m_cbPayload;		//!< 最近一次擷取的資料區大小
+};
+
+/**
+ * @class	CxFrameSnapshot
+ * @brief	程序記憶體快照讀取類別
+ *
+ * 以 MapViewOfFile 開啟快照檔案, 不需解析或複製資料, 區域資料可直接以指標存取. \n
+ * 整個檔案一次對應, x86 組建只能開啟不超過 SNAPSHOT_MAP_LIMIT_X86 的檔案. \n
+ * Diff 以頁雜湊表比較兩份快照, 雜湊相同的頁面不必讀取資料.
+ */
+class CxFrameSnapshot
+{
+public:
+	CxFrameSnapshot();
+	virtual ~CxFrameSnapshot();
+
+	BOOL	Open(LPCTSTR szFilePtr);
+	void	Close();
+	BOOL	IsOpen();
+
+	const SSSNAPHEADER*	GetHeader();
+	size_t	GetRegionCount();
+	const SSSNAPREGION*	GetRegion(size_t idx);
+	const BYTE*		GetRegionData(size_t idx);
+	const UINT64*	GetPageHash(size_t idx);
+	int		Find(ULONGLONG uAddress);
+	SIZE_T	ReadMemory(ULONGLONG uAddress, LPVOID aBuffPtr, SIZE_T uSize);
+
+	static size_t	Diff(CxFrameSnapshot* oldPtr, CxFrameSnapshot* newPtr, std::vector<ULONGLONG>* aPagePtr);
+	static UINT64	HashPage(const BYTE* aPagePtr);
+
+private:
+	HANDLE		m_hFile;		//!< 快照檔案 Handle
+	HANDLE		m_hMapping;		//!< 檔案對應物件 Handle
+	const BYTE*	m_aViewPtr;		//!< 檔案對應起始位址
+	const SSSNAPHEADER*	m_headPtr;		//!< 檔案標頭
+	const SSSNAPREGION*	m_regionPtr;	//!< 區域索引
+	const UINT64*		m_aHashPtr;		//!< 頁雜湊表 (無雜湊表為 NULL)
+};
+
+#endif // !__AXEEN_WIN32FRAME_SNAPSHOT_HH__
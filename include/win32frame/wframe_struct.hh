@@ -3,7 +3,7 @@
  * @brief	Win32 Frame library 資料結構
  * @author	Swang
  * @date	2018-03-31
- * @date	2018-07-25
+ * @date	2026-10-17
  * @note	none
  *****************************************************************************/
 #ifndef __AXEEN_WIN32FRAME_STRUCT_HH__
@@ -49,6 +49,58 @@ enum EECTRLTYPE {
 };
 
 
+/**
+ * @enum	EEVALUETYPE
+ * @brief	數值搜尋資料型別
+ */
+enum EEVALUETYPE {
+	EValueInt8 = 0,				//!< 8 位元整數 (帶正負號)
+	EValueInt16,				//!< 16 位元整數 (帶正負號)
+	EValueInt32,				//!< 32 位元整數 (帶正負號)
+	EValueInt64,				//!< 64 位元整數 (帶正負號)
+	EValueFloat,				//!< 單精度浮點數
+	EValueDouble,				//!< 倍精度浮點數
+	EValueTypeEnd				//!< 結束識別符號
+};
+
+/**
+ * @enum	EEPROCEVENT
+ * @brief	程序監看事件類型
+ */
+enum EEPROCEVENT {
+	EProcStart = 0,				//!< 程序啟動 (含開始監看時已在執行的程序)
+	EProcExit,					//!< 程序結束
+	EProcEventEnd				//!< 結束識別符號
+};
+
+/**
+ * @enum	EESCANCOMPARE
+ * @brief	數值搜尋比對方式
+ */
+enum EESCANCOMPARE {
+	EScanExact = 0,				//!< 等於指定值
+	EScanRange,					//!< 介於指定範圍 (包含上下限)
+	EScanUnknown,				//!< 未知初始值 (僅首次搜尋, 全部位址為候選)
+	EScanChanged,				//!< 與上次搜尋相比已改變
+	EScanUnchanged,				//!< 與上次搜尋相比未改變
+	EScanIncreased,				//!< 與上次搜尋相比增加
+	EScanDecreased,				//!< 與上次搜尋相比減少
+	EScanCompareEnd				//!< 結束識別符號
+};
+
+/**
+ * @enum	EESORTTYPE
+ * @brief	ListView 資料排序欄位比較方式
+ */
+enum EESORTTYPE {
+	ESortText = 0,				//!< 文字, 依使用者地區設定 (LCMapStringEx 排序鍵)
+	ESortTextNoCase,			//!< 文字, 不分大小寫
+	ESortNumber,				//!< 數值 (CxFrameListSource::GetCellNumber)
+	ESortTime,					//!< 時間 (CxFrameListSource::GetCellTime)
+	ESortTypeEnd				//!< 結束識別符號
+};
+
+
 /**
  * @struct	SSLVCOLUMN
  * @brief	建立 Listview 控制項， Column 資訊設定
@@ -122,10 +174,216 @@ typedef SSFRAMEWINDOW*	LPSSFRAMEWINDOW;	//!< SSFRAMEWINDOW 結構指標型別
 #define DEFAULT_SWND_WIDTH      1280					//!< 預設視窗寬度
 #define DEFAULT_SWND_HEIGHT     720						//!< 預設視窗高度
 #define DEFAULT_SWND_STYLE      (WS_OVERLAPPEDWINDOW | WS_SYSMENU | WS_MINIMIZEBOX | WS_MAXIMIZEBOX)	//!< 預設視窗風格
+#define DEFAULT_SWND_IDLE       4000					//!< 預設每輪閒置處理時間上限 (in µs, for RunPeekMessage)
 
 #define EVENT_IDTIMER_NIL		0		//!< 計時器ID 無效值
 #define EVENT_IDTIMER_MIN		1		//!< 計時器ID 最小值
 #define EVENT_IDTIMER_MAX		65535	//!< 計時器ID 最大值
 
 
+/**
+ * @struct	SSMEMRANGE
+ * @brief	程序記憶體批次讀寫範圍
+ * @details	提供 CxFrameProcess::ReadMemoryV, CxFrameProcess::WriteMemoryV 使用 \n
+ *			讀取時 aBuffPtr 為資料存放位址, 寫入時 aBuffPtr 為資料來源位址
+ */
+struct SSMEMRANGE {
+	LPVOID		aBasePtr;		//!< 目標程序記憶體位址
+	LPVOID		aBuffPtr;		//!< 本地緩衝區位址
+	SIZE_T		uSize;			//!< 資料長度 (in Byte)
+	SIZE_T		cbDone;			//!< 實際完成讀寫長度 (in Byte), 由函數填入
+};
+typedef SSMEMRANGE*		LPSSMEMRANGE;	//!< SSMEMRANGE 結構指標型別
+#define MEMRANGE_MERGE_GAP		256		//!< 批次讀取時, 兩範圍間距不超過此值 (in Byte) 即合併讀取
+
+
+/**
+ * @struct	SSMEMREGION
+ * @brief	程序記憶體區域資訊
+ * @details	由 CxFrameRegionMap 依 VirtualQueryEx 結果建立, 不包含 MEM_FREE 區域
+ */
+struct SSMEMREGION {
+	ULONG_PTR	uBase;			//!< 區域起始位址
+	SIZE_T		uSize;			//!< 區域長度 (in Byte)
+	ULONG_PTR	uAllocBase;		//!< 配置起始位址 (AllocationBase)
+	DWORD		dwState;		//!< MEM_COMMIT 或 MEM_RESERVE
+	DWORD		dwProtect;		//!< 存取保護屬性 (PAGE_xxx)
+	DWORD		dwType;			//!< MEM_IMAGE, MEM_MAPPED 或 MEM_PRIVATE
+	int			idxModule;		//!< 對應模組索引, 參照 CxFrameRegionMap::GetModulePath (-1 表示無)
+};
+typedef SSMEMREGION*		LPSSMEMREGION;	//!< SSMEMREGION 結構指標型別
+
+
+/**
+ * @struct	SSMEMCACHESTAT
+ * @brief	程序記憶體快取統計資訊
+ * @details	由 CxFrameMemoryCache::GetStats 取得, 用於調整快取容量與略過範圍
+ */
+struct SSMEMCACHESTAT {
+	ULONGLONG	nHit;			//!< 快取命中頁數
+	ULONGLONG	nMiss;			//!< 快取未命中頁數
+	ULONGLONG	nBypass;		//!< 略過快取直接讀取次數
+	ULONGLONG	nRead;			//!< 實際調用 ReadMemory 次數
+	ULONGLONG	nEvict;			//!< 淘汰頁數
+	SIZE_T		cbUsed;			//!< 目前使用中的快取容量 (in Byte)
+	SIZE_T		cbBudget;		//!< 快取容量上限 (in Byte)
+};
+typedef SSMEMCACHESTAT*	LPSSMEMCACHESTAT;	//!< SSMEMCACHESTAT 結構指標型別
+#define MEMCACHE_PAGE_SIZE		4096				//!< 快取頁大小 (in Byte)
+#define MEMCACHE_BUDGET			(4 * 1024 * 1024)	//!< 預設快取容量 (in Byte)
+
+
+/**
+ * @struct	SSPROCEVENT
+ * @brief	程序監看事件
+ * @details	由 CxFrameProcessWatch 產生, 經回呼函數或事件佇列傳遞
+ */
+struct SSPROCEVENT {
+	EEPROCEVENT	eEvent;			//!< 事件類型
+	DWORD		dwProcessID;	//!< 程序 ID
+	DWORD		dwExitCode;		//!< 結束代碼 (僅 EProcExit, 無法取得時為 PROCWATCH_EXIT_UNKNOWN)
+	TCHAR		szName[MAX_PATH];	//!< 程序名稱
+};
+typedef SSPROCEVENT*		LPSSPROCEVENT;	//!< SSPROCEVENT 結構指標型別
+#define PROCWATCH_EXIT_UNKNOWN	0xFFFFFFFF		//!< 無法取得結束代碼
+
+
+/**
+ * @struct	SSSNAPHEADER
+ * @brief	記憶體快照檔案標頭
+ * @details	位於檔案起始位置, 之後依序為區域索引 (SSSNAPREGION × nRegions), 頁雜湊表 (UINT64 × 頁數) 與資料區. 
+
+ *			欄位皆為固定大小, x86 與 x64 使用相同格式.
+ */
+struct SSSNAPHEADER {
+	DWORD		dwMagic;		//!< 識別碼 SNAPSHOT_MAGIC
+	DWORD		dwVersion;		//!< 格式版本 SNAPSHOT_VERSION
+	DWORD		dwPageSize;		//!< 頁大小 (in Byte), 資料區與各區域資料皆以此對齊
+	DWORD		dwFlags;		//!< SNAPSHOT_FLAG_xxx
+	DWORD		idProcess;		//!< 來源程序 ID
+	DWORD		nRegions;		//!< 區域數量
+	ULONGLONG	uIndexOffset;	//!< 區域索引於檔案中的位置
+	ULONGLONG	uHashOffset;	//!< 頁雜湊表於檔案中的位置 (無雜湊表為零)
+	ULONGLONG	uPayloadOffset;	//!< 資料區於檔案中的位置
+	ULONGLONG	uFileSize;		//!< 檔案大小 (in Byte)
+	ULONGLONG	ftCapture;		//!< 擷取時間 (FILETIME, UTC)
+};
+typedef SSSNAPHEADER*		LPSSSNAPHEADER;	//!< SSSNAPHEADER 結構指標型別
+
+/**
+ * @struct	SSSNAPREGION
+ * @brief	記憶體快照區域索引項目
+ */
+struct SSSNAPREGION {
+	ULONGLONG	uBase;			//!< 來源程序中的區域起始位址
+	ULONGLONG	uSize;			//!< 區域長度 (in Byte)
+	ULONGLONG	uOffset;		//!< 區域資料於資料區中的位置
+	ULONGLONG	idxHash;		//!< 區域第一頁於頁雜湊表中的索引
+	DWORD		dwProtect;		//!< 存取保護屬性 (PAGE_xxx)
+	DWORD		dwType;			//!< MEM_IMAGE, MEM_MAPPED 或 MEM_PRIVATE
+};
+typedef SSSNAPREGION*		LPSSSNAPREGION;	//!< SSSNAPREGION 結構指標型別
+#define SNAPSHOT_MAGIC			0x4E535841		//!< 快照識別碼 'AXSN'
+#define SNAPSHOT_VERSION		1				//!< 快照格式版本
+#define SNAPSHOT_FLAG_HASH		0x00000001		//!< 包含頁雜湊表
+#define SNAPSHOT_PAGE_SIZE		4096			//!< 快照頁大小 (in Byte)
+#define SNAPSHOT_IO_BUFFER		(1 << 20)		//!< 擷取寫入緩衝區大小 (in Byte, 共兩個)
+#define SNAPSHOT_MAP_LIMIT_X86	0x40000000		//!< x86 組建可開啟的快照檔案大小上限 (in Byte, 整個檔案須對應至位址空間)
+
+
+/**
+ * @struct	SSPTRCHAINSTAT
+ * @brief	指標路徑解析統計資訊
+ * @details	由 CxFramePointerChain::GetStats 取得
+ */
+struct SSPTRCHAINSTAT {
+	ULONGLONG	nResolve;		//!< Resolve 調用次數
+	ULONGLONG	nRead;			//!< 批次讀取 (ReadMemoryV) 次數
+	ULONGLONG	nPointer;		//!< 實際讀取的指標數量 (相同位址只讀取一次)
+	ULONGLONG	nHit;			//!< 使用快取指標的次數
+	ULONGLONG	nBroken;		//!< 路徑中斷次數
+	ULONGLONG	nSkip;			//!< 因已中斷而略過的路徑次數
+};
+typedef SSPTRCHAINSTAT*	LPSSPTRCHAINSTAT;	//!< SSPTRCHAINSTAT 結構指標型別
+#define PTRCHAIN_CACHE_TICKS	16			//!< 預設中間指標快取有效次數 (Resolve 次數)
+#define PTRCHAIN_RETRY_TICKS	64			//!< 預設中斷路徑重試間隔 (Resolve 次數)
+#define PTRCHAIN_OK				(-1)		//!< 路徑狀態: 解析成功
+#define PTRCHAIN_REMOVED		(-2)		//!< 路徑狀態: 已移除
+
+
+/**
+ * @struct	SSFRAMESTAT
+ * @brief	固定步進訊框迴圈統計資訊
+ * @details	由 CxFramePacer::GetStats 取得, 百分位數以最近 PACER_HISTORY 個訊框計算
+ */
+struct SSFRAMESTAT {
+	ULONGLONG	nFrames;		//!< 訊框總數
+	ULONGLONG	nSteps;			//!< 固定步進更新總數
+	ULONGLONG	nMissed;		//!< 錯過期限的訊框數量 (工作完成時已超過期限)
+	ULONGLONG	nDropped;		//!< 因更新落後而捨棄的步進時間 (in µs)
+	DWORD		dwTarget;		//!< 目標訊框時間 (in µs)
+	DWORD		nSamples;		//!< 統計樣本數量
+	DWORD		dwAvg;			//!< 平均訊框時間 (in µs)
+	DWORD		dwP50;			//!< 第 50 百分位訊框時間 (in µs)
+	DWORD		dwP99;			//!< 第 99 百分位訊框時間 (in µs)
+	DWORD		dwMax;			//!< 最大訊框時間 (in µs)
+};
+typedef SSFRAMESTAT*	LPSSFRAMESTAT;	//!< SSFRAMESTAT 結構指標型別
+#define PACER_HISTORY			1024		//!< 訊框時間統計樣本數量
+#define PACER_SPIN_MARGIN		2000		//!< 期限前改為忙等的時間 (in µs), 其餘時間休眠
+#define PACER_MAX_STEPS			5			//!< 每個訊框最多執行的固定步進更新次數
+
+
+/**
+ * @struct	SSTHUNKSTAT
+ * @brief	可執行跳板 (thunk) 配置統計資訊
+ * @details	由 CxFrameThunkPool::GetStats 取得
+ */
+struct SSTHUNKSTAT {
+	size_t		nChunks;		//!< 已配置區塊數量
+	size_t		nSlots;			//!< 全部跳板數量
+	size_t		nUsed;			//!< 使用中的跳板數量
+	ULONGLONG	nAlloc;			//!< 累計配置次數
+	ULONGLONG	nFree;			//!< 累計釋放次數
+};
+typedef SSTHUNKSTAT*	LPSSTHUNKSTAT;	//!< SSTHUNKSTAT 結構指標型別
+#define THUNK_SLOT_SIZE			32			//!< 每個跳板大小 (in Byte)
+
+
+/**
+ * @struct	SSTASKPOOLSTAT
+ * @brief	工作竊取執行緒池統計資訊
+ * @details	由 CxFrameTaskPool::GetStats 取得
+ */
+struct SSTASKPOOLSTAT {
+	DWORD		nThreads;		//!< 工作執行緒數量
+	LONG64		nSubmitted;		//!< 投遞工作總數
+	LONG64		nExecuted;		//!< 已執行工作總數
+	LONG64		nStolen;		//!< 由其他工作執行緒竊取執行的數量
+	LONG64		nLocal;			//!< 由工作執行緒投遞至自己佇列的數量
+	LONG64		nSleeps;		//!< 工作執行緒進入等待次數
+	LONG64		nPending;		//!< 尚未完成的工作數量
+};
+typedef SSTASKPOOLSTAT*	LPSSTASKPOOLSTAT;	//!< SSTASKPOOLSTAT 結構指標型別
+#define TASKPOOL_SPIN_COUNT		64			//!< 工作執行緒進入等待前重試竊取的次數
+#define TASKPOOL_WAIT_SLICE		100			//!< CxFrameTaskPool::Wait 重新檢查的間隔 (in ms)
+
+
+/**
+ * @struct	SSSORTKEY
+ * @brief	ListView 資料排序鍵
+ * @details	提供 CxFrameListSort::Sort 使用, 多個排序鍵依陣列順序比較
+ */
+struct SSSORTKEY {
+	int			nColumn;		//!< 欄索引 (zero-base)
+	EESORTTYPE	eType;			//!< 比較方式
+	BOOL		bDescend;		//!< 非零值(non-zero) 表示遞減排序
+};
+typedef SSSORTKEY*		LPSSSORTKEY;	//!< SSSORTKEY 結構指標型別
+#define LISTSORT_MAX_KEYS		8			//!< 排序鍵數量上限
+#define LISTSORT_CHUNK			16384		//!< 平行處理時每個工作項目的列數
+#define LISTSORT_TEXT_MAX		260			//!< 取得欄位文字的緩衝區長度 (in TCHAR)
+#define LISTFILTER_SEPARATOR	0x1F		//!< 篩選索引中欄位間的分隔字元 (不構成三字元組)
+#define LISTFILTER_CHECK_ROWS	4096		//!< 篩選時每比對多少列檢查一次是否有新的查詢
+
 #endif // !__AXEEN_WIN32FRAME_STRUCT_HH__
@@ -0,0 +1,136 @@
+﻿/**************************************************************************//**
+ * @file	wframe_taskpool.hh
+ * @brief	工作竊取執行緒池類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_TASKPOOL_HH__
+#define __AXEEN_WIN32FRAME_TASKPOOL_HH__
+#include "wframe_define.hh"
+
+/**
+ * @class	CxFrameTaskPool
+ * @brief	工作竊取 (work-stealing) 執行緒池類別
+ *
+ * 每個工作執行緒擁有自己的工作佇列 (deque): \n
+ * - 工作執行緒投遞的工作放入自己佇列的尾端, 並由尾端取出 (LIFO), 分治型工作可保持快取區域性
+ * - 其他執行緒投遞的工作輪流放入各工作執行緒佇列的尾端
+ * - 自己的佇列為空時由其他佇列的前端竊取 (FIFO), 取得最早投遞、通常也是最大的工作
+ *
+ * 沒有工作時工作執行緒以號誌 (semaphore) 等待, 不佔用 CPU; 只有存在等待中的工作執行緒時投遞才觸發號誌. \n
+ * 與 CxFrameWorkPool (固定項目數量的平行迴圈) 不同, 此類別適用於數量不定、可再產生子工作的工作. \n
+ * Submit, Wait 與 GetStats 可由任何執行緒調用.
+ */
+class CxFrameTaskPool
+{
+public:
+	typedef void (CALLBACK* LPFNTASK)(LPVOID aParamPtr);	//!< 工作處理函數
+
+public:
+	CxFrameTaskPool();
+	virtual ~CxFrameTaskPool();
+
+	BOOL	Create(DWORD nThreads = 0);
+	void	Close();
+	BOOL	IsCreated() const;
+
+	BOOL	Submit(LPFNTASK fnTaskPtr, LPVOID aParamPtr);
+	template<typename FN> BOOL Submit(FN fnTask);
+	BOOL	Wait(DWORD dwTimeout = INFINITE);
+
+	DWORD	GetThreadCount() const;
+	int		GetWorkerIndex() const;
+	void	GetStats(LPSSTASKPOOLSTAT statPtr);
+	void	ResetStats();
+
+	static DWORD GetProcessorCount();
+
+private:
+	/**
+	 * @struct	SSTASK
+	 * @brief	工作
+	 */
+	struct SSTASK {
+		LPFNTASK	fnTaskPtr;	//!< 處理函數
+		LPFNTASK	fnFreePtr;	//!< 未執行即捨棄時的釋放函數
+		LPVOID		aParamPtr;	//!< 處理函數參數
+	};
+
+	/**
+	 * @struct	SSWORKER
+	 * @brief	工作執行緒 (各自配置, 避免不同執行緒的資料位於同一快取行)
+	 */
+	struct SSWORKER {
+		CxFrameTaskPool*	poolPtr;	//!< 所屬執行緒池
+		HANDLE				hThread;	//!< 執行緒 Handle
+		DWORD				idxWorker;	//!< 工作執行緒索引
+		SRWLOCK				srwLock;	//!< 保護工作佇列
+		std::deque<SSTASK>	aTask;		//!< 工作佇列
+		volatile LONG		nCount;		//!< 工作佇列數量 (不需鎖定即可判斷是否為空)
+		LONG64				nExecuted;	//!< 統計: 執行數量
+		LONG64				nStolen;	//!< 統計: 竊取數量
+		LONG64				nSleeps;	//!< 統計: 等待次數
+	};
+
+	BOOL	PushTask(LPFNTASK fnTaskPtr, LPFNTASK fnFreePtr, LPVOID aParamPtr);
+	BOOL	PopTask(SSWORKER* workerPtr, SSTASK* taskPtr);
+	BOOL	StealTask(SSWORKER* workerPtr, SSTASK* taskPtr);
+	void	RunTask(const SSTASK& task);
+	void	WorkerProc(SSWORKER* workerPtr);
+
+	static DWORD WINAPI StaticWorkerProc(LPVOID aParamPtr);
+	template<typename FN> static void CALLBACK InvokeTask(LPVOID aParamPtr);
+	template<typename FN> static void CALLBACK DeleteTask(LPVOID aParamPtr);
+
+private:
+	std::vector<SSWORKER*>	m_aWorker;		//!< 工作執行緒
+	HANDLE				m_hSemaphore;		//!< 喚醒等待中工作執行緒的號誌
+	HANDLE				m_hIdle;			//!< 全部工作完成事件 (manual-reset)
+	volatile LONG		m_nSleeping;		//!< 等待中的工作執行緒數量
+	volatile LONG		m_bQuit;			//!< 是否結束
+	volatile LONG		m_idxNext;			//!< 外部投遞輪流分配的下一個佇列
+	volatile LONG64		m_nQueued;			//!< 全部佇列中的工作數量
+	volatile LONG64		m_nPending;			//!< 尚未完成的工作數量
+	volatile LONG64		m_nSubmitted;		//!< 統計: 投遞總數
+	volatile LONG64		m_nLocal;			//!< 統計: 工作執行緒投遞至自己佇列的數量
+};
+
+/**
+ * @brief	投遞可呼叫物件 (lambda, 函數物件)
+ * @param	[in] fnTask	可呼叫物件, 以 fnTask() 調用
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			配置記憶體失敗或執行緒池未建立返回零(zero)
+ * @remark	可呼叫物件會被複製至堆積, 執行後或執行緒池關閉時釋放.
+ */
+template<typename FN>
+BOOL CxFrameTaskPool::Submit(FN fnTask)
+{
+	FN* fnPtr = new (std::nothrow) FN(std::move(fnTask));
+
+	if (fnPtr == NULL)
+		return FALSE;
+	if (this->PushTask(&CxFrameTaskPool::InvokeTask<FN>, &CxFrameTaskPool::DeleteTask<FN>, fnPtr))
+		return TRUE;
+	delete fnPtr;
+	return FALSE;
+}
+
+//! 執行並釋放可呼叫物件
+template<typename FN>
+void CALLBACK CxFrameTaskPool::InvokeTask(LPVOID aParamPtr)
+{
+	FN* fnPtr = static_cast<FN*>(aParamPtr);
+	(*fnPtr)();
+	delete fnPtr;
+}
+
+//! 釋放未執行的可呼叫物件
+template<typename FN>
+void CALLBACK CxFrameTaskPool::DeleteTask(LPVOID aParamPtr)
+{
+	delete static_cast<FN*>(aParamPtr);
+}
+
+#endif // !__AXEEN_WIN32FRAME_TASKPOOL_HH__
@@ -0,0 +1,63 @@
+﻿/**************************************************************************//**
+ * @file	wframe_thunk.hh
+ * @brief	可執行跳板 (thunk) 配置類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_THUNK_HH__
+#define __AXEEN_WIN32FRAME_THUNK_HH__
+#include "wframe_define.hh"
+
+/**
+ * @class	CxFrameThunkPool
+ * @brief	可執行跳板 (thunk) 配置類別
+ *
+ * 跳板是一小段機器碼, 將呼叫的第一個參數替換為綁定的指標後跳至目標函數. \n
+ * 例如綁定 this 與視窗處理函數後設為視窗的 WNDPROC, 收到訊息時不需 GetWindowLongPtr 查詢物件. \n
+ *
+ * 跳板以區塊 (系統配置粒度, 通常 64 KB) 配置, 每個區塊為一個分頁檔區段映射兩次: \n
+ * - 寫入視圖 (PAGE_READWRITE) 只用於寫入跳板
+ * - 執行視圖 (PAGE_EXECUTE_READ) 只用於執行跳板
+ *
+ * 任何視圖都不同時可寫可執行 (W^X), 配置與釋放時也不需改變其他執行中跳板的分頁保護. \n
+ * 支援 x86 (__stdcall), x64 與 ARM64; 系統禁止動態程式碼 (ACG) 時 Alloc 返回 NULL. \n
+ * 此類別為執行緒安全.
+ */
+class CxFrameThunkPool
+{
+public:
+	CxFrameThunkPool();
+	virtual ~CxFrameThunkPool();
+
+	LPVOID	Alloc(LPVOID aBindPtr, LPCVOID fnTargetPtr);
+	BOOL	Free(LPVOID thunkPtr);
+	void	GetStats(LPSSTHUNKSTAT statPtr);
+
+	static CxFrameThunkPool& Shared();
+
+private:
+	/**
+	 * @struct	SSCHUNK
+	 * @brief	跳板區塊
+	 */
+	struct SSCHUNK {
+		HANDLE	hSection;	//!< 分頁檔區段
+		LPBYTE	aWritePtr;	//!< 寫入視圖
+		LPBYTE	aExecPtr;	//!< 執行視圖
+	};
+
+	BOOL	AddChunk();
+	LPBYTE	GetWritePtr(LPBYTE aExecPtr);
+	void	WriteSlot(LPBYTE aWritePtr, LPBYTE aExecPtr, LPVOID aBindPtr, LPCVOID fnTargetPtr);
+	void	ClearSlot(LPBYTE aWritePtr, LPBYTE aExecPtr);
+
+private:
+	CRITICAL_SECTION		m_csPool;		//!< 保護區塊與可用跳板
+	std::vector<SSCHUNK>	m_aChunk;		//!< 已配置區塊
+	std::vector<LPBYTE>		m_aFree;		//!< 可用跳板 (執行視圖位址)
+	SIZE_T					m_uChunkSize;	//!< 區塊大小 (in Byte)
+	SSTHUNKSTAT				m_stat;			//!< 統計資訊
+};
+
+#endif // !__AXEEN_WIN32FRAME_THUNK_HH__
@@ -0,0 +1,87 @@
+﻿/**************************************************************************//**
+ * @file	wframe_valuescan.hh
+ * @brief	程序記憶體數值搜尋類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_VALUESCAN_HH__
+#define __AXEEN_WIN32FRAME_VALUESCAN_HH__
+#include "wframe_regionmap.hh"
+#include "wframe_workpool.hh"
+
+#define VALUESCAN_BLOCK			(4 << 20)	//!< 搜尋區塊大小 (in Byte)
+#define VALUESCAN_SPARSE_RATIO	32			//!< 候選數量低於 區塊位置數/此值 時, 改用差值編碼存放
+
+/**
+ * @class	CxFrameValueScan
+ * @brief	程序記憶體數值搜尋類別
+ *
+ * 首次搜尋 (FirstScan) 於目標程序全部可寫入區域尋找符合條件的位址, \n
+ * 之後以 NextScan (改變/未改變/增加/減少/等於/範圍) 逐步縮小候選範圍. \n
+ * 數值依型別大小對齊 (如 int32 位址為 4 的倍數).
+ *
+ * 可寫入區域切割為 VALUESCAN_BLOCK 大小的區塊, 每個區塊獨立存放候選位址:
+ * - 候選密集時使用位元集 (每個位置 1 bit) 並保存整個區塊的上次數值
+ * - 候選稀疏時使用差值 varint 編碼的位置索引, 只保存候選位置的上次數值
+ *
+ * 各區塊可交由 CxFrameWorkPool 平行處理, 比對使用 SSE2 指令一次處理 16 bytes.
+ */
+class CxFrameValueScan
+{
+public:
+	CxFrameValueScan();
+	virtual ~CxFrameValueScan();
+
+	BOOL	FirstScan(CxFrameProcess* procPtr, EEVALUETYPE eType, EESCANCOMPARE eCompare, LPCVOID aValuePtr = NULL, LPCVOID aValue2Ptr = NULL,
+				CxFrameWorkPool* poolPtr = NULL, CxFrameRegionMap* mapPtr = NULL);
+	BOOL	NextScan(EESCANCOMPARE eCompare, LPCVOID aValuePtr = NULL, LPCVOID aValue2Ptr = NULL, CxFrameWorkPool* poolPtr = NULL);
+	void	Clear();
+
+	ULONGLONG	GetCount();
+	size_t	GetResults(std::vector<ULONG_PTR>* aAddressPtr, size_t nMax);
+	SIZE_T	GetMemoryUsage();
+	EEVALUETYPE	GetValueType();
+
+private:
+	/**
+	 * @struct	SSBLOCK
+	 * @brief	搜尋區塊與其候選位址
+	 */
+	struct SSBLOCK {
+		ULONG_PTR			uBase;		//!< 區塊起始位址
+		SIZE_T				nSlots;		//!< 區塊內數值位置數量
+		SIZE_T				nCount;		//!< 候選數量
+		BOOL				bSparse;	//!< 是否使用差值編碼
+		SIZE_T				idxFirst;	//!< 稀疏模式: 第一個候選位置索引
+		SIZE_T				idxLast;	//!< 稀疏模式: 最後一個候選位置索引
+		std::vector<UINT64>	aBits;		//!< 密集模式: 候選位元集
+		std::vector<BYTE>	aDelta;		//!< 稀疏模式: 位置索引差值 (varint)
+		std::vector<BYTE>	aValue;		//!< 上次數值 (密集: 整個區塊, 稀疏: 依候選順序緊密排列)
+	};
+
+	BOOL	RunPass(CxFrameWorkPool* poolPtr);
+	void	ScanBlock(size_t idxBlock, DWORD idxWorker);
+	void	ScanDense(SSBLOCK* blockPtr, std::vector<BYTE>* aBuffPtr);
+	void	ScanSparse(SSBLOCK* blockPtr, std::vector<BYTE>* aBuffPtr);
+	void	MakeSparse(SSBLOCK* blockPtr, const BYTE* aDataPtr);
+	BOOL	MatchScalar(const BYTE* aNewPtr, const BYTE* aOldPtr);
+	SIZE_T	CompareDense(const BYTE* aNewPtr, const BYTE* aOldPtr, SIZE_T nSlots, UINT64* aBitsPtr);
+
+	static void CALLBACK StaticScanProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker);
+	static SIZE_T ValueSize(EEVALUETYPE eType);
+
+private:
+	CxFrameProcess*			m_procPtr;		//!< 目標程序物件
+	std::vector<SSBLOCK>	m_aBlock;		//!< 搜尋區塊
+	std::vector<std::vector<BYTE>>	m_aBuffer;	//!< 各工作執行緒讀取緩衝區
+	EEVALUETYPE				m_eType;		//!< 數值型別
+	SIZE_T					m_uValueSize;	//!< 數值大小 (in Byte)
+	EESCANCOMPARE			m_eCompare;		//!< 目前比對方式
+	BOOL					m_bFirst;		//!< 目前是否為首次搜尋
+	BYTE					m_aValue1[8];	//!< 比對值 (或範圍下限)
+	BYTE					m_aValue2[8];	//!< 範圍上限
+	volatile LONG64			m_nCount;		//!< 候選總數
+};
+
+#endif // !__AXEEN_WIN32FRAME_VALUESCAN_HH__
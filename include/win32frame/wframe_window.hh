@@ -8,6 +8,7 @@
 #ifndef __AXEEN_WIN32FRAME_WINDOW_HH__
 #define __AXEEN_WIN32FRAME_WINDOW_HH__
 #include "wframe_object.hh"
+#include "wframe_pacer.hh"
 
 
  /**
@@ -22,14 +23,20 @@ protected:
 	static	LRESULT CALLBACK WndProc(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam);
 	virtual	LRESULT MessageDispose(UINT uMessage, WPARAM wParam, LPARAM lParam);
 	LRESULT	DefaultWindowProc(UINT uMessage, WPARAM wParam, LPARAM lParam);
+	virtual	BOOL IdleDispose(DWORD dwBudget);
+	virtual	void FrameUpdate(double dStep);
+	virtual	void FrameRender(double dAlpha);
 	int	RunPeekMessage();
 	int	RunStayMessage();
+	BOOL	RunIdle();
 
 public:
 	CxFrameWindow();
 	virtual ~CxFrameWindow();
 
 	int		Run(BOOL bPeek=FALSE);
+	int		RunFrame(DWORD nUpdateHz, DWORD nRenderHz = 0);
+	CxFramePacer*	GetPacer();
 	BOOL	CreateWindow(LPSSFRAMEWINDOW swndPtr);
 	BOOL	CreateSample(HINSTANCE hInstance);
 
@@ -37,6 +44,9 @@ protected:
 	virtual void WindowInTheEnd() override;
 	BOOL SysRegisterWindow(LPSSFRAMEWINDOW swndPtr);
 	BOOL SysCreateWindow(LPSSFRAMEWINDOW swndPtr);
+
+private:
+	CxFramePacer	m_pacer;	//!< 訊框迴圈節拍 (RunFrame)
 };
 
 #endif	// !__AXEEN_WIN32FRAME_WINDOW_HH__
@@ -0,0 +1,59 @@
+﻿/**************************************************************************//**
+ * @file	wframe_workpool.hh
+ * @brief	工作執行緒池類別
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#ifndef __AXEEN_WIN32FRAME_WORKPOOL_HH__
+#define __AXEEN_WIN32FRAME_WORKPOOL_HH__
+#include "wframe_define.hh"
+
+/**
+ * @class	CxFrameWorkPool
+ * @brief	工作執行緒池類別
+ *
+ * 使用 Windows 執行緒池 (Thread Pool API) 建立專用且常駐的工作執行緒, \n
+ * 多次調用 Run 時重複使用相同執行緒, 不必反覆建立與結束執行緒.
+ */
+class CxFrameWorkPool
+{
+public:
+	/**
+	 * @brief	工作項目處理函數型別
+	 * @param	[in] aParamPtr	調用 Run 時傳入的參數
+	 * @param	[in] idxItem	工作項目索引 (0 ~ nItems-1)
+	 * @param	[in] idxWorker	工作執行緒索引 (0 ~ GetThreadCount()-1), 可用於存取各執行緒專屬資料
+	 */
+	typedef void (CALLBACK* LPFNWORKPROC)(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker);
+
+public:
+	CxFrameWorkPool();
+	virtual ~CxFrameWorkPool();
+
+	BOOL	Create(DWORD nThreads = 0);
+	void	Close();
+	BOOL	Run(LPFNWORKPROC fnWorkPtr, LPVOID aParamPtr, size_t nItems);
+	void	Cancel();
+	BOOL	IsCancel();
+	DWORD	GetThreadCount();
+
+private:
+	static void CALLBACK StaticWorkProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_WORK tpWork);
+	void WorkProc();
+
+private:
+	PTP_POOL		m_tpPool;		//!< 專用執行緒池
+	PTP_WORK		m_tpWork;		//!< 工作物件
+	TP_CALLBACK_ENVIRON	m_tpEnv;	//!< 執行緒池回呼環境
+	DWORD			m_nThreads;		//!< 工作執行緒數量
+
+	LPFNWORKPROC	m_fnWorkPtr;	//!< 目前工作處理函數
+	LPVOID			m_aParamPtr;	//!< 目前工作參數
+	LONG64			m_nItems;		//!< 目前工作項目數量
+	volatile LONG64	m_idxNext;		//!< 下一個待處理工作項目索引
+	volatile LONG	m_idxWorker;	//!< 工作執行緒索引分配計數
+	volatile LONG	m_bCancel;		//!< 取消旗標
+};
+
+#endif // !__AXEEN_WIN32FRAME_WORKPOOL_HH__
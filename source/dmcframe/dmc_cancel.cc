@@ -0,0 +1,65 @@
+﻿/**************************************************************************//**
+ * @file	dmc_cancel.cc
+ * @brief	取消標記類別 - 成員函數
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "dmcframe/dmc_cancel.hh"
+
+//! DmCancelToken 建構式
+DmCancelToken::DmCancelToken() : m_nRef(1), m_bCancel(FALSE) { }
+
+//! DmCancelToken 解構式
+DmCancelToken::~DmCancelToken() { }
+
+/**
+ * @brief	建立取消標記 (static)
+ * @return	@c 型別: DmCancelToken* \n
+ *			參考計數為 1 的取消標記, 使用完畢調用 Release \n
+ *			配置記憶體失敗返回 NULL
+ */
+DmCancelToken* DmCancelToken::Create()
+{
+	return new (std::nothrow) DmCancelToken();
+}
+
+/**
+ * @brief	增加參考計數
+ * @return	@c 型別: LONG \n 增加後的參考計數
+ */
+LONG DmCancelToken::AddRef()
+{
+	return ::InterlockedIncrement(&m_nRef);
+}
+
+/**
+ * @brief	減少參考計數, 歸零時釋放物件
+ * @return	@c 型別: LONG \n 減少後的參考計數, 返回零(zero) 時物件已釋放
+ */
+LONG DmCancelToken::Release()
+{
+	LONG nRef = ::InterlockedDecrement(&m_nRef);
+
+	if (nRef == 0)
+		delete this;
+	return nRef;
+}
+
+/**
+ * @brief	設為已取消
+ * @remark	取消後無法恢復.
+ */
+void DmCancelToken::Cancel()
+{
+	::InterlockedExchange(&m_bCancel, TRUE);
+}
+
+/**
+ * @brief	是否已取消
+ * @return	@c 型別: BOOL \n 已取消返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL DmCancelToken::IsCancelled() const
+{
+	return ::InterlockedCompareExchange(const_cast<volatile LONG*>(&m_bCancel), 0, 0) != FALSE;
+}
@@ -0,0 +1,129 @@
+﻿/**************************************************************************//**
+ * @file	dmc_coroutine.cc
+ * @brief	協程 (coroutine) 支援 - 框架配置
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "dmcframe/dmc_coroutine.hh"
+
+namespace {
+	volatile LONG64 s_nFrames = 0;		//!< 統計: 配置框架總數
+	volatile LONG64 s_nPooled = 0;		//!< 統計: 由可用清單取得的數量
+	volatile LONG64 s_nHeap = 0;		//!< 統計: 直接配置堆積的數量
+	volatile LONG64 s_nCancelled = 0;	//!< 統計: 因取消而銷毀的數量
+}
+
+/**
+ * @brief	配置協程框架 (static)
+ * @param	[in] uSize	框架大小 (in Byte)
+ * @return	@c 型別: LPVOID \n 框架位址, 配置記憶體失敗返回 NULL
+ * @remark	可用清單中的框架以 ::operator new 配置, 已符合 SLIST 的對齊需求 (MEMORY_ALLOCATION_ALIGNMENT).
+ */
+LPVOID DmCoroFramePool::Alloc(size_t uSize)
+{
+	int idxClass = GetClass(uSize);
+	LPVOID framePtr = NULL;
+
+	::InterlockedIncrement64(&s_nFrames);
+	if (idxClass < 0) {
+		::InterlockedIncrement64(&s_nHeap);
+		return ::operator new(uSize, std::nothrow);
+	}
+
+	if ((framePtr = ::InterlockedPopEntrySList(GetList(idxClass))) != NULL) {
+		::InterlockedIncrement64(&s_nPooled);
+		return framePtr;
+	}
+	return ::operator new(static_cast<size_t>(COROFRAME_MIN_SIZE) << idxClass, std::nothrow);
+}
+
+/**
+ * @brief	釋放協程框架 (static)
+ * @param	[in] framePtr	Alloc 返回的框架位址
+ * @param	[in] uSize		框架大小 (與配置時相同)
+ * @remark	可用清單已達 COROFRAME_CACHE_DEPTH 時直接釋放.
+ */
+void DmCoroFramePool::Free(LPVOID framePtr, size_t uSize)
+{
+	int idxClass = GetClass(uSize);
+
+	if (framePtr == NULL)
+		return;
+	if (idxClass < 0 || ::QueryDepthSList(GetList(idxClass)) >= COROFRAME_CACHE_DEPTH) {
+		::operator delete(framePtr);
+		return;
+	}
+	::InterlockedPushEntrySList(GetList(idxClass), static_cast<PSLIST_ENTRY>(framePtr));
+}
+
+/**
+ * @brief	釋放全部可用清單中的框架 (static)
+ * @remark	使用中的框架不受影響, 結束後仍會回到可用清單.
+ */
+void DmCoroFramePool::Flush()
+{
+	for (int i = 0; i < COROFRAME_CLASSES; ++i) {
+		PSLIST_ENTRY entryPtr = ::InterlockedFlushSList(GetList(i));
+		while (entryPtr != NULL) {
+			PSLIST_ENTRY nextPtr = entryPtr->Next;
+			::operator delete(entryPtr);
+			entryPtr = nextPtr;
+		}
+	}
+}
+
+//! 記錄因取消而銷毀的框架 (static)
+void DmCoroFramePool::NoteCancelled()
+{
+	::InterlockedIncrement64(&s_nCancelled);
+}
+
+/**
+ * @brief	取得統計資訊 (static)
+ * @param	[out] statPtr	SSCOROSTAT 結構指標
+ */
+void DmCoroFramePool::GetStats(LPSSCOROSTAT statPtr)
+{
+	if (statPtr == NULL)
+		return;
+
+	statPtr->nFrames = ::InterlockedCompareExchange64(&s_nFrames, 0, 0);
+	statPtr->nPooled = ::InterlockedCompareExchange64(&s_nPooled, 0, 0);
+	statPtr->nHeap = ::InterlockedCompareExchange64(&s_nHeap, 0, 0);
+	statPtr->nCancelled = ::InterlockedCompareExchange64(&s_nCancelled, 0, 0);
+	statPtr->nCached = 0;
+	for (int i = 0; i < COROFRAME_CLASSES; ++i)
+		statPtr->nCached += ::QueryDepthSList(GetList(i));
+}
+
+/**
+ * @brief	取得框架大小所屬的尺寸分級 (static)
+ * @param	[in] uSize	框架大小 (in Byte)
+ * @return	@c 型別: int \n 尺寸分級索引, 超過最大分級返回 -1
+ */
+int DmCoroFramePool::GetClass(size_t uSize)
+{
+	size_t uClassSize = COROFRAME_MIN_SIZE;
+
+	for (int i = 0; i < COROFRAME_CLASSES; ++i, uClassSize <<= 1) {
+		if (uSize <= uClassSize)
+			return i;
+	}
+	return -1;
+}
+
+/**
+ * @brief	取得尺寸分級的可用清單 (static)
+ * @param	[in] idxClass	尺寸分級索引
+ * @return	@c 型別: PSLIST_HEADER, 於第一次調用時初始化
+ */
+PSLIST_HEADER DmCoroFramePool::GetList(int idxClass)
+{
+	struct SSLISTS {
+		SLIST_HEADER aList[COROFRAME_CLASSES];
+		SSLISTS() { for (int i = 0; i < COROFRAME_CLASSES; ++i) ::InitializeSListHead(&aList[i]); }
+	};
+	static SSLISTS s_lists;
+	return &s_lists.aList[idxClass];
+}
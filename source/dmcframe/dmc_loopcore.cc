@@ -0,0 +1,784 @@
+﻿/**************************************************************************//**
+ * @file	dmc_loopcore.cc
+ * @brief	DMC Frame 事件迴圈核心類別, 成員函數
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "dmcframe/dmc_loopcore.hh"
+
+//! DmLoopCore construct
+DmLoopCore::DmLoopCore()
+	: DmObject()
+	, m_bMessage(TRUE)
+	, m_hWake(NULL)
+	, m_headPtr(&m_stub)
+	, m_tailPtr(&m_stub)
+	, m_nBatch(LOOPCORE_TASK_BATCH)
+	, m_idxIdle(0)
+	, m_dwIdleBudget(LOOPCORE_IDLE_BUDGET)
+	, m_bIdleMore(FALSE)
+	, m_fnFilterPtr(NULL)
+	, m_aFilterPtr(NULL)
+	, m_idNext(0)
+	, m_bSignal(FALSE)
+	, m_bQuit(FALSE)
+	, m_iExitCode(0)
+	, m_llFrequency(0)
+{
+	LARGE_INTEGER liFrequency;
+
+	::memset(&m_stub, 0, sizeof(m_stub));
+	::InitializeCriticalSection(&m_csCoalesce);
+	::QueryPerformanceFrequency(&liFrequency);
+	m_llFrequency = liFrequency.QuadPart;
+	this->ResetTaskStats();
+}
+
+//! DmLoopCore deconstruct
+DmLoopCore::~DmLoopCore()
+{
+	this->Close();
+	::DeleteCriticalSection(&m_csCoalesce);
+}
+
+/**
+ * @brief	建立事件迴圈
+ * @param	[in] bMessage	是否處理視窗訊息, FALSE 時只處理工作、計時器與核心物件 (headless)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			無法建立喚醒事件返回零(zero)
+ * @remark	重複調用時捨棄之前設定的計時器、等待項目與閒置處理函數.
+ */
+BOOL DmLoopCore::Create(BOOL bMessage)
+{
+	if (m_hWake == NULL) {
+		m_hWake = ::CreateEvent(NULL, FALSE, FALSE, NULL);
+		if (m_hWake == NULL)
+			return FALSE;
+	}
+
+	m_bMessage = bMessage;
+	m_bQuit = FALSE;
+	m_iExitCode = 0;
+	m_aTimer.clear();
+	m_aHandle.assign(1, m_hWake);
+	m_aWait.clear();
+	m_aIdle.clear();
+	m_bIdleMore = FALSE;
+	return TRUE;
+}
+
+/**
+ * @brief	關閉事件迴圈, 未執行的工作、計時器與等待項目全部捨棄
+ * @remark	調用時不可有其他執行緒正在投遞工作.
+ */
+void DmLoopCore::Close()
+{
+	this->FreeTasks();
+
+	m_aTimer.clear();
+	m_aHandle.clear();
+	m_aWait.clear();
+	m_aIdle.clear();
+	m_bIdleMore = FALSE;
+	if (m_hWake != NULL) {
+		::CloseHandle(m_hWake);
+		m_hWake = NULL;
+	}
+}
+
+/**
+ * @brief	執行事件迴圈, 直到 Quit 或收到 WM_QUIT
+ * @return	@c 型別: int, 結束碼
+ */
+int DmLoopCore::Run()
+{
+	while (this->RunOnce(INFINITE))
+		continue;
+	return m_iExitCode;
+}
+
+/**
+ * @brief	等待並處理一輪事件
+ * @param	[in] dwTimeout	沒有事件時最長等待時間 (in ms), 零(zero) 表示不等待
+ * @return	@c 型別: BOOL \n
+ *			尚未結束返回非零值(non-zero) \n
+ *			已結束 (Quit 或 WM_QUIT) 返回零(zero)
+ * @remark	處理順序: 觸發的核心物件, 視窗訊息, 到期計時器, 投遞工作, 閒置處理. \n
+ *			有事件發生時, 全部閒置處理項目重新標記為尚有工作; \n
+ *			閒置處理項目尚有工作時不等待, 否則等待至下一個事件或 dwTimeout.
+ */
+BOOL DmLoopCore::RunOnce(DWORD dwTimeout)
+{
+	DWORD nHandles = static_cast<DWORD>(m_aHandle.size());
+	DWORD dwResult;
+
+	if (m_bQuit || m_hWake == NULL)
+		return FALSE;
+
+	dwTimeout = this->NextTimeout(dwTimeout);
+	if (m_bMessage)
+		dwResult = ::MsgWaitForMultipleObjectsEx(nHandles, m_aHandle.data(), dwTimeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE | MWMO_ALERTABLE);
+	else
+		dwResult = ::WaitForMultipleObjectsEx(nHandles, m_aHandle.data(), FALSE, dwTimeout, TRUE);
+
+	if (dwResult > WAIT_OBJECT_0 && dwResult < WAIT_OBJECT_0 + nHandles) {
+		size_t idx = dwResult - WAIT_OBJECT_0 - 1;
+		SSWAIT wait = m_aWait[idx];
+		wait.fnWaitPtr(wait.aParamPtr, m_aHandle[idx + 1]);
+	}
+
+	if (m_bMessage && !this->DispatchMessages())
+		return FALSE;
+	if (this->DispatchTimers())
+		dwResult = WAIT_OBJECT_0;
+	this->DispatchTasks();
+
+	if (!m_aIdle.empty()) {
+		if (dwResult != WAIT_TIMEOUT) {
+			for (size_t i = 0; i < m_aIdle.size(); ++i)
+				m_aIdle[i].bMore = TRUE;
+			m_bIdleMore = TRUE;
+		}
+		if (m_bIdleMore && !m_bQuit)
+			this->DispatchIdle();
+	}
+	return !m_bQuit;
+}
+
+/**
+ * @brief	結束事件迴圈
+ * @param	[in] iExitCode	結束碼, 由 Run 返回
+ * @remark	可由任何執行緒調用.
+ */
+void DmLoopCore::Quit(int iExitCode)
+{
+	m_iExitCode = iExitCode;
+	::InterlockedExchange(&m_bQuit, TRUE);
+	if (m_hWake != NULL)
+		::SetEvent(m_hWake);
+}
+
+/**
+ * @brief	事件迴圈是否已結束
+ * @return	@c 型別: BOOL \n 已結束返回非零值(non-zero)
+ */
+BOOL DmLoopCore::IsQuit() const { return m_bQuit; }
+
+/**
+ * @brief	取得結束碼
+ * @return	@c 型別: int, 結束碼
+ */
+int DmLoopCore::GetExitCode() const { return m_iExitCode; }
+
+/**
+ * @brief	投遞工作
+ * @param	[in] fnTaskPtr	工作處理函數
+ * @param	[in] aParamPtr	工作處理函數參數
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			參數錯誤、配置記憶體失敗或迴圈未建立返回零(zero)
+ * @remark	可由任何執行緒調用, 工作於迴圈執行緒依投遞順序執行.
+ */
+BOOL DmLoopCore::PostTask(LPFNLOOPTASK fnTaskPtr, LPVOID aParamPtr)
+{
+	return this->PushTask(fnTaskPtr, NULL, aParamPtr);
+}
+
+/**
+ * @brief	以合併鍵值投遞工作
+ * @param	[in] aTargetPtr	合併鍵值: 目標 (如控制項或物件指標)
+ * @param	[in] uKind		合併鍵值: 種類 (如訊息或更新種類)
+ * @param	[in] fnTaskPtr	工作處理函數
+ * @param	[in] aParamPtr	工作處理函數參數
+ * @param	[in] fnFreePtr	未執行即捨棄 (被取代或迴圈關閉) 時的釋放函數, 可為 NULL
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			參數錯誤、配置記憶體失敗或迴圈未建立返回零(zero)
+ * @remark	同鍵值已有尚未執行的項目時取代其處理函數與參數 (不再加入佇列), 舊參數以舊的釋放函數釋放; \n
+ *			項目於第一次投遞的佇列位置執行最後一次投遞的內容. 可由任何執行緒調用.
+ */
+BOOL DmLoopCore::PostCoalesced(LPCVOID aTargetPtr, UINT uKind, LPFNLOOPTASK fnTaskPtr, LPVOID aParamPtr, LPFNLOOPTASK fnFreePtr)
+{
+	const COALESCEKEY key(aTargetPtr, uKind);
+	LPFNLOOPTASK fnOldFreePtr = NULL;
+	LPVOID aOldParamPtr = NULL;
+	BOOL bMerged = FALSE;
+	BOOL bResult = TRUE;
+
+	if (fnTaskPtr == NULL || m_hWake == NULL)
+		return FALSE;
+
+	::EnterCriticalSection(&m_csCoalesce);
+	auto it = m_mapCoalesce.find(key);
+	if (it != m_mapCoalesce.end()) {
+		fnOldFreePtr = it->second.fnFreePtr;
+		aOldParamPtr = it->second.aParamPtr;
+		it->second.fnTaskPtr = fnTaskPtr;
+		it->second.fnFreePtr = fnFreePtr;
+		it->second.aParamPtr = aParamPtr;
+		bMerged = TRUE;
+	}
+	else {
+		SSCOALESCE item = { this, aTargetPtr, uKind, fnTaskPtr, fnFreePtr, aParamPtr };
+		it = m_mapCoalesce.insert(std::make_pair(key, item)).first;
+		if (!this->PushTask(&DmLoopCore::RunCoalesced, &DmLoopCore::FreeCoalesced, &it->second)) {
+			m_mapCoalesce.erase(it);
+			bResult = FALSE;
+		}
+	}
+	::LeaveCriticalSection(&m_csCoalesce);
+
+	if (bResult)
+		::InterlockedIncrement64(&m_nCoalesced);
+	if (bMerged) {
+		::InterlockedIncrement64(&m_nMerged);
+		if (fnOldFreePtr != NULL)
+			fnOldFreePtr(aOldParamPtr);
+	}
+	return bResult;
+}
+
+/**
+ * @brief	以合併鍵值投遞視窗訊息
+ * @param	[in] hWnd		視窗 Handle, 應屬於迴圈執行緒
+ * @param	[in] uMessage	視窗訊息
+ * @param	[in] wParam		參數 1
+ * @param	[in] lParam		參數 2
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ * @remark	合併鍵值為 (hWnd, uMessage), 尚未執行前再次投遞時只以最後的 wParam, lParam 調用 SendMessage. \n
+ *			lParam 不可為需要釋放的指標, 被取代的訊息不會送出.
+ */
+BOOL DmLoopCore::PostCoalescedMessage(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam)
+{
+	if (hWnd == NULL)
+		return FALSE;
+
+	return this->PostCoalesced(hWnd, uMessage, [hWnd, uMessage, wParam, lParam]() {
+		if (::IsWindow(hWnd))
+			::SendMessage(hWnd, uMessage, wParam, lParam);
+	});
+}
+
+/**
+ * @brief	設定每輪最多執行的投遞工作數量
+ * @param	[in] nBatch	工作數量, 零(zero) 表示使用預設值 LOOPCORE_TASK_BATCH
+ * @remark	超過數量的工作留待下一輪, 期間仍會處理視窗訊息與計時器.
+ */
+void DmLoopCore::SetTaskBatch(size_t nBatch)
+{
+	m_nBatch = nBatch != 0 ? nBatch : LOOPCORE_TASK_BATCH;
+}
+
+/**
+ * @brief	取得投遞工作統計資訊
+ * @param	[out] statPtr	SSLOOPSTAT 結構指標
+ * @remark	可由任何執行緒調用, 由其他執行緒取得時數值為近似值.
+ */
+void DmLoopCore::GetTaskStats(LPSSLOOPSTAT statPtr)
+{
+	if (statPtr == NULL)
+		return;
+
+	statPtr->nPosted = m_nPosted;
+	statPtr->nExecuted = m_nExecuted;
+	statPtr->nDepth = statPtr->nPosted - statPtr->nExecuted;
+	if (statPtr->nDepth < 0) statPtr->nDepth = 0;
+	statPtr->nMaxDepth = m_nMaxDepth;
+	statPtr->nWakeups = m_nWakeups;
+	statPtr->nDrains = m_nDrains;
+	statPtr->nCoalesced = m_nCoalesced;
+	statPtr->nMerged = m_nMerged;
+	statPtr->llLatencyAvg = 0;
+	statPtr->llLatencyMax = 0;
+	if (m_llFrequency != 0) {
+		if (statPtr->nExecuted != 0)
+			statPtr->llLatencyAvg = m_llLatency / statPtr->nExecuted * 1000000 / m_llFrequency;
+		statPtr->llLatencyMax = m_llLatencyMax * 1000000 / m_llFrequency;
+	}
+}
+
+/**
+ * @brief	重設投遞工作統計資訊
+ * @remark	佇列深度以投遞與執行總數計算, 佇列中仍有工作時不重設這兩項.
+ */
+void DmLoopCore::ResetTaskStats()
+{
+	if (this->IsTaskEmpty()) {
+		::InterlockedExchange64(&m_nPosted, 0);
+		m_nExecuted = 0;
+	}
+	::InterlockedExchange64(&m_nWakeups, 0);
+	::InterlockedExchange64(&m_nCoalesced, 0);
+	::InterlockedExchange64(&m_nMerged, 0);
+	m_nMaxDepth = 0;
+	m_nDrains = 0;
+	m_llLatency = 0;
+	m_llLatencyMax = 0;
+}
+
+/**
+ * @brief	設定計時器
+ * @param	[in] dwDelay	第一次觸發延遲時間 (in ms)
+ * @param	[in] dwPeriod	週期 (in ms), 零(zero) 表示只觸發一次
+ * @param	[in] fnTaskPtr	計時器處理函數
+ * @param	[in] aParamPtr	計時器處理函數參數
+ * @return	@c 型別: UINT \n 計時器 ID, 參數錯誤返回零(zero)
+ * @remark	計時器數量很多時改用 DmTimerWheel (DmThread::GetTimerWheel).
+ */
+UINT DmLoopCore::SetTimer(DWORD dwDelay, DWORD dwPeriod, LPFNLOOPTASK fnTaskPtr, LPVOID aParamPtr)
+{
+	SSTIMER timer;
+
+	if (fnTaskPtr == NULL)
+		return 0;
+
+	if (++m_idNext == 0) ++m_idNext;
+	timer.ullDue = ::GetTickCount64() + dwDelay;
+	timer.dwPeriod = dwPeriod;
+	timer.idTimer = m_idNext;
+	timer.fnTaskPtr = fnTaskPtr;
+	timer.aParamPtr = aParamPtr;
+	m_aTimer.push_back(timer);
+	std::push_heap(m_aTimer.begin(), m_aTimer.end(), TimerLater);
+	return timer.idTimer;
+}
+
+/**
+ * @brief	移除計時器
+ * @param	[in] idTimer	計時器 ID
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero), 找不到計時器返回零(zero)
+ */
+BOOL DmLoopCore::KillTimer(UINT idTimer)
+{
+	for (size_t i = 0; i < m_aTimer.size(); ++i) {
+		if (m_aTimer[i].idTimer != idTimer)
+			continue;
+
+		m_aTimer[i] = m_aTimer.back();
+		m_aTimer.pop_back();
+		std::make_heap(m_aTimer.begin(), m_aTimer.end(), TimerLater);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/**
+ * @brief	等待核心物件
+ * @param	[in] hObject	核心物件 (事件、程序、執行緒、計時器等)
+ * @param	[in] fnWaitPtr	觸發時的處理函數
+ * @param	[in] aParamPtr	處理函數參數
+ * @return	@c 型別: UINT \n 等待 ID, 參數錯誤或超過等待數量上限返回零(zero)
+ * @remark	物件持續保持觸發狀態 (如 manual-reset 事件) 時, 每一輪都會調用處理函數, \n
+ *			處理函數需重設物件或調用 RemoveWait. 最多可等待 MAXIMUM_WAIT_OBJECTS - 1 個物件.
+ */
+UINT DmLoopCore::AddWait(HANDLE hObject, LPFNLOOPWAIT fnWaitPtr, LPVOID aParamPtr)
+{
+	SSWAIT wait;
+
+	if (hObject == NULL || fnWaitPtr == NULL || m_aHandle.empty() || m_aHandle.size() >= MAXIMUM_WAIT_OBJECTS)
+		return 0;
+
+	if (++m_idNext == 0) ++m_idNext;
+	wait.idWait = m_idNext;
+	wait.fnWaitPtr = fnWaitPtr;
+	wait.aParamPtr = aParamPtr;
+	m_aHandle.push_back(hObject);
+	m_aWait.push_back(wait);
+	return wait.idWait;
+}
+
+/**
+ * @brief	移除核心物件等待
+ * @param	[in] idWait	等待 ID
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero), 找不到等待項目返回零(zero)
+ */
+BOOL DmLoopCore::RemoveWait(UINT idWait)
+{
+	for (size_t i = 0; i < m_aWait.size(); ++i) {
+		if (m_aWait[i].idWait != idWait)
+			continue;
+
+		m_aWait.erase(m_aWait.begin() + i);
+		m_aHandle.erase(m_aHandle.begin() + i + 1);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/**
+ * @brief	設定訊息前置處理函數
+ * @param	[in] fnFilterPtr	前置處理函數 (如調用 IsDialogMessage), NULL 表示不使用
+ * @param	[in] aParamPtr		前置處理函數參數
+ */
+void DmLoopCore::SetMessageFilter(LPFNLOOPFILTER fnFilterPtr, LPVOID aParamPtr)
+{
+	m_fnFilterPtr = fnFilterPtr;
+	m_aFilterPtr = aParamPtr;
+}
+
+/**
+ * @brief	加入閒置處理函數
+ * @param	[in] fnIdlePtr	閒置處理函數, 返回 TRUE 表示尚有工作, 下一輪繼續調用
+ * @param	[in] aParamPtr	閒置處理函數參數
+ * @return	@c 型別: UINT \n 閒置處理 ID, 參數錯誤返回零(zero)
+ * @remark	閒置處理函數應將工作切分為小段, 並於 dwBudget 用完前返回.
+ */
+UINT DmLoopCore::AddIdle(LPFNLOOPIDLE fnIdlePtr, LPVOID aParamPtr)
+{
+	SSIDLE idle;
+
+	if (fnIdlePtr == NULL)
+		return 0;
+
+	if (++m_idNext == 0) ++m_idNext;
+	idle.idIdle = m_idNext;
+	idle.fnIdlePtr = fnIdlePtr;
+	idle.aParamPtr = aParamPtr;
+	idle.bMore = TRUE;
+	m_aIdle.push_back(idle);
+	m_bIdleMore = TRUE;
+	return idle.idIdle;
+}
+
+/**
+ * @brief	移除閒置處理函數
+ * @param	[in] idIdle	閒置處理 ID
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero), 找不到閒置處理項目返回零(zero)
+ */
+BOOL DmLoopCore::RemoveIdle(UINT idIdle)
+{
+	for (size_t i = 0; i < m_aIdle.size(); ++i) {
+		if (m_aIdle[i].idIdle != idIdle)
+			continue;
+
+		m_aIdle.erase(m_aIdle.begin() + i);
+		if (m_idxIdle >= m_aIdle.size())
+			m_idxIdle = 0;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/**
+ * @brief	設定每輪閒置處理時間上限
+ * @param	[in] dwBudget	時間上限 (in µs), 零(zero) 表示使用預設值 LOOPCORE_IDLE_BUDGET
+ */
+void DmLoopCore::SetIdleBudget(DWORD dwBudget)
+{
+	m_dwIdleBudget = dwBudget != 0 ? dwBudget : LOOPCORE_IDLE_BUDGET;
+}
+
+/**
+ * @brief	投遞工作節點
+ * @param	[in] fnTaskPtr	工作處理函數
+ * @param	[in] fnFreePtr	未執行即捨棄時的釋放函數, 可為 NULL
+ * @param	[in] aParamPtr	工作處理函數參數
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ * @remark	只有佇列由已處理轉為待處理時 (m_bSignal 由零變為非零) 才觸發喚醒事件.
+ */
+BOOL DmLoopCore::PushTask(LPFNLOOPTASK fnTaskPtr, LPFNLOOPTASK fnFreePtr, LPVOID aParamPtr)
+{
+	LARGE_INTEGER liNow;
+	SSTASK* taskPtr;
+
+	if (fnTaskPtr == NULL || m_hWake == NULL)
+		return FALSE;
+	if ((taskPtr = new (std::nothrow) SSTASK) == NULL)
+		return FALSE;
+
+	::QueryPerformanceCounter(&liNow);
+	taskPtr->fnTaskPtr = fnTaskPtr;
+	taskPtr->fnFreePtr = fnFreePtr;
+	taskPtr->aParamPtr = aParamPtr;
+	taskPtr->llPost = liNow.QuadPart;
+	::InterlockedIncrement64(&m_nPosted);
+	this->PushNode(taskPtr);
+
+	if (::InterlockedExchange(&m_bSignal, TRUE) == FALSE) {
+		::InterlockedIncrement64(&m_nWakeups);
+		::SetEvent(m_hWake);
+	}
+	return TRUE;
+}
+
+/**
+ * @brief	節點加入佇列 (生產者端, 可由多個執行緒同時調用)
+ * @param	[in] taskPtr	節點
+ */
+void DmLoopCore::PushNode(SSTASK* taskPtr)
+{
+	SSTASK* prevPtr;
+
+	taskPtr->nextPtr = NULL;
+	prevPtr = static_cast<SSTASK*>(::InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&m_headPtr), taskPtr));
+	prevPtr->nextPtr = taskPtr;
+}
+
+/**
+ * @brief	自佇列取出節點 (消費者端, 只能由迴圈執行緒調用)
+ * @return	@c 型別: SSTASK* \n
+ *			取出的節點 \n
+ *			佇列為空或生產者尚未完成連結返回 NULL
+ */
+DmLoopCore::SSTASK* DmLoopCore::PopNode()
+{
+	SSTASK* tailPtr = m_tailPtr;
+	SSTASK* nextPtr = tailPtr->nextPtr;
+
+	if (tailPtr == &m_stub) {
+		if (nextPtr == NULL)
+			return NULL;
+		m_tailPtr = tailPtr = nextPtr;
+		nextPtr = nextPtr->nextPtr;
+	}
+	if (nextPtr != NULL) {
+		m_tailPtr = nextPtr;
+		return tailPtr;
+	}
+
+	// 生產者已交換佇列頭但尚未連結, 留待下一輪
+	if (tailPtr != m_headPtr)
+		return NULL;
+
+	// 剩最後一個節點, 重新加入虛節點後才能取出
+	this->PushNode(&m_stub);
+	nextPtr = tailPtr->nextPtr;
+	if (nextPtr != NULL) {
+		m_tailPtr = nextPtr;
+		return tailPtr;
+	}
+	return NULL;
+}
+
+/**
+ * @brief	佇列是否為空
+ * @return	@c 型別: BOOL \n 佇列為空返回非零值(non-zero), 有工作或生產者尚未完成連結返回零(zero)
+ */
+BOOL DmLoopCore::IsTaskEmpty() const
+{
+	return m_tailPtr == &m_stub && m_headPtr == &m_stub;
+}
+
+//! 捨棄佇列中全部未執行的工作
+void DmLoopCore::FreeTasks()
+{
+	SSTASK* taskPtr;
+
+	while ((taskPtr = this->PopNode()) != NULL) {
+		if (taskPtr->fnFreePtr != NULL)
+			taskPtr->fnFreePtr(taskPtr->aParamPtr);
+		delete taskPtr;
+		++m_nExecuted;
+	}
+	::InterlockedExchange(&m_bSignal, FALSE);
+}
+
+/**
+ * @brief	計算等待時間
+ * @param	[in] dwTimeout	最長等待時間 (in ms)
+ * @return	@c 型別: DWORD \n 有待執行工作時為零, 否則為最近到期計時器與 dwTimeout 的較小值
+ */
+DWORD DmLoopCore::NextTimeout(DWORD dwTimeout)
+{
+	if (m_bSignal || m_bIdleMore)
+		return 0;
+
+	if (!m_aTimer.empty()) {
+		ULONGLONG ullNow = ::GetTickCount64();
+		ULONGLONG ullDue = m_aTimer.front().ullDue;
+		DWORD dwDue = ullDue <= ullNow ? 0 : static_cast<DWORD>(ullDue - ullNow);
+		if (dwDue < dwTimeout) dwTimeout = dwDue;
+	}
+	return dwTimeout;
+}
+
+/**
+ * @brief	處理佇列中的全部視窗訊息
+ * @return	@c 型別: BOOL \n 收到 WM_QUIT 返回零(zero), 否則返回非零值(non-zero)
+ */
+BOOL DmLoopCore::DispatchMessages()
+{
+	MSG message;
+
+	while (::PeekMessage(&message, NULL, 0, 0, PM_REMOVE)) {
+		if (message.message == WM_QUIT) {
+			m_iExitCode = static_cast<int>(message.wParam);
+			::InterlockedExchange(&m_bQuit, TRUE);
+			return FALSE;
+		}
+		if (m_fnFilterPtr != NULL && m_fnFilterPtr(m_aFilterPtr, &message))
+			continue;
+		::TranslateMessage(&message);
+		::DispatchMessage(&message);
+	}
+	return TRUE;
+}
+
+/**
+ * @brief	執行已到期的計時器
+ * @return	@c 型別: BOOL \n 有計時器到期返回非零值(non-zero)
+ */
+BOOL DmLoopCore::DispatchTimers()
+{
+	ULONGLONG ullNow;
+	BOOL bFired = FALSE;
+
+	if (m_aTimer.empty())
+		return FALSE;
+
+	ullNow = ::GetTickCount64();
+	while (!m_aTimer.empty() && m_aTimer.front().ullDue <= ullNow) {
+		std::pop_heap(m_aTimer.begin(), m_aTimer.end(), TimerLater);
+		SSTIMER timer = m_aTimer.back();
+
+		// 週期計時器以原到期時間計算下一次, 不累積延遲
+		if (timer.dwPeriod != 0) {
+			m_aTimer.back().ullDue += timer.dwPeriod;
+			if (m_aTimer.back().ullDue <= ullNow)
+				m_aTimer.back().ullDue = ullNow + timer.dwPeriod;
+			std::push_heap(m_aTimer.begin(), m_aTimer.end(), TimerLater);
+		}
+		else {
+			m_aTimer.pop_back();
+		}
+		bFired = TRUE;
+		timer.fnTaskPtr(timer.aParamPtr);
+	}
+	return bFired;
+}
+
+/**
+ * @brief	執行投遞的工作
+ * @remark	最多執行 m_nBatch 個工作. 佇列清空後才重設 m_bSignal, \n
+ *			重設後再次檢查佇列, 避免與投遞端競爭而遺漏喚醒.
+ */
+void DmLoopCore::DispatchTasks()
+{
+	LARGE_INTEGER liNow;
+	LONG64 nDepth;
+	size_t nCount;
+
+	if (!m_bSignal)
+		return;
+
+	::QueryPerformanceCounter(&liNow);
+	nDepth = m_nPosted - m_nExecuted;
+	if (nDepth > m_nMaxDepth) m_nMaxDepth = nDepth;
+	++m_nDrains;
+
+	for (nCount = 0; nCount < m_nBatch; ++nCount) {
+		SSTASK* taskPtr = this->PopNode();
+		if (taskPtr == NULL)
+			break;
+
+		LPFNLOOPTASK fnTaskPtr = taskPtr->fnTaskPtr;
+		LPVOID aParamPtr = taskPtr->aParamPtr;
+		LONGLONG llLatency = liNow.QuadPart - taskPtr->llPost;
+		delete taskPtr;
+
+		if (llLatency > 0) {
+			m_llLatency += llLatency;
+			if (llLatency > m_llLatencyMax) m_llLatencyMax = llLatency;
+		}
+		++m_nExecuted;
+		fnTaskPtr(aParamPtr);
+	}
+
+	if (nCount < m_nBatch) {
+		::InterlockedExchange(&m_bSignal, FALSE);
+		if (!this->IsTaskEmpty())
+			::InterlockedExchange(&m_bSignal, TRUE);
+	}
+}
+
+/**
+ * @brief	執行閒置處理
+ * @remark	自 m_idxIdle 開始輪流調用尚有工作的閒置處理函數, 直到全部完成或超過 m_dwIdleBudget. \n
+ *			每輪起始位置輪替, 避免耗時的處理函數佔用全部時間. 處理函數執行期間若有新訊息則提前結束.
+ */
+void DmLoopCore::DispatchIdle()
+{
+	LARGE_INTEGER liStart, liNow;
+	LONGLONG llBudget = static_cast<LONGLONG>(m_dwIdleBudget) * m_llFrequency / 1000000;
+	LONGLONG llUsed = 0;
+	BOOL bMore = TRUE;
+
+	::QueryPerformanceCounter(&liStart);
+	while (bMore && llUsed < llBudget) {
+		bMore = FALSE;
+		for (size_t n = 0; n < m_aIdle.size() && llUsed < llBudget; ++n) {
+			size_t idx = (m_idxIdle + n) % m_aIdle.size();
+			if (!m_aIdle[idx].bMore)
+				continue;
+
+			DWORD dwRemain = static_cast<DWORD>((llBudget - llUsed) * 1000000 / m_llFrequency);
+			SSIDLE idle = m_aIdle[idx];
+			BOOL bResult = idle.fnIdlePtr(idle.aParamPtr, dwRemain);
+
+			// 處理函數可能移除閒置處理項目, 以 ID 確認
+			if (idx < m_aIdle.size() && m_aIdle[idx].idIdle == idle.idIdle)
+				m_aIdle[idx].bMore = bResult;
+			bMore |= bResult;
+
+			::QueryPerformanceCounter(&liNow);
+			llUsed = liNow.QuadPart - liStart.QuadPart;
+		}
+		if (m_bMessage && HIWORD(::GetQueueStatus(QS_ALLINPUT)) != 0)
+			break;
+	}
+
+	m_idxIdle = m_aIdle.empty() ? 0 : (m_idxIdle + 1) % m_aIdle.size();
+	m_bIdleMore = FALSE;
+	for (size_t i = 0; i < m_aIdle.size(); ++i)
+		m_bIdleMore |= m_aIdle[i].bMore;
+}
+
+/**
+ * @brief	計時器堆積比較函數 (static)
+ * @return	@c 型別: bool, a 比 b 晚到期返回 true (使最早到期者位於堆積頂端)
+ */
+bool DmLoopCore::TimerLater(const SSTIMER& a, const SSTIMER& b) { return a.ullDue > b.ullDue; }
+
+/**
+ * @brief	執行合併項目 (佇列節點的處理函數)
+ * @param	[in] aParamPtr	SSCOALESCE 結構指標
+ * @remark	先自合併表移除再執行, 執行期間同鍵值的投遞會成為新的項目.
+ */
+void CALLBACK DmLoopCore::RunCoalesced(LPVOID aParamPtr)
+{
+	SSCOALESCE* itemPtr = static_cast<SSCOALESCE*>(aParamPtr);
+	DmLoopCore* loopPtr = itemPtr->loopPtr;
+	LPFNLOOPTASK fnTaskPtr;
+	LPVOID aTaskParamPtr;
+
+	::EnterCriticalSection(&loopPtr->m_csCoalesce);
+	fnTaskPtr = itemPtr->fnTaskPtr;
+	aTaskParamPtr = itemPtr->aParamPtr;
+	loopPtr->m_mapCoalesce.erase(COALESCEKEY(itemPtr->aTargetPtr, itemPtr->uKind));
+	::LeaveCriticalSection(&loopPtr->m_csCoalesce);
+
+	fnTaskPtr(aTaskParamPtr);
+}
+
+/**
+ * @brief	捨棄合併項目 (佇列節點的釋放函數)
+ * @param	[in] aParamPtr	SSCOALESCE 結構指標
+ */
+void CALLBACK DmLoopCore::FreeCoalesced(LPVOID aParamPtr)
+{
+	SSCOALESCE* itemPtr = static_cast<SSCOALESCE*>(aParamPtr);
+	DmLoopCore* loopPtr = itemPtr->loopPtr;
+	LPFNLOOPTASK fnFreePtr;
+	LPVOID aFreeParamPtr;
+
+	::EnterCriticalSection(&loopPtr->m_csCoalesce);
+	fnFreePtr = itemPtr->fnFreePtr;
+	aFreeParamPtr = itemPtr->aParamPtr;
+	loopPtr->m_mapCoalesce.erase(COALESCEKEY(itemPtr->aTargetPtr, itemPtr->uKind));
+	::LeaveCriticalSection(&loopPtr->m_csCoalesce);
+
+	if (fnFreePtr != NULL)
+		fnFreePtr(aFreeParamPtr);
+}
@@ -8,7 +8,14 @@
 #include "dmcframe/dmc_thread.hh"
 
 //! DmThread construct
-DmThread::DmThread() : DmObject() { }
+DmThread::DmThread()
+	: DmObject()
+	, m_loop()
+	, m_wheel()
+{
+	m_loop.Create(TRUE);
+	m_loop.SetMessageFilter(&DmThread::MessageFilter, this);
+}
 
 //! DmObject deconstruct
 DmThread::~DmThread() { }
@@ -25,44 +32,100 @@ int DmThread::MessageLoop(int bPreek)
 	return this->MessageLoopNormal();
 }
 
+/**
+ * @brief	取得事件迴圈核心
+ * @return	@c 型別: DmLoopCore*, 可設定計時器 (SetTimer) 或等待核心物件 (AddWait)
+ */
+DmLoopCore* DmThread::GetLoop() { return &m_loop; }
+
+/**
+ * @brief	取得執行緒的計時輪
+ * @return	@c 型別: DmTimerWheel* \n 建立失敗返回 NULL (包括 DmLoopCore 等待數量已滿)
+ * @remark	首次調用時建立, 只能由訊息迴圈所在執行緒調用. \n
+ *			大量計時器 (例如每個清單項目各自的動畫或逾時) 共用一個可等待計時器, \n
+ *			不佔用 WM_TIMER; 建立時以 AddWait 佔用 DmLoopCore 一個等待數量 (上限 MAXIMUM_WAIT_OBJECTS - 1), \n
+ *			之後計時器數量不論多少都不再增加.
+ */
+DmTimerWheel* DmThread::GetTimerWheel()
+{
+	if (!m_wheel.IsCreated() && !m_wheel.Create(&m_loop))
+		return NULL;
+	return &m_wheel;
+}
+
+/**
+ * @brief	投遞工作至執行緒的事件迴圈
+ * @param	[in] fnTaskPtr	工作處理函數
+ * @param	[in] aParamPtr	工作處理函數參數
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ * @remark	可由任何執行緒調用, 工作於訊息迴圈所在執行緒執行. \n
+ *			不佔用視窗訊息佇列, 大量投遞時只喚醒一次; 亦可投遞 lambda: PostTask([=]() { ... }).
+ */
+BOOL DmThread::PostTask(DmLoopCore::LPFNLOOPTASK fnTaskPtr, LPVOID aParamPtr)
+{
+	return m_loop.PostTask(fnTaskPtr, aParamPtr);
+}
+
+/**
+ * @brief	以合併鍵值 (hWnd, uMessage) 投遞視窗訊息至執行緒的事件迴圈
+ * @param	[in] hWnd		視窗 Handle
+ * @param	[in] uMessage	視窗訊息
+ * @param	[in] wParam		參數 1
+ * @param	[in] lParam		參數 2
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ * @remark	尚未處理前重複投遞的同一訊息只處理最後一次, 適用於 SetText, 進度更新等高頻率通知. \n
+ *			合併數量可由 GetLoop()->GetTaskStats 取得.
+ */
+BOOL DmThread::PostCoalescedMessage(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam)
+{
+	return m_loop.PostCoalescedMessage(hWnd, uMessage, wParam, lParam);
+}
+
 /**
  * @brief	視窗訊息迴圈
- * @remark	標準訊息迴圈，等待訊息及進行對應處理
+ * @remark	標準訊息迴圈，等待訊息、投遞工作、計時器及核心物件並進行對應處理
  * @return	@c 型別: int, 返回值為視窗結束碼
  */
 int DmThread::MessageLoopNormal()
 {
-	MSG message;
-
-	::memset(&message, 0, sizeof(message));
-	while (::GetMessage(&message, NULL, 0, 0)) {
-		::TranslateMessage(&message);
-		::DispatchMessage(&message);
-	}
-	return static_cast<int>(message.wParam);
+	return m_loop.Run();
 }
 
 /**
  * @brief	視窗訊息迴圈
- * @remark	訊息處理迴圈，不等等待訊息
+ * @remark	閒置處理迴圈，處理完訊息後於時間上限內執行閒置處理函數 (GetLoop()->AddIdle)，\n
+ *			閒置處理完成後等待下一個事件，不再以 PeekMessage 空轉
  * @return	@c 型別: int, 返回值為視窗結束碼
  */
 int DmThread::MessageLoopPeek()
 {
-	MSG message;
-
-	::memset(&message, 0, sizeof(message));
-	for (;;) {
-		while (::PeekMessage(&message, NULL, 0, 0, PM_REMOVE)) {
-			::TranslateMessage(&message);
-			::DispatchMessage(&message);
-		}
+	while (m_loop.RunOnce(INFINITE)) {
+		// Background Processing 由閒置處理函數執行
+	}
+	return m_loop.GetExitCode();
+}
 
-		if (message.message == WM_QUIT)
-			break;
+/**
+ * @brief	訊息前置處理 (於 TranslateMessage 之前調用)
+ * @param	[in] msgPtr	訊息
+ * @return	@c 型別: BOOL \n
+ *			訊息已處理返回非零值(non-zero), 不再轉送 \n
+ *			否則返回零(zero)
+ * @remark	衍生類別可覆寫, 例如調用 IsDialogMessage 處理非強制對話框.
+ */
+BOOL DmThread::PreTranslateMessage(MSG* msgPtr)
+{
+	UNREFERENCED_PARAMETER(msgPtr);
+	return FALSE;
+}
 
-		// TODO: 要處理動作項目 (如動態 UI，計時或遊戲)
-		// Background Processing
-	}
-	return static_cast<int>(message.wParam);
+/**
+ * @brief	事件迴圈訊息前置處理函數 (static)
+ * @param	[in] aParamPtr	DmThread 物件指標
+ * @param	[in] msgPtr		訊息
+ * @return	@c 型別: BOOL, 訊息已處理返回非零值(non-zero)
+ */
+BOOL CALLBACK DmThread::MessageFilter(LPVOID aParamPtr, MSG* msgPtr)
+{
+	return static_cast<DmThread*>(aParamPtr)->PreTranslateMessage(msgPtr);
 }
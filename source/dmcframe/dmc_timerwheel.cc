@@ -0,0 +1,612 @@
+﻿/**************************************************************************//**
+ * @file	dmc_timerwheel.cc
+ * @brief	階層式計時輪類別 - 成員函數
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "dmcframe/dmc_timerwheel.hh"
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION	0x00000002	// Windows 10 1803 以上支援
+#endif
+
+namespace {
+	const int		c_nSlots = 1 << TIMERWHEEL_SLOT_BITS;				//!< 每層槽位數量
+	const ULONGLONG	c_ullSlotMask = c_nSlots - 1;						//!< 槽位索引遮罩
+	const DWORD		c_idxMask = (1UL << TIMERWHEEL_INDEX_BITS) - 1;		//!< 計時器 ID 中的節點索引遮罩
+	const DWORD		c_genMask = (1UL << (32 - TIMERWHEEL_INDEX_BITS)) - 1;	//!< 計時器 ID 中的世代編號遮罩
+	const ULONGLONG	c_ullNever = ~0ULL;									//!< 系統計時器未設定
+
+	//! 最低位的 1 (ullValue 不可為零)
+	inline int LowBit(ULONGLONG ullValue)
+	{
+		unsigned long uBit;
+		if (_BitScanForward(&uBit, static_cast<unsigned long>(ullValue)))
+			return static_cast<int>(uBit);
+		_BitScanForward(&uBit, static_cast<unsigned long>(ullValue >> 32));
+		return static_cast<int>(uBit) + 32;
+	}
+
+	//! 最高位的 1 (ullValue 不可為零)
+	inline int HighBit(ULONGLONG ullValue)
+	{
+		unsigned long uBit;
+		if (_BitScanReverse(&uBit, static_cast<unsigned long>(ullValue >> 32)))
+			return static_cast<int>(uBit) + 32;
+		_BitScanReverse(&uBit, static_cast<unsigned long>(ullValue));
+		return static_cast<int>(uBit);
+	}
+}
+
+//! DmTimerWheel 建構式
+DmTimerWheel::DmTimerWheel()
+	: DmObject()
+	, m_loopPtr(NULL)
+	, m_hTimer(NULL)
+	, m_idWait(0)
+	, m_llFreq(0)
+	, m_ullCurrent(0)
+	, m_ullArmed(c_ullNever)
+	, m_idxFree(0)
+	, m_idxExpired(0)
+	, m_nCount(0)
+{
+	::memset(m_aHead, 0, sizeof(m_aHead));
+	::memset(m_aMask, 0, sizeof(m_aMask));
+	::memset(&m_stat, 0, sizeof(m_stat));
+}
+
+//! DmTimerWheel 解構式
+DmTimerWheel::~DmTimerWheel() { this->Close(); }
+
+/**
+ * @brief	建立計時輪
+ * @param	[in] loopPtr	執行計時器的事件迴圈
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			已建立, 參數錯誤, 建立系統計時器失敗或超過迴圈等待數量上限返回零(zero)
+ * @remark	必須由執行迴圈的執行緒調用.
+ */
+BOOL DmTimerWheel::Create(DmLoopCore* loopPtr)
+{
+	auto err = BOOL(TRUE);
+	LARGE_INTEGER liValue;
+
+	if (loopPtr == NULL || m_hTimer != NULL)
+		return FALSE;
+
+	for (;;) {
+		// 優先使用高解析度計時器, 系統不支援時改用一般計時器 (synchronization timer)
+		m_hTimer = ::CreateWaitableTimerEx(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (m_hTimer == NULL)
+			m_hTimer = ::CreateWaitableTimer(NULL, FALSE, NULL);
+		if (m_hTimer == NULL)
+			break;
+		if ((m_idWait = loopPtr->AddWait(m_hTimer, &DmTimerWheel::OnSignal, this)) == 0)
+			break;
+
+		::QueryPerformanceFrequency(&liValue);
+		m_llFreq = liValue.QuadPart;
+		m_loopPtr = loopPtr;
+		m_ullCurrent = this->GetNow();
+		m_ullArmed = c_ullNever;
+		m_aNode.assign(1, SSNODE());	// 索引零(zero) 不使用
+		::memset(&m_aNode[0], 0, sizeof(SSNODE));
+		err = FALSE;
+		break;
+	}
+
+	if (err && m_hTimer != NULL) {
+		::CloseHandle(m_hTimer);
+		m_hTimer = NULL;
+	}
+	return !err;
+}
+
+/**
+ * @brief	關閉計時輪
+ * @remark	移除全部計時器並釋放可呼叫物件, 必須由執行迴圈的執行緒調用.
+ */
+void DmTimerWheel::Close()
+{
+	if (m_hTimer == NULL)
+		return;
+
+	m_loopPtr->RemoveWait(m_idWait);
+	::CancelWaitableTimer(m_hTimer);
+	::CloseHandle(m_hTimer);
+	m_hTimer = NULL;
+	m_idWait = 0;
+	m_loopPtr = NULL;
+
+	for (size_t i = 1; i < m_aNode.size(); ++i) {
+		if (m_aNode[i].byState != STATE_FREE && m_aNode[i].fnFreePtr != NULL)
+			m_aNode[i].fnFreePtr(m_aNode[i].aParamPtr);
+	}
+	m_aNode.clear();
+	m_idxFree = 0;
+	m_idxExpired = 0;
+	m_nCount = 0;
+	::memset(m_aHead, 0, sizeof(m_aHead));
+	::memset(m_aMask, 0, sizeof(m_aMask));
+}
+
+/**
+ * @brief	是否已建立
+ * @return	@c 型別: BOOL \n 已建立返回非零值(non-zero)
+ */
+BOOL DmTimerWheel::IsCreated() const { return m_hTimer != NULL; }
+
+/**
+ * @brief	設定計時器
+ * @param	[in] dwDelay		第一次觸發的延遲 (in ms)
+ * @param	[in] dwPeriod		週期 (in ms), 零(zero) 表示只觸發一次
+ * @param	[in] fnTimerPtr		計時器處理函數
+ * @param	[in] aParamPtr		計時器處理函數參數
+ * @param	[in] dwTolerance	容許延遲 (in ms), 大於零時可與其他計時器合併觸發
+ * @return	@c 型別: UINT \n 計時器 ID, 未建立, 參數錯誤或超過計時器數量上限返回零(zero)
+ * @remark	計時器 ID 含世代編號, 計時器移除後舊 ID 不會誤移除重複使用的節點.
+ */
+UINT DmTimerWheel::SetTimer(DWORD dwDelay, DWORD dwPeriod, LPFNTIMER fnTimerPtr, LPVOID aParamPtr, DWORD dwTolerance)
+{
+	return this->AddTimer(dwDelay, dwPeriod, fnTimerPtr, NULL, aParamPtr, dwTolerance);
+}
+
+/**
+ * @brief	重新設定計時器的下一次觸發時間
+ * @param	[in] idTimer	計時器 ID
+ * @param	[in] dwDelay	由現在起算的延遲 (in ms)
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero), 找不到計時器返回零(zero)
+ * @remark	適用於逾時偵測: 每次收到資料即延後, 不需移除再設定. 單次計時器於處理函數中調用時會再觸發一次.
+ */
+BOOL DmTimerWheel::ResetTimer(UINT idTimer, DWORD dwDelay)
+{
+	DWORD idxNode = this->FindNode(idTimer);
+
+	if (idxNode == 0)
+		return FALSE;
+
+	SSNODE& node = m_aNode[idxNode];
+	if (node.byState == STATE_RUNNING) {
+		node.ullDue = this->GetNow() + dwDelay;
+		node.byRearm = TRUE;
+		return TRUE;
+	}
+
+	this->UnlinkNode(idxNode);
+	this->Schedule(idxNode, this->GetNow() + dwDelay);
+	if (m_aNode[idxNode].ullExpire < m_ullArmed)
+		this->Arm();
+	return TRUE;
+}
+
+/**
+ * @brief	移除計時器
+ * @param	[in] idTimer	計時器 ID
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero), 找不到計時器返回零(zero)
+ * @remark	可於處理函數中移除自己, 處理函數返回後才釋放可呼叫物件.
+ */
+BOOL DmTimerWheel::KillTimer(UINT idTimer)
+{
+	DWORD idxNode = this->FindNode(idTimer);
+
+	if (idxNode == 0)
+		return FALSE;
+
+	++m_stat.nKilled;
+	if (m_aNode[idxNode].byState == STATE_RUNNING) {
+		m_aNode[idxNode].byState = STATE_KILLED;
+		return TRUE;
+	}
+	this->UnlinkNode(idxNode);
+	this->ReleaseNode(idxNode);
+	return TRUE;
+}
+
+/**
+ * @brief	取得計時器數量
+ * @return	@c 型別: size_t
+ */
+size_t DmTimerWheel::GetCount() const { return m_nCount; }
+
+/**
+ * @brief	取得統計資訊
+ * @param	[out] statPtr	SSWHEELSTAT 結構指標
+ */
+void DmTimerWheel::GetStats(LPSSWHEELSTAT statPtr)
+{
+	if (statPtr == NULL)
+		return;
+
+	*statPtr = m_stat;
+	statPtr->nActive = static_cast<LONG64>(m_nCount);
+}
+
+/**
+ * @brief	加入計時器
+ * @param	[in] dwDelay		第一次觸發的延遲 (in ms)
+ * @param	[in] dwPeriod		週期 (in ms)
+ * @param	[in] fnTimerPtr		計時器處理函數
+ * @param	[in] fnFreePtr		計時器移除後的釋放函數, NULL 表示不需釋放
+ * @param	[in] aParamPtr		計時器處理函數參數
+ * @param	[in] dwTolerance	容許延遲 (in ms)
+ * @return	@c 型別: UINT \n 計時器 ID, 失敗返回零(zero)
+ */
+UINT DmTimerWheel::AddTimer(DWORD dwDelay, DWORD dwPeriod, LPFNTIMER fnTimerPtr, LPFNTIMER fnFreePtr, LPVOID aParamPtr, DWORD dwTolerance)
+{
+	DWORD idxNode;
+
+	if (m_hTimer == NULL || fnTimerPtr == NULL)
+		return 0;
+	if ((idxNode = this->AllocNode()) == 0)
+		return 0;
+
+	SSNODE& node = m_aNode[idxNode];
+	node.byState = STATE_ACTIVE;
+	node.dwPeriod = dwPeriod;
+	node.dwTolerance = dwTolerance;
+	node.fnTimerPtr = fnTimerPtr;
+	node.fnFreePtr = fnFreePtr;
+	node.aParamPtr = aParamPtr;
+	++m_nCount;
+	++m_stat.nSet;
+
+	this->Schedule(idxNode, this->GetNow() + dwDelay);
+	if (m_aNode[idxNode].ullExpire < m_ullArmed)
+		this->Arm();
+	return (static_cast<UINT>(m_aNode[idxNode].wGen & c_genMask) << TIMERWHEEL_INDEX_BITS) | idxNode;
+}
+
+/**
+ * @brief	由計時器 ID 取得節點索引
+ * @param	[in] idTimer	計時器 ID
+ * @return	@c 型別: DWORD \n 節點索引, 計時器不存在或已移除返回零(zero)
+ */
+DWORD DmTimerWheel::FindNode(UINT idTimer) const
+{
+	DWORD idxNode = idTimer & c_idxMask;
+
+	if (idxNode == 0 || idxNode >= m_aNode.size())
+		return 0;
+
+	const SSNODE& node = m_aNode[idxNode];
+	if (node.byState == STATE_FREE || node.byState == STATE_KILLED)
+		return 0;
+	if ((node.wGen & c_genMask) != (idTimer >> TIMERWHEEL_INDEX_BITS))
+		return 0;
+	return idxNode;
+}
+
+/**
+ * @brief	配置節點
+ * @return	@c 型別: DWORD \n 節點索引, 超過數量上限或配置記憶體失敗返回零(zero)
+ */
+DWORD DmTimerWheel::AllocNode()
+{
+	DWORD idxNode = m_idxFree;
+	WORD wGen;
+
+	if (idxNode != 0) {
+		m_idxFree = m_aNode[idxNode].idxNext;
+		wGen = m_aNode[idxNode].wGen;
+	}
+	else {
+		if (m_aNode.size() > c_idxMask)
+			return 0;
+		idxNode = static_cast<DWORD>(m_aNode.size());
+		m_aNode.push_back(SSNODE());
+		wGen = 0;
+	}
+
+	::memset(&m_aNode[idxNode], 0, sizeof(SSNODE));
+	m_aNode[idxNode].wGen = wGen;
+	m_aNode[idxNode].wList = LIST_NONE;
+	return idxNode;
+}
+
+/**
+ * @brief	釋放節點, 並調用釋放函數
+ * @param	[in] idxNode	節點索引 (已不在任何串列)
+ */
+void DmTimerWheel::ReleaseNode(DWORD idxNode)
+{
+	SSNODE& node = m_aNode[idxNode];
+	LPFNTIMER fnFreePtr = node.fnFreePtr;
+	LPVOID aParamPtr = node.aParamPtr;
+
+	node.byState = STATE_FREE;
+	node.fnTimerPtr = NULL;
+	node.fnFreePtr = NULL;
+	node.aParamPtr = NULL;
+	++node.wGen;
+	node.idxNext = m_idxFree;
+	m_idxFree = idxNode;
+	--m_nCount;
+
+	if (fnFreePtr != NULL)
+		fnFreePtr(aParamPtr);
+}
+
+/**
+ * @brief	依預定時間與容許延遲計算到期時間, 並放入計時輪
+ * @param	[in] idxNode	節點索引 (不在任何串列)
+ * @param	[in] ullDue		預定時間 (in ms)
+ * @remark	到期時間對齊至不超過容許延遲的最大 2 的次方邊界, 對齊後不會晚於 ullDue + dwTolerance.
+ */
+void DmTimerWheel::Schedule(DWORD idxNode, ULONGLONG ullDue)
+{
+	SSNODE& node = m_aNode[idxNode];
+	ULONGLONG ullExpire = ullDue;
+
+	if (node.dwTolerance != 0) {
+		ULONGLONG ullAlign = 1ULL << HighBit(static_cast<ULONGLONG>(node.dwTolerance) + 1);
+		ullExpire = (ullDue + ullAlign - 1) & ~(ullAlign - 1);
+	}
+	node.ullDue = ullDue;
+	node.ullExpire = ullExpire < m_ullCurrent ? m_ullCurrent : ullExpire;
+	this->Place(idxNode);
+}
+
+/**
+ * @brief	依到期時間放入對應層的槽位
+ * @param	[in] idxNode	節點索引 (不在任何串列)
+ * @remark	層數為到期時間與目前時間最高的相異位元所在群組, \n
+ *			同一層中到期時間的槽位必定不早於目前時間的槽位, 不需處理繞回.
+ */
+void DmTimerWheel::Place(DWORD idxNode)
+{
+	ULONGLONG ullExpire = m_aNode[idxNode].ullExpire;
+	ULONGLONG ullDiff = ullExpire ^ m_ullCurrent;
+	int iLevel = ullDiff == 0 ? 0 : HighBit(ullDiff) / TIMERWHEEL_SLOT_BITS;
+	int iSlot = static_cast<int>((ullExpire >> (iLevel * TIMERWHEEL_SLOT_BITS)) & c_ullSlotMask);
+
+	this->LinkNode(idxNode, static_cast<WORD>(iLevel * c_nSlots + iSlot));
+}
+
+/**
+ * @brief	將節點加入串列開頭
+ * @param	[in] idxNode	節點索引 (不在任何串列)
+ * @param	[in] wList		串列: 層 * 64 + 槽, 或 LIST_EXPIRED
+ */
+void DmTimerWheel::LinkNode(DWORD idxNode, WORD wList)
+{
+	SSNODE& node = m_aNode[idxNode];
+	DWORD* idxHeadPtr;
+
+	if (wList == LIST_EXPIRED) {
+		idxHeadPtr = &m_idxExpired;
+	}
+	else {
+		idxHeadPtr = &m_aHead[wList / c_nSlots][wList % c_nSlots];
+		m_aMask[wList / c_nSlots] |= 1ULL << (wList % c_nSlots);
+	}
+
+	node.wList = wList;
+	node.idxPrev = 0;
+	node.idxNext = *idxHeadPtr;
+	if (*idxHeadPtr != 0)
+		m_aNode[*idxHeadPtr].idxPrev = idxNode;
+	*idxHeadPtr = idxNode;
+}
+
+/**
+ * @brief	將節點移出所在串列
+ * @param	[in] idxNode	節點索引
+ */
+void DmTimerWheel::UnlinkNode(DWORD idxNode)
+{
+	SSNODE& node = m_aNode[idxNode];
+	WORD wList = node.wList;
+
+	if (wList == LIST_NONE)
+		return;
+
+	if (node.idxNext != 0)
+		m_aNode[node.idxNext].idxPrev = node.idxPrev;
+	if (node.idxPrev != 0) {
+		m_aNode[node.idxPrev].idxNext = node.idxNext;
+	}
+	else if (wList == LIST_EXPIRED) {
+		m_idxExpired = node.idxNext;
+	}
+	else {
+		m_aHead[wList / c_nSlots][wList % c_nSlots] = node.idxNext;
+		if (node.idxNext == 0)
+			m_aMask[wList / c_nSlots] &= ~(1ULL << (wList % c_nSlots));
+	}
+
+	node.wList = LIST_NONE;
+	node.idxPrev = 0;
+	node.idxNext = 0;
+}
+
+/**
+ * @brief	處理至 ullNow (含) 為止的全部事件
+ * @param	[in] ullNow	目前時間 (in ms)
+ * @remark	每次直接跳至下一個事件 (槽位到期或上層移至下層), 沒有事件的時間不處理.
+ */
+void DmTimerWheel::Advance(ULONGLONG ullNow)
+{
+	ULONGLONG ullTick;
+
+	while (this->NextEvent(&ullTick) && ullTick <= ullNow) {
+		m_ullCurrent = ullTick;
+
+		// 由上層往下處理, 移下的計時器若落在同一時間的下層槽位, 於同一輪繼續處理
+		for (int iLevel = TIMERWHEEL_LEVELS - 1; iLevel > 0; --iLevel) {
+			int iShift = iLevel * TIMERWHEEL_SLOT_BITS;
+			if (iShift < 64 && (m_ullCurrent & ((1ULL << iShift) - 1)) == 0)
+				this->Cascade(iLevel, static_cast<int>((m_ullCurrent >> iShift) & c_ullSlotMask));
+		}
+
+		int iSlot = static_cast<int>(m_ullCurrent & c_ullSlotMask);
+		DWORD idxNode;
+		while ((idxNode = m_aHead[0][iSlot]) != 0) {
+			this->UnlinkNode(idxNode);
+			this->LinkNode(idxNode, LIST_EXPIRED);
+		}
+
+		// 先前進再執行處理函數, 處理函數中設定的已到期計時器於下一毫秒觸發
+		m_ullCurrent = ullTick + 1;
+		this->RunExpired();
+	}
+
+	if (m_ullCurrent < ullNow)
+		m_ullCurrent = ullNow;
+}
+
+/**
+ * @brief	將上層槽位的計時器移至下層
+ * @param	[in] iLevel	層
+ * @param	[in] iSlot	槽位
+ */
+void DmTimerWheel::Cascade(int iLevel, int iSlot)
+{
+	DWORD idxNode;
+
+	while ((idxNode = m_aHead[iLevel][iSlot]) != 0) {
+		this->UnlinkNode(idxNode);
+		this->Place(idxNode);
+		++m_stat.nCascaded;
+	}
+}
+
+/**
+ * @brief	執行到期串列中的計時器
+ * @remark	處理函數可設定, 重設或移除任何計時器 (包含自己); \n
+ *			節點陣列可能因此擴充, 處理函數返回後以索引重新取得節點.
+ */
+void DmTimerWheel::RunExpired()
+{
+	DWORD idxNode;
+
+	while ((idxNode = m_idxExpired) != 0) {
+		this->UnlinkNode(idxNode);
+		m_aNode[idxNode].byState = STATE_RUNNING;
+		++m_stat.nFired;
+		m_aNode[idxNode].fnTimerPtr(m_aNode[idxNode].aParamPtr);
+		if (m_hTimer == NULL)
+			return;	// 處理函數中調用了 Close
+
+		SSNODE& node = m_aNode[idxNode];
+		if (node.byState == STATE_KILLED) {
+			this->ReleaseNode(idxNode);
+		}
+		else if (node.byRearm) {
+			node.byRearm = FALSE;
+			node.byState = STATE_ACTIVE;
+			this->Schedule(idxNode, node.ullDue);
+		}
+		else if (node.dwPeriod != 0) {
+			// 週期計時器以原預定時間計算下一次, 不累積延遲; 落後超過一個週期時不補觸發
+			ULONGLONG ullDue = node.ullDue + node.dwPeriod;
+			if (ullDue < m_ullCurrent)
+				ullDue = m_ullCurrent - 1 + node.dwPeriod;
+			node.byState = STATE_ACTIVE;
+			this->Schedule(idxNode, ullDue);
+		}
+		else {
+			this->ReleaseNode(idxNode);
+		}
+	}
+}
+
+/**
+ * @brief	取得下一個事件的時間
+ * @param	[out] ullTickPtr	事件時間 (in ms)
+ * @return	@c 型別: BOOL \n 有事件返回非零值(non-zero), 計時輪為空返回零(zero)
+ * @remark	目前時間恰為上層槽位起點且該槽尚未移至下層時, 事件即為目前時間; \n
+ *			否則由下層往上找, 下層的事件必定早於上層, 找到即返回.
+ */
+BOOL DmTimerWheel::NextEvent(ULONGLONG* ullTickPtr) const
+{
+	int iCurrent;
+	ULONGLONG ullMask;
+
+	for (int iLevel = 1; iLevel < TIMERWHEEL_LEVELS; ++iLevel) {
+		int iShift = iLevel * TIMERWHEEL_SLOT_BITS;
+		if (iShift >= 64 || (m_ullCurrent & ((1ULL << iShift) - 1)) != 0)
+			break;
+		iCurrent = static_cast<int>((m_ullCurrent >> iShift) & c_ullSlotMask);
+		if ((m_aMask[iLevel] & (1ULL << iCurrent)) != 0) {
+			*ullTickPtr = m_ullCurrent;
+			return TRUE;
+		}
+	}
+
+	iCurrent = static_cast<int>(m_ullCurrent & c_ullSlotMask);
+	ullMask = m_aMask[0] & (~0ULL << iCurrent);
+	if (ullMask != 0) {
+		*ullTickPtr = (m_ullCurrent & ~c_ullSlotMask) | static_cast<ULONGLONG>(LowBit(ullMask));
+		return TRUE;
+	}
+
+	for (int iLevel = 1; iLevel < TIMERWHEEL_LEVELS; ++iLevel) {
+		int iShift = iLevel * TIMERWHEEL_SLOT_BITS;
+		if (iShift >= 64)
+			break;
+
+		iCurrent = static_cast<int>((m_ullCurrent >> iShift) & c_ullSlotMask);
+		ullMask = iCurrent == c_nSlots - 1 ? 0 : m_aMask[iLevel] & (~0ULL << (iCurrent + 1));
+		if (ullMask == 0)
+			continue;
+
+		ULONGLONG ullHigh = iShift + TIMERWHEEL_SLOT_BITS >= 64 ? 0 : (m_ullCurrent >> (iShift + TIMERWHEEL_SLOT_BITS)) << (iShift + TIMERWHEEL_SLOT_BITS);
+		*ullTickPtr = ullHigh | (static_cast<ULONGLONG>(LowBit(ullMask)) << iShift);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+//! 依下一個事件設定系統計時器, 計時輪為空時取消
+void DmTimerWheel::Arm()
+{
+	ULONGLONG ullTick;
+	ULONGLONG ullNow;
+	LARGE_INTEGER liDue;
+
+	if (!this->NextEvent(&ullTick)) {
+		if (m_ullArmed != c_ullNever)
+			::CancelWaitableTimer(m_hTimer);
+		m_ullArmed = c_ullNever;
+		return;
+	}
+	if (ullTick == m_ullArmed)
+		return;
+
+	// 相對時間以 100 ns 為單位, 負值表示相對現在
+	ullNow = this->GetNow();
+	liDue.QuadPart = ullTick > ullNow ? -static_cast<LONGLONG>(ullTick - ullNow) * 10000 : -1;
+	::SetWaitableTimer(m_hTimer, &liDue, 0, NULL, NULL, FALSE);
+	m_ullArmed = ullTick;
+}
+
+/**
+ * @brief	取得目前時間
+ * @return	@c 型別: ULONGLONG \n 目前時間 (in ms), 以 QueryPerformanceCounter 計算
+ */
+ULONGLONG DmTimerWheel::GetNow() const
+{
+	LARGE_INTEGER liNow;
+
+	::QueryPerformanceCounter(&liNow);
+	return static_cast<ULONGLONG>(liNow.QuadPart / m_llFreq) * 1000 + static_cast<ULONGLONG>(liNow.QuadPart % m_llFreq) * 1000 / m_llFreq;
+}
+
+/**
+ * @brief	系統計時器觸發 (static)
+ * @param	[in] aParamPtr	DmTimerWheel 物件指標
+ * @param	[in] hObject	系統計時器
+ */
+void CALLBACK DmTimerWheel::OnSignal(LPVOID aParamPtr, HANDLE hObject)
+{
+	DmTimerWheel* thisPtr = static_cast<DmTimerWheel*>(aParamPtr);
+
+	UNREFERENCED_PARAMETER(hObject);
+	++thisPtr->m_stat.nWakeups;
+	thisPtr->m_ullArmed = c_ullNever;
+	thisPtr->Advance(thisPtr->GetNow());
+	if (thisPtr->m_hTimer != NULL)
+		thisPtr->Arm();
+}
@@ -16,7 +16,11 @@ DmWinApp::DmWinApp() : DmThread(), m_hInstance(NULL), m_hResource(NULL), m_fnCal
 }
 
 //! DmWinApp destructor
-DmWinApp::~DmWinApp() { }
+DmWinApp::~DmWinApp()
+{
+	// Iu@, Bzi뻼ܨƥj
+	m_pool.Close();
+}
 
 BOOL DmWinApp::IsReady() const
 {
@@ -48,6 +52,23 @@ HINSTANCE DmWinApp::GetInstanceHandle() const { return m_hInstance; }
  */
 HINSTANCE DmWinApp::GetResourceHandle() const { return m_hResource; }
 
+/**
+ * @brief	oIu@
+ * @return	@c O: CxFrameTaskPool* \n
+ *			Iu@, Lkإߪ^ NULL
+ * @remark	Ĥ@եήɫإ, u@ƶqBzƶq@ (Od UI ), ܤ֬ 1. \n
+ *			 UI ե.
+ */
+CxFrameTaskPool* DmWinApp::GetPool()
+{
+	if (!m_pool.IsCreated()) {
+		DWORD nThreads = CxFrameTaskPool::GetProcessorCount();
+		if (!m_pool.Create(nThreads > 1 ? nThreads - 1 : 1))
+			return NULL;
+	}
+	return &m_pool;
+}
+
 
 /**
  * @brief	]w Callback function
@@ -120,4 +141,4 @@ DmWinApp* DmWinApp::SetnGetThis(DmWinApp* thisPtr)
 	return dmWinAppPtr;
 }
 
-DmWinApp& GetAPP() { DmWinApp::SetnGetThis(); }
+DmWinApp& GetAPP() { return *DmWinApp::SetnGetThis(); }
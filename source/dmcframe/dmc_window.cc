@@ -6,17 +6,29 @@
  * @author	Swang
  *****************************************************************************/
 #include "dmcframe/dmc_window.hh"
+#include "win32frame/wframe_thunk.hh"
+#include "axeen/axeen_profile.hh"
 
 //! DmWindow constructor
 DmWindow::DmWindow()
 	: DmObject()
 	, m_hWnd(NULL)
 	, m_fnPrevWndProc(NULL)
-	, m_bAttach(FALSE) {
+	, m_bAttach(FALSE)
+	, m_bThunk(FALSE)
+	, m_thunkPtr(NULL)
+	, m_tokenPtr(NULL) {
 }
 
 //! DmWindow deconstructor
-DmWindow::~DmWindow() { }
+DmWindow::~DmWindow()
+{
+	if (m_tokenPtr != NULL) {
+		m_tokenPtr->Cancel();
+		m_tokenPtr->Release();
+		m_tokenPtr = NULL;
+	}
+}
 
 /**
  * @brief	連接一個新的視窗(控制項)
@@ -89,8 +101,13 @@ HWND DmWindow::Detach()
 		}
 
 		hWnd = this->GetSafeHwnd();
-		::SetWindowLongPtr(hWnd, GWLP_USERDATA, 0);
-		::SetWindowLongPtr(hWnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(fncc));
+		if (m_thunkPtr != NULL) {
+			this->RemoveThunk(hWnd);
+		}
+		else {
+			::SetWindowLongPtr(hWnd, GWLP_USERDATA, 0);
+			::SetWindowLongPtr(hWnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(fncc));
+		}
 		m_hWnd = NULL;
 		m_bAttach = FALSE;
 		m_fnPrevWndProc = NULL;
@@ -99,6 +116,45 @@ HWND DmWindow::Detach()
 	return hWnd;
 }
 
+/**
+ * @brief	設定是否使用跳板 (thunk) 分派訊息
+ * @param	[in] bThunk	TRUE = 使用跳板, FALSE = 使用 GWLP_USERDATA (預設)
+ * @return	@c 型別: BOOL \n
+ *			設定成功返回非零值(nonzero) \n
+ *			已連接視窗時無法變更, 返回零(zero)
+ * @remark	必須於 Attach 或建立視窗前設定. \n
+ *			跳板模式將 this 直接綁定於視窗的 WNDPROC, 每個訊息不需 GetWindowLongPtr 查詢物件, \n
+ *			且 GWLP_USERDATA 保留給應用程式使用. 無法配置跳板時 (如系統禁止動態程式碼) 自動改用 GWLP_USERDATA.
+ */
+BOOL DmWindow::SetThunkMode(BOOL bThunk)
+{
+	if (this->IsWindow())
+		return FALSE;
+	m_bThunk = bThunk;
+	return TRUE;
+}
+
+/**
+ * @brief	是否正以跳板 (thunk) 分派訊息
+ * @return	@c 型別: BOOL \n 已安裝跳板返回非零值(nonzero)
+ */
+BOOL DmWindow::IsThunkMode() const { return m_thunkPtr != NULL; }
+
+/**
+ * @brief	取得目前視窗的取消標記
+ * @return	@c 型別: DmCancelToken* \n
+ *			取消標記, 不增加參考計數; 需要保留時由調用者調用 AddRef \n
+ *			沒有視窗或配置記憶體失敗返回 NULL
+ * @remark	每個視窗實體一個標記: 建立視窗 (WM_CREATE 或 Attach) 時建立新的標記, \n
+ *			視窗結束 (DeathOfWindow) 時設為已取消並釋放; 同一物件再建立的視窗使用新的標記. \n
+ *			非同步工作 (如 DmTask 協程) 取得後調用 AddRef 保留, 以此判斷綁定的視窗是否仍然存在. \n
+ *			由 UI 執行緒以外調用時, 視窗不可同時結束.
+ */
+DmCancelToken* DmWindow::GetCancelToken()
+{
+	return m_tokenPtr;
+}
+
 //! 摧毀視窗
 void DmWindow::Destroy()
 {
@@ -1385,13 +1441,23 @@ void DmWindow::DeathOfWindow()
 	assert(this->IsWindow());
 
 	if (hWnd != NULL) {
-		if (m_fnPrevWndProc != NULL) {
+		if (m_thunkPtr != NULL) {
+			this->RemoveThunk(hWnd);
+		}
+		else if (m_fnPrevWndProc != NULL) {
 			::SetWindowLongPtr(hWnd, GWLP_USERDATA, 0);
 			::SetWindowLongPtr(hWnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(m_fnPrevWndProc));
 		}
 		m_hWnd = NULL;
 		m_fnPrevWndProc = NULL;
 	}
+
+	// 取消與此視窗綁定的非同步工作, 已綁定的工作各自持有參考
+	if (m_tokenPtr != NULL) {
+		m_tokenPtr->Cancel();
+		m_tokenPtr->Release();
+		m_tokenPtr = NULL;
+	}
 }
 
 /**
@@ -1399,7 +1465,7 @@ void DmWindow::DeathOfWindow()
  * @param	[in] hWnd 視窗(控制項)操作 Handle
  * @remark	這是私有成員，僅供 DmWindow 內部運算用。
  */
-DmWindow::DmWindow(HWND hWnd) : m_hWnd(NULL), m_fnPrevWndProc(NULL), m_bAttach(FALSE)
+DmWindow::DmWindow(HWND hWnd) : m_hWnd(NULL), m_fnPrevWndProc(NULL), m_bAttach(FALSE), m_bThunk(FALSE), m_thunkPtr(NULL), m_tokenPtr(NULL)
 {
 	if (hWnd == NULL) {
 		// error handling at here
@@ -1419,11 +1485,60 @@ void DmWindow::AttachToClass(HWND hWnd)
 	if (::IsWindow(hWnd)) {
 		m_hWnd = hWnd;
 		m_bAttach = TRUE;
+		this->RenewCancelToken();
+		if (m_bThunk && this->InstallThunk(hWnd))
+			return;
 		::SetWindowLongPtr(hWnd, GWLP_USERDATA, (LONG_PTR)this);
 		m_fnPrevWndProc = reinterpret_cast<WNDPROC>(::SetWindowLongPtr(hWnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(DmWindow::StaticWindowProc)));
 	}
 }
 
+/**
+ * @brief	為新的視窗實體建立取消標記
+ * @remark	於 UI 執行緒建立視窗時調用; 仍保留的舊標記 (未經 DeathOfWindow) 設為已取消並釋放.
+ */
+void DmWindow::RenewCancelToken()
+{
+	if (m_tokenPtr != NULL) {
+		m_tokenPtr->Cancel();
+		m_tokenPtr->Release();
+	}
+	m_tokenPtr = DmCancelToken::Create();
+}
+
+/**
+ * @brief	配置跳板並設為視窗的 WNDPROC
+ * @param	[in] hWnd 視窗或控制項操作 Handle
+ * @return	@c 型別: BOOL \n 安裝成功返回非零值(nonzero), 無法配置跳板返回零(zero)
+ * @remark	由 DmWinApp 註冊類別建立的視窗, 原 WNDPROC 為 StaticWindowProc, 不保存於 m_fnPrevWndProc.
+ */
+BOOL DmWindow::InstallThunk(HWND hWnd)
+{
+	WNDPROC fnPrev;
+
+	m_thunkPtr = CxFrameThunkPool::Shared().Alloc(this, reinterpret_cast<LPCVOID>(&DmWindow::ThunkWindowProc));
+	if (m_thunkPtr == NULL)
+		return FALSE;
+
+	fnPrev = reinterpret_cast<WNDPROC>(::SetWindowLongPtr(hWnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(m_thunkPtr)));
+	m_fnPrevWndProc = fnPrev != DmWindow::StaticWindowProc ? fnPrev : NULL;
+	return TRUE;
+}
+
+/**
+ * @brief	還原視窗的 WNDPROC 並釋放跳板
+ * @param	[in] hWnd 視窗或控制項操作 Handle
+ * @remark	先還原 WNDPROC 再釋放, 之後的訊息 (如 WM_NCDESTROY) 不會再經過跳板.
+ */
+void DmWindow::RemoveThunk(HWND hWnd)
+{
+	WNDPROC fnRestore = m_fnPrevWndProc != NULL ? m_fnPrevWndProc : DmWindow::StaticWindowProc;
+
+	::SetWindowLongPtr(hWnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(fnRestore));
+	CxFrameThunkPool::Shared().Free(m_thunkPtr);
+	m_thunkPtr = NULL;
+}
+
 /**
  * @brief	視窗訊息處理 Callback function
  * @param	[in] hWnd		視窗 Handle
@@ -1438,11 +1553,18 @@ LRESULT DmWindow::StaticWindowProc(HWND hWnd, UINT uMessage, WPARAM wParam, LPAR
 {
 	DmWindow* fmObj = NULL;
 
+	AXEEN_PROFILE_MESSAGE(hWnd, uMessage, wParam);
+
 	// If use CreateWindow() or CreateWindowEx create a window will be have this message
 	if (uMessage == WM_CREATE) {
 		fmObj = (DmWindow*)((LPCREATESTRUCT)lParam)->lpCreateParams;
 		if (fmObj != NULL) {
 			fmObj->m_hWnd = hWnd;
+			fmObj->RenewCancelToken();
+
+			// 跳板模式: 之後的訊息直接經由跳板分派, 不使用 GWLP_USERDATA
+			if (fmObj->m_bThunk && fmObj->InstallThunk(hWnd))
+				return fmObj->WndProc(uMessage, wParam, lParam);
 			::SetWindowLongPtr(hWnd, GWLP_USERDATA, (LONG_PTR)fmObj);
 		}
 	}
@@ -1456,3 +1578,20 @@ LRESULT DmWindow::StaticWindowProc(HWND hWnd, UINT uMessage, WPARAM wParam, LPAR
 	return fmObj->WndProc(uMessage, wParam, lParam);
 }
 
+/**
+ * @brief	跳板模式視窗訊息處理 Callback function
+ * @param	[in] hWnd		由跳板替換為 DmWindow 物件指標
+ * @param	[in] uMessage	視窗訊息
+ * @param	[in] wParam		參數 1
+ * @param	[in] lParam		參數 2
+ * @return	@c LRESULT \n
+ *			視窗操作結果, 依據視窗訊息操作有所不同.
+ * @remark	此項必須為靜態函數，只經由 CxFrameThunkPool 配置的跳板調用
+ */
+LRESULT DmWindow::ThunkWindowProc(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam)
+{
+	DmWindow* fmObj = reinterpret_cast<DmWindow*>(hWnd);
+
+	AXEEN_PROFILE_MESSAGE(fmObj->m_hWnd, uMessage, wParam);
+	return fmObj->WndProc(uMessage, wParam, lParam);
+}
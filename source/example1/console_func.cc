@@ -197,3 +197,674 @@ void test_timer()
 	std::wcout << TEXT("testAddFunc() function = ") << dwEnd - dwStart << std::setw(8) << sum << std::endl;
 }
 
+void test_process_search()
+{
+	const int loop = 1000;
+	LPCTSTR szModulePtr = TEXT("explorer.exe");
+	CxFrameProcess process;
+	CxFrameProcessIndex index;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+	DWORD idProcess = 0;
+
+	// 每次搜尋都重新取得系統快照
+	dwStart = ::timeGetTime();
+	for (int i = 0; i < loop; i++) {
+		idProcess = process.SearchProcess(szModulePtr);
+	}
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("SearchProcess() = ") << dwEnd - dwStart << std::setw(8) << idProcess << std::endl;
+
+	// 建立一次索引後反覆查詢
+	dwStart = ::timeGetTime();
+	index.Refresh();
+	for (int i = 0; i < loop; i++) {
+		idProcess = index.Search(szModulePtr);
+	}
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("CxFrameProcessIndex::Search() = ") << dwEnd - dwStart << std::setw(8) << idProcess << std::endl;
+
+	// 每次查詢前增量更新索引
+	dwStart = ::timeGetTime();
+	for (int i = 0; i < loop; i++) {
+		index.Refresh();
+		idProcess = index.Search(szModulePtr);
+	}
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("Refresh() + Search() = ") << dwEnd - dwStart << std::setw(8) << idProcess << std::endl;
+}
+
+static BOOL CALLBACK test_pattern_scan_proc(LPVOID aParamPtr, ULONG_PTR uAddress)
+{
+	UNREFERENCED_PARAMETER(aParamPtr);
+	std::wcout << TEXT("  found at 0x") << std::hex << uAddress << std::dec << std::endl;
+	return TRUE;
+}
+
+void test_pattern_scan()
+{
+	// 搜尋目標: 自身程序中的特徵碼
+	static const BYTE aSignature[] = { 0x41, 0x58, 0x45, 0x45, 0x4E, 0xA5, 0x53, 0x43, 0x41, 0x4E, 0x21, 0x7E };
+	CxFrameProcess process;
+	CxFrameWorkPool pool;
+	CxFramePatternScan scan;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+	size_t nMatch = 0;
+
+	if (process.OpenProcess(::GetCurrentProcessId()) == NULL)
+		return;
+	if (!scan.SetPattern(TEXT("41 58 45 45 4E ?? 53 4? 41 4E 21 7E")))
+		return;
+	std::wcout << TEXT("signature at 0x") << std::hex << reinterpret_cast<ULONG_PTR>(aSignature) << std::dec << std::endl;
+
+	// 單一執行緒
+	dwStart = ::timeGetTime();
+	nMatch = scan.Scan(&process, test_pattern_scan_proc, NULL);
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("Scan() single thread = ") << dwEnd - dwStart << std::setw(8) << nMatch << std::endl;
+
+	// 工作執行緒池
+	pool.Create();
+	dwStart = ::timeGetTime();
+	nMatch = scan.Scan(&process, test_pattern_scan_proc, NULL, &pool);
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("Scan() work pool = ") << dwEnd - dwStart << std::setw(8) << nMatch << std::endl;
+}
+
+void test_memory_cache()
+{
+	const int loop = 10000;
+	static int aField[64];
+	CxFrameProcess process;
+	CxFrameMemoryCache cache;
+	SSMEMCACHESTAT stat;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+	int sum = 0;
+	int value = 0;
+
+	if (process.OpenProcess(::GetCurrentProcessId()) == NULL)
+		return;
+	for (int i = 0; i < 64; i++) aField[i] = i;
+
+	// 每個欄位直接讀取
+	dwStart = ::timeGetTime();
+	for (int k = 0; k < loop; k++) {
+		for (int i = 0; i < 64; i++) {
+			process.ReadMemory(&aField[i], &value, sizeof(value));
+			sum += value;
+		}
+	}
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("ReadMemory() = ") << dwEnd - dwStart << std::setw(8) << sum << std::endl;
+
+	// 經由快取讀取, 每輪開始新的世代
+	sum = 0;
+	cache.Create(&process);
+	cache.AddBypass(&aField[0], sizeof(int));
+	dwStart = ::timeGetTime();
+	for (int k = 0; k < loop; k++) {
+		cache.NewEpoch();
+		for (int i = 0; i < 64; i++) {
+			cache.ReadMemory(&aField[i], &value, sizeof(value));
+			sum += value;
+		}
+	}
+	dwEnd = ::timeGetTime();
+	cache.GetStats(&stat);
+	std::wcout << TEXT("CxFrameMemoryCache::ReadMemory() = ") << dwEnd - dwStart << std::setw(8) << sum << std::endl;
+	std::wcout << TEXT("  hit = ") << stat.nHit << TEXT(", miss = ") << stat.nMiss << TEXT(", bypass = ") << stat.nBypass
+		<< TEXT(", read = ") << stat.nRead << std::endl;
+}
+
+void test_value_scan()
+{
+	static volatile int target = 0x13572468;
+	CxFrameProcess process;
+	CxFrameValueScan scan;
+	CxFrameWorkPool pool;
+	std::vector<ULONG_PTR> aResult;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+	int value = target;
+
+	if (process.OpenProcess(::GetCurrentProcessId()) == NULL)
+		return;
+	pool.Create();
+
+	// 首次搜尋指定數值
+	dwStart = ::timeGetTime();
+	scan.FirstScan(&process, EValueInt32, EScanExact, &value, NULL, &pool);
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("FirstScan() = ") << dwEnd - dwStart << std::setw(8) << scan.GetCount()
+		<< TEXT(", memory = ") << scan.GetMemoryUsage() << std::endl;
+
+	// 改變數值後再次搜尋
+	target = target + 1;
+	dwStart = ::timeGetTime();
+	scan.NextScan(EScanIncreased, NULL, NULL, &pool);
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("NextScan() = ") << dwEnd - dwStart << std::setw(8) << scan.GetCount()
+		<< TEXT(", memory = ") << scan.GetMemoryUsage() << std::endl;
+
+	scan.GetResults(&aResult, 16);
+	for (size_t i = 0; i < aResult.size(); i++) {
+		std::wcout << TEXT("  0x") << std::hex << aResult[i] << std::dec
+			<< (aResult[i] == reinterpret_cast<ULONG_PTR>(&target) ? TEXT(" (target)") : TEXT("")) << std::endl;
+	}
+}
+
+static void CALLBACK test_process_watch_proc(LPVOID aParamPtr, const SSPROCEVENT* eventPtr)
+{
+	DWORD dwStart = *reinterpret_cast<DWORD*>(aParamPtr);
+
+	std::wcout << (eventPtr->eEvent == EProcStart ? TEXT("  start ") : TEXT("  exit  ")) << std::setw(8) << eventPtr->dwProcessID
+		<< TEXT(" ") << eventPtr->szName << TEXT(", code = ") << eventPtr->dwExitCode
+		<< TEXT(", time = ") << ::timeGetTime() - dwStart << std::endl;
+}
+
+void test_process_watch()
+{
+	TCHAR szCommand[] = TEXT("cmd.exe /c ping -n 2 127.0.0.1 > nul");
+	CxFrameProcessWatch watch;
+	STARTUPINFO si;
+	PROCESS_INFORMATION pi;
+	DWORD dwStart = ::timeGetTime();
+
+	// 監看 cmd.exe 與 ping.exe, 已在執行的程序也會通知
+	watch.AddPattern(TEXT("cmd.exe"));
+	watch.AddPattern(TEXT("ping*.exe"));
+	if (!watch.Start(test_process_watch_proc, &dwStart))
+		return;
+
+	::memset(&si, 0, sizeof(si));
+	si.cb = sizeof(si);
+	dwStart = ::timeGetTime();
+	if (::CreateProcess(NULL, szCommand, NULL, NULL, FALSE, CREATE_NO_WINDOW, NULL, NULL, &si, &pi)) {
+		::WaitForSingleObject(pi.hProcess, INFINITE);
+		::CloseHandle(pi.hThread);
+		::CloseHandle(pi.hProcess);
+	}
+	::Sleep(PROCWATCH_INTERVAL * 2);
+	watch.Stop();
+}
+
+void test_process_group()
+{
+	const int loop = 100;
+	const size_t nProcess = 128;
+	static int aCounter[4] = { 1, 2, 3, 4 };
+	static double aPosition[3] = { 1.0, 2.0, 3.0 };
+	const SIZE_T aFieldSize[] = { sizeof(aCounter), sizeof(aPosition) };
+	std::vector<DWORD> aPid(nProcess, ::GetCurrentProcessId());
+	CxFrameProcessGroup group;
+	CxFrameWorkPool pool;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+
+	// 以自身程序模擬多個目標程序
+	pool.Create();
+	group.Attach(aPid.data(), aPid.size(), &pool);
+	group.SetFields(aFieldSize, 2);
+	for (size_t i = 0; i < group.GetCount(); i++) {
+		group.SetAddress(i, 0, reinterpret_cast<ULONG_PTR>(aCounter));
+		group.SetAddress(i, 1, reinterpret_cast<ULONG_PTR>(aPosition));
+	}
+
+	// 單一執行緒
+	dwStart = ::timeGetTime();
+	for (int k = 0; k < loop; k++) group.Read();
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("Read() single thread = ") << dwEnd - dwStart << std::setw(8) << group.GetCount() << std::endl;
+
+	// 工作執行緒池
+	dwStart = ::timeGetTime();
+	for (int k = 0; k < loop; k++) group.Read(&pool);
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("Read() work pool = ") << dwEnd - dwStart << std::setw(8) << group.GetCount() << std::endl;
+
+	// 欄位結果為連續陣列
+	const double* aPosPtr = reinterpret_cast<const double*>(group.GetField(1));
+	const DWORD* aLatencyPtr = group.GetLatency();
+	if (aPosPtr != NULL && aLatencyPtr != NULL) {
+		std::wcout << TEXT("  last position = ") << aPosPtr[(group.GetCount() - 1) * 3 + 2]
+			<< TEXT(", latency[0] = ") << aLatencyPtr[0] << TEXT(" us") << std::endl;
+	}
+}
+
+void test_snapshot()
+{
+	static int aField[1024];
+	CxFrameProcess process;
+	CxFrameSnapshotWriter writer;
+	CxFrameSnapshot snapOld;
+	CxFrameSnapshot snapNew;
+	std::vector<ULONGLONG> aPage;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+	int value = 0;
+
+	if (process.OpenProcess(::GetCurrentProcessId()) == NULL)
+		return;
+
+	// 擷取兩份快照, 中間改變一個欄位
+	dwStart = ::timeGetTime();
+	writer.Capture(&process, TEXT("snapshot_old.axsn"));
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("Capture() = ") << dwEnd - dwStart << std::setw(12) << writer.GetPayloadSize() << std::endl;
+
+	aField[512] = 0x2468;
+	writer.Capture(&process, TEXT("snapshot_new.axsn"));
+
+	// 開啟快照不需解析資料
+	dwStart = ::timeGetTime();
+	snapOld.Open(TEXT("snapshot_old.axsn"));
+	snapNew.Open(TEXT("snapshot_new.axsn"));
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("Open() = ") << dwEnd - dwStart << std::setw(8) << snapNew.GetRegionCount() << std::endl;
+
+	snapNew.ReadMemory(reinterpret_cast<ULONG_PTR>(&aField[512]), &value, sizeof(value));
+	std::wcout << TEXT("  aField[512] = 0x") << std::hex << value << std::dec << std::endl;
+
+	dwStart = ::timeGetTime();
+	CxFrameSnapshot::Diff(&snapOld, &snapNew, &aPage);
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("Diff() = ") << dwEnd - dwStart << std::setw(8) << aPage.size() << std::endl;
+
+	snapOld.Close();
+	snapNew.Close();
+	::DeleteFile(TEXT("snapshot_old.axsn"));
+	::DeleteFile(TEXT("snapshot_new.axsn"));
+}
+
+void test_pointer_chain()
+{
+	struct SSTESTNODE { int aPad[4]; SSTESTNODE* nextPtr; int value; };
+	const int loop = 1000;
+	const size_t nPaths = 1000;
+	static SSTESTNODE aNode[3];
+	static SSTESTNODE* rootPtr = &aNode[0];
+	const LONG_PTR aOffset[] = { 0, offsetof(SSTESTNODE, nextPtr), offsetof(SSTESTNODE, nextPtr), offsetof(SSTESTNODE, value) };
+	CxFrameProcess process;
+	CxFramePointerChain chain;
+	SSPTRCHAINSTAT stat;
+	ULONG_PTR uNode = 0;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+
+	if (process.OpenProcess(::GetCurrentProcessId()) == NULL)
+		return;
+
+	// [[[&rootPtr] + next] + next] + value
+	aNode[0].nextPtr = &aNode[1];
+	aNode[1].nextPtr = &aNode[2];
+	aNode[2].value = 0x1234;
+
+	// 逐一以 ReadMemory 解析
+	dwStart = ::timeGetTime();
+	for (int k = 0; k < loop; k++) {
+		for (size_t i = 0; i < nPaths; i++) {
+			ULONG_PTR uPtr = reinterpret_cast<ULONG_PTR>(&rootPtr);
+			for (int n = 0; n < 3; n++)
+				process.ReadMemory(reinterpret_cast<LPCVOID>(uPtr + aOffset[n]), &uPtr, sizeof(uPtr));
+			uNode = uPtr + aOffset[3];
+		}
+	}
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("ReadMemory() chain = ") << dwEnd - dwStart << std::endl;
+
+	// 批次解析 (每層一次 ReadMemoryV, 中間指標快取)
+	chain.Create(&process);
+	for (size_t i = 0; i < nPaths; i++)
+		chain.AddPath(reinterpret_cast<ULONG_PTR>(&rootPtr), aOffset, 4);
+	dwStart = ::timeGetTime();
+	for (int k = 0; k < loop; k++)
+		chain.Resolve();
+	dwEnd = ::timeGetTime();
+	chain.GetStats(&stat);
+	std::wcout << TEXT("CxFramePointerChain::Resolve() = ") << dwEnd - dwStart
+		<< (chain.GetAddress(0) == uNode ? TEXT(" (match)") : TEXT(" (mismatch)")) << std::endl;
+	std::wcout << TEXT("  read = ") << stat.nRead << TEXT(", pointer = ") << stat.nPointer << TEXT(", hit = ") << stat.nHit << std::endl;
+
+	// 路徑中斷後不再每次重新解析
+	aNode[1].nextPtr = NULL;
+	chain.Invalidate();
+	for (int k = 0; k < 10; k++)
+		chain.Resolve();
+	std::wcout << TEXT("  broken = ") << chain.GetBroken(NULL) << TEXT(", level = ") << chain.GetStatus(0) << std::endl;
+}
+
+/**
+ * @class	CxBenchSwitchBase
+ * @brief	test_message_map : 基底類別 virtual switch 訊息處理 (模擬 CxFrameWindow)
+ */
+class CxBenchSwitchBase
+{
+public:
+	CxBenchSwitchBase() : m_nDefault(0) { }
+	virtual ~CxBenchSwitchBase() { }
+
+	virtual LRESULT MessageDispose(UINT uMessage, WPARAM wParam, LPARAM lParam)
+	{
+		switch (uMessage)
+		{
+		case WM_CLOSE:
+		case WM_DESTROY:
+			break;
+		default:
+			return this->DefaultWindowProc(uMessage, wParam, lParam);
+		}
+		return 0;
+	}
+
+	virtual LRESULT DefaultWindowProc(UINT uMessage, WPARAM wParam, LPARAM lParam)
+	{
+		UNREFERENCED_PARAMETER(wParam);
+		UNREFERENCED_PARAMETER(lParam);
+		return static_cast<LRESULT>(++m_nDefault + uMessage);
+	}
+
+	size_t	m_nDefault;
+};
+
+/**
+ * @class	CxBenchSwitch
+ * @brief	test_message_map : 衍生類別 virtual switch 訊息處理
+ */
+class CxBenchSwitch : public CxBenchSwitchBase
+{
+public:
+	CxBenchSwitch() : CxBenchSwitchBase(), m_nSum(0) { }
+
+	virtual LRESULT MessageDispose(UINT uMessage, WPARAM wParam, LPARAM lParam) override
+	{
+		switch (uMessage)
+		{
+		case WM_SIZE:
+			m_nSum += LOWORD(lParam) + HIWORD(lParam);
+			break;
+		case WM_MOUSEMOVE:
+			m_nSum += LOWORD(lParam);
+			break;
+		case WM_COMMAND:
+			m_nSum += LOWORD(wParam);
+			break;
+		case WM_TIMER:
+			m_nSum += wParam;
+			break;
+		case WM_PAINT:
+			++m_nSum;
+			break;
+		default:
+			return CxBenchSwitchBase::MessageDispose(uMessage, wParam, lParam);
+		}
+		return 0;
+	}
+
+	size_t	m_nSum;
+};
+
+/**
+ * @class	CxBenchMap
+ * @brief	test_message_map : 訊息映射表處理
+ */
+class CxBenchMap
+{
+public:
+	CxBenchMap() : m_nDefault(0), m_nSum(0) { }
+
+	LRESULT MessageDispose(UINT uMessage, WPARAM wParam, LPARAM lParam)
+	{
+		LRESULT lResult;
+		if (MessageMap::Dispatch(this, uMessage, wParam, lParam, &lResult))
+			return lResult;
+		return this->DefaultWindowProc(uMessage, wParam, lParam);
+	}
+
+	LRESULT DefaultWindowProc(UINT uMessage, WPARAM wParam, LPARAM lParam)
+	{
+		UNREFERENCED_PARAMETER(wParam);
+		UNREFERENCED_PARAMETER(lParam);
+		return static_cast<LRESULT>(++m_nDefault + uMessage);
+	}
+
+	void OnSize(UINT uType, int cx, int cy) { UNREFERENCED_PARAMETER(uType); m_nSum += cx + cy; }
+	void OnMouseMove(UINT uKeys, int x, int y) { UNREFERENCED_PARAMETER(uKeys); UNREFERENCED_PARAMETER(y); m_nSum += x; }
+	void OnCommand(UINT uID, UINT uCode, HWND hCtrl) { UNREFERENCED_PARAMETER(uCode); UNREFERENCED_PARAMETER(hCtrl); m_nSum += uID; }
+	void OnTimer(UINT_PTR idTimer) { m_nSum += idTimer; }
+	void OnPaint() { ++m_nSum; }
+	void OnNothing() { }
+
+	typedef CxMsgMap<CxBenchMap
+		, AXEEN_MSGHANDLER(WM_SIZE, &CxBenchMap::OnSize)
+		, AXEEN_MSGHANDLER(WM_MOUSEMOVE, &CxBenchMap::OnMouseMove)
+		, AXEEN_MSGHANDLER(WM_COMMAND, &CxBenchMap::OnCommand)
+		, AXEEN_MSGHANDLER(WM_TIMER, &CxBenchMap::OnTimer)
+		, AXEEN_MSGHANDLER(WM_PAINT, &CxBenchMap::OnPaint)
+		, AXEEN_MSGHANDLER(WM_CLOSE, &CxBenchMap::OnNothing)
+		, AXEEN_MSGHANDLER(WM_DESTROY, &CxBenchMap::OnNothing)
+	> MessageMap;
+
+	size_t	m_nDefault;
+	size_t	m_nSum;
+};
+
+void test_message_map()
+{
+	const int loop = 20000;
+	const UINT aHandled[] = { WM_SIZE, WM_MOUSEMOVE, WM_COMMAND, WM_TIMER, WM_PAINT };
+	const UINT aDefault[] = { WM_NCHITTEST, WM_SETCURSOR, WM_NCMOUSEMOVE, WM_GETICON, WM_ERASEBKGND, WM_WINDOWPOSCHANGING, WM_KEYDOWN, WM_CHAR };
+	std::vector<UINT> aMessage(1024);
+	CxBenchSwitch benchSwitch;
+	CxBenchSwitchBase* switchPtr = &benchSwitch;
+	CxBenchMap benchMap;
+	LRESULT lSum = 0;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+
+	// 約四分之一為已處理訊息, 其餘交給預設處理函數
+	::srand(1234);
+	for (size_t i = 0; i < aMessage.size(); i++) {
+		if (::rand() % 4 == 0)
+			aMessage[i] = aHandled[::rand() % (sizeof(aHandled) / sizeof(aHandled[0]))];
+		else
+			aMessage[i] = aDefault[::rand() % (sizeof(aDefault) / sizeof(aDefault[0]))];
+	}
+
+	dwStart = ::timeGetTime();
+	for (int k = 0; k < loop; k++) {
+		for (size_t i = 0; i < aMessage.size(); i++)
+			lSum += switchPtr->MessageDispose(aMessage[i], i, MAKELPARAM(i, k));
+	}
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("virtual switch = ") << dwEnd - dwStart << TEXT(", default = ") << benchSwitch.m_nDefault << TEXT(", sum = ") << benchSwitch.m_nSum << std::endl;
+
+	dwStart = ::timeGetTime();
+	for (int k = 0; k < loop; k++) {
+		for (size_t i = 0; i < aMessage.size(); i++)
+			lSum += benchMap.MessageDispose(aMessage[i], i, MAKELPARAM(i, k));
+	}
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("CxMsgMap = ") << dwEnd - dwStart << TEXT(", default = ") << benchMap.m_nDefault << TEXT(", sum = ") << benchMap.m_nSum << std::endl;
+	std::wcout << TEXT("  table = ") << (CxBenchMap::MessageMap::bDense ? TEXT("dense") : CxBenchMap::MessageMap::bSorted ? TEXT("sorted") : TEXT("hash"))
+		<< TEXT(", size = ") << CxBenchMap::MessageMap::nSize << TEXT(", check = ") << lSum << std::endl;
+}
+
+class CxBenchThunk
+{
+public:
+	CxBenchThunk() : m_nSum(0) { }
+
+	LRESULT WndProc(UINT uMessage, WPARAM wParam, LPARAM lParam)
+	{
+		m_nSum += uMessage + wParam + lParam;
+		return static_cast<LRESULT>(m_nSum);
+	}
+
+	// 以 GWLP_USERDATA 查詢物件
+	static LRESULT CALLBACK UserDataProc(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam)
+	{
+		auto objPtr = reinterpret_cast<CxBenchThunk*>(::GetWindowLongPtr(hWnd, GWLP_USERDATA));
+		return objPtr != NULL ? objPtr->WndProc(uMessage, wParam, lParam) : 0;
+	}
+
+	// 由跳板將 hWnd 替換為物件指標
+	static LRESULT CALLBACK ThunkProc(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam)
+	{
+		return reinterpret_cast<CxBenchThunk*>(hWnd)->WndProc(uMessage, wParam, lParam);
+	}
+
+	size_t	m_nSum;
+};
+
+void test_window_thunk()
+{
+	const int loop = 10000000;
+	const int count = 4096;
+	CxFrameThunkPool& pool = CxFrameThunkPool::Shared();
+	std::vector<LPVOID> aThunk(count);
+	SSTHUNKSTAT stat;
+	CxBenchThunk benchUser;
+	CxBenchThunk benchThunk;
+	WNDPROC fnUser = CxBenchThunk::UserDataProc;
+	WNDPROC fnThunk = NULL;
+	HWND hWnd = NULL;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+
+	// 配置與釋放
+	dwStart = ::timeGetTime();
+	for (int k = 0; k < 100; k++) {
+		for (int i = 0; i < count; i++)
+			aThunk[i] = pool.Alloc(&benchThunk, reinterpret_cast<LPCVOID>(&CxBenchThunk::ThunkProc));
+		for (int i = 0; i < count; i++)
+			pool.Free(aThunk[i]);
+	}
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("alloc/free ") << count * 100 << TEXT(" thunks = ") << dwEnd - dwStart << std::endl;
+
+	fnThunk = reinterpret_cast<WNDPROC>(pool.Alloc(&benchThunk, reinterpret_cast<LPCVOID>(&CxBenchThunk::ThunkProc)));
+	if (fnThunk == NULL) {
+		std::wcout << TEXT("thunk not available, dynamic code blocked or unsupported platform") << std::endl;
+		return;
+	}
+
+	hWnd = ::CreateWindowEx(0, TEXT("STATIC"), NULL, 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, ::GetModuleHandle(NULL), NULL);
+	if (hWnd != NULL) {
+		::SetWindowLongPtr(hWnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(&benchUser));
+
+		dwStart = ::timeGetTime();
+		for (int i = 0; i < loop; i++)
+			fnUser(hWnd, WM_USER, i, 0);
+		dwEnd = ::timeGetTime();
+		std::wcout << TEXT("GWLP_USERDATA = ") << dwEnd - dwStart << TEXT(", sum = ") << benchUser.m_nSum << std::endl;
+
+		dwStart = ::timeGetTime();
+		for (int i = 0; i < loop; i++)
+			fnThunk(hWnd, WM_USER, i, 0);
+		dwEnd = ::timeGetTime();
+		std::wcout << TEXT("thunk = ") << dwEnd - dwStart << TEXT(", sum = ") << benchThunk.m_nSum << std::endl;
+		::DestroyWindow(hWnd);
+	}
+
+	pool.Free(reinterpret_cast<LPVOID>(fnThunk));
+	pool.GetStats(&stat);
+	std::wcout << TEXT("chunks = ") << stat.nChunks << TEXT(", slots = ") << stat.nSlots << TEXT(", used = ") << stat.nUsed
+		<< TEXT(", alloc = ") << stat.nAlloc << TEXT(", free = ") << stat.nFree << std::endl;
+}
+
+static LRESULT CALLBACK test_profile_proc(HWND hWnd, UINT uMessage, WPARAM wParam, LPARAM lParam)
+{
+	AXEEN_PROFILE_MESSAGE(hWnd, uMessage, wParam);
+	return static_cast<LRESULT>(uMessage + wParam + lParam);
+}
+
+void test_message_profile()
+{
+#if (__AXEEN_PROFILE__ == 1)
+	const int loop = 1000000;
+	const UINT aMessage[] = { WM_MOUSEMOVE, WM_SETCURSOR, WM_NCHITTEST, WM_PAINT, WM_TIMER, WM_USER + 1, WM_APP + 2 };
+	const size_t nMessage = sizeof(aMessage) / sizeof(aMessage[0]);
+	std::basic_string<TCHAR> strReport;
+	LRESULT lSum = 0;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+
+	CxMsgProfiler::Enable(FALSE);
+	dwStart = ::timeGetTime();
+	for (int i = 0; i < loop; i++)
+		lSum += test_profile_proc(NULL, aMessage[i % nMessage], i, 0);
+	dwEnd = ::timeGetTime();
+	std::wcout << TEXT("disabled = ") << dwEnd - dwStart << std::endl;
+
+	CxMsgProfiler::Reset();
+	CxMsgProfiler::Enable(TRUE);
+	dwStart = ::timeGetTime();
+	for (int i = 0; i < loop; i++)
+		lSum += test_profile_proc(NULL, aMessage[i % nMessage], i, 0);
+	dwEnd = ::timeGetTime();
+	CxMsgProfiler::Enable(FALSE);
+	std::wcout << TEXT("enabled = ") << dwEnd - dwStart << TEXT(", check = ") << lSum << std::endl;
+
+	CxMsgProfiler::GetReport(strReport, 8);
+	std::wcout << strReport;
+#else
+	std::wcout << TEXT("__AXEEN_PROFILE__ is 0, profiling removed") << std::endl;
+#endif
+}
+
+static void test_task_fib(CxFrameTaskPool* poolPtr, int n, volatile LONG64* sumPtr)
+{
+	// 小於門檻時直接計算, 否則分為兩個子工作
+	if (n < 16) {
+		LONG64 a = 0, b = 1;
+		for (int i = 0; i < n; i++) {
+			LONG64 t = a + b;
+			a = b;
+			b = t;
+		}
+		::InterlockedExchangeAdd64(sumPtr, a);
+		return;
+	}
+	poolPtr->Submit([poolPtr, n, sumPtr]() { test_task_fib(poolPtr, n - 1, sumPtr); });
+	poolPtr->Submit([poolPtr, n, sumPtr]() { test_task_fib(poolPtr, n - 2, sumPtr); });
+}
+
+void test_task_pool()
+{
+	const int loop = 1000000;
+	CxFrameTaskPool pool;
+	SSTASKPOOLSTAT stat;
+	volatile LONG64 nSum = 0;
+	DWORD dwStart = 0;
+	DWORD dwEnd = 0;
+
+	if (!pool.Create()) {
+		std::wcout << TEXT("create task pool failed") << std::endl;
+		return;
+	}
+
+	// 外部執行緒投遞大量小工作
+	dwStart = ::timeGetTime();
+	for (int i = 0; i < loop; i++)
+		pool.Submit([&nSum]() { ::InterlockedIncrement64(&nSum); });
+	pool.Wait();
+	dwEnd = ::timeGetTime();
+	pool.GetStats(&stat);
+	std::wcout << TEXT("flat ") << loop << TEXT(" tasks = ") << dwEnd - dwStart << TEXT(", sum = ") << nSum
+		<< TEXT(", stolen = ") << stat.nStolen << TEXT(", sleeps = ") << stat.nSleeps << std::endl;
+
+	// 工作執行緒遞迴產生子工作 (分治)
+	pool.ResetStats();
+	nSum = 0;
+	dwStart = ::timeGetTime();
+	pool.Submit([&pool, &nSum]() { test_task_fib(&pool, 36, &nSum); });
+	pool.Wait();
+	dwEnd = ::timeGetTime();
+	pool.GetStats(&stat);
+	std::wcout << TEXT("fib(36) = ") << nSum << TEXT(", time = ") << dwEnd - dwStart << TEXT(", threads = ") << stat.nThreads
+		<< TEXT(", tasks = ") << stat.nExecuted << TEXT(", local = ") << stat.nLocal
+		<< TEXT(", stolen = ") << stat.nStolen << TEXT(", sleeps = ") << stat.nSleeps << std::endl;
+	pool.Close();
+}
@@ -23,6 +23,18 @@ int _tmain(int argc, TCHAR* argv[])
 	//std::wcout << TEXT("Exit Code = ") << res << std::endl;
 	//test_integer();
 	//test_timer();
+	//test_process_search();
+	//test_pattern_scan();
+	//test_memory_cache();
+	//test_value_scan();
+	//test_process_watch();
+	//test_process_group();
+	//test_snapshot();
+	//test_pointer_chain();
+	//test_message_map();
+	//test_window_thunk();
+	//test_message_profile();
+	//test_task_pool();
 
 	system("pause");
 	return res;
@@ -2,11 +2,24 @@
  * @file	console_define.hh
  * @brief	Example1 - Console define header
  * @date	2018-04-20
- * @date	2018-07-25
+ * @date	2026-10-17
  * @author	Swang
  *****************************************************************************/
 #ifndef __AXEEN_EXAMPLE1_DEFINE_HH__
 #define __AXEEN_EXAMPLE1_DEFINE_HH__
+#include "axeen/axeen_msgmap.hh"
+#include "axeen/axeen_profile.hh"
 #include "win32frame/wframe.hh"
+#include "win32frame/wframe_process.hh"
+#include "win32frame/wframe_procindex.hh"
+#include "win32frame/wframe_scanner.hh"
+#include "win32frame/wframe_memcache.hh"
+#include "win32frame/wframe_valuescan.hh"
+#include "win32frame/wframe_procwatch.hh"
+#include "win32frame/wframe_procgroup.hh"
+#include "win32frame/wframe_snapshot.hh"
+#include "win32frame/wframe_ptrchain.hh"
+#include "win32frame/wframe_thunk.hh"
+#include "win32frame/wframe_taskpool.hh"
 
 #endif	// !__AXEEN_EXAMPLE1_DEFINE_HH__
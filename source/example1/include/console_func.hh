@@ -2,7 +2,7 @@
  * @file	console_func.hh
  * @brief	Example1 - Console Test function header
  * @date	2018-04-20
- * @date	2018-07-25
+ * @date	2026-10-17
  * @author	Swang
  *****************************************************************************/
 #ifndef __AXEEN_CONSOLE_HEADER_HH__
@@ -15,5 +15,17 @@ int test_swap(int* a, int *b);
 int test_window();
 int test_integer();
 void test_timer();
+void test_process_search();
+void test_pattern_scan();
+void test_memory_cache();
+void test_value_scan();
+void test_process_watch();
+void test_process_group();
+void test_snapshot();
+void test_pointer_chain();
+void test_message_map();
+void test_window_thunk();
+void test_message_profile();
+void test_task_pool();
 
 #endif // !__AXEEN_CONSOLE_HEADER_HH__
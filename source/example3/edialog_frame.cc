@@ -25,28 +25,25 @@ CxExamaleDialog::~CxExamaleDialog() { }
  * @param	[in] wParam		訊息參數
  * @param	[in] lParam		訊息參數
  * @return	@c INT_PTR		訊息處理結果
- * @remark	MessageDisopse 為虛擬函示，由衍生者重載重新定義動作內容
+ * @remark	MessageDisopse 為虛擬函示，由衍生者重載重新定義動作內容 \n
+ *			訊息經由 MessageMap 分派, 沒有對應的處理函數時返回 FALSE 交由系統處理
  */
 INT_PTR CxExamaleDialog::MessageDispose(UINT uMessage, WPARAM wParam, LPARAM lParam)
 {
-	switch (uMessage)
-	{
-	case WM_INITDIALOG:
-		this->OnInitDialog(wParam, lParam);
-		break;
-	case WM_DESTROY:
-		this->SysDestroyWindow();
-		break;
-	case WM_CLOSE:
-		this->SysCloseWindow();
-		break;
-	case WM_COMMAND:
-		this->OnCommand(wParam, lParam);
-		break;
-	default:
-		return FALSE;
-	}
-	return TRUE;
+	LRESULT lResult;
+	return MessageMap::Dispatch(this, uMessage, wParam, lParam, &lResult) ? TRUE : FALSE;
+}
+
+//! WM_DESTROY 訊息處理
+void CxExamaleDialog::OnDestroy()
+{
+	this->SysDestroyWindow();
+}
+
+//! WM_CLOSE 訊息處理
+void CxExamaleDialog::OnClose()
+{
+	this->SysCloseWindow();
 }
 
 /**
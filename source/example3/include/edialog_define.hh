@@ -24,6 +24,7 @@
 #define __XPP_STYLE__		1		//<! // 編譯 GUI 類型的的程式，是否編譯成具備 XP 的風格
 #endif
 
+#include "axeen/axeen_msgmap.hh"
 #include "win32frame/wframe.hh"
 #include "resource/resource.h"
 
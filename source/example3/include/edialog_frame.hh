@@ -19,9 +19,19 @@ protected:
 	virtual	INT_PTR MessageDispose(UINT uMessage, WPARAM wParam, LPARAM lParam) override;
 	void OnInitDialog(WPARAM wParam, LPARAM lParam);
 	void OnCommand(WPARAM wParam, LPARAM lParam);
+	void OnDestroy();
+	void OnClose();
 
 	virtual void WindowInTheEnd() override;
 
+	//! 訊息映射表 (編譯期產生分派表, 取代 switch)
+	typedef CxMsgMap<CxExamaleDialog
+		, AXEEN_MSGHANDLER(WM_INITDIALOG, &CxExamaleDialog::OnInitDialog)
+		, AXEEN_MSGHANDLER(WM_DESTROY, &CxExamaleDialog::OnDestroy)
+		, AXEEN_MSGHANDLER(WM_CLOSE, &CxExamaleDialog::OnClose)
+		, AXEEN_MSGHANDLER(WM_COMMAND, &CxExamaleDialog::OnCommand)
+	> MessageMap;
+
 protected:
 	CxFrameEditbox*		m_cEdit;
 	CxFrameButton*		m_cButton;
@@ -42,6 +42,40 @@ int CxFrameCombo::DeleteItem(int nIndex)
 	return static_cast<int>(this->SendMessage(CB_DELETESTRING, wParam, lParam));
 }
 
+/**
+ * @brief	批次新增字串項目
+ * @param	[in] aTextPtr	字串位址陣列, NULL 元素略過
+ * @param	[in] nCount		陣列元素數量
+ * @return	@c int 型別 \n
+ *			成功新增的項目數量, 失敗 (CB_ERR, CB_ERRSPACE) 時停止並返回已新增的數量
+ * @remark	先以 CB_INITSTORAGE 依項目數量與字串總長度一次配置, \n
+ *			新增期間暫停重繪 (BeginUpdate), 結束時只重繪一次.
+ */
+int CxFrameCombo::AddItems(const LPCTSTR* aTextPtr, int nCount)
+{
+	DWORD	cbTotal = 0;
+	int		nAdded = 0;
+
+	if (aTextPtr == NULL || nCount <= 0)
+		return 0;
+
+	for (int i = 0; i < nCount; ++i) {
+		if (aTextPtr[i] != NULL)
+			cbTotal += static_cast<DWORD>((::lstrlen(aTextPtr[i]) + 1) * sizeof(TCHAR));
+	}
+
+	CxFrameUpdateScope scope(*this);
+	this->InitStorage(nCount, cbTotal);
+	for (int i = 0; i < nCount; ++i) {
+		if (aTextPtr[i] == NULL)
+			continue;
+		if (this->AddItem(aTextPtr[i]) < 0)
+			break;
+		++nAdded;
+	}
+	return nAdded;
+}
+
 /**
  * @brief	取得項目數量
  * @return	@c int 型別 \n
@@ -99,6 +133,21 @@ int CxFrameCombo::GetItemTextLength(int nIndex)
 	return static_cast<int>(this->SendMessage(CB_GETLBTEXTLEN, wParam, lParam));
 }
 
+/**
+ * @brief	預先配置項目記憶體
+ * @param	[in] nItems		即將新增的項目數量
+ * @param	[in] cbBytes	即將新增的字串總長度 (in Byte)
+ * @return	@c int 型別 \n
+ *			函數操作成功返回已配置的項目總數, 記憶體不足返回 CB_ERRSPACE
+ */
+int CxFrameCombo::InitStorage(int nItems, DWORD cbBytes)
+{
+	// CB_INITSTORAGE
+	WPARAM wParam = static_cast<WPARAM>(nItems);	// 新增項目數量
+	LPARAM lParam = static_cast<LPARAM>(cbBytes);	// 字串記憶體大小 (in Byte)
+	return static_cast<int>(this->SendMessage(CB_INITSTORAGE, wParam, lParam));
+}
+
 /**
  * @brief	新增項目、
  * @details	使用 InsertItem 新增一個項目 \n
@@ -8,18 +8,48 @@
 #include "win32frame/wframe_control.hh"
 
 //! CxFrameControl 建構式
-CxFrameControl::CxFrameControl() : CxFrameObject() {  }
+CxFrameControl::CxFrameControl() : CxFrameObject(), m_nUpdateLock(0) {  }
 
 /**
  * @brief	CxFrameControl 建構式
  * @param	eType 控制項種類
  * @see		EECTRLTYPE
  */
-CxFrameControl::CxFrameControl(EECTRLTYPE eType) : CxFrameObject(eType) {  }
+CxFrameControl::CxFrameControl(EECTRLTYPE eType) : CxFrameObject(eType), m_nUpdateLock(0) {  }
 
 //! CxFrameControl 解構式
 CxFrameControl::~CxFrameControl() { }
 
+/**
+ * @brief	開始批次更新, 暫停控制項重繪 (WM_SETREDRAW)
+ * @return	此函數沒有返回值
+ * @remark	可巢狀調用, 最外層的 EndUpdate 才恢復重繪. \n
+ *			大量加入或刪除項目時, 控制項不再每個項目各自重繪與更新捲軸. 建議以 CxFrameUpdateScope 配對調用.
+ */
+void CxFrameControl::BeginUpdate()
+{
+	if (m_nUpdateLock++ == 0 && m_hWnd != NULL)
+		this->SendMessage(WM_SETREDRAW, FALSE, 0);
+}
+
+/**
+ * @brief	結束批次更新, 恢復重繪並重繪一次
+ * @return	此函數沒有返回值
+ */
+void CxFrameControl::EndUpdate()
+{
+	if (m_nUpdateLock <= 0 || --m_nUpdateLock != 0 || m_hWnd == NULL)
+		return;
+	this->SendMessage(WM_SETREDRAW, TRUE, 0);
+	::RedrawWindow(m_hWnd, NULL, NULL, RDW_ERASE | RDW_FRAME | RDW_INVALIDATE | RDW_ALLCHILDREN);
+}
+
+/**
+ * @brief	是否在批次更新中
+ * @return	@c 型別: BOOL \n 在 BeginUpdate 與 EndUpdate 之間返回非零值(non-zero)
+ */
+BOOL CxFrameControl::IsUpdating() const { return m_nUpdateLock > 0; }
+
 
 /**
  * @brief	建立控制項, 使用 Win32API - CreateWindowEx
@@ -249,6 +279,7 @@ BOOL CxFrameControl::CreateControllerEx(HINSTANCE hInst, HWND hWndParent, int id
 void CxFrameControl::WindowInTheEnd()
 {
 	// TODO: 結束視窗處理
+	m_nUpdateLock = 0;
 	CxFrameObject::WindowInTheEnd();
 }
 
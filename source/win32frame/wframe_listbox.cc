@@ -41,6 +41,40 @@ int CxFrameListbox::AddItem(TCHAR * szTextPtr)
 	return static_cast<int>(this->SendMessage(LB_ADDSTRING, wParam, lParam));
 }
 
+/**
+ * @brief	批次新增字串項目
+ * @param	[in] aTextPtr	字串位址陣列, NULL 元素略過
+ * @param	[in] nCount		陣列元素數量
+ * @return	@c 型別: int \n
+ *			成功新增的項目數量, 記憶體不足 (LB_ERRSPACE) 時停止並返回已新增的數量
+ * @remark	先以 LB_INITSTORAGE 依項目數量與字串總長度一次配置, \n
+ *			新增期間暫停重繪 (BeginUpdate), 結束時只重繪一次.
+ */
+int CxFrameListbox::AddItems(const LPCTSTR* aTextPtr, int nCount)
+{
+	DWORD	cbTotal = 0;
+	int		nAdded = 0;
+
+	if (aTextPtr == NULL || nCount <= 0)
+		return 0;
+
+	for (int i = 0; i < nCount; ++i) {
+		if (aTextPtr[i] != NULL)
+			cbTotal += static_cast<DWORD>((::lstrlen(aTextPtr[i]) + 1) * sizeof(TCHAR));
+	}
+
+	CxFrameUpdateScope scope(*this);
+	this->InitStorage(nCount, cbTotal);
+	for (int i = 0; i < nCount; ++i) {
+		if (aTextPtr[i] == NULL)
+			continue;
+		if (this->AddItem(const_cast<LPTSTR>(aTextPtr[i])) < 0)
+			break;
+		++nAdded;
+	}
+	return nAdded;
+}
+
 /**
  * @brief	刪除一個項目
  * @param	[in] nIndex	項目索引 (zero-base)
@@ -211,6 +245,22 @@ int CxFrameListbox::GetItemTextLength(int nIndex)
 	return static_cast<int>(this->SendMessage(LB_GETTEXTLEN, wParam, lParam));
 }
 
+/**
+ * @brief	預先配置項目記憶體
+ * @param	[in] nItems		即將新增的項目數量
+ * @param	[in] cbBytes	即將新增的字串總長度 (in Byte)
+ * @return	@c 型別: int \n
+ *			函數操作成功返回已配置的項目總數, 記憶體不足返回 LB_ERRSPACE
+ * @remark	大量新增前調用, 控制項不必每個項目各自重新配置.
+ */
+int CxFrameListbox::InitStorage(int nItems, DWORD cbBytes)
+{
+	// LB_INITSTORAGE
+	WPARAM wParam = static_cast<WPARAM>(nItems);			// 新增項目數量
+	LPARAM lParam = static_cast<LPARAM>(cbBytes);			// 字串記憶體大小 (in Byte)
+	return static_cast<int>(this->SendMessage(LB_INITSTORAGE, wParam, lParam));
+}
+
 /**
  * @brief	插入一個項目
  * @param	[in] nIndex		指定項目索引 (zero-base), 若此參數被設定為 -1, 則插入到列表最後
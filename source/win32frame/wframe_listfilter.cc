@@ -0,0 +1,525 @@
+﻿/**************************************************************************//**
+ * @file	wframe_listfilter.cc
+ * @brief	ListView 資料即時篩選索引類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_listfilter.hh"
+
+//! CxFrameListFilter 建構式
+CxFrameListFilter::CxFrameListFilter()
+	: m_bLastValid(FALSE)
+	, m_nPending(0)
+	, m_nDone(0)
+	, m_bResult(FALSE)
+	, m_tpWork(NULL)
+	, m_hWnd(NULL)
+	, m_uMessage(0)
+	, m_bBusy(FALSE)
+	, m_bRunning(FALSE)
+{
+	::InitializeCriticalSection(&m_csSearch);
+	::InitializeCriticalSection(&m_csLock);
+}
+
+//! CxFrameListFilter 解構式
+CxFrameListFilter::~CxFrameListFilter()
+{
+	this->Stop();
+	::DeleteCriticalSection(&m_csLock);
+	::DeleteCriticalSection(&m_csSearch);
+}
+
+/**
+ * @brief	建立篩選索引
+ * @param	[in] srcPtr		資料來源
+ * @param	[in] aColumnPtr	篩選的欄位索引陣列
+ * @param	[in] nColumns	欄位數量
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			參數錯誤返回零(zero)
+ * @remark	取得全部列的文字並建立索引, 資料量大時應於工作執行緒調用. \n
+ *			索引於建立完成後才替換, 建立期間仍可使用原索引篩選. \n
+ *			每個欄位取得的文字長度上限為 LISTSORT_TEXT_MAX - 1 個字元.
+ */
+BOOL CxFrameListFilter::Build(CxFrameListSource* srcPtr, const int* aColumnPtr, int nColumns)
+{
+	if (srcPtr == NULL || aColumnPtr == NULL || nColumns <= 0)
+		return FALSE;
+
+	TCHAR	szCell[LISTSORT_TEXT_MAX];
+	int		nRows = srcPtr->GetRowCount();
+	std::vector<TCHAR>	aText;
+	std::vector<size_t>	aOffset;
+	std::vector<int>	aPosting;
+	std::vector<ULONGLONG>	aGram;
+	std::unordered_map<ULONGLONG, SSPOSTING>	mapTrigram;
+
+	if (nRows < 0) nRows = 0;
+	aOffset.reserve(static_cast<size_t>(nRows) + 1);
+
+	// 取得各列文字, 轉為小寫
+	for (int nRow = 0; nRow < nRows; ++nRow) {
+		aOffset.push_back(aText.size());
+		for (int i = 0; i < nColumns; ++i) {
+			if (i != 0) aText.push_back(static_cast<TCHAR>(LISTFILTER_SEPARATOR));
+
+			szCell[0] = TEXT('\0');
+			if (!srcPtr->GetCellText(nRow, aColumnPtr[i], szCell, LISTSORT_TEXT_MAX))
+				continue;
+			szCell[LISTSORT_TEXT_MAX - 1] = TEXT('\0');
+
+			DWORD ccCell = static_cast<DWORD>(::_tcslen(szCell));
+			if (ccCell != 0) {
+				::CharLowerBuff(szCell, ccCell);
+				aText.insert(aText.end(), szCell, szCell + ccCell);
+			}
+		}
+		aText.push_back(TEXT('\0'));
+	}
+	aOffset.push_back(aText.size());
+
+	// 第一次: 計算各三字元組的列數 (同一列只計一次)
+	for (int nRow = 0; nRow < nRows; ++nRow) {
+		CollectTrigram(&aText[aOffset[nRow]], &aGram);
+		for (size_t i = 0; i < aGram.size(); ++i) {
+			SSPOSTING& post = mapTrigram[aGram[i]];
+			++post.nCount;
+		}
+	}
+
+	// 配置各列表位置
+	size_t nTotal = 0;
+	for (auto& it : mapTrigram) {
+		it.second.nStart = nTotal;
+		nTotal += it.second.nCount;
+		it.second.nCount = 0;
+	}
+	aPosting.resize(nTotal);
+
+	// 第二次: 依列順序填入, 各列表自然遞增
+	for (int nRow = 0; nRow < nRows; ++nRow) {
+		CollectTrigram(&aText[aOffset[nRow]], &aGram);
+		for (size_t i = 0; i < aGram.size(); ++i) {
+			SSPOSTING& post = mapTrigram.find(aGram[i])->second;
+			aPosting[post.nStart + post.nCount++] = nRow;
+		}
+	}
+
+	::EnterCriticalSection(&m_csSearch);
+	m_aText.swap(aText);
+	m_aOffset.swap(aOffset);
+	m_aPosting.swap(aPosting);
+	m_mapTrigram.swap(mapTrigram);
+	m_strLast.clear();
+	m_aLast.clear();
+	m_bLastValid = FALSE;
+	::LeaveCriticalSection(&m_csSearch);
+	return TRUE;
+}
+
+//! 清除篩選索引
+void CxFrameListFilter::Clear()
+{
+	::EnterCriticalSection(&m_csSearch);
+	std::vector<TCHAR>().swap(m_aText);
+	std::vector<size_t>().swap(m_aOffset);
+	std::vector<int>().swap(m_aPosting);
+	std::unordered_map<ULONGLONG, SSPOSTING>().swap(m_mapTrigram);
+	m_strLast.clear();
+	std::vector<int>().swap(m_aLast);
+	m_bLastValid = FALSE;
+	::LeaveCriticalSection(&m_csSearch);
+}
+
+/**
+ * @brief	篩選 (同步執行)
+ * @param	[in]  szQueryPtr	查詢文字 (不區分大小寫), NULL 或空字串表示全部列
+ * @param	[out] aRowPtr		取得符合的來源列索引 (遞增)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			參數錯誤返回零(zero)
+ * @remark	可於任何執行緒調用; 與非同步模式的篩選共用上一次的結果.
+ */
+BOOL CxFrameListFilter::Search(LPCTSTR szQueryPtr, std::vector<int>* aRowPtr)
+{
+	if (aRowPtr == NULL)
+		return FALSE;
+
+	TSTRING strQuery(szQueryPtr != NULL ? szQueryPtr : TEXT(""));
+	FoldText(&strQuery);
+
+	::EnterCriticalSection(&m_csSearch);
+	auto bRet = this->SearchCore(strQuery, aRowPtr, 0);
+	::LeaveCriticalSection(&m_csSearch);
+	return bRet;
+}
+
+/**
+ * @brief	開始非同步模式
+ * @param	[in] hWnd		結果通知視窗
+ * @param	[in] uMessage	結果通知訊息, 如: WM_APP + n
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			已在執行中或建立執行緒池物件失敗返回零(zero)
+ * @remark	篩選完成時 PostMessage(hWnd, uMessage, nSerial, 0), nSerial 為查詢序號.
+ */
+BOOL CxFrameListFilter::Start(HWND hWnd, UINT uMessage)
+{
+	if (hWnd == NULL || m_bRunning)
+		return FALSE;
+
+	m_tpWork = ::CreateThreadpoolWork(StaticWorkProc, this, NULL);
+	if (m_tpWork == NULL)
+		return FALSE;
+
+	::EnterCriticalSection(&m_csLock);
+	m_hWnd = hWnd;
+	m_uMessage = uMessage;
+	m_strPending.clear();
+	m_nDone = m_nPending;
+	m_aResult.clear();
+	m_bResult = FALSE;
+	m_bBusy = FALSE;
+	m_bRunning = TRUE;
+	::LeaveCriticalSection(&m_csLock);
+	return TRUE;
+}
+
+/**
+ * @brief	停止非同步模式
+ * @remark	放棄執行中的篩選並等待完成後返回; 未取出的結果一併清除.
+ */
+void CxFrameListFilter::Stop()
+{
+	if (!m_bRunning)
+		return;
+
+	::EnterCriticalSection(&m_csLock);
+	m_bRunning = FALSE;
+	::InterlockedIncrement(&m_nPending);
+	::LeaveCriticalSection(&m_csLock);
+
+	::WaitForThreadpoolWorkCallbacks(m_tpWork, TRUE);
+	::CloseThreadpoolWork(m_tpWork);
+	m_tpWork = NULL;
+
+	::EnterCriticalSection(&m_csLock);
+	m_strPending.clear();
+	m_aResult.clear();
+	m_bResult = FALSE;
+	m_bBusy = FALSE;
+	m_hWnd = NULL;
+	::LeaveCriticalSection(&m_csLock);
+}
+
+/**
+ * @brief	是否為非同步模式
+ * @return	@c 型別: BOOL \n
+ *			非同步模式返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameListFilter::IsRunning()
+{
+	return m_bRunning;
+}
+
+/**
+ * @brief	提交查詢 (非同步模式)
+ * @param	[in] szQueryPtr	查詢文字 (不區分大小寫), NULL 或空字串表示全部列
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			未調用 Start 返回零(zero)
+ * @remark	立即返回; 只處理最新的查詢, 之前未完成的查詢被放棄, 不會送出結果; \n
+ *			之前已完成但尚未以 GetResult 取出的結果同時丟棄.
+ */
+BOOL CxFrameListFilter::Query(LPCTSTR szQueryPtr)
+{
+	if (!m_bRunning)
+		return FALSE;
+
+	TSTRING strQuery(szQueryPtr != NULL ? szQueryPtr : TEXT(""));
+	FoldText(&strQuery);
+
+	::EnterCriticalSection(&m_csLock);
+	m_strPending.swap(strQuery);
+	::InterlockedIncrement(&m_nPending);
+	// 尚未取出的結果屬於較舊的查詢, 丟棄
+	m_aResult.clear();
+	m_bResult = FALSE;
+	auto bSubmit = !m_bBusy;
+	m_bBusy = TRUE;
+	::LeaveCriticalSection(&m_csLock);
+
+	if (bSubmit) ::SubmitThreadpoolWork(m_tpWork);
+	return TRUE;
+}
+
+/**
+ * @brief	取出篩選結果 (非同步模式)
+ * @param	[out] aRowPtr	取得符合的來源列索引 (遞增), 以交換方式取出
+ * @return	@c 型別: BOOL \n
+ *			有新的結果返回非零值(non-zero) \n
+ *			沒有新的結果返回零(zero)
+ * @remark	多次通知只需取出一次, 取得的必為最新查詢的結果 (Query 會丟棄尚未取出的舊結果); \n
+ *			較舊查詢的通知可能在新查詢之後才送達, 此時返回零或最新查詢的結果.
+ */
+BOOL CxFrameListFilter::GetResult(std::vector<int>* aRowPtr)
+{
+	if (aRowPtr == NULL)
+		return FALSE;
+
+	::EnterCriticalSection(&m_csLock);
+	auto bRet = m_bResult;
+	if (bRet) {
+		aRowPtr->swap(m_aResult);
+		m_aResult.clear();
+		m_bResult = FALSE;
+	}
+	::LeaveCriticalSection(&m_csLock);
+	return bRet;
+}
+
+/**
+ * @brief	取得索引列數
+ * @return	@c 型別: int \n
+ *			建立索引時資料來源的列數
+ */
+int CxFrameListFilter::GetRowCount()
+{
+	::EnterCriticalSection(&m_csSearch);
+	auto nRows = m_aOffset.empty() ? 0 : static_cast<int>(m_aOffset.size() - 1);
+	::LeaveCriticalSection(&m_csSearch);
+	return nRows;
+}
+
+/**
+ * @brief	取得索引中不同三字元組的數量
+ * @return	@c 型別: size_t \n
+ *			三字元組數量
+ */
+size_t CxFrameListFilter::GetTrigramCount()
+{
+	::EnterCriticalSection(&m_csSearch);
+	auto nCount = m_mapTrigram.size();
+	::LeaveCriticalSection(&m_csSearch);
+	return nCount;
+}
+
+/**
+ * @brief	篩選 (調用前須取得 m_csSearch)
+ * @param	[in]  strQuery	查詢文字 (已轉為小寫)
+ * @param	[out] aRowPtr	取得符合的來源列索引 (遞增)
+ * @param	[in]  nSerial	查詢序號, 有更新的查詢時中止; 零(zero)表示不中止
+ * @return	@c 型別: BOOL \n
+ *			篩選完成返回非零值(non-zero) \n
+ *			因有更新的查詢而中止返回零(zero)
+ * @remark	查詢包含上一次的查詢時, 候選列以上一次的結果為上限. \n
+ *			三個字元以上的查詢以三字元組列表交集取得候選列, 再以子字串比對確認.
+ */
+BOOL CxFrameListFilter::SearchCore(const TSTRING& strQuery, std::vector<int>* aRowPtr, LONG nSerial)
+{
+	auto nRows = m_aOffset.empty() ? 0 : static_cast<int>(m_aOffset.size() - 1);
+	auto bBase = m_bLastValid && !m_strLast.empty() && strQuery.find(m_strLast) != TSTRING::npos;
+	auto bAll = BOOL(FALSE);
+	std::vector<int> aCand;
+	std::vector<const SSPOSTING*> aList;
+
+	aRowPtr->clear();
+
+	for (;;) {
+		if (strQuery.empty()) {
+			// 空查詢: 全部列
+			aRowPtr->resize(static_cast<size_t>(nRows));
+			for (int i = 0; i < nRows; ++i) (*aRowPtr)[i] = i;
+			break;
+		}
+
+		// 取得查詢的三字元組列表, 任一不存在即無符合的列
+		auto bNone = BOOL(FALSE);
+		for (size_t i = 0; i + 2 < strQuery.size(); ++i) {
+			auto ullGram = MakeTrigram(&strQuery[i]);
+			if (ullGram == 0) continue;
+
+			auto it = m_mapTrigram.find(ullGram);
+			if (it == m_mapTrigram.end()) {
+				bNone = TRUE;
+				break;
+			}
+			aList.push_back(&it->second);
+		}
+		if (bNone) break;
+
+		// 由短至長求交集, 先處理較短的列表使候選列快速減少
+		std::sort(aList.begin(), aList.end(), [](const SSPOSTING* aPtr, const SSPOSTING* bPtr) {
+			return aPtr->nCount != bPtr->nCount ? aPtr->nCount < bPtr->nCount : aPtr < bPtr;
+		});
+		aList.erase(std::unique(aList.begin(), aList.end()), aList.end());
+
+		if (aList.empty()) {
+			if (bBase) aCand = m_aLast;
+			else bAll = TRUE;
+		}
+		else if (bBase && m_aLast.size() <= aList[0]->nCount) {
+			aCand = m_aLast;
+		}
+		else {
+			aCand.assign(m_aPosting.begin() + aList[0]->nStart, m_aPosting.begin() + aList[0]->nStart + aList[0]->nCount);
+			if (bBase) Intersect(&aCand, m_aLast.data(), m_aLast.size());
+		}
+		for (size_t i = 1; i < aList.size() && !aCand.empty(); ++i)
+			Intersect(&aCand, &m_aPosting[aList[i]->nStart], aList[i]->nCount);
+
+		// 子字串比對確認
+		size_t nCand = bAll ? static_cast<size_t>(nRows) : aCand.size();
+		for (size_t i = 0; i < nCand; ++i) {
+			if ((i % LISTFILTER_CHECK_ROWS) == 0 && this->IsCancel(nSerial)) {
+				aRowPtr->clear();
+				return FALSE;
+			}
+
+			auto nRow = bAll ? static_cast<int>(i) : aCand[i];
+			if (::_tcsstr(&m_aText[m_aOffset[nRow]], strQuery.c_str()) != NULL)
+				aRowPtr->push_back(nRow);
+		}
+		break;
+	}
+
+	m_strLast = strQuery;
+	m_aLast = *aRowPtr;
+	m_bLastValid = TRUE;
+	return TRUE;
+}
+
+/**
+ * @brief	是否有更新的查詢
+ * @param	[in] nSerial	查詢序號, 零(zero)表示不中止
+ * @return	@c 型別: BOOL \n
+ *			有更新的查詢返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameListFilter::IsCancel(LONG nSerial)
+{
+	return nSerial != 0 && m_nPending != nSerial;
+}
+
+/**
+ * @brief	篩選工作 (執行緒池執行緒)
+ * @remark	處理至沒有新的查詢為止; 完成時已有更新的查詢則不送出結果.
+ */
+void CxFrameListFilter::WorkProc()
+{
+	for (;;) {
+		::EnterCriticalSection(&m_csLock);
+		if (!m_bRunning || m_nDone == m_nPending) {
+			m_bBusy = FALSE;
+			::LeaveCriticalSection(&m_csLock);
+			break;
+		}
+		TSTRING strQuery(m_strPending);
+		LONG nSerial = m_nPending;
+		m_nDone = nSerial;
+		::LeaveCriticalSection(&m_csLock);
+
+		std::vector<int> aRow;
+		::EnterCriticalSection(&m_csSearch);
+		auto bDone = this->SearchCore(strQuery, &aRow, nSerial);
+		::LeaveCriticalSection(&m_csSearch);
+		if (!bDone) continue;
+
+		auto bPost = BOOL(FALSE);
+		::EnterCriticalSection(&m_csLock);
+		if (m_bRunning && m_nPending == nSerial) {
+			m_aResult.swap(aRow);
+			m_bResult = TRUE;
+			bPost = TRUE;
+		}
+		::LeaveCriticalSection(&m_csLock);
+
+		if (bPost) ::PostMessage(m_hWnd, m_uMessage, static_cast<WPARAM>(nSerial), 0);
+	}
+}
+
+/**
+ * @brief	文字轉為小寫 (static)
+ * @param	[in,out] strTextPtr	文字
+ */
+void CxFrameListFilter::FoldText(TSTRING* strTextPtr)
+{
+	if (!strTextPtr->empty())
+		::CharLowerBuff(&(*strTextPtr)[0], static_cast<DWORD>(strTextPtr->size()));
+}
+
+/**
+ * @brief	取得一列文字中不重複的三字元組 (static)
+ * @param	[in]  szTextPtr	列文字 (已轉為小寫)
+ * @param	[out] aGramPtr	取得三字元組 (遞增, 不重複)
+ */
+void CxFrameListFilter::CollectTrigram(LPCTSTR szTextPtr, std::vector<ULONGLONG>* aGramPtr)
+{
+	aGramPtr->clear();
+	for (size_t i = 0; szTextPtr[i] != TEXT('\0') && szTextPtr[i + 1] != TEXT('\0') && szTextPtr[i + 2] != TEXT('\0'); ++i) {
+		auto ullGram = MakeTrigram(szTextPtr + i);
+		if (ullGram != 0) aGramPtr->push_back(ullGram);
+	}
+	std::sort(aGramPtr->begin(), aGramPtr->end());
+	aGramPtr->erase(std::unique(aGramPtr->begin(), aGramPtr->end()), aGramPtr->end());
+}
+
+/**
+ * @brief	兩個遞增列索引陣列求交集 (static)
+ * @param	[in,out] aRowPtr	候選列 (遞增), 只保留同時存在於 aListPtr 的列
+ * @param	[in]     aListPtr	列索引列表 (遞增)
+ * @param	[in]     nCount		列表長度
+ * @remark	列表遠長於候選列時以二分搜尋跳過, 否則逐一比對.
+ */
+void CxFrameListFilter::Intersect(std::vector<int>* aRowPtr, const int* aListPtr, size_t nCount)
+{
+	const int*	aEndPtr = aListPtr + nCount;
+	const int*	aPosPtr = aListPtr;
+	auto bSkip = nCount / 16 > aRowPtr->size();
+	size_t n = 0;
+
+	for (size_t i = 0; i < aRowPtr->size() && aPosPtr != aEndPtr; ++i) {
+		int nRow = (*aRowPtr)[i];
+		if (bSkip) {
+			aPosPtr = std::lower_bound(aPosPtr, aEndPtr, nRow);
+		}
+		else {
+			while (aPosPtr != aEndPtr && *aPosPtr < nRow) ++aPosPtr;
+		}
+		if (aPosPtr != aEndPtr && *aPosPtr == nRow)
+			(*aRowPtr)[n++] = nRow;
+	}
+	aRowPtr->resize(n);
+}
+
+/**
+ * @brief	三個字元組合為三字元組鍵值 (static)
+ * @param	[in] szTextPtr	文字位置 (至少三個字元)
+ * @return	@c 型別: ULONGLONG \n
+ *			三字元組鍵值 \n
+ *			包含欄位分隔字元返回零(zero)
+ */
+ULONGLONG CxFrameListFilter::MakeTrigram(LPCTSTR szTextPtr)
+{
+	ULONGLONG ullGram = 0;
+	for (int i = 0; i < 3; ++i) {
+		if (szTextPtr[i] == static_cast<TCHAR>(LISTFILTER_SEPARATOR))
+			return 0;
+		ullGram = (ullGram << 16) | static_cast<ULONGLONG>(static_cast<std::make_unsigned<TCHAR>::type>(szTextPtr[i]));
+	}
+	return ullGram;
+}
+
+/**
+ * @brief	篩選工作回呼函數 (static)
+ * @param	[in] tpInstance		回呼實體
+ * @param	[in] aContextPtr	CxFrameListFilter 物件指標
+ * @param	[in] tpWork			工作物件
+ */
+void CALLBACK CxFrameListFilter::StaticWorkProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_WORK tpWork)
+{
+	UNREFERENCED_PARAMETER(tpInstance);
+	UNREFERENCED_PARAMETER(tpWork);
+	reinterpret_cast<CxFrameListFilter*>(aContextPtr)->WorkProc();
+}
@@ -0,0 +1,329 @@
+﻿/**************************************************************************//**
+ * @file	wframe_listsort.cc
+ * @brief	Win32 視窗操作 : ListView 資料多欄排序類別 - 成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_listsort.hh"
+
+//! CxFrameListSort 建構式
+CxFrameListSort::CxFrameListSort()
+	: m_srcPtr(NULL)
+	, m_aSourcePtr(NULL)
+	, m_nRows(0)
+	, m_aColumn()
+	, m_aChunk()
+	, m_aPerm()
+	, m_aTemp()
+	, m_aBound() { }
+
+//! CxFrameListSort 解構式
+CxFrameListSort::~CxFrameListSort() { }
+
+/**
+ * @brief	多欄穩定排序
+ * @param	[in]     srcPtr		資料來源
+ * @param	[in]     aKeyPtr	排序鍵陣列, 依陣列順序比較
+ * @param	[in]     nKeys		排序鍵數量 (1 ~ LISTSORT_MAX_KEYS)
+ * @param	[in,out] aRowPtr	待排序的來源列索引 (例如篩選結果), 返回排序後的列索引 \n
+ *							空陣列維持為空陣列; 排序全部列使用 SortAll
+ * @param	[in]     poolPtr	工作執行緒池 (可為 NULL)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			參數錯誤或工作被取消返回零(zero), 此時 aRowPtr 維持排序前的順序
+ * @remark	排序鍵相同的列維持原本的相對順序, 可依序以不同欄位排序, 或一次指定多個排序鍵. \n
+ *			排序期間資料來源不可變更; 使用執行緒池時資料來源的取值函數由多個執行緒同時調用.
+ */
+BOOL CxFrameListSort::Sort(CxFrameListSource* srcPtr, const SSSORTKEY* aKeyPtr, int nKeys, std::vector<int>* aRowPtr, CxFrameWorkPool* poolPtr)
+{
+	auto	err = BOOL(FALSE);
+	size_t	nChunks;
+	size_t	nRuns;
+
+	if (srcPtr == NULL || aKeyPtr == NULL || aRowPtr == NULL || nKeys <= 0 || nKeys > LISTSORT_MAX_KEYS)
+		return FALSE;
+	for (int i = 0; i < nKeys; ++i) {
+		if (aKeyPtr[i].eType < ESortText || aKeyPtr[i].eType >= ESortTypeEnd)
+			return FALSE;
+	}
+	if (poolPtr != NULL && poolPtr->GetThreadCount() == 0)
+		poolPtr = NULL;
+
+	if (aRowPtr->size() < 2)
+		return TRUE;
+
+	m_srcPtr = srcPtr;
+	m_aSourcePtr = aRowPtr->data();
+	m_nRows = aRowPtr->size();
+
+	// 配置排序鍵
+	m_aColumn.resize(nKeys);
+	for (int i = 0; i < nKeys; ++i) {
+		SSCOLUMN& col = m_aColumn[i];
+
+		col.key = aKeyPtr[i];
+		col.aNumber.clear();
+		col.aTime.clear();
+		col.aTextPtr.clear();
+		col.aTextLen.clear();
+		switch (col.key.eType) {
+		case ESortNumber:
+			col.aNumber.resize(m_nRows);
+			break;
+		case ESortTime:
+			col.aTime.resize(m_nRows);
+			break;
+		default:
+			col.aTextPtr.resize(m_nRows);
+			col.aTextLen.resize(m_nRows);
+			break;
+		}
+	}
+	nChunks = (m_nRows + LISTSORT_CHUNK - 1) / LISTSORT_CHUNK;
+	if (m_aChunk.size() < nChunks)
+		m_aChunk.resize(nChunks);
+
+	// 位置排列與區段
+	m_aPerm.resize(m_nRows);
+	for (size_t i = 0; i < m_nRows; ++i)
+		m_aPerm[i] = static_cast<int>(i);
+
+	nRuns = poolPtr != NULL ? poolPtr->GetThreadCount() : 1;
+	if (nRuns > nChunks)
+		nRuns = nChunks;
+	m_aBound.resize(nRuns + 1);
+	for (size_t i = 0; i <= nRuns; ++i)
+		m_aBound[i] = m_nRows * i / nRuns;
+
+	for (;;) {
+		if (poolPtr == NULL) {
+			for (size_t i = 0; i < nChunks; ++i)
+				this->ExtractChunk(i);
+			this->SortRun(0);
+			err = TRUE;
+			break;
+		}
+
+		if (!poolPtr->Run(StaticExtractProc, this, nChunks))
+			break;
+		if (!poolPtr->Run(StaticSortProc, this, nRuns))
+			break;
+
+		// 相鄰區段兩兩合併, 直到只剩一段
+		m_aTemp.resize(m_nRows);
+		while (m_aBound.size() > 2) {
+			size_t nPairs = m_aBound.size() / 2;	// (區段數 + 1) / 2
+
+			if (!poolPtr->Run(StaticMergeProc, this, nPairs))
+				break;
+			m_aPerm.swap(m_aTemp);
+
+			std::vector<size_t> aBound;
+			for (size_t i = 0; i < m_aBound.size() - 1; i += 2)
+				aBound.push_back(m_aBound[i]);
+			aBound.push_back(m_nRows);
+			m_aBound.swap(aBound);
+		}
+		err = m_aBound.size() <= 2;
+		break;
+	}
+
+	if (err) {
+		// 位置排列轉為來源列索引
+		m_aTemp.resize(m_nRows);
+		for (size_t i = 0; i < m_nRows; ++i)
+			m_aTemp[i] = m_aSourcePtr[m_aPerm[i]];
+		aRowPtr->swap(m_aTemp);
+	}
+
+	m_srcPtr = NULL;
+	m_aSourcePtr = NULL;
+	return err;
+}
+
+/**
+ * @brief	多欄穩定排序資料來源的全部列
+ * @param	[in]  srcPtr	資料來源
+ * @param	[in]  aKeyPtr	排序鍵陣列, 依陣列順序比較
+ * @param	[in]  nKeys		排序鍵數量 (1 ~ LISTSORT_MAX_KEYS)
+ * @param	[out] aRowPtr	取得排序後的來源列索引
+ * @param	[in]  poolPtr	工作執行緒池 (可為 NULL)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			參數錯誤或工作被取消返回零(zero), 此時 aRowPtr 為未排序的全部列
+ * @remark	以 0 ~ GetRowCount() - 1 填入 aRowPtr 後調用 Sort.
+ */
+BOOL CxFrameListSort::SortAll(CxFrameListSource* srcPtr, const SSSORTKEY* aKeyPtr, int nKeys, std::vector<int>* aRowPtr, CxFrameWorkPool* poolPtr)
+{
+	if (srcPtr == NULL || aRowPtr == NULL)
+		return FALSE;
+
+	int nCount = srcPtr->GetRowCount();
+	aRowPtr->resize(nCount > 0 ? static_cast<size_t>(nCount) : 0);
+	for (int i = 0; i < nCount; ++i)
+		(*aRowPtr)[i] = i;
+	return this->Sort(srcPtr, aKeyPtr, nKeys, aRowPtr, poolPtr);
+}
+
+/**
+ * @brief	釋放排序鍵與工作緩衝區
+ * @remark	緩衝區平時保留至下次排序重複使用, 不再排序時可調用此函數釋放記憶體.
+ */
+void CxFrameListSort::Clear()
+{
+	std::vector<SSCOLUMN>().swap(m_aColumn);
+	std::vector<SSCHUNK>().swap(m_aChunk);
+	std::vector<int>().swap(m_aPerm);
+	std::vector<int>().swap(m_aTemp);
+	std::vector<size_t>().swap(m_aBound);
+	m_nRows = 0;
+}
+
+/**
+ * @brief	取得一個區塊的排序鍵
+ * @param	[in] idxChunk	區塊索引, 處理位置 [idxChunk * LISTSORT_CHUNK, +LISTSORT_CHUNK)
+ * @remark	文字排序鍵先寫入區塊緩衝區並記錄位置, 緩衝區不再變動後才轉換為位址.
+ */
+void CxFrameListSort::ExtractChunk(size_t idxChunk)
+{
+	TCHAR	szCell[LISTSORT_TEXT_MAX];
+	BYTE	aSortKey[LISTSORT_TEXT_MAX * 8];
+	SSCHUNK& chunk = m_aChunk[idxChunk];
+	size_t	idxFirst = idxChunk * LISTSORT_CHUNK;
+	size_t	idxLast = idxFirst + LISTSORT_CHUNK < m_nRows ? idxFirst + LISTSORT_CHUNK : m_nRows;
+
+	if (chunk.aKey.size() < m_aColumn.size())
+		chunk.aKey.resize(m_aColumn.size());
+	chunk.aOff.resize(idxLast - idxFirst);
+
+	for (size_t k = 0; k < m_aColumn.size(); ++k) {
+		SSCOLUMN& col = m_aColumn[k];
+		int nColumn = col.key.nColumn;
+
+		if (col.key.eType == ESortNumber) {
+			for (size_t i = idxFirst; i < idxLast; ++i) {
+				if (!m_srcPtr->GetCellNumber(m_aSourcePtr[i], nColumn, &col.aNumber[i]) || col.aNumber[i] != col.aNumber[i])
+					col.aNumber[i] = -HUGE_VAL;		// 沒有數值 (或 NaN) 視為最小
+			}
+			continue;
+		}
+		if (col.key.eType == ESortTime) {
+			for (size_t i = idxFirst; i < idxLast; ++i) {
+				if (!m_srcPtr->GetCellTime(m_aSourcePtr[i], nColumn, &col.aTime[i]))
+					col.aTime[i] = 0;
+			}
+			continue;
+		}
+
+		// 文字: LCMapStringEx 排序鍵, 比較時只需 memcmp
+		DWORD dwFlags = LCMAP_SORTKEY | (col.key.eType == ESortTextNoCase ? NORM_IGNORECASE : 0);
+		std::vector<BYTE>& aKey = chunk.aKey[k];
+
+		aKey.clear();
+		for (size_t i = idxFirst; i < idxLast; ++i) {
+			int cbKey = 0;
+
+			chunk.aOff[i - idxFirst] = static_cast<DWORD>(aKey.size());
+			if (m_srcPtr->GetCellText(m_aSourcePtr[i], nColumn, szCell, LISTSORT_TEXT_MAX)) {
+				szCell[LISTSORT_TEXT_MAX - 1] = 0;
+#ifdef UNICODE
+				cbKey = ::LCMapStringEx(LOCALE_NAME_USER_DEFAULT, dwFlags, szCell, -1, reinterpret_cast<LPWSTR>(aSortKey), sizeof(aSortKey), NULL, NULL, 0);
+#else
+				cbKey = ::LCMapStringA(LOCALE_USER_DEFAULT, dwFlags, szCell, -1, reinterpret_cast<LPSTR>(aSortKey), sizeof(aSortKey));
+#endif
+			}
+			if (cbKey > 0)
+				aKey.insert(aKey.end(), aSortKey, aSortKey + cbKey);
+			col.aTextLen[i] = static_cast<DWORD>(cbKey > 0 ? cbKey : 0);
+		}
+		for (size_t i = idxFirst; i < idxLast; ++i)
+			col.aTextPtr[i] = aKey.data() + chunk.aOff[i - idxFirst];
+	}
+}
+
+/**
+ * @brief	排序一個區段
+ * @param	[in] idxRun	區段索引
+ */
+void CxFrameListSort::SortRun(size_t idxRun)
+{
+	std::stable_sort(m_aPerm.begin() + m_aBound[idxRun], m_aPerm.begin() + m_aBound[idxRun + 1], [this](int idxA, int idxB) {
+		return this->Compare(idxA, idxB) < 0;
+	});
+}
+
+/**
+ * @brief	合併相鄰的兩個區段至合併緩衝區
+ * @param	[in] idxPair	區段組索引, 合併第 idxPair*2 與 idxPair*2+1 段 (最後一段沒有相鄰區段時直接複製)
+ */
+void CxFrameListSort::MergeRun(size_t idxPair)
+{
+	size_t idxRun = idxPair * 2;
+	size_t idxFirst = m_aBound[idxRun];
+	size_t idxMiddle = m_aBound[idxRun + 1];
+	size_t idxLast = idxRun + 2 < m_aBound.size() ? m_aBound[idxRun + 2] : idxMiddle;
+
+	std::merge(m_aPerm.begin() + idxFirst, m_aPerm.begin() + idxMiddle,
+		m_aPerm.begin() + idxMiddle, m_aPerm.begin() + idxLast,
+		m_aTemp.begin() + idxFirst, [this](int idxA, int idxB) {
+		return this->Compare(idxA, idxB) < 0;
+	});
+}
+
+/**
+ * @brief	依全部排序鍵比較兩個位置
+ * @param	[in] idxA	位置 A
+ * @param	[in] idxB	位置 B
+ * @return	@c 型別: int \n A 在前返回負值, 相同返回零(zero), B 在前返回正值
+ */
+int CxFrameListSort::Compare(int idxA, int idxB) const
+{
+	for (const SSCOLUMN& col : m_aColumn) {
+		int nResult;
+
+		switch (col.key.eType) {
+		case ESortNumber:
+			nResult = col.aNumber[idxA] < col.aNumber[idxB] ? -1 : col.aNumber[idxA] > col.aNumber[idxB] ? 1 : 0;
+			break;
+		case ESortTime:
+			nResult = col.aTime[idxA] < col.aTime[idxB] ? -1 : col.aTime[idxA] > col.aTime[idxB] ? 1 : 0;
+			break;
+		default:
+		{
+			DWORD cbA = col.aTextLen[idxA];
+			DWORD cbB = col.aTextLen[idxB];
+
+			nResult = ::memcmp(col.aTextPtr[idxA], col.aTextPtr[idxB], cbA < cbB ? cbA : cbB);
+			if (nResult == 0)
+				nResult = cbA < cbB ? -1 : cbA > cbB ? 1 : 0;
+			break;
+		}
+		}
+
+		if (nResult != 0)
+			return col.key.bDescend ? -nResult : nResult;
+	}
+	return 0;
+}
+
+//! 取得排序鍵 (CxFrameWorkPool 工作項目: 區塊)
+void CALLBACK CxFrameListSort::StaticExtractProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker)
+{
+	UNREFERENCED_PARAMETER(idxWorker);
+	static_cast<CxFrameListSort*>(aParamPtr)->ExtractChunk(idxItem);
+}
+
+//! 分段排序 (CxFrameWorkPool 工作項目: 區段)
+void CALLBACK CxFrameListSort::StaticSortProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker)
+{
+	UNREFERENCED_PARAMETER(idxWorker);
+	static_cast<CxFrameListSort*>(aParamPtr)->SortRun(idxItem);
+}
+
+//! 合併區段 (CxFrameWorkPool 工作項目: 區段組)
+void CALLBACK CxFrameListSort::StaticMergeProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker)
+{
+	UNREFERENCED_PARAMETER(idxWorker);
+	static_cast<CxFrameListSort*>(aParamPtr)->MergeRun(idxItem);
+}
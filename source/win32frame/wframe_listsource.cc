@@ -0,0 +1,317 @@
+﻿/**************************************************************************//**
+ * @file	wframe_listsource.cc
+ * @brief	Win32 視窗操作 : ListView 虛擬模式資料來源類別 - 成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_listsource.hh"
+
+//! CxFrameListSource 建構式
+CxFrameListSource::CxFrameListSource() { }
+
+//! CxFrameListSource 解構式
+CxFrameListSource::~CxFrameListSource() { }
+
+/**
+ * @fn		int CxFrameListSource::GetRowCount()
+ * @brief	取得列數 (純虛擬函數)
+ * @return	@c 型別: int \n 資料列數量
+ */
+
+/**
+ * @fn		BOOL CxFrameListSource::GetCellText(int nRow, int nCol, LPTSTR szTextPtr, int ccMax)
+ * @brief	取得欄位文字 (純虛擬函數)
+ * @param	[in]  nRow		列索引 (zero-base)
+ * @param	[in]  nCol		欄索引 (zero-base)
+ * @param	[out] szTextPtr	文字緩衝區, 由控制項提供
+ * @param	[in]  ccMax		緩衝區長度 (in TCHAR), 包含結尾字元
+ * @return	@c 型別: BOOL \n 有內容返回非零值(non-zero), 返回零(zero) 時顯示空白
+ * @remark	資料變更後至 CxFrameListview::UpdateDataSource 之前, nRow 可能超出目前列數, 須自行檢查.
+ */
+
+/**
+ * @brief	取得欄位圖示索引
+ * @param	[in] nRow	列索引 (zero-base)
+ * @param	[in] nCol	欄索引 (zero-base)
+ * @return	@c 型別: int \n 影像清單索引, 預設返回 I_IMAGENONE (不顯示圖示)
+ */
+int CxFrameListSource::GetCellImage(int nRow, int nCol)
+{
+	UNREFERENCED_PARAMETER(nRow);
+	UNREFERENCED_PARAMETER(nCol);
+	return I_IMAGENONE;
+}
+
+/**
+ * @brief	取得欄位數值 (排序使用)
+ * @param	[in]  nRow		列索引 (zero-base)
+ * @param	[in]  nCol		欄索引 (zero-base)
+ * @param	[out] dValuePtr	數值
+ * @return	@c 型別: BOOL \n 有數值返回非零值(non-zero), 否則返回零(zero), 排序時視為最小
+ * @remark	預設由 GetCellText 轉換, 略過千位分隔符號 (,); 資料本身為數值時衍生類別應直接提供.
+ */
+BOOL CxFrameListSource::GetCellNumber(int nRow, int nCol, double* dValuePtr)
+{
+	TCHAR	szCell[LISTSORT_TEXT_MAX];
+	TCHAR	szDigit[LISTSORT_TEXT_MAX];
+	LPTSTR	szEndPtr = NULL;
+	int		ccDigit = 0;
+
+	if (dValuePtr == NULL || !this->GetCellText(nRow, nCol, szCell, LISTSORT_TEXT_MAX))
+		return FALSE;
+
+	szCell[LISTSORT_TEXT_MAX - 1] = 0;
+	for (LPCTSTR szPtr = szCell; *szPtr != 0; ++szPtr) {
+		if (*szPtr != TEXT(',') && *szPtr != TEXT(' '))
+			szDigit[ccDigit++] = *szPtr;
+	}
+	szDigit[ccDigit] = 0;
+
+	*dValuePtr = ::_tcstod(szDigit, &szEndPtr);
+	return szEndPtr != szDigit;
+}
+
+/**
+ * @brief	取得欄位時間 (排序使用)
+ * @param	[in]  nRow			列索引 (zero-base)
+ * @param	[in]  nCol			欄索引 (zero-base)
+ * @param	[out] ullTimePtr	時間 (FILETIME, 100 ns)
+ * @return	@c 型別: BOOL \n 有時間返回非零值(non-zero), 否則返回零(zero), 排序時視為最小
+ * @remark	預設由 GetCellText 依序取得 年 月 日 [時 分 秒] 數字 (分隔符號不限, 例如 2018-07-25 13:05:09); \n
+ *			其他格式或資料本身為時間時衍生類別應直接提供.
+ */
+BOOL CxFrameListSource::GetCellTime(int nRow, int nCol, ULONGLONG* ullTimePtr)
+{
+	TCHAR		szCell[LISTSORT_TEXT_MAX];
+	WORD		aField[6] = { 0 };
+	int			nField = 0;
+	SYSTEMTIME	st;
+	FILETIME	ft;
+
+	if (ullTimePtr == NULL || !this->GetCellText(nRow, nCol, szCell, LISTSORT_TEXT_MAX))
+		return FALSE;
+
+	szCell[LISTSORT_TEXT_MAX - 1] = 0;
+	for (LPCTSTR szPtr = szCell; *szPtr != 0 && nField < 6; ) {
+		if (*szPtr < TEXT('0') || *szPtr > TEXT('9')) {
+			++szPtr;
+			continue;
+		}
+		UINT uValue = 0;
+		while (*szPtr >= TEXT('0') && *szPtr <= TEXT('9')) {
+			uValue = uValue * 10 + static_cast<UINT>(*szPtr++ - TEXT('0'));
+			if (uValue > 0xFFFF)
+				return FALSE;
+		}
+		aField[nField++] = static_cast<WORD>(uValue);
+	}
+	if (nField < 3)
+		return FALSE;
+
+	::memset(&st, 0, sizeof(SYSTEMTIME));
+	st.wYear = aField[0];
+	st.wMonth = aField[1];
+	st.wDay = aField[2];
+	st.wHour = aField[3];
+	st.wMinute = aField[4];
+	st.wSecond = aField[5];
+	if (!::SystemTimeToFileTime(&st, &ft))
+		return FALSE;
+
+	*ullTimePtr = (static_cast<ULONGLONG>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+	return TRUE;
+}
+
+/**
+ * @brief	預先載入即將顯示的列 (LVN_ODCACHEHINT)
+ * @param	[in] nFrom	第一列索引 (zero-base)
+ * @param	[in] nTo	最後一列索引 (包含)
+ * @remark	控制項重繪前以一次通知告知可見範圍, 資料位於資料庫或檔案時可在此一次讀取整個範圍, \n
+ *			之後的 GetCellText 直接由快取取得. 預設不處理.
+ */
+void CxFrameListSource::PrepareRows(int nFrom, int nTo)
+{
+	UNREFERENCED_PARAMETER(nFrom);
+	UNREFERENCED_PARAMETER(nTo);
+}
+
+/**
+ * @brief	搜尋第一欄文字符合的列 (LVN_ODFINDITEM, 鍵盤輸入搜尋)
+ * @param	[in] nStart		開始搜尋的列索引 (zero-base), 到達結尾後由第一列繼續
+ * @param	[in] szTextPtr	搜尋文字
+ * @param	[in] bPartial	非零值(non-zero) 表示只比對開頭, 零(zero) 表示完全相同
+ * @return	@c 型別: int \n 符合的列索引, 找不到返回 -1
+ * @remark	預設以 GetCellText 逐列比對 (不分大小寫), 資料量大時衍生類別可改用自己的索引.
+ */
+int CxFrameListSource::FindRow(int nStart, LPCTSTR szTextPtr, BOOL bPartial)
+{
+	TCHAR szCell[MAX_PATH];
+	int nCount = this->GetRowCount();
+	int ccText;
+
+	if (szTextPtr == NULL || nCount <= 0)
+		return -1;
+	if (nStart < 0 || nStart >= nCount)
+		nStart = 0;
+
+	ccText = ::lstrlen(szTextPtr);
+	for (int i = 0; i < nCount; ++i) {
+		int nRow = (nStart + i) % nCount;
+
+		if (!this->GetCellText(nRow, 0, szCell, MAX_PATH))
+			continue;
+		if (bPartial) {
+			if (::lstrlen(szCell) >= ccText && ::CompareString(LOCALE_USER_DEFAULT, NORM_IGNORECASE, szCell, ccText, szTextPtr, ccText) == CSTR_EQUAL)
+				return nRow;
+		}
+		else if (::lstrcmpi(szCell, szTextPtr) == 0) {
+			return nRow;
+		}
+	}
+	return -1;
+}
+
+
+//! CxFrameListRowMap 建構式
+CxFrameListRowMap::CxFrameListRowMap()
+	: CxFrameListSource()
+	, m_srcPtr(NULL)
+	, m_aRow()
+	, m_bIdentity(TRUE) { }
+
+//! CxFrameListRowMap 解構式
+CxFrameListRowMap::~CxFrameListRowMap() { }
+
+/**
+ * @brief	設定來源, 並清除對照表
+ * @param	[in] srcPtr	來源 (不擁有), NULL 表示沒有資料
+ */
+void CxFrameListRowMap::SetSource(CxFrameListSource* srcPtr)
+{
+	m_srcPtr = srcPtr;
+	this->ResetRows();
+}
+
+/**
+ * @brief	取得來源
+ * @return	@c 型別: CxFrameListSource* \n 未設定返回 NULL
+ */
+CxFrameListSource* CxFrameListRowMap::GetSource() { return m_srcPtr; }
+
+/**
+ * @brief	設定列索引對照表
+ * @param	[in,out] aRowPtr	對照表, 內容以交換 (swap) 方式取得, 返回時為原本的對照表
+ * @remark	交換而不複製, 百萬列的結果也能立即套用; 返回的舊對照表可留待下次排序重複使用記憶體. \n
+ *			對照表中的索引必須小於來源列數.
+ */
+void CxFrameListRowMap::SetRows(std::vector<int>* aRowPtr)
+{
+	if (aRowPtr == NULL)
+		return;
+	m_aRow.swap(*aRowPtr);
+	m_bIdentity = FALSE;
+}
+
+//! 清除對照表, 直接對應來源的全部列
+void CxFrameListRowMap::ResetRows()
+{
+	m_aRow.clear();
+	m_bIdentity = TRUE;
+}
+
+/**
+ * @brief	取得列索引對照表
+ * @return	@c 型別: const std::vector<int>& \n 未設定 (IsIdentity) 時為空陣列
+ */
+const std::vector<int>& CxFrameListRowMap::GetRows() const { return m_aRow; }
+
+/**
+ * @brief	取得顯示列對應的來源列
+ * @param	[in] nRow	顯示列索引 (zero-base), 例如選取項目
+ * @return	@c 型別: int \n 來源列索引, 超出範圍返回 -1
+ */
+int CxFrameListRowMap::MapRow(int nRow) const
+{
+	if (m_bIdentity)
+		return nRow;
+	if (nRow < 0 || static_cast<size_t>(nRow) >= m_aRow.size())
+		return -1;
+	return m_aRow[nRow];
+}
+
+/**
+ * @brief	是否直接對應來源 (未設定對照表)
+ * @return	@c 型別: BOOL \n 未設定對照表返回非零值(non-zero)
+ */
+BOOL CxFrameListRowMap::IsIdentity() const { return m_bIdentity; }
+
+//! 取得列數 (對照表長度)
+int CxFrameListRowMap::GetRowCount()
+{
+	if (m_srcPtr == NULL)
+		return 0;
+	return m_bIdentity ? m_srcPtr->GetRowCount() : static_cast<int>(m_aRow.size());
+}
+
+//! 取得欄位文字 (轉交來源)
+BOOL CxFrameListRowMap::GetCellText(int nRow, int nCol, LPTSTR szTextPtr, int ccMax)
+{
+	int nSource = this->MapRow(nRow);
+	return m_srcPtr != NULL && nSource >= 0 && m_srcPtr->GetCellText(nSource, nCol, szTextPtr, ccMax);
+}
+
+//! 取得欄位圖示索引 (轉交來源)
+int CxFrameListRowMap::GetCellImage(int nRow, int nCol)
+{
+	int nSource = this->MapRow(nRow);
+	return m_srcPtr != NULL && nSource >= 0 ? m_srcPtr->GetCellImage(nSource, nCol) : I_IMAGENONE;
+}
+
+//! 取得欄位數值 (轉交來源)
+BOOL CxFrameListRowMap::GetCellNumber(int nRow, int nCol, double* dValuePtr)
+{
+	int nSource = this->MapRow(nRow);
+	return m_srcPtr != NULL && nSource >= 0 && m_srcPtr->GetCellNumber(nSource, nCol, dValuePtr);
+}
+
+//! 取得欄位時間 (轉交來源)
+BOOL CxFrameListRowMap::GetCellTime(int nRow, int nCol, ULONGLONG* ullTimePtr)
+{
+	int nSource = this->MapRow(nRow);
+	return m_srcPtr != NULL && nSource >= 0 && m_srcPtr->GetCellTime(nSource, nCol, ullTimePtr);
+}
+
+/**
+ * @brief	預先載入即將顯示的列
+ * @param	[in] nFrom	第一列索引 (zero-base)
+ * @param	[in] nTo	最後一列索引 (包含)
+ * @remark	對照後的來源列通常不連續, 以連續的來源列為一段, 逐段轉交來源.
+ */
+void CxFrameListRowMap::PrepareRows(int nFrom, int nTo)
+{
+	int nFirst = -1;
+	int nLast = -1;
+
+	if (m_srcPtr == NULL)
+		return;
+	if (m_bIdentity) {
+		m_srcPtr->PrepareRows(nFrom, nTo);
+		return;
+	}
+
+	for (int nRow = nFrom; nRow <= nTo; ++nRow) {
+		int nSource = this->MapRow(nRow);
+		if (nSource < 0)
+			continue;
+		if (nFirst >= 0 && nSource == nLast + 1) {
+			nLast = nSource;
+			continue;
+		}
+		if (nFirst >= 0)
+			m_srcPtr->PrepareRows(nFirst, nLast);
+		nFirst = nLast = nSource;
+	}
+	if (nFirst >= 0)
+		m_srcPtr->PrepareRows(nFirst, nLast);
+}
@@ -11,7 +11,8 @@
 CxFrameListview::CxFrameListview()
 	: CxFrameControl(ECtrlSysListView32)
 	, m_nSelectItemCount(0)
-	, m_nSelectItemIndex(0) { }
+	, m_nSelectItemIndex(0)
+	, m_srcPtr(NULL) { }
 
 //! CxFrameListview 解構式
 CxFrameListview::~CxFrameListview() { }
@@ -453,6 +454,71 @@ BOOL CxFrameListview::InsertItem(int nIndex, int nSub, LPTSTR szTextPtr)
 	return this->SendMessage(LVM_INSERTITEM, wParam, lParam) != -1;
 }
 
+/**
+ * @brief	重繪指定範圍的項目
+ * @param	[in] nFirst	第一個項目索引 (zero-base)
+ * @param	[in] nLast	最後一個項目索引 (包含)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 若失敗返回零(zero)
+ * @remark	虛擬模式下資料來源部分內容變更時使用, 只重繪可見範圍內的項目.
+ */
+BOOL CxFrameListview::RedrawItems(int nFirst, int nLast)
+{
+	// LVM_REDRAWITEMS
+	WPARAM wParam = static_cast<WPARAM>(nFirst);	// 第一個項目索引
+	LPARAM lParam = static_cast<LPARAM>(nLast);		// 最後一個項目索引
+	if (this->SendMessage(LVM_REDRAWITEMS, wParam, lParam) == 0)
+		return FALSE;
+	return ::UpdateWindow(m_hWnd);
+}
+
+/**
+ * @brief	於結尾批次新增項目 (第一欄)
+ * @param	[in] aTextPtr	字串位址陣列, NULL 元素略過
+ * @param	[in] nCount		陣列元素數量
+ * @return	@c 型別: int \n
+ *			成功新增的項目數量; 虛擬模式返回零(zero), 錯誤碼為 ERROR_INVALID_FUNCTION
+ * @remark	以 InitStorage 預先配置, 新增期間暫停重繪; 其他欄位可在同一個 CxFrameUpdateScope 內以 SetItemText 設定.
+ */
+int CxFrameListview::AddItems(const LPCTSTR* aTextPtr, int nCount)
+{
+	int nIndex;
+	int nAdded = 0;
+
+	if (aTextPtr == NULL || nCount <= 0)
+		return 0;
+	if (this->IsVirtual()) {
+		this->SetError(ERROR_INVALID_FUNCTION);
+		return 0;
+	}
+
+	CxFrameUpdateScope scope(*this);
+	nIndex = this->GetItemCount();
+	this->InitStorage(nCount);
+	for (int i = 0; i < nCount; ++i) {
+		if (aTextPtr[i] == NULL)
+			continue;
+		if (!this->InsertItem(nIndex + nAdded, 0, const_cast<LPTSTR>(aTextPtr[i])))
+			break;
+		++nAdded;
+	}
+	return nAdded;
+}
+
+/**
+ * @brief	預先配置項目記憶體
+ * @param	[in] nItems	即將新增的項目數量
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 若失敗返回零(zero)
+ * @remark	以目前項目數量加上 nItems 調用 LVM_SETITEMCOUNT; 虛擬模式請改用 UpdateDataSource.
+ */
+BOOL CxFrameListview::InitStorage(int nItems)
+{
+	if (nItems <= 0)
+		return TRUE;
+	return this->SetItemCount(this->GetItemCount() + nItems);
+}
+
 /**
  * @brief	設定背景顏色
  * @param	[in] dwColor 顏色(RGB)
@@ -523,6 +589,25 @@ void CxFrameListview::SetExListViewStyle(DWORD dwExStyle)
 	this->SendMessage(LVM_SETEXTENDEDLISTVIEWSTYLE, wParam, lParam);
 }
 
+/**
+ * @brief	設定項目數量
+ * @param	[in] nCount		項目數量
+ * @param	[in] dwFlags	虛擬模式的更新方式 (預設 LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL)
+ *						- LVSICF_NOINVALIDATEALL	只重繪受影響的可見項目
+ *						- LVSICF_NOSCROLL			不改變捲動位置
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 若失敗返回零(zero)
+ * @remark	虛擬模式下只設定數量, 與項目多寡無關; 一般模式下為預先配置項目的記憶體 (dwFlags 無作用).
+ * @see		https://docs.microsoft.com/en-us/windows/desktop/controls/lvm-setitemcount
+ */
+BOOL CxFrameListview::SetItemCount(int nCount, DWORD dwFlags)
+{
+	// LVM_SETITEMCOUNT
+	WPARAM wParam = static_cast<WPARAM>(nCount);	// 項目數量
+	LPARAM lParam = static_cast<LPARAM>(dwFlags);	// 更新方式 (只用於虛擬模式)
+	return this->SendMessage(LVM_SETITEMCOUNT, wParam, lParam) != 0;
+}
+
 /**
  * @brief	設定項目(Item) 被選取狀態
  * @param	[in] nIndex		項目索引 (zero-base)
@@ -626,14 +711,53 @@ BOOL CxFrameListview::SetTextColor(COLORREF dwColor)
  *			操作失敗可調用 CxFrameObject::GetError() 或衍生類別取得失敗錯誤碼.
  */
 BOOL CxFrameListview::CreateListview(LPCTSTR szCaptionPtr, int x, int y, int wd, int ht, HWND hParent, int idItem, HINSTANCE hInst, WNDPROC fnWndProc)
+{
+	UNREFERENCED_PARAMETER(szCaptionPtr);
+	UNREFERENCED_PARAMETER(hInst);
+	return this->CreateReportView(x, y, wd, ht, hParent, idItem, LVS_REPORT | LVS_SHOWSELALWAYS, fnWndProc); // LVS_EDITLABELS;
+}
+
+/**
+ * @brief	建立虛擬模式 (LVS_OWNERDATA) List view controller
+ * @param	[in] x				起始座標 (對應父視窗左上座標 X)
+ * @param	[in] y				起始座標 (對應父視窗左上座標 Y)
+ * @param	[in] wd				寬度
+ * @param	[in] ht				高度
+ * @param	[in] hParent		父視窗 Handle
+ * @param	[in] idItem			控制項 ID
+ * @param	[in] hInst			Handle of module, 若此值為 NULL, 將視為使用現行的程序模組
+ * @param	[in] fnWndProc		pointer of callback function
+ * @return	@c BOOL \n
+ *			函數操作成功返回非零值(non-zero), 操作失敗返回零(zero)\n
+ *			操作失敗可調用 CxFrameObject::GetError() 或衍生類別取得失敗錯誤碼.
+ * @remark	LVS_OWNERDATA 只能在建立時指定; 建立後以 SetDataSource 綁定資料來源.
+ */
+BOOL CxFrameListview::CreateVirtualListview(int x, int y, int wd, int ht, HWND hParent, int idItem, HINSTANCE hInst, WNDPROC fnWndProc)
+{
+	UNREFERENCED_PARAMETER(hInst);
+	return this->CreateReportView(x, y, wd, ht, hParent, idItem, LVS_REPORT | LVS_SHOWSELALWAYS | LVS_OWNERDATA, fnWndProc);
+}
+
+/**
+ * @brief	建立 Report 樣式 List view controller (CreateListview, CreateVirtualListview 共用)
+ * @param	[in] x			起始座標 (對應父視窗左上座標 X)
+ * @param	[in] y			起始座標 (對應父視窗左上座標 Y)
+ * @param	[in] wd			寬度
+ * @param	[in] ht			高度
+ * @param	[in] hParent	父視窗 Handle
+ * @param	[in] idItem		控制項 ID
+ * @param	[in] dwStyle	ListView 樣式
+ * @param	[in] fnWndProc	pointer of callback function
+ * @return	@c BOOL \n
+ *			函數操作成功返回非零值(non-zero), 操作失敗返回零(zero)
+ */
+BOOL CxFrameListview::CreateReportView(int x, int y, int wd, int ht, HWND hParent, int idItem, DWORD dwStyle, WNDPROC fnWndProc)
 {
 	auto	err = BOOL(FALSE);
 	SSCTRL	ctrl;
 
-	UNREFERENCED_PARAMETER(szCaptionPtr);
-
 	for (;;) {
-		if ((hInst = ::GetModuleHandle(NULL)) == NULL) {
+		if (::GetModuleHandle(NULL) == NULL) {
 			this->SetError(::GetLastError());
 			break;
 		}
@@ -651,7 +775,7 @@ BOOL CxFrameListview::CreateListview(LPCTSTR szCaptionPtr, int x, int y, int wd,
 		ctrl.hParent = hParent;
 		ctrl.eType = ECtrlSysListView32;
 		ctrl.szNamePtr = NULL;
-		ctrl.dwStyle = LVS_REPORT | LVS_SHOWSELALWAYS; // LVS_EDITLABELS;
+		ctrl.dwStyle = dwStyle;
 		ctrl.dwExStyle = 0;
 		ctrl.iPosx = x;
 		ctrl.iPosy = y;
@@ -693,6 +817,121 @@ BOOL CxFrameListview::CreateListviewEx(HINSTANCE hInst, HWND hParent, int idItem
 	return this->CreateControllerEx(hInst, hParent, idItem, fnWndProc);
 }
 
+/**
+ * @brief	是否為虛擬模式 (LVS_OWNERDATA)
+ * @return	@c 型別: BOOL \n 控制項以 LVS_OWNERDATA 建立返回非零值(non-zero)
+ */
+BOOL CxFrameListview::IsVirtual()
+{
+	return (this->GetStyle() & LVS_OWNERDATA) != 0;
+}
+
+/**
+ * @brief	綁定虛擬模式資料來源
+ * @param	[in] srcPtr	資料來源, NULL 表示解除綁定
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			控制項不是虛擬模式返回零(zero), 錯誤碼為 ERROR_INVALID_FUNCTION
+ * @remark	不擁有資料來源, 資料來源必須在解除綁定或控制項結束前保持有效. \n
+ *			綁定後立即以 UpdateDataSource 設定列數.
+ */
+BOOL CxFrameListview::SetDataSource(CxFrameListSource* srcPtr)
+{
+	if (!this->IsVirtual()) {
+		this->SetError(ERROR_INVALID_FUNCTION);
+		return FALSE;
+	}
+	m_srcPtr = srcPtr;
+	return this->UpdateDataSource();
+}
+
+/**
+ * @brief	取得綁定的資料來源
+ * @return	@c 型別: CxFrameListSource* \n 未綁定返回 NULL
+ */
+CxFrameListSource* CxFrameListview::GetDataSource() { return m_srcPtr; }
+
+/**
+ * @brief	資料來源內容或列數變更後更新控制項
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 若失敗返回零(zero)
+ * @remark	以 LVM_SETITEMCOUNT 設定列數並重繪可見範圍, 與列數多寡無關; 捲動位置不變.
+ */
+BOOL CxFrameListview::UpdateDataSource()
+{
+	int nCount = m_srcPtr != NULL ? m_srcPtr->GetRowCount() : 0;
+
+	if (!this->SetItemCount(nCount < 0 ? 0 : nCount, LVSICF_NOSCROLL))
+		return FALSE;
+	return ::InvalidateRect(m_hWnd, NULL, FALSE);
+}
+
+/**
+ * @brief	處理虛擬模式的 WM_NOTIFY 通知
+ * @param	[in]  nmPtr		WM_NOTIFY 的 lParam
+ * @param	[out] resultPtr	保存視窗程序的返回值, 可為 NULL
+ * @return	@c 型別: BOOL \n
+ *			通知來自此控制項且已處理返回非零值(non-zero), 否則返回零(zero), 由父視窗自行處理
+ * @remark	處理下列通知:
+ *			- LVN_GETDISPINFO	由資料來源取得欄位文字與圖示, 直接寫入控制項提供的緩衝區
+ *			- LVN_ODCACHEHINT	以 PrepareRows 通知即將顯示的範圍, 可一次載入
+ *			- LVN_ODFINDITEM	以 FindRow 搜尋鍵盤輸入的文字
+ *
+ * @code
+ *	case WM_NOTIFY:
+ *	{
+ *		LRESULT lResult = 0;
+ *		if (m_listview.NotifyDataSource(reinterpret_cast<LPNMHDR>(lParam), &lResult))
+ *			return lResult;
+ *		break;
+ *	}
+ * @endcode
+ */
+BOOL CxFrameListview::NotifyDataSource(LPNMHDR nmPtr, LRESULT* resultPtr)
+{
+	LRESULT lResult = 0;
+
+	if (nmPtr == NULL || m_srcPtr == NULL || nmPtr->hwndFrom != m_hWnd)
+		return FALSE;
+
+	switch (nmPtr->code) {
+	case LVN_GETDISPINFO:
+	{
+		LPLVITEM lviPtr = &reinterpret_cast<NMLVDISPINFO*>(nmPtr)->item;
+
+		if ((lviPtr->mask & LVIF_TEXT) != 0 && lviPtr->pszText != NULL && lviPtr->cchTextMax > 0) {
+			if (!m_srcPtr->GetCellText(lviPtr->iItem, lviPtr->iSubItem, lviPtr->pszText, lviPtr->cchTextMax))
+				lviPtr->pszText[0] = 0;
+			lviPtr->pszText[lviPtr->cchTextMax - 1] = 0;
+		}
+		if ((lviPtr->mask & LVIF_IMAGE) != 0)
+			lviPtr->iImage = m_srcPtr->GetCellImage(lviPtr->iItem, lviPtr->iSubItem);
+		break;
+	}
+	case LVN_ODCACHEHINT:
+	{
+		LPNMLVCACHEHINT hintPtr = reinterpret_cast<LPNMLVCACHEHINT>(nmPtr);
+		m_srcPtr->PrepareRows(hintPtr->iFrom, hintPtr->iTo);
+		break;
+	}
+	case LVN_ODFINDITEM:
+	{
+		LPNMLVFINDITEM findPtr = reinterpret_cast<LPNMLVFINDITEM>(nmPtr);
+
+		lResult = -1;
+		if ((findPtr->lvfi.flags & (LVFI_STRING | LVFI_PARTIAL)) != 0 && findPtr->lvfi.psz != NULL)
+			lResult = m_srcPtr->FindRow(findPtr->iStart, findPtr->lvfi.psz, (findPtr->lvfi.flags & LVFI_PARTIAL) != 0);
+		break;
+	}
+	default:
+		return FALSE;
+	}
+
+	if (resultPtr != NULL)
+		*resultPtr = lResult;
+	return TRUE;
+}
+
 
 /**
  * @brief	使用自訂 ListView Report 預設樣式
@@ -731,6 +970,7 @@ void CxFrameListview::DefaultReportStyle()
 void CxFrameListview::WindowInTheEnd()
 {
 	// TODO: 結束視窗處理
+	m_srcPtr = NULL;
 	CxFrameControl::WindowInTheEnd();
 }
 
@@ -0,0 +1,359 @@
+﻿/**************************************************************************//**
+ * @file	wframe_memcache.cc
+ * @brief	程序記憶體頁快取類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_memcache.hh"
+
+#define MEMCACHE_NIL	static_cast<DWORD>(-1)	//!< 無效項目索引
+
+//! CxFrameMemoryCache 建構式
+CxFrameMemoryCache::CxFrameMemoryCache()
+	: m_procPtr(NULL)
+	, m_idxHead(MEMCACHE_NIL)
+	, m_idxTail(MEMCACHE_NIL)
+	, m_nUsed(0)
+	, m_dwEpoch(1)
+{
+	::memset(&m_stat, 0, sizeof(m_stat));
+}
+
+//! CxFrameMemoryCache 解構式
+CxFrameMemoryCache::~CxFrameMemoryCache() { this->Close(); }
+
+/**
+ * @brief	建立快取
+ * @param	[in] procPtr	已開啟的目標程序物件
+ * @param	[in] cbBudget	快取容量上限 (in Byte), 以 MEMCACHE_PAGE_SIZE 為單位, 至少一頁
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			函數操作失敗返回零(zero)
+ * @remark	重複調用會捨棄原有快取內容, 可用於調整容量上限.
+ */
+BOOL CxFrameMemoryCache::Create(CxFrameProcess* procPtr, SIZE_T cbBudget)
+{
+	this->Close();
+	if (procPtr == NULL)
+		return FALSE;
+
+	size_t nPages = cbBudget / MEMCACHE_PAGE_SIZE;
+	if (nPages == 0) nPages = 1;
+
+	m_procPtr = procPtr;
+	m_aPage.resize(nPages);
+	m_aData.resize(nPages * MEMCACHE_PAGE_SIZE);
+	m_mapPage.reserve(nPages);
+	return TRUE;
+}
+
+//! 關閉快取, 釋放全部快取頁
+void CxFrameMemoryCache::Close()
+{
+	m_aPage.clear();
+	m_aData.clear();
+	m_aStage.clear();
+	m_mapPage.clear();
+	m_idxHead = MEMCACHE_NIL;
+	m_idxTail = MEMCACHE_NIL;
+	m_nUsed = 0;
+	m_dwEpoch = 1;
+	m_procPtr = NULL;
+}
+
+/**
+ * @brief	讀取指定記憶體區資料 (經由快取)
+ * @param	[in]  aBasePtr	欲讀取目標位址
+ * @param	[out] aBuffPtr	欲讀取資料存放位址
+ * @param	[in]  uSize		欲讀取資料長度 (in Byte)
+ * @return	@c 型別: SIZE_T \n
+ *			讀取成功返回非零值(non-zero)為實際讀取資料長度 (單位 byte) \n
+ *			讀取失敗返回零(zero)
+ * @remark	與 CxFrameProcess::ReadMemory 用法相同. \n
+ *			範圍與略過範圍重疊、或超過快取容量一半時, 直接讀取不經由快取.
+ */
+SIZE_T CxFrameMemoryCache::ReadMemory(LPCVOID aBasePtr, LPVOID aBuffPtr, SIZE_T uSize)
+{
+	if (m_procPtr == NULL || aBuffPtr == NULL || uSize == 0)
+		return 0;
+
+	ULONG_PTR uStart = reinterpret_cast<ULONG_PTR>(aBasePtr);
+	ULONG_PTR uEnd = uStart + uSize;
+	ULONG_PTR uFirst = uStart & ~static_cast<ULONG_PTR>(MEMCACHE_PAGE_SIZE - 1);
+	size_t nPages = static_cast<size_t>((uEnd - uFirst + MEMCACHE_PAGE_SIZE - 1) / MEMCACHE_PAGE_SIZE);
+
+	if (nPages > m_aPage.size() / 2 || this->IsBypass(uStart, uEnd)) {
+		++m_stat.nBypass;
+		++m_stat.nRead;
+		return m_procPtr->ReadMemory(aBasePtr, aBuffPtr, uSize);
+	}
+
+	BYTE* aDstPtr = reinterpret_cast<BYTE*>(aBuffPtr);
+	ULONG_PTR uPage = uFirst;
+	while (uPage < uEnd) {
+		const BYTE* aSrcPtr;
+		SIZE_T cbValid;
+		size_t nRun = 1;
+
+		DWORD idx = this->Lookup(uPage);
+		if (idx != MEMCACHE_NIL) {
+			// 命中
+			aSrcPtr = this->PageData(idx);
+			cbValid = MEMCACHE_PAGE_SIZE;
+		}
+		else {
+			// 未命中, 連續未命中的頁面合併讀取
+			while (uPage + nRun * MEMCACHE_PAGE_SIZE < uEnd) {
+				auto it = m_mapPage.find(uPage + nRun * MEMCACHE_PAGE_SIZE);
+				if (it != m_mapPage.end() && m_aPage[it->second].dwEpoch == m_dwEpoch)
+					break;
+				++nRun;
+			}
+			cbValid = this->FillPages(uPage, nRun);
+			aSrcPtr = m_aStage.data();
+		}
+
+		// 複製與讀取範圍重疊的部分
+		ULONG_PTR uLow = uPage < uStart ? uStart : uPage;
+		ULONG_PTR uHigh = uPage + cbValid;
+		if (uHigh > uEnd) uHigh = uEnd;
+		if (uHigh > uLow)
+			::memcpy(aDstPtr + (uLow - uStart), aSrcPtr + (uLow - uPage), static_cast<size_t>(uHigh - uLow));
+
+		// 無法讀取的頁面, 返回已連續讀取的長度
+		if (cbValid < nRun * MEMCACHE_PAGE_SIZE)
+			return uHigh > uStart ? static_cast<SIZE_T>(uHigh - uStart) : 0;
+		uPage += nRun * MEMCACHE_PAGE_SIZE;
+	}
+	return uSize;
+}
+
+/**
+ * @brief	開始新的世代, 全部快取頁失效
+ * @remark	只遞增世代計數, 快取頁於下次讀取時才重新填入, 調用成本為 O(1).
+ */
+void CxFrameMemoryCache::NewEpoch()
+{
+	if (++m_dwEpoch != 0)
+		return;
+
+	// 世代計數溢位, 清除全部項目避免誤判
+	m_mapPage.clear();
+	m_idxHead = MEMCACHE_NIL;
+	m_idxTail = MEMCACHE_NIL;
+	m_nUsed = 0;
+	m_dwEpoch = 1;
+}
+
+/**
+ * @brief	使指定範圍的快取頁失效
+ * @param	[in] aBasePtr	起始位址
+ * @param	[in] uSize		長度 (in Byte)
+ * @remark	用於已知寫入目標程序記憶體後, 確保下次讀取取得最新資料.
+ */
+void CxFrameMemoryCache::Invalidate(LPCVOID aBasePtr, SIZE_T uSize)
+{
+	ULONG_PTR uStart = reinterpret_cast<ULONG_PTR>(aBasePtr);
+	ULONG_PTR uEnd = uStart + uSize;
+
+	for (ULONG_PTR uPage = uStart & ~static_cast<ULONG_PTR>(MEMCACHE_PAGE_SIZE - 1); uPage < uEnd; uPage += MEMCACHE_PAGE_SIZE) {
+		auto it = m_mapPage.find(uPage);
+		if (it != m_mapPage.end())
+			m_aPage[it->second].dwEpoch = m_dwEpoch - 1;
+	}
+}
+
+/**
+ * @brief	加入略過快取的位址範圍
+ * @param	[in] aBasePtr	起始位址
+ * @param	[in] uSize		長度 (in Byte)
+ * @remark	讀取範圍與略過範圍重疊時, 整段直接讀取, 適用於經常變動的欄位.
+ */
+void CxFrameMemoryCache::AddBypass(LPCVOID aBasePtr, SIZE_T uSize)
+{
+	SSBYPASS bypass;
+
+	bypass.uBase = reinterpret_cast<ULONG_PTR>(aBasePtr);
+	bypass.uEnd = bypass.uBase + uSize;
+	m_aBypass.push_back(bypass);
+}
+
+/**
+ * @brief	移除略過快取的位址範圍
+ * @param	[in] aBasePtr	調用 AddBypass 時指定的起始位址
+ */
+void CxFrameMemoryCache::RemoveBypass(LPCVOID aBasePtr)
+{
+	ULONG_PTR uBase = reinterpret_cast<ULONG_PTR>(aBasePtr);
+
+	for (size_t i = 0; i < m_aBypass.size(); ++i) {
+		if (m_aBypass[i].uBase == uBase) {
+			m_aBypass.erase(m_aBypass.begin() + i);
+			break;
+		}
+	}
+}
+
+//! 清除全部略過快取的位址範圍
+void CxFrameMemoryCache::ClearBypass() { m_aBypass.clear(); }
+
+/**
+ * @brief	取得統計資訊
+ * @param	[out] statPtr	統計資訊存放位址
+ */
+void CxFrameMemoryCache::GetStats(LPSSMEMCACHESTAT statPtr)
+{
+	if (statPtr == NULL)
+		return;
+
+	*statPtr = m_stat;
+	statPtr->cbUsed = static_cast<SIZE_T>(m_nUsed) * MEMCACHE_PAGE_SIZE;
+	statPtr->cbBudget = m_aPage.size() * MEMCACHE_PAGE_SIZE;
+}
+
+//! 重設統計資訊計數
+void CxFrameMemoryCache::ResetStats() { ::memset(&m_stat, 0, sizeof(m_stat)); }
+
+/**
+ * @brief	範圍是否與略過範圍重疊
+ * @param	[in] uStart	起始位址
+ * @param	[in] uEnd	結束位址 (不包含)
+ * @return	@c 型別: BOOL \n 重疊返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameMemoryCache::IsBypass(ULONG_PTR uStart, ULONG_PTR uEnd)
+{
+	for (size_t i = 0; i < m_aBypass.size(); ++i) {
+		if (m_aBypass[i].uBase < uEnd && uStart < m_aBypass[i].uEnd)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/**
+ * @brief	查詢快取頁
+ * @param	[in] uPage	頁起始位址
+ * @return	@c 型別: DWORD \n 命中返回項目索引並移至 LRU 串列首, 未命中或已失效返回 MEMCACHE_NIL
+ */
+DWORD CxFrameMemoryCache::Lookup(ULONG_PTR uPage)
+{
+	auto it = m_mapPage.find(uPage);
+	if (it == m_mapPage.end() || m_aPage[it->second].dwEpoch != m_dwEpoch)
+		return MEMCACHE_NIL;
+
+	DWORD idx = it->second;
+	if (idx != m_idxHead) {
+		this->Unlink(idx);
+		this->LinkFront(idx);
+	}
+	++m_stat.nHit;
+	return idx;
+}
+
+/**
+ * @brief	取得一個快取項目存放指定頁
+ * @param	[in] uPage	頁起始位址
+ * @return	@c 型別: DWORD \n 項目索引, 已移至 LRU 串列首
+ * @remark	優先重用同一頁的失效項目, 其次使用未使用項目, 最後淘汰最久未使用的項目.
+ */
+DWORD CxFrameMemoryCache::Acquire(ULONG_PTR uPage)
+{
+	DWORD idx;
+
+	auto it = m_mapPage.find(uPage);
+	if (it != m_mapPage.end()) {
+		idx = it->second;
+		this->Unlink(idx);
+	}
+	else {
+		if (m_nUsed < m_aPage.size()) {
+			idx = m_nUsed++;
+		}
+		else {
+			idx = m_idxTail;
+			this->Unlink(idx);
+			m_mapPage.erase(m_aPage[idx].uPage);
+			++m_stat.nEvict;
+		}
+		m_aPage[idx].uPage = uPage;
+		m_mapPage[uPage] = idx;
+	}
+
+	m_aPage[idx].dwEpoch = m_dwEpoch;
+	this->LinkFront(idx);
+	return idx;
+}
+
+/**
+ * @brief	讀取連續頁面並存入快取
+ * @param	[in] uPage	第一頁起始位址
+ * @param	[in] nPages	頁數
+ * @return	@c 型別: SIZE_T \n 自 uPage 起連續讀取成功的長度 (in Byte), 資料存放於 m_aStage
+ * @remark	合併讀取失敗時 (如中間有無法讀取的頁面), 改為逐頁讀取直到失敗為止.
+ */
+SIZE_T CxFrameMemoryCache::FillPages(ULONG_PTR uPage, size_t nPages)
+{
+	SIZE_T cbTotal = nPages * MEMCACHE_PAGE_SIZE;
+	SIZE_T cbReads;
+
+	if (m_aStage.size() < cbTotal)
+		m_aStage.resize(cbTotal);
+
+	m_stat.nMiss += nPages;
+	++m_stat.nRead;
+	cbReads = m_procPtr->ReadMemory(reinterpret_cast<LPCVOID>(uPage), m_aStage.data(), cbTotal);
+
+	if (cbReads < cbTotal && nPages > 1) {
+		cbReads -= cbReads % MEMCACHE_PAGE_SIZE;
+		while (cbReads < cbTotal) {
+			++m_stat.nRead;
+			SIZE_T cbPage = m_procPtr->ReadMemory(reinterpret_cast<LPCVOID>(uPage + cbReads), m_aStage.data() + cbReads, MEMCACHE_PAGE_SIZE);
+			cbReads += cbPage;
+			if (cbPage < MEMCACHE_PAGE_SIZE) break;
+		}
+	}
+
+	// 只快取完整讀取的頁面
+	for (size_t i = 0, n = cbReads / MEMCACHE_PAGE_SIZE; i < n; ++i) {
+		DWORD idx = this->Acquire(uPage + i * MEMCACHE_PAGE_SIZE);
+		::memcpy(this->PageData(idx), m_aStage.data() + i * MEMCACHE_PAGE_SIZE, MEMCACHE_PAGE_SIZE);
+	}
+	return cbReads;
+}
+
+/**
+ * @brief	自 LRU 串列移除項目
+ * @param	[in] idx	項目索引
+ */
+void CxFrameMemoryCache::Unlink(DWORD idx)
+{
+	SSPAGE& page = m_aPage[idx];
+
+	if (page.idxPrev != MEMCACHE_NIL) m_aPage[page.idxPrev].idxNext = page.idxNext;
+	else m_idxHead = page.idxNext;
+	if (page.idxNext != MEMCACHE_NIL) m_aPage[page.idxNext].idxPrev = page.idxPrev;
+	else m_idxTail = page.idxPrev;
+	page.idxPrev = page.idxNext = MEMCACHE_NIL;
+}
+
+/**
+ * @brief	將項目加入 LRU 串列首
+ * @param	[in] idx	項目索引
+ */
+void CxFrameMemoryCache::LinkFront(DWORD idx)
+{
+	SSPAGE& page = m_aPage[idx];
+
+	page.idxPrev = MEMCACHE_NIL;
+	page.idxNext = m_idxHead;
+	if (m_idxHead != MEMCACHE_NIL) m_aPage[m_idxHead].idxPrev = idx;
+	m_idxHead = idx;
+	if (m_idxTail == MEMCACHE_NIL) m_idxTail = idx;
+}
+
+/**
+ * @brief	取得項目的頁資料位址
+ * @param	[in] idx	項目索引
+ * @return	@c 型別: BYTE* \n 頁資料位址 (長度 MEMCACHE_PAGE_SIZE)
+ */
+BYTE* CxFrameMemoryCache::PageData(DWORD idx) { return m_aData.data() + static_cast<size_t>(idx) * MEMCACHE_PAGE_SIZE; }
@@ -0,0 +1,248 @@
+﻿/**************************************************************************//**
+ * @file	wframe_pacer.cc
+ * @brief	固定步進訊框節拍類別 - 成員函數
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_pacer.hh"
+
+//! CxFramePacer 建構式
+CxFramePacer::CxFramePacer()
+	: m_llFrequency(0)
+	, m_llStep(0)
+	, m_llPeriod(0)
+	, m_llSpin(0)
+	, m_llPrev(0)
+	, m_llAccum(0)
+	, m_llLast(0)
+	, m_llNext(0)
+	, m_bWaiting(FALSE)
+	, m_bLate(FALSE)
+	, m_bPeriod(FALSE)
+	, m_idxHistory(0)
+{
+	LARGE_INTEGER liFrequency;
+
+	::QueryPerformanceFrequency(&liFrequency);
+	m_llFrequency = liFrequency.QuadPart;
+	m_llSpin = PACER_SPIN_MARGIN * m_llFrequency / 1000000;
+	m_aHistory.resize(PACER_HISTORY, 0);
+	this->ResetStats();
+}
+
+//! CxFramePacer 解構式
+CxFramePacer::~CxFramePacer() { this->Stop(); }
+
+/**
+ * @brief	設定節拍頻率
+ * @param	[in] nUpdateHz	固定步進更新頻率 (每秒次數)
+ * @param	[in] nRenderHz	繪製頻率 (每秒次數), 零(zero) 表示與更新頻率相同
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			頻率為零或系統不支援高解析度計時返回零(zero)
+ */
+BOOL CxFramePacer::Create(DWORD nUpdateHz, DWORD nRenderHz)
+{
+	if (nUpdateHz == 0 || m_llFrequency == 0)
+		return FALSE;
+	if (nRenderHz == 0)
+		nRenderHz = nUpdateHz;
+
+	m_llStep = m_llFrequency / nUpdateHz;
+	m_llPeriod = m_llFrequency / nRenderHz;
+	if (m_llStep == 0 || m_llPeriod == 0)
+		return FALSE;
+
+	this->ResetStats();
+	return TRUE;
+}
+
+/**
+ * @brief	開始計時
+ * @remark	調用 timeBeginPeriod(1) 提高休眠精確度, 由 Stop 還原.
+ */
+void CxFramePacer::Start()
+{
+	LONGLONG llNow;
+
+	if (!m_bPeriod)
+		m_bPeriod = ::timeBeginPeriod(1) == TIMERR_NOERROR;
+
+	llNow = this->Now();
+	m_llPrev = llNow;
+	m_llLast = llNow;
+	m_llNext = llNow + m_llPeriod;
+	m_llAccum = 0;
+	m_bWaiting = FALSE;
+	m_bLate = FALSE;
+}
+
+//! 停止計時, 還原計時器精確度
+void CxFramePacer::Stop()
+{
+	if (m_bPeriod) {
+		::timeEndPeriod(1);
+		m_bPeriod = FALSE;
+	}
+}
+
+/**
+ * @brief	開始一個訊框
+ * @return	@c 型別: DWORD \n 本訊框需執行的固定步進更新次數
+ * @remark	經過時間超過 PACER_MAX_STEPS 個步進時捨棄多餘時間 (記錄於 nDropped), 避免更新落後越來越多.
+ */
+DWORD CxFramePacer::BeginFrame()
+{
+	LONGLONG llNow = this->Now();
+	LONGLONG llElapsed = llNow - m_llPrev;
+	LONGLONG llLimit = m_llStep * PACER_MAX_STEPS;
+	DWORD nSteps;
+
+	m_llPrev = llNow;
+	if (llElapsed > llLimit) {
+		m_stat.nDropped += (llElapsed - llLimit) * 1000000 / m_llFrequency;
+		llElapsed = llLimit;
+	}
+
+	m_llAccum += llElapsed;
+	nSteps = static_cast<DWORD>(m_llAccum / m_llStep);
+	m_llAccum -= nSteps * m_llStep;
+	m_stat.nSteps += nSteps;
+	return nSteps;
+}
+
+/**
+ * @brief	等待至下一個訊框期限
+ * @param	[in] bMessage	等待期間是否因執行緒訊息佇列有輸入而提前返回
+ * @return	@c 型別: BOOL \n
+ *			已到達期限返回非零值(non-zero), 訊框結束 \n
+ *			有輸入而提前返回零(zero), 處理訊息後應再次調用 (不需重新 BeginFrame)
+ * @remark	距離期限超過 PACER_SPIN_MARGIN 時休眠, 其餘時間忙等以取得精確的期限.
+ */
+BOOL CxFramePacer::WaitFrame(BOOL bMessage)
+{
+	LONGLONG llNow = this->Now();
+
+	if (!m_bWaiting) {
+		m_bWaiting = TRUE;
+		m_bLate = llNow > m_llNext;
+	}
+
+	while (llNow < m_llNext) {
+		LONGLONG llRemain = m_llNext - llNow;
+
+		if (llRemain > m_llSpin) {
+			DWORD dwSleep = static_cast<DWORD>((llRemain - m_llSpin) * 1000 / m_llFrequency);
+			if (dwSleep != 0) {
+				if (!bMessage)
+					::Sleep(dwSleep);
+				else if (::MsgWaitForMultipleObjectsEx(0, NULL, dwSleep, QS_ALLINPUT, MWMO_INPUTAVAILABLE) == WAIT_OBJECT_0)
+					return FALSE;
+			}
+		}
+		else {
+			::YieldProcessor();
+		}
+		llNow = this->Now();
+	}
+
+	this->EndFrame(llNow);
+	return TRUE;
+}
+
+/**
+ * @brief	是否正在等待訊框期限 (WaitFrame 提前返回後尚未完成)
+ * @return	@c 型別: BOOL \n 正在等待返回非零值(non-zero)
+ */
+BOOL CxFramePacer::IsWaiting() const { return m_bWaiting; }
+
+/**
+ * @brief	取得固定步進時間
+ * @return	@c 型別: double, 固定步進時間 (in 秒)
+ */
+double CxFramePacer::GetStep() const
+{
+	return m_llFrequency != 0 ? static_cast<double>(m_llStep) / m_llFrequency : 0.0;
+}
+
+/**
+ * @brief	取得繪製內插比例
+ * @return	@c 型別: double, 尚未更新的累積時間佔一個步進的比例 (0.0 ~ 1.0)
+ */
+double CxFramePacer::GetAlpha() const
+{
+	return m_llStep != 0 ? static_cast<double>(m_llAccum) / m_llStep : 0.0;
+}
+
+/**
+ * @brief	取得統計資訊
+ * @param	[out] statPtr	SSFRAMESTAT 結構指標
+ */
+void CxFramePacer::GetStats(LPSSFRAMESTAT statPtr)
+{
+	ULONGLONG ullTotal = 0;
+	size_t nSamples;
+
+	if (statPtr == NULL)
+		return;
+
+	*statPtr = m_stat;
+	statPtr->dwTarget = m_llFrequency != 0 ? static_cast<DWORD>(m_llPeriod * 1000000 / m_llFrequency) : 0;
+	nSamples = m_stat.nFrames < PACER_HISTORY ? static_cast<size_t>(m_stat.nFrames) : PACER_HISTORY;
+	statPtr->nSamples = static_cast<DWORD>(nSamples);
+	if (nSamples == 0)
+		return;
+
+	m_aSorted.assign(m_aHistory.begin(), m_aHistory.begin() + nSamples);
+	for (size_t i = 0; i < nSamples; ++i)
+		ullTotal += m_aSorted[i];
+	statPtr->dwAvg = static_cast<DWORD>(ullTotal / nSamples);
+
+	std::nth_element(m_aSorted.begin(), m_aSorted.begin() + nSamples / 2, m_aSorted.end());
+	statPtr->dwP50 = m_aSorted[nSamples / 2];
+	std::nth_element(m_aSorted.begin(), m_aSorted.begin() + nSamples * 99 / 100, m_aSorted.end());
+	statPtr->dwP99 = m_aSorted[nSamples * 99 / 100];
+	statPtr->dwMax = *std::max_element(m_aSorted.begin(), m_aSorted.end());
+}
+
+//! 重設統計資訊
+void CxFramePacer::ResetStats()
+{
+	::memset(&m_stat, 0, sizeof(m_stat));
+	m_idxHistory = 0;
+}
+
+/**
+ * @brief	取得目前時間
+ * @return	@c 型別: LONGLONG, QueryPerformanceCounter 值
+ */
+LONGLONG CxFramePacer::Now() const
+{
+	LARGE_INTEGER liNow;
+	::QueryPerformanceCounter(&liNow);
+	return liNow.QuadPart;
+}
+
+/**
+ * @brief	結束訊框, 記錄訊框時間並計算下一個期限
+ * @param	[in] llNow	目前時間
+ * @remark	落後超過一個訊框時以目前時間重新起算, 不連續補畫.
+ */
+void CxFramePacer::EndFrame(LONGLONG llNow)
+{
+	LONGLONG llFrame = (llNow - m_llLast) * 1000000 / m_llFrequency;
+
+	m_aHistory[m_idxHistory] = llFrame > MAXDWORD ? MAXDWORD : static_cast<DWORD>(llFrame);
+	m_idxHistory = (m_idxHistory + 1) % PACER_HISTORY;
+	++m_stat.nFrames;
+	if (m_bLate)
+		++m_stat.nMissed;
+
+	m_llLast = llNow;
+	m_llNext += m_llPeriod;
+	if (m_llNext <= llNow)
+		m_llNext = llNow + m_llPeriod;
+	m_bWaiting = FALSE;
+	m_bLate = FALSE;
+}
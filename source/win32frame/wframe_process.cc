@@ -2,7 +2,7 @@
  * @file	wframe_process.cc
  * @brief	程序操作基底類別，成員函式
  * @date	2002-01-15
- * @date	2018-04-02
+ * @date	2026-10-17
  * @author	Swang
  *****************************************************************************/
 #include "win32frame/wframe_process.hh"
@@ -26,13 +26,16 @@ CxFrameProcess::~CxFrameProcess() { this->ClassInTheEnd(); }
  * @remark	@c 使用方式 \n
  *			程序模組名稱即為可執行程式的檔案名稱，如 Foo.exe, Foo.dll \n
  *			程序模組名稱不必刻意注意大小寫，會自動進行辨認。 \n
- *			若搜尋到指定程序於系統中運行，則傳回該程序運作之 ID
+ *			若搜尋到指定程序於系統中運行，則傳回該程序運作之 ID \n
+ *			每次調用都會重新取得系統快照，需要反覆搜尋時請使用 CxFrameProcessIndex
+ * @see		CxFrameProcessIndex
  */
 DWORD CxFrameProcess::SearchProcess(LPCTSTR szModulePtr)
 {
 	const DWORD errProcessID = 0;
 	HANDLE hProcessSnap;
 	PROCESSENTRY32 pe32;
+	DWORD idProcess = errProcessID;
 
 	// 採用快照方式，取得系統正在運作的全部程序。
 	hProcessSnap = ::CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
@@ -44,19 +47,21 @@ DWORD CxFrameProcess::SearchProcess(LPCTSTR szModulePtr)
 	pe32.dwSize = sizeof(PROCESSENTRY32);
 
 	// 取得第一個執行中程序，若失敗就退出
-	if (!::Process32First(hProcessSnap, &pe32))
-		return errProcessID;
-
-	// 開始依序取得系統中所有執行的程式
-	do {
-		// 比對指定搜尋程式名稱
-		if (this->StrCompare(szModulePtr, pe32.szExeFile, FALSE)) {
-			// 找到目標程序, 回傳運行程序ID
-			return pe32.th32ProcessID;
-		}
-	} while (::Process32Next(hProcessSnap, &pe32));
+	if (::Process32First(hProcessSnap, &pe32)) {
+		// 開始依序取得系統中所有執行的程式
+		do {
+			// 比對指定搜尋程式名稱
+			if (this->StrCompare(szModulePtr, pe32.szExeFile, FALSE)) {
+				// 找到目標程序, 記錄運行程序ID
+				idProcess = pe32.th32ProcessID;
+				break;
+			}
+		} while (::Process32Next(hProcessSnap, &pe32));
+	}
 
-	return errProcessID;
+	// 釋放快照 handle
+	::CloseHandle(hProcessSnap);
+	return idProcess;
 }
 
 /**
@@ -112,7 +117,7 @@ SIZE_T CxFrameProcess::ReadMemory(LPCVOID aBasePtr, LPVOID aBuffPtr, SIZE_T uSiz
  *			讀取失敗返回零(zero) \n
  *			實際資料寫入長度與指定長度不同，使用 GetLastError() 去了解狀況
  */
-inline SIZE_T CxFrameProcess::WriteMemory(LPVOID aBasePtr, LPCVOID aBuffPtr, SIZE_T uSize)
+SIZE_T CxFrameProcess::WriteMemory(LPVOID aBasePtr, LPCVOID aBuffPtr, SIZE_T uSize)
 {
 	HANDLE hProcess = m_hProcess;
 	SIZE_T cbWrite = 0;
@@ -120,6 +125,139 @@ inline SIZE_T CxFrameProcess::WriteMemory(LPVOID aBasePtr, LPCVOID aBuffPtr, SIZ
 	return cbWrite;
 }
 
+/**
+ * @brief	批次讀取指定記憶體區資料
+ * @param	[in,out] aRangePtr	讀取範圍陣列位址, 每個範圍的 cbDone 會填入實際讀取長度
+ * @param	[in]     nCount		讀取範圍數量
+ * @return	@c 型別: SIZE_T \n
+ *			返回全部範圍實際讀取資料長度總和 (in Byte) \n
+ *			若總和與各範圍長度總和不同, 檢查各範圍的 cbDone 了解狀況
+ * @remark	範圍依目標位址排序後, 相鄰、重疊或間距不超過 MEMRANGE_MERGE_GAP 的範圍 \n
+ *			合併為一次 ReadProcessMemory, 再分配至各範圍的緩衝區, 以減少系統呼叫次數. \n
+ *			合併讀取只完成部分時, 其餘範圍會改為逐一讀取.
+ */
+SIZE_T CxFrameProcess::ReadMemoryV(LPSSMEMRANGE aRangePtr, size_t nCount)
+{
+	HANDLE hProcess = m_hProcess;
+	SIZE_T cbTotal = 0;
+
+	if (aRangePtr == NULL || nCount == 0)
+		return 0;
+
+	// 依目標位址排序 (不改變調用者的陣列順序)
+	m_aOrder.resize(nCount);
+	for (size_t i = 0; i < nCount; ++i) {
+		aRangePtr[i].cbDone = 0;
+		m_aOrder[i] = i;
+	}
+	std::sort(m_aOrder.begin(), m_aOrder.end(), [aRangePtr](size_t a, size_t b) {
+		return reinterpret_cast<ULONG_PTR>(aRangePtr[a].aBasePtr) < reinterpret_cast<ULONG_PTR>(aRangePtr[b].aBasePtr);
+	});
+
+	size_t idxFirst = 0;
+	while (idxFirst < nCount) {
+		LPSSMEMRANGE rgPtr = &aRangePtr[m_aOrder[idxFirst]];
+		ULONG_PTR uStart = reinterpret_cast<ULONG_PTR>(rgPtr->aBasePtr);
+		ULONG_PTR uEnd = uStart + rgPtr->uSize;
+		size_t idxLast = idxFirst + 1;
+
+		// 找出可合併讀取的範圍
+		while (idxLast < nCount) {
+			rgPtr = &aRangePtr[m_aOrder[idxLast]];
+			ULONG_PTR uBase = reinterpret_cast<ULONG_PTR>(rgPtr->aBasePtr);
+			if (uBase > uEnd + MEMRANGE_MERGE_GAP)
+				break;
+			if (uBase + rgPtr->uSize > uEnd)
+				uEnd = uBase + rgPtr->uSize;
+			++idxLast;
+		}
+
+		SIZE_T cbReads = 0;
+		if (idxLast - idxFirst == 1) {
+			// 單一範圍, 直接讀入調用者緩衝區
+			rgPtr = &aRangePtr[m_aOrder[idxFirst]];
+			::ReadProcessMemory(hProcess, rgPtr->aBasePtr, rgPtr->aBuffPtr, rgPtr->uSize, &cbReads);
+			rgPtr->cbDone = cbReads;
+			cbTotal += cbReads;
+		}
+		else {
+			// 合併範圍, 讀入暫存區後分配
+			SIZE_T uSpan = static_cast<SIZE_T>(uEnd - uStart);
+			if (m_aScratch.size() < uSpan)
+				m_aScratch.resize(uSpan);
+			::ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(uStart), m_aScratch.data(), uSpan, &cbReads);
+			this->ReadRangeSplit(aRangePtr, &m_aOrder[idxFirst], idxLast - idxFirst, cbReads);
+			for (size_t i = idxFirst; i < idxLast; ++i)
+				cbTotal += aRangePtr[m_aOrder[i]].cbDone;
+		}
+		idxFirst = idxLast;
+	}
+	return cbTotal;
+}
+
+/**
+ * @brief	批次寫入指定記憶體區資料
+ * @param	[in,out] aRangePtr	寫入範圍陣列位址, 每個範圍的 cbDone 會填入實際寫入長度
+ * @param	[in]     nCount		寫入範圍數量
+ * @return	@c 型別: SIZE_T \n
+ *			返回全部範圍實際寫入資料長度總和 (in Byte) \n
+ *			若總和與各範圍長度總和不同, 檢查各範圍的 cbDone 了解狀況
+ * @remark	依陣列順序寫入, 連續且位址首尾相接的範圍合併為一次 WriteProcessMemory. \n
+ *			不會重新排序, 範圍重疊時以後寫入者為準.
+ */
+SIZE_T CxFrameProcess::WriteMemoryV(LPSSMEMRANGE aRangePtr, size_t nCount)
+{
+	HANDLE hProcess = m_hProcess;
+	SIZE_T cbTotal = 0;
+
+	if (aRangePtr == NULL || nCount == 0)
+		return 0;
+
+	size_t idxFirst = 0;
+	while (idxFirst < nCount) {
+		ULONG_PTR uEnd = reinterpret_cast<ULONG_PTR>(aRangePtr[idxFirst].aBasePtr) + aRangePtr[idxFirst].uSize;
+		size_t idxLast = idxFirst + 1;
+
+		// 找出首尾相接的連續範圍
+		while (idxLast < nCount && reinterpret_cast<ULONG_PTR>(aRangePtr[idxLast].aBasePtr) == uEnd) {
+			uEnd += aRangePtr[idxLast].uSize;
+			++idxLast;
+		}
+
+		SIZE_T cbWrite = 0;
+		if (idxLast - idxFirst == 1) {
+			LPSSMEMRANGE rgPtr = &aRangePtr[idxFirst];
+			::WriteProcessMemory(hProcess, rgPtr->aBasePtr, rgPtr->aBuffPtr, rgPtr->uSize, &cbWrite);
+			rgPtr->cbDone = cbWrite;
+			cbTotal += cbWrite;
+		}
+		else {
+			// 合併寫入, 先依序複製到暫存區
+			SIZE_T uSpan = static_cast<SIZE_T>(uEnd - reinterpret_cast<ULONG_PTR>(aRangePtr[idxFirst].aBasePtr));
+			SIZE_T uOffset = 0;
+			if (m_aScratch.size() < uSpan)
+				m_aScratch.resize(uSpan);
+			for (size_t i = idxFirst; i < idxLast; ++i) {
+				::memcpy(m_aScratch.data() + uOffset, aRangePtr[i].aBuffPtr, aRangePtr[i].uSize);
+				uOffset += aRangePtr[i].uSize;
+			}
+			::WriteProcessMemory(hProcess, aRangePtr[idxFirst].aBasePtr, m_aScratch.data(), uSpan, &cbWrite);
+
+			// 依實際寫入長度分配各範圍結果
+			uOffset = 0;
+			for (size_t i = idxFirst; i < idxLast; ++i) {
+				SIZE_T uSize = aRangePtr[i].uSize;
+				if (uOffset >= cbWrite) aRangePtr[i].cbDone = 0;
+				else aRangePtr[i].cbDone = (cbWrite - uOffset < uSize) ? cbWrite - uOffset : uSize;
+				cbTotal += aRangePtr[i].cbDone;
+				uOffset += uSize;
+			}
+		}
+		idxFirst = idxLast;
+	}
+	return cbTotal;
+}
+
 /**
  * @brief	取得已連接的 Process Handle
  * @return	@c 型別: HANDLE \n
@@ -154,9 +292,6 @@ void CxFrameProcess::ClassInTheEnd()
  */
 BOOL CxFrameProcess::StrCompare(LPCTSTR szDstPtr, LPCTSTR szSrcPtr, BOOL bCase)
 {
-	TCHAR szDst[MAX_PATH];
-	TCHAR szSrc[MAX_PATH];
-
 	// 防呆，防例外處理
 	if (szDstPtr == NULL || szSrcPtr == NULL)
 		return FALSE;
@@ -164,12 +299,8 @@ BOOL CxFrameProcess::StrCompare(LPCTSTR szDstPtr, LPCTSTR szSrcPtr, BOOL bCase)
 	// 比對時區分大小寫
 	if (bCase) return _tcscmp(szDstPtr, szSrcPtr) == 0;
 
-	// 進行字串大小寫轉換後再比對
-	_tcscpy(szDst, szDstPtr);
-	_tcscpy(szSrc, szSrcPtr);
-	this->StrUpper(szDst);
-	this->StrUpper(szSrc);
-	return _tcscmp(szDst, szSrc) == 0;
+	// 不區分大小寫比對, 不需複製字串
+	return _tcsicmp(szDstPtr, szSrcPtr) == 0;
 }
 
 /**
@@ -201,3 +332,32 @@ void CxFrameProcess::StrLower(LPTSTR szPtr)
 		szPtr[i] = static_cast<TCHAR>(_totlower(szPtr[i]));
 	}
 }
+
+/**
+ * @brief	分配合併讀取結果至各範圍
+ * @param	[in,out] aRangePtr	讀取範圍陣列位址
+ * @param	[in]     aIndexPtr	本次合併的範圍索引 (已依位址排序)
+ * @param	[in]     nCount		本次合併的範圍數量
+ * @param	[in]     cbReads	合併讀取實際完成長度 (in Byte)
+ * @remark	完整落在已讀取部分的範圍直接自暫存區複製, 其餘範圍改為逐一讀取.
+ */
+void CxFrameProcess::ReadRangeSplit(LPSSMEMRANGE aRangePtr, const size_t* aIndexPtr, size_t nCount, SIZE_T cbReads)
+{
+	ULONG_PTR uStart = reinterpret_cast<ULONG_PTR>(aRangePtr[aIndexPtr[0]].aBasePtr);
+
+	for (size_t i = 0; i < nCount; ++i) {
+		LPSSMEMRANGE rgPtr = &aRangePtr[aIndexPtr[i]];
+		SIZE_T uOffset = static_cast<SIZE_T>(reinterpret_cast<ULONG_PTR>(rgPtr->aBasePtr) - uStart);
+
+		if (uOffset + rgPtr->uSize <= cbReads) {
+			::memcpy(rgPtr->aBuffPtr, m_aScratch.data() + uOffset, rgPtr->uSize);
+			rgPtr->cbDone = rgPtr->uSize;
+			continue;
+		}
+
+		// 合併讀取未涵蓋此範圍 (如跨越不可讀取頁面), 單獨讀取
+		SIZE_T cbDone = 0;
+		::ReadProcessMemory(m_hProcess, rgPtr->aBasePtr, rgPtr->aBuffPtr, rgPtr->uSize, &cbDone);
+		rgPtr->cbDone = cbDone;
+	}
+}
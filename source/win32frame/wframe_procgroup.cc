@@ -0,0 +1,334 @@
+﻿/**************************************************************************//**
+ * @file	wframe_procgroup.cc
+ * @brief	多程序群組讀取類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_procgroup.hh"
+
+//! CxFrameProcessGroup 建構式
+CxFrameProcessGroup::CxFrameProcessGroup()
+	: m_aOpenPidPtr(NULL)
+	, m_bDirty(TRUE)
+	, m_llFrequency(0)
+{
+	LARGE_INTEGER li;
+	if (::QueryPerformanceFrequency(&li))
+		m_llFrequency = li.QuadPart;
+}
+
+//! CxFrameProcessGroup 解構式
+CxFrameProcessGroup::~CxFrameProcessGroup() { this->Clear(); }
+
+/**
+ * @brief	開啟多個程序並加入群組
+ * @param	[in] aPidPtr	程序 ID 陣列
+ * @param	[in] nCount		程序 ID 數量
+ * @param	[in] poolPtr	工作執行緒池, 為 NULL 時於調用端執行緒依序開啟
+ * @return	@c 型別: size_t \n
+ *			成功加入的程序數量
+ * @remark	無法開啟的程序不會加入群組, 以 GetProcessID 取得各索引對應的程序 ID. \n
+ *			新加入的程序欄位位址皆為零, 需以 SetAddress 設定.
+ */
+size_t CxFrameProcessGroup::Attach(const DWORD* aPidPtr, size_t nCount, CxFrameWorkPool* poolPtr)
+{
+	size_t nAttach = 0;
+
+	if (aPidPtr == NULL || nCount == 0)
+		return 0;
+
+	m_aOpen.assign(nCount, NULL);
+	m_aOpenPidPtr = aPidPtr;
+	if (poolPtr != NULL && poolPtr->GetThreadCount() != 0) {
+		poolPtr->Run(StaticOpenProc, this, nCount);
+	}
+	else {
+		for (size_t i = 0; i < nCount; ++i)
+			this->OpenOne(i);
+	}
+
+	for (size_t i = 0; i < nCount; ++i) {
+		if (m_aOpen[i] == NULL)
+			continue;
+		m_aProcess.push_back(m_aOpen[i]);
+		m_aPid.push_back(aPidPtr[i]);
+		m_aAddress.resize(m_aAddress.size() + m_aFieldSize.size(), 0);
+		++nAttach;
+	}
+
+	m_aOpen.clear();
+	m_aOpenPidPtr = NULL;
+	if (nAttach != 0) m_bDirty = TRUE;
+	return nAttach;
+}
+
+/**
+ * @brief	將程序移出群組
+ * @param	[in] idxProcess	程序索引
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 索引錯誤返回零(zero)
+ * @remark	之後的程序索引會往前移動一位.
+ */
+BOOL CxFrameProcessGroup::Detach(size_t idxProcess)
+{
+	size_t nFields = m_aFieldSize.size();
+
+	if (idxProcess >= m_aProcess.size())
+		return FALSE;
+
+	delete m_aProcess[idxProcess];
+	m_aProcess.erase(m_aProcess.begin() + idxProcess);
+	m_aPid.erase(m_aPid.begin() + idxProcess);
+	m_aAddress.erase(m_aAddress.begin() + idxProcess * nFields, m_aAddress.begin() + (idxProcess + 1) * nFields);
+	m_bDirty = TRUE;
+	return TRUE;
+}
+
+//! 關閉全部程序並清除欄位設定
+void CxFrameProcessGroup::Clear()
+{
+	for (size_t i = 0; i < m_aProcess.size(); ++i)
+		delete m_aProcess[i];
+
+	m_aProcess.clear();
+	m_aPid.clear();
+	m_aDone.clear();
+	m_aLatency.clear();
+	m_aFieldSize.clear();
+	m_aFieldOffset.clear();
+	m_aAddress.clear();
+	m_aData.clear();
+	m_aRange.clear();
+	m_bDirty = TRUE;
+}
+
+/**
+ * @brief	設定欄位配置
+ * @param	[in] aSizePtr	各欄位大小陣列 (in Byte)
+ * @param	[in] nFields	欄位數量
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 參數錯誤返回零(zero)
+ * @remark	全部程序共用相同欄位配置, 設定後全部欄位位址重設為零.
+ */
+BOOL CxFrameProcessGroup::SetFields(const SIZE_T* aSizePtr, size_t nFields)
+{
+	if (aSizePtr == NULL || nFields == 0)
+		return FALSE;
+
+	m_aFieldSize.assign(aSizePtr, aSizePtr + nFields);
+	m_aAddress.assign(m_aProcess.size() * nFields, 0);
+	m_bDirty = TRUE;
+	return TRUE;
+}
+
+/**
+ * @brief	設定程序的欄位位址
+ * @param	[in] idxProcess	程序索引
+ * @param	[in] idxField	欄位索引
+ * @param	[in] uAddress	目標程序中的位址, 零(zero) 表示此程序不讀取此欄位
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 索引錯誤返回零(zero)
+ */
+BOOL CxFrameProcessGroup::SetAddress(size_t idxProcess, size_t idxField, ULONG_PTR uAddress)
+{
+	if (idxProcess >= m_aProcess.size() || idxField >= m_aFieldSize.size())
+		return FALSE;
+
+	m_aAddress[idxProcess * m_aFieldSize.size() + idxField] = uAddress;
+	return TRUE;
+}
+
+/**
+ * @brief	讀取全部程序的全部欄位
+ * @param	[in] poolPtr	工作執行緒池, 為 NULL 時於調用端執行緒依序讀取
+ * @return	@c 型別: BOOL \n
+ *			全部程序的全部欄位皆完整讀取返回非零值(non-zero) \n
+ *			有任何欄位讀取失敗返回零(zero), 以 GetReadSizes 確認各程序讀取長度
+ * @remark	讀取失敗的欄位內容不會更新.
+ */
+BOOL CxFrameProcessGroup::Read(CxFrameWorkPool* poolPtr)
+{
+	size_t nProcess = m_aProcess.size();
+	size_t nBuffer;
+	SIZE_T cbExpect;
+
+	if (nProcess == 0 || m_aFieldSize.empty())
+		return FALSE;
+
+	if (m_bDirty)
+		this->Layout();
+
+	if (poolPtr != NULL && poolPtr->GetThreadCount() == 0)
+		poolPtr = NULL;
+	nBuffer = poolPtr != NULL ? poolPtr->GetThreadCount() : 1;
+	if (m_aRange.size() < nBuffer)
+		m_aRange.resize(nBuffer);
+
+	if (poolPtr != NULL) {
+		poolPtr->Run(StaticReadProc, this, nProcess);
+	}
+	else {
+		for (size_t i = 0; i < nProcess; ++i)
+			this->ReadOne(i, 0);
+	}
+
+	for (size_t p = 0; p < nProcess; ++p) {
+		cbExpect = 0;
+		for (size_t f = 0; f < m_aFieldSize.size(); ++f) {
+			if (m_aAddress[p * m_aFieldSize.size() + f] != 0)
+				cbExpect += m_aFieldSize[f];
+		}
+		if (m_aDone[p] != cbExpect)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+/**
+ * @brief	取得群組內程序數量
+ * @return	@c 型別: size_t \n 程序數量
+ */
+size_t CxFrameProcessGroup::GetCount() { return m_aProcess.size(); }
+
+/**
+ * @brief	取得欄位數量
+ * @return	@c 型別: size_t \n 欄位數量
+ */
+size_t CxFrameProcessGroup::GetFieldCount() { return m_aFieldSize.size(); }
+
+/**
+ * @brief	取得程序 ID
+ * @param	[in] idxProcess	程序索引
+ * @return	@c 型別: DWORD \n 程序 ID, 索引錯誤返回零(zero)
+ */
+DWORD CxFrameProcessGroup::GetProcessID(size_t idxProcess)
+{
+	return idxProcess < m_aPid.size() ? m_aPid[idxProcess] : 0;
+}
+
+/**
+ * @brief	取得程序物件
+ * @param	[in] idxProcess	程序索引
+ * @return	@c 型別: CxFrameProcess* \n 程序物件指標, 索引錯誤返回 NULL
+ * @remark	不可於 Read 執行中使用此物件讀寫.
+ */
+CxFrameProcess* CxFrameProcessGroup::GetProcess(size_t idxProcess)
+{
+	return idxProcess < m_aProcess.size() ? m_aProcess[idxProcess] : NULL;
+}
+
+/**
+ * @brief	取得欄位讀取結果陣列
+ * @param	[in] idxField	欄位索引
+ * @return	@c 型別: const BYTE* \n
+ *			GetCount() 個數值的連續陣列, 第 p 個程序的數值位於 + p * 欄位大小 \n
+ *			索引錯誤或尚未讀取返回 NULL
+ */
+const BYTE* CxFrameProcessGroup::GetField(size_t idxField)
+{
+	if (m_bDirty || idxField >= m_aFieldSize.size() || m_aData.empty())
+		return NULL;
+	return m_aData.data() + m_aFieldOffset[idxField];
+}
+
+/**
+ * @brief	取得各程序最近一次讀取長度陣列
+ * @return	@c 型別: const SIZE_T* \n GetCount() 個讀取長度 (in Byte), 尚未讀取返回 NULL
+ */
+const SIZE_T* CxFrameProcessGroup::GetReadSizes() { return m_bDirty || m_aDone.empty() ? NULL : m_aDone.data(); }
+
+/**
+ * @brief	取得各程序最近一次讀取時間陣列
+ * @return	@c 型別: const DWORD* \n GetCount() 個讀取時間 (in μs), 尚未讀取返回 NULL
+ */
+const DWORD* CxFrameProcessGroup::GetLatency() { return m_bDirty || m_aLatency.empty() ? NULL : m_aLatency.data(); }
+
+/**
+ * @brief	開啟一個程序 (Attach 工作項目)
+ * @param	[in] idxItem	程序 ID 陣列索引
+ */
+void CxFrameProcessGroup::OpenOne(size_t idxItem)
+{
+	CxFrameProcess* procPtr = new CxFrameProcess;
+
+	if (procPtr->OpenProcess(m_aOpenPidPtr[idxItem]) == NULL) {
+		delete procPtr;
+		return;
+	}
+	m_aOpen[idxItem] = procPtr;
+}
+
+/**
+ * @brief	讀取一個程序的全部欄位 (Read 工作項目)
+ * @param	[in] idxProcess	程序索引
+ * @param	[in] idxWorker	工作執行緒索引
+ */
+void CxFrameProcessGroup::ReadOne(size_t idxProcess, DWORD idxWorker)
+{
+	std::vector<SSMEMRANGE>& aRange = m_aRange[idxWorker];
+	size_t nFields = m_aFieldSize.size();
+	const ULONG_PTR* aAddressPtr = &m_aAddress[idxProcess * nFields];
+	LARGE_INTEGER liStart, liEnd;
+
+	aRange.clear();
+	for (size_t f = 0; f < nFields; ++f) {
+		if (aAddressPtr[f] == 0)
+			continue;
+
+		SSMEMRANGE range;
+		range.aBasePtr = reinterpret_cast<LPVOID>(aAddressPtr[f]);
+		range.aBuffPtr = m_aData.data() + m_aFieldOffset[f] + idxProcess * m_aFieldSize[f];
+		range.uSize = m_aFieldSize[f];
+		range.cbDone = 0;
+		aRange.push_back(range);
+	}
+
+	::QueryPerformanceCounter(&liStart);
+	m_aDone[idxProcess] = aRange.empty() ? 0 : m_aProcess[idxProcess]->ReadMemoryV(aRange.data(), aRange.size());
+	::QueryPerformanceCounter(&liEnd);
+
+	if (m_llFrequency != 0)
+		m_aLatency[idxProcess] = static_cast<DWORD>((liEnd.QuadPart - liStart.QuadPart) * 1000000 / m_llFrequency);
+}
+
+//! 依程序與欄位數量配置結果緩衝區
+void CxFrameProcessGroup::Layout()
+{
+	size_t nProcess = m_aProcess.size();
+	SIZE_T uOffset = 0;
+
+	m_aFieldOffset.resize(m_aFieldSize.size());
+	for (size_t f = 0; f < m_aFieldSize.size(); ++f) {
+		m_aFieldOffset[f] = uOffset;
+		uOffset += m_aFieldSize[f] * nProcess;
+	}
+
+	m_aData.assign(uOffset, 0);
+	m_aDone.assign(nProcess, 0);
+	m_aLatency.assign(nProcess, 0);
+	m_bDirty = FALSE;
+}
+
+/**
+ * @brief	Attach 工作執行緒回呼函數 (static)
+ * @param	[in] aParamPtr	CxFrameProcessGroup 物件指標
+ * @param	[in] idxItem	程序 ID 陣列索引
+ * @param	[in] idxWorker	工作執行緒索引
+ */
+void CALLBACK CxFrameProcessGroup::StaticOpenProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker)
+{
+	UNREFERENCED_PARAMETER(idxWorker);
+	reinterpret_cast<CxFrameProcessGroup*>(aParamPtr)->OpenOne(idxItem);
+}
+
+/**
+ * @brief	Read 工作執行緒回呼函數 (static)
+ * @param	[in] aParamPtr	CxFrameProcessGroup 物件指標
+ * @param	[in] idxItem	程序索引
+ * @param	[in] idxWorker	工作執行緒索引
+ */
+void CALLBACK CxFrameProcessGroup::StaticReadProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker)
+{
+	reinterpret_cast<CxFrameProcessGroup*>(aParamPtr)->ReadOne(idxItem, idxWorker);
+}
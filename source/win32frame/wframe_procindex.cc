@@ -0,0 +1,217 @@
+﻿/**************************************************************************//**
+ * @file	wframe_procindex.cc
+ * @brief	程序名稱索引類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_procindex.hh"
+
+//! CxFrameProcessIndex 建構式
+CxFrameProcessIndex::CxFrameProcessIndex() : m_dwGeneration(0) { }
+
+//! CxFrameProcessIndex 解構式
+CxFrameProcessIndex::~CxFrameProcessIndex() { this->Clear(); }
+
+/**
+ * @brief	更新程序索引
+ * @param	[out] aStartPtr	新增程序 ID 存放位址 (可為 NULL)
+ * @param	[out] aExitPtr	已結束程序 ID 存放位址 (可為 NULL)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			函數操作失敗返回零(zero), 索引內容維持不變
+ * @remark	取得一次系統程序快照並與現有索引比對: \n
+ *			- 快照中新出現的程序 ID 加入索引 (僅此時進行名稱轉換)
+ *			- 已存在且名稱、父程序相同的項目只更新世代
+ *			- 未出現在快照中的項目視為已結束並自索引移除
+ *
+ *			程序 ID 可能被系統重複使用, 若同一 ID 的名稱或父程序不同, 視為舊程序結束後新程序啟動.
+ */
+BOOL CxFrameProcessIndex::Refresh(std::vector<DWORD>* aStartPtr, std::vector<DWORD>* aExitPtr)
+{
+	HANDLE hProcessSnap;
+	PROCESSENTRY32 pe32;
+	DWORD dwGeneration;
+
+	// 採用快照方式，取得系統正在運作的全部程序。
+	hProcessSnap = ::CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+	if (hProcessSnap == INVALID_HANDLE_VALUE)
+		return FALSE;
+
+	::memset(&pe32, 0, sizeof(PROCESSENTRY32));
+	pe32.dwSize = sizeof(PROCESSENTRY32);
+
+	if (!::Process32First(hProcessSnap, &pe32)) {
+		::CloseHandle(hProcessSnap);
+		return FALSE;
+	}
+
+	dwGeneration = ++m_dwGeneration;
+	if (m_mapProcess.empty())
+		m_mapProcess.reserve(BUFF_SIZE_512);
+
+	do {
+		auto it = m_mapProcess.find(pe32.th32ProcessID);
+
+		if (it != m_mapProcess.end()) {
+			// 既有程序, 名稱與父程序相同就只更新世代
+			if (it->second.idParent == pe32.th32ParentProcessID &&
+				_tcscmp(it->second.strName.c_str(), pe32.szExeFile) == 0) {
+				it->second.dwGeneration = dwGeneration;
+				continue;
+			}
+
+			// 程序 ID 被重複使用, 舊程序已結束
+			if (aExitPtr != NULL) aExitPtr->push_back(pe32.th32ProcessID);
+			this->RemoveEntry(pe32.th32ProcessID, it->second);
+			m_mapProcess.erase(it);
+		}
+
+		this->InsertEntry(pe32.th32ProcessID, pe32.szExeFile, pe32.th32ParentProcessID);
+		if (aStartPtr != NULL) aStartPtr->push_back(pe32.th32ProcessID);
+	} while (::Process32Next(hProcessSnap, &pe32));
+
+	::CloseHandle(hProcessSnap);
+
+	// 移除未出現在本次快照中的程序
+	for (auto it = m_mapProcess.begin(); it != m_mapProcess.end();) {
+		if (it->second.dwGeneration != dwGeneration) {
+			if (aExitPtr != NULL) aExitPtr->push_back(it->first);
+			this->RemoveEntry(it->first, it->second);
+			it = m_mapProcess.erase(it);
+			continue;
+		}
+		++it;
+	}
+	return TRUE;
+}
+
+/**
+ * @brief	搜尋指定程序
+ * @param	[in] szModulePtr 指定程序名稱，如： foo.exe, foo.dll (不區分大小寫)
+ * @return	@c 型別: DWORD \n
+ *			若找到目標程序返回非零值(non-zero)為程序運作 ID \n
+ *			若索引中沒有目標程序返回零(zero)
+ * @remark	查詢僅使用目前索引內容, 不會重新取得快照, 必要時先調用 Refresh. \n
+ *			若同名程序有多個, 返回最早加入索引的程序 ID.
+ */
+DWORD CxFrameProcessIndex::Search(LPCTSTR szModulePtr)
+{
+	if (szModulePtr == NULL)
+		return 0;
+
+	this->FoldName(szModulePtr, &m_strFold);
+	auto it = m_mapName.find(m_strFold);
+	if (it == m_mapName.end() || it->second.empty())
+		return 0;
+	return it->second.front();
+}
+
+/**
+ * @brief	搜尋指定程序 (全部同名程序)
+ * @param	[in]  szModulePtr	指定程序名稱 (不區分大小寫)
+ * @param	[out] aPidPtr		程序 ID 存放位址, 找到的程序 ID 會附加於尾端
+ * @return	@c 型別: size_t \n
+ *			找到的程序數量, 若沒有目標程序返回零(zero)
+ */
+size_t CxFrameProcessIndex::Search(LPCTSTR szModulePtr, std::vector<DWORD>* aPidPtr)
+{
+	if (szModulePtr == NULL || aPidPtr == NULL)
+		return 0;
+
+	this->FoldName(szModulePtr, &m_strFold);
+	auto it = m_mapName.find(m_strFold);
+	if (it == m_mapName.end())
+		return 0;
+
+	aPidPtr->insert(aPidPtr->end(), it->second.begin(), it->second.end());
+	return it->second.size();
+}
+
+/**
+ * @brief	取得索引中程序的名稱
+ * @param	[in]  dwProcessID	程序 ID
+ * @param	[out] szPtr			字串緩衝區位址
+ * @param	[in]  ccLen			字串緩衝區長度 (in TCHAR)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 若索引中沒有此程序或緩衝區不足返回零(zero)
+ */
+BOOL CxFrameProcessIndex::GetModuleName(DWORD dwProcessID, LPTSTR szPtr, size_t ccLen)
+{
+	auto it = m_mapProcess.find(dwProcessID);
+
+	if (szPtr == NULL || it == m_mapProcess.end())
+		return FALSE;
+	if (it->second.strName.size() >= ccLen)
+		return FALSE;
+
+	_tcscpy(szPtr, it->second.strName.c_str());
+	return TRUE;
+}
+
+/**
+ * @brief	取得索引中的程序數量
+ * @return	@c 型別: size_t \n 索引中的程序數量
+ */
+size_t CxFrameProcessIndex::GetCount() { return m_mapProcess.size(); }
+
+//! 清除索引內容
+void CxFrameProcessIndex::Clear()
+{
+	m_mapName.clear();
+	m_mapProcess.clear();
+}
+
+/**
+ * @brief	轉換名稱為索引鍵 (轉為大寫)
+ * @param	[in]  szPtr		程序名稱
+ * @param	[out] strPtr	索引鍵存放位址
+ */
+void CxFrameProcessIndex::FoldName(LPCTSTR szPtr, TSTRING* strPtr)
+{
+	strPtr->assign(szPtr);
+	if (!strPtr->empty()) {
+		::CharUpperBuff(&(*strPtr)[0], static_cast<DWORD>(strPtr->size()));
+	}
+}
+
+/**
+ * @brief	加入一個程序項目
+ * @param	[in] dwProcessID	程序 ID
+ * @param	[in] szNamePtr		程序名稱
+ * @param	[in] idParent		父程序 ID
+ */
+void CxFrameProcessIndex::InsertEntry(DWORD dwProcessID, LPCTSTR szNamePtr, DWORD idParent)
+{
+	SSENTRY& entry = m_mapProcess[dwProcessID];
+
+	entry.strName.assign(szNamePtr);
+	this->FoldName(szNamePtr, &entry.strKey);
+	entry.idParent = idParent;
+	entry.dwGeneration = m_dwGeneration;
+	m_mapName[entry.strKey].push_back(dwProcessID);
+}
+
+/**
+ * @brief	自名稱索引移除一個程序項目
+ * @param	[in] dwProcessID	程序 ID
+ * @param	[in] entry			程序項目
+ * @remark	僅移除名稱索引中的程序 ID, 程序項目本身由調用者自 m_mapProcess 移除.
+ */
+void CxFrameProcessIndex::RemoveEntry(DWORD dwProcessID, const SSENTRY& entry)
+{
+	auto it = m_mapName.find(entry.strKey);
+	if (it == m_mapName.end())
+		return;
+
+	auto& aPid = it->second;
+	for (size_t i = 0; i < aPid.size(); ++i) {
+		if (aPid[i] == dwProcessID) {
+			// 保持加入順序, 同名程序通常只有少數幾個
+			aPid.erase(aPid.begin() + i);
+			break;
+		}
+	}
+	if (aPid.empty())
+		m_mapName.erase(it);
+}
@@ -0,0 +1,440 @@
+﻿/**************************************************************************//**
+ * @file	wframe_procwatch.cc
+ * @brief	程序啟動/結束監看類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_procwatch.hh"
+
+//! CxFrameProcessWatch 建構式
+CxFrameProcessWatch::CxFrameProcessWatch()
+	: m_tpGroup(NULL)
+	, m_tpTimer(NULL)
+	, m_fnWatchPtr(NULL)
+	, m_aParamPtr(NULL)
+	, m_hWnd(NULL)
+	, m_uMessage(0)
+	, m_bRunning(FALSE)
+{
+	::memset(&m_tpEnv, 0, sizeof(m_tpEnv));
+	::InitializeCriticalSection(&m_csLock);
+	::InitializeCriticalSection(&m_csNotify);
+}
+
+//! CxFrameProcessWatch 解構式
+CxFrameProcessWatch::~CxFrameProcessWatch()
+{
+	this->Stop();
+	::DeleteCriticalSection(&m_csNotify);
+	::DeleteCriticalSection(&m_csLock);
+}
+
+/**
+ * @brief	加入監看的程序名稱樣式
+ * @param	[in] szPatternPtr	名稱樣式, 如: foo.exe, game*.exe (不區分大小寫)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			參數錯誤返回零(zero)
+ * @remark	未加入任何樣式時監看全部程序. \n
+ *			監看中加入的樣式只套用於之後啟動的程序.
+ */
+BOOL CxFrameProcessWatch::AddPattern(LPCTSTR szPatternPtr)
+{
+	if (szPatternPtr == NULL || szPatternPtr[0] == TEXT('\0'))
+		return FALSE;
+
+	::EnterCriticalSection(&m_csLock);
+	m_aPattern.push_back(TSTRING(szPatternPtr));
+	::LeaveCriticalSection(&m_csLock);
+	return TRUE;
+}
+
+//! 清除全部名稱樣式
+void CxFrameProcessWatch::ClearPattern()
+{
+	::EnterCriticalSection(&m_csLock);
+	m_aPattern.clear();
+	::LeaveCriticalSection(&m_csLock);
+}
+
+/**
+ * @brief	開始監看 (回呼模式)
+ * @param	[in] fnWatchPtr	事件處理函數
+ * @param	[in] aParamPtr	事件處理函數參數
+ * @param	[in] dwInterval	檢查新程序間隔時間 (in ms)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			已在監看中或建立執行緒池物件失敗返回零(zero)
+ * @remark	開始監看時已在執行且符合樣式的程序, 於函數返回前以 EProcStart 事件通知.
+ */
+BOOL CxFrameProcessWatch::Start(LPFNPROCWATCHPROC fnWatchPtr, LPVOID aParamPtr, DWORD dwInterval)
+{
+	if (fnWatchPtr == NULL || m_bRunning)
+		return FALSE;
+
+	m_fnWatchPtr = fnWatchPtr;
+	m_aParamPtr = aParamPtr;
+	m_hWnd = NULL;
+	m_uMessage = 0;
+	return this->StartWatch(dwInterval);
+}
+
+/**
+ * @brief	開始監看 (事件佇列模式)
+ * @param	[in] hWnd		事件通知視窗, 為 NULL 時不通知, 由調用端自行調用 GetEvents
+ * @param	[in] uMessage	事件通知訊息, 如 WM_APP + n
+ * @param	[in] dwInterval	檢查新程序間隔時間 (in ms)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			已在監看中或建立執行緒池物件失敗返回零(zero)
+ * @remark	佇列由空變為非空時才 PostMessage, 收到訊息後應以 GetEvents 一次取出全部事件.
+ */
+BOOL CxFrameProcessWatch::Start(HWND hWnd, UINT uMessage, DWORD dwInterval)
+{
+	if (m_bRunning)
+		return FALSE;
+
+	m_fnWatchPtr = NULL;
+	m_aParamPtr = NULL;
+	m_hWnd = hWnd;
+	m_uMessage = uMessage;
+	return this->StartWatch(dwInterval);
+}
+
+/**
+ * @brief	停止監看
+ * @remark	等待執行中的回呼完成後返回, 不可於事件處理函數內調用. \n
+ *			佇列內尚未取出的事件會保留.
+ */
+void CxFrameProcessWatch::Stop()
+{
+	::EnterCriticalSection(&m_csLock);
+	if (!m_bRunning) {
+		::LeaveCriticalSection(&m_csLock);
+		return;
+	}
+	m_bRunning = FALSE;
+	::LeaveCriticalSection(&m_csLock);
+
+	// 關閉計時器與全部等待物件, 並等待執行中的回呼完成
+	::CloseThreadpoolCleanupGroupMembers(m_tpGroup, TRUE, NULL);
+	::CloseThreadpoolCleanupGroup(m_tpGroup);
+	::DestroyThreadpoolEnvironment(&m_tpEnv);
+	m_tpGroup = NULL;
+	m_tpTimer = NULL;
+
+	for (auto it = m_mapWatch.begin(); it != m_mapWatch.end(); ++it) {
+		if (it->second->hProcess != NULL)
+			::CloseHandle(it->second->hProcess);
+		delete it->second;
+	}
+	m_mapWatch.clear();
+	m_index.Clear();
+}
+
+/**
+ * @brief	是否監看中
+ * @return	@c 型別: BOOL \n 監看中返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameProcessWatch::IsRunning() { return m_bRunning; }
+
+/**
+ * @brief	取出佇列內全部事件 (事件佇列模式)
+ * @param	[out] aEventPtr	事件存放位址, 事件會附加於尾端 (依發生順序)
+ * @return	@c 型別: size_t \n 取出的事件數量
+ */
+size_t CxFrameProcessWatch::GetEvents(std::vector<SSPROCEVENT>* aEventPtr)
+{
+	size_t nCount;
+
+	if (aEventPtr == NULL)
+		return 0;
+
+	::EnterCriticalSection(&m_csNotify);
+	nCount = m_aQueue.size();
+	aEventPtr->insert(aEventPtr->end(), m_aQueue.begin(), m_aQueue.end());
+	m_aQueue.clear();
+	::LeaveCriticalSection(&m_csNotify);
+	return nCount;
+}
+
+/**
+ * @brief	取得監看中的程序數量
+ * @return	@c 型別: size_t \n 符合樣式且尚未結束的程序數量
+ */
+size_t CxFrameProcessWatch::GetWatchCount()
+{
+	size_t nCount;
+
+	::EnterCriticalSection(&m_csLock);
+	nCount = m_mapWatch.size();
+	::LeaveCriticalSection(&m_csLock);
+	return nCount;
+}
+
+/**
+ * @brief	建立執行緒池物件並開始監看
+ * @param	[in] dwInterval	檢查新程序間隔時間 (in ms)
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ */
+BOOL CxFrameProcessWatch::StartWatch(DWORD dwInterval)
+{
+	auto err = BOOL(FALSE);
+
+	if (dwInterval == 0)
+		dwInterval = PROCWATCH_INTERVAL;
+
+	for (;;) {
+		m_tpGroup = ::CreateThreadpoolCleanupGroup();
+		if (m_tpGroup == NULL) break;
+
+		::InitializeThreadpoolEnvironment(&m_tpEnv);
+		::SetThreadpoolCallbackCleanupGroup(&m_tpEnv, m_tpGroup, NULL);
+
+		m_tpTimer = ::CreateThreadpoolTimer(StaticTimerProc, this, &m_tpEnv);
+		if (m_tpTimer == NULL) break;
+
+		// 先以目前程序建立索引, 已在執行的程序以 EProcStart 通知
+		m_index.Clear();
+		m_bRunning = TRUE;
+		this->Refresh();
+
+		// 允許系統延後 1/4 間隔, 與其他計時器合併喚醒
+		ULARGE_INTEGER uli;
+		FILETIME ftDue;
+		uli.QuadPart = static_cast<ULONGLONG>(-static_cast<LONGLONG>(dwInterval) * 10000);
+		ftDue.dwLowDateTime = uli.LowPart;
+		ftDue.dwHighDateTime = uli.HighPart;
+		::SetThreadpoolTimer(m_tpTimer, &ftDue, dwInterval, dwInterval / 4);
+		err = TRUE;
+		break;
+	}
+
+	if (!err && m_tpGroup != NULL) {
+		::CloseThreadpoolCleanupGroupMembers(m_tpGroup, TRUE, NULL);
+		::CloseThreadpoolCleanupGroup(m_tpGroup);
+		::DestroyThreadpoolEnvironment(&m_tpEnv);
+		m_tpGroup = NULL;
+		m_tpTimer = NULL;
+	}
+	return err;
+}
+
+/**
+ * @brief	更新程序索引, 處理新增與已結束的程序
+ * @remark	有 Handle 的程序由等待物件通知結束, 此處只處理無法開啟 (如權限不足) 的程序. \n
+ *			等待物件於 EProcStart 事件傳遞後才啟動, 確保同一程序的 EProcExit 在 EProcStart 之後.
+ */
+void CxFrameProcessWatch::Refresh()
+{
+	std::vector<DWORD> aStart, aExit;
+	std::vector<SSPROCEVENT> aEvent;
+	std::vector<SSWATCH*> aArm;
+	TCHAR szName[MAX_PATH];
+
+	::EnterCriticalSection(&m_csLock);
+	if (!m_bRunning || !m_index.Refresh(&aStart, &aExit)) {
+		::LeaveCriticalSection(&m_csLock);
+		return;
+	}
+
+	// 程序 ID 被重複使用時, 同一 ID 會先出現在 aExit 再出現在 aStart
+	for (size_t i = 0; i < aExit.size(); ++i) {
+		auto it = m_mapWatch.find(aExit[i]);
+		if (it == m_mapWatch.end() || it->second->hProcess != NULL)
+			continue;
+
+		aEvent.resize(aEvent.size() + 1);
+		MakeEvent(EProcExit, it->first, PROCWATCH_EXIT_UNKNOWN, it->second->strName.c_str(), &aEvent.back());
+		delete it->second;
+		m_mapWatch.erase(it);
+	}
+
+	for (size_t i = 0; i < aStart.size(); ++i) {
+		if (!m_index.GetModuleName(aStart[i], szName, MAX_PATH) || !this->IsMatch(szName))
+			continue;
+		this->AddWatch(aStart[i], szName, &aEvent, &aArm);
+	}
+	::LeaveCriticalSection(&m_csLock);
+
+	this->Deliver(&aEvent);
+	if (aArm.empty())
+		return;
+
+	// 啟動等待物件; 尚未啟動的監看項目只會由 Stop 釋放, 監看中即仍有效
+	::EnterCriticalSection(&m_csLock);
+	if (m_bRunning) {
+		for (size_t i = 0; i < aArm.size(); ++i)
+			::SetThreadpoolWait(aArm[i]->tpWait, aArm[i]->hProcess, NULL);
+	}
+	::LeaveCriticalSection(&m_csLock);
+}
+
+/**
+ * @brief	程序名稱是否符合監看樣式
+ * @param	[in] szNamePtr	程序名稱
+ * @return	@c 型別: BOOL \n 符合返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameProcessWatch::IsMatch(LPCTSTR szNamePtr)
+{
+	if (m_aPattern.empty())
+		return TRUE;
+
+	for (size_t i = 0; i < m_aPattern.size(); ++i) {
+		if (::PathMatchSpec(szNamePtr, m_aPattern[i].c_str()))
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/**
+ * @brief	加入監看中的程序
+ * @param	[in]  dwProcessID	程序 ID
+ * @param	[in]  szNamePtr		程序名稱
+ * @param	[out] aEventPtr		事件存放位址, EProcStart 事件會附加於尾端
+ * @param	[out] aArmPtr		待啟動的等待物件, 監看項目會附加於尾端
+ * @remark	持有程序 Handle 期間系統不會重複使用此程序 ID. \n
+ *			等待物件只建立不啟動, 由調用者於傳遞 EProcStart 事件後啟動.
+ */
+void CxFrameProcessWatch::AddWatch(DWORD dwProcessID, LPCTSTR szNamePtr, std::vector<SSPROCEVENT>* aEventPtr, std::vector<SSWATCH*>* aArmPtr)
+{
+	SSWATCH* watchPtr;
+
+	auto it = m_mapWatch.find(dwProcessID);
+	if (it != m_mapWatch.end()) {
+		// 仍持有 Handle 表示舊程序尚未通知結束
+		if (it->second->hProcess != NULL)
+			return;
+		delete it->second;
+		m_mapWatch.erase(it);
+	}
+
+	watchPtr = new SSWATCH;
+	watchPtr->thisPtr = this;
+	watchPtr->dwProcessID = dwProcessID;
+	watchPtr->strName = szNamePtr;
+	watchPtr->tpWait = NULL;
+	watchPtr->hProcess = ::OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, dwProcessID);
+	if (watchPtr->hProcess == NULL)
+		watchPtr->hProcess = ::OpenProcess(SYNCHRONIZE, FALSE, dwProcessID);
+
+	if (watchPtr->hProcess != NULL) {
+		watchPtr->tpWait = ::CreateThreadpoolWait(StaticWaitProc, watchPtr, &m_tpEnv);
+		if (watchPtr->tpWait != NULL) {
+			aArmPtr->push_back(watchPtr);
+		}
+		else {
+			// 無法建立等待物件, 改由程序索引偵測結束
+			::CloseHandle(watchPtr->hProcess);
+			watchPtr->hProcess = NULL;
+		}
+	}
+
+	m_mapWatch[dwProcessID] = watchPtr;
+
+	aEventPtr->resize(aEventPtr->size() + 1);
+	MakeEvent(EProcStart, dwProcessID, 0, szNamePtr, &aEventPtr->back());
+}
+
+/**
+ * @brief	程序結束, 移除監看項目
+ * @param	[in] watchPtr	監看項目
+ */
+void CxFrameProcessWatch::CloseWatch(SSWATCH* watchPtr)
+{
+	std::vector<SSPROCEVENT> aEvent(1);
+	DWORD dwExitCode = PROCWATCH_EXIT_UNKNOWN;
+
+	::EnterCriticalSection(&m_csLock);
+	if (!m_bRunning) {
+		// 正在停止, 由 Stop 釋放
+		::LeaveCriticalSection(&m_csLock);
+		return;
+	}
+	m_mapWatch.erase(watchPtr->dwProcessID);
+	::CloseThreadpoolWait(watchPtr->tpWait);
+	::LeaveCriticalSection(&m_csLock);
+
+	if (!::GetExitCodeProcess(watchPtr->hProcess, &dwExitCode))
+		dwExitCode = PROCWATCH_EXIT_UNKNOWN;
+	MakeEvent(EProcExit, watchPtr->dwProcessID, dwExitCode, watchPtr->strName.c_str(), &aEvent[0]);
+	::CloseHandle(watchPtr->hProcess);
+	delete watchPtr;
+
+	this->Deliver(&aEvent);
+}
+
+/**
+ * @brief	傳遞事件
+ * @param	[in] aEventPtr	事件
+ * @remark	回呼模式依序調用事件處理函數; 佇列模式存入佇列, 佇列由空變為非空時通知視窗.
+ */
+void CxFrameProcessWatch::Deliver(std::vector<SSPROCEVENT>* aEventPtr)
+{
+	BOOL bNotify;
+
+	if (aEventPtr->empty())
+		return;
+
+	::EnterCriticalSection(&m_csNotify);
+	if (m_fnWatchPtr != NULL) {
+		for (size_t i = 0; i < aEventPtr->size(); ++i)
+			m_fnWatchPtr(m_aParamPtr, &(*aEventPtr)[i]);
+		::LeaveCriticalSection(&m_csNotify);
+		return;
+	}
+
+	bNotify = m_aQueue.empty();
+	m_aQueue.insert(m_aQueue.end(), aEventPtr->begin(), aEventPtr->end());
+	::LeaveCriticalSection(&m_csNotify);
+
+	if (bNotify && m_hWnd != NULL)
+		::PostMessage(m_hWnd, m_uMessage, 0, 0);
+}
+
+/**
+ * @brief	填寫事件內容 (static)
+ * @param	[in]  eEvent		事件類型
+ * @param	[in]  dwProcessID	程序 ID
+ * @param	[in]  dwExitCode	結束代碼
+ * @param	[in]  szNamePtr		程序名稱
+ * @param	[out] eventPtr		事件存放位址
+ */
+void CxFrameProcessWatch::MakeEvent(EEPROCEVENT eEvent, DWORD dwProcessID, DWORD dwExitCode, LPCTSTR szNamePtr, SSPROCEVENT* eventPtr)
+{
+	eventPtr->eEvent = eEvent;
+	eventPtr->dwProcessID = dwProcessID;
+	eventPtr->dwExitCode = dwExitCode;
+	_tcsncpy_s(eventPtr->szName, MAX_PATH, szNamePtr, _TRUNCATE);
+}
+
+/**
+ * @brief	新程序檢查計時器回呼函數 (static)
+ * @param	[in] tpInstance		回呼實體
+ * @param	[in] aContextPtr	CxFrameProcessWatch 物件指標
+ * @param	[in] tpTimer		計時器物件
+ */
+void CALLBACK CxFrameProcessWatch::StaticTimerProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_TIMER tpTimer)
+{
+	UNREFERENCED_PARAMETER(tpInstance);
+	UNREFERENCED_PARAMETER(tpTimer);
+	reinterpret_cast<CxFrameProcessWatch*>(aContextPtr)->Refresh();
+}
+
+/**
+ * @brief	程序結束等待回呼函數 (static)
+ * @param	[in] tpInstance		回呼實體
+ * @param	[in] aContextPtr	SSWATCH 監看項目指標
+ * @param	[in] tpWait			等待物件
+ * @param	[in] tpResult		等待結果
+ */
+void CALLBACK CxFrameProcessWatch::StaticWaitProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_WAIT tpWait, TP_WAIT_RESULT tpResult)
+{
+	UNREFERENCED_PARAMETER(tpInstance);
+	UNREFERENCED_PARAMETER(tpWait);
+	UNREFERENCED_PARAMETER(tpResult);
+
+	SSWATCH* watchPtr = reinterpret_cast<SSWATCH*>(aContextPtr);
+	watchPtr->thisPtr->CloseWatch(watchPtr);
+}
@@ -0,0 +1,360 @@
+﻿/**************************************************************************//**
+ * @file	wframe_ptrchain.cc
+ * @brief	多層指標路徑解析類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_ptrchain.hh"
+
+//! CxFramePointerChain 建構式
+CxFramePointerChain::CxFramePointerChain()
+	: m_procPtr(NULL)
+	, m_uPtrSize(sizeof(ULONG_PTR))
+	, m_dwTick(0)
+	, m_nCacheTicks(PTRCHAIN_CACHE_TICKS)
+	, m_nRetryTicks(PTRCHAIN_RETRY_TICKS)
+{
+	::memset(&m_stat, 0, sizeof(m_stat));
+}
+
+//! CxFramePointerChain 解構式
+CxFramePointerChain::~CxFramePointerChain() { this->Close(); }
+
+/**
+ * @brief	建立指標路徑解析
+ * @param	[in] procPtr	已開啟的目標程序物件
+ * @param	[in] uPtrSize	目標程序指標大小, 4 (32 位元程序) 或 8 (64 位元程序)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			參數錯誤返回零(zero)
+ */
+BOOL CxFramePointerChain::Create(CxFrameProcess* procPtr, SIZE_T uPtrSize)
+{
+	if (procPtr == NULL || (uPtrSize != 4 && uPtrSize != 8) || uPtrSize > sizeof(ULONG_PTR))
+		return FALSE;
+
+	this->Close();
+	m_procPtr = procPtr;
+	m_uPtrSize = uPtrSize;
+	return TRUE;
+}
+
+//! 清除全部路徑與快取
+void CxFramePointerChain::Close()
+{
+	this->ClearPath();
+	m_procPtr = NULL;
+}
+
+/**
+ * @brief	加入指標路徑
+ * @param	[in] uBase		起始位址 (如模組基底位址 + 靜態偏移量)
+ * @param	[in] aOffsetPtr	各層偏移量陣列
+ * @param	[in] nOffsets	偏移量數量, 零(zero) 表示解析結果即為 uBase
+ * @return	@c 型別: size_t \n 路徑索引
+ * @remark	路徑索引於 ClearPath 前不會改變.
+ */
+size_t CxFramePointerChain::AddPath(ULONG_PTR uBase, const LONG_PTR* aOffsetPtr, size_t nOffsets)
+{
+	if (aOffsetPtr == NULL)
+		nOffsets = 0;
+
+	m_aBase.push_back(uBase);
+	m_aFirst.push_back(m_aOffset.size());
+	m_aDepth.push_back(nOffsets);
+	m_aOffset.insert(m_aOffset.end(), aOffsetPtr, aOffsetPtr + nOffsets);
+	m_aTrail.resize(m_aOffset.size(), 0);
+	m_aResult.push_back(0);
+	m_aCursor.push_back(0);
+	m_aStatus.push_back(PTRCHAIN_OK);
+	m_aRetry.push_back(0);
+	m_aCached.push_back(0);
+	return m_aBase.size() - 1;
+}
+
+/**
+ * @brief	移除指標路徑
+ * @param	[in] idxPath	路徑索引
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 索引錯誤返回零(zero)
+ * @remark	其他路徑索引不變, 已移除的路徑不再解析.
+ */
+BOOL CxFramePointerChain::RemovePath(size_t idxPath)
+{
+	if (idxPath >= m_aStatus.size())
+		return FALSE;
+
+	m_aStatus[idxPath] = PTRCHAIN_REMOVED;
+	m_aResult[idxPath] = 0;
+	return TRUE;
+}
+
+//! 清除全部路徑與快取
+void CxFramePointerChain::ClearPath()
+{
+	m_aBase.clear();
+	m_aFirst.clear();
+	m_aDepth.clear();
+	m_aOffset.clear();
+	m_aTrail.clear();
+	m_aResult.clear();
+	m_aCursor.clear();
+	m_aStatus.clear();
+	m_aRetry.clear();
+	m_aCached.clear();
+	m_mapCache.clear();
+}
+
+/**
+ * @brief	解析全部路徑
+ * @return	@c 型別: size_t \n 本次解析成功的路徑數量
+ * @remark	每一層只調用一次 ReadMemoryV, 調用次數最多為最長路徑的偏移量數量 - 1. \n
+ *			於重試間隔內的中斷路徑不解析, 保留中斷狀態.
+ */
+size_t CxFramePointerChain::Resolve()
+{
+	size_t nResolved = 0;
+
+	if (m_procPtr == NULL)
+		return 0;
+
+	++m_dwTick;
+	++m_stat.nResolve;
+
+	m_aActive.clear();
+	for (size_t p = 0; p < m_aStatus.size(); ++p) {
+		if (m_aStatus[p] == PTRCHAIN_REMOVED)
+			continue;
+		if (m_aStatus[p] != PTRCHAIN_OK && static_cast<LONG>(m_dwTick - m_aRetry[p]) < 0) {
+			++m_stat.nSkip;
+			continue;
+		}
+		m_aStatus[p] = PTRCHAIN_OK;
+		m_aCursor[p] = m_aBase[p];
+		m_aCached[p] = 0;
+		m_aActive.push_back(p);
+	}
+
+	for (size_t iLevel = 0; !m_aActive.empty(); ++iLevel) {
+		size_t nKeep = 0;
+
+		m_aPending.clear();
+		m_aRequest.clear();
+		for (size_t i = 0; i < m_aActive.size(); ++i) {
+			size_t p = m_aActive[i];
+
+			// 最後一層不讀取, 指標加上偏移量即為結果
+			if (m_aDepth[p] == 0) {
+				m_aResult[p] = m_aBase[p];
+				++nResolved;
+				continue;
+			}
+			size_t idxOffset = m_aFirst[p] + iLevel;
+			ULONG_PTR uAddress = m_aCursor[p] + m_aOffset[idxOffset];
+			if (iLevel == m_aDepth[p] - 1) {
+				m_aResult[p] = uAddress;
+				++nResolved;
+				continue;
+			}
+
+			m_aTrail[idxOffset] = uAddress;
+			if (m_nCacheTicks != 0) {
+				auto it = m_mapCache.find(uAddress);
+				if (it != m_mapCache.end() && m_dwTick - it->second.dwTick < m_nCacheTicks) {
+					m_aCursor[p] = it->second.uValue;
+					m_aCached[p] = 1;
+					m_aActive[nKeep++] = p;
+					++m_stat.nHit;
+					continue;
+				}
+			}
+			m_aPending.push_back(p);
+			m_aRequest.push_back(uAddress);
+		}
+
+		if (!m_aPending.empty()) {
+			std::sort(m_aRequest.begin(), m_aRequest.end());
+			m_aRequest.erase(std::unique(m_aRequest.begin(), m_aRequest.end()), m_aRequest.end());
+			this->ReadLevel();
+
+			for (size_t i = 0; i < m_aPending.size(); ++i) {
+				size_t p = m_aPending[i];
+				ULONG_PTR uAddress = m_aTrail[m_aFirst[p] + iLevel];
+				size_t idx = std::lower_bound(m_aRequest.begin(), m_aRequest.end(), uAddress) - m_aRequest.begin();
+
+				if (m_aValue[idx] == 0) {
+					this->BreakPath(p, static_cast<int>(iLevel));
+					continue;
+				}
+				m_aCursor[p] = m_aValue[idx];
+				m_aActive[nKeep++] = p;
+			}
+		}
+		m_aActive.resize(nKeep);
+	}
+	return nResolved;
+}
+
+/**
+ * @brief	取得路徑解析結果
+ * @param	[in] idxPath	路徑索引
+ * @return	@c 型別: ULONG_PTR \n 解析後的位址, 路徑中斷或索引錯誤返回零(zero)
+ */
+ULONG_PTR CxFramePointerChain::GetAddress(size_t idxPath)
+{
+	if (idxPath >= m_aStatus.size() || m_aStatus[idxPath] != PTRCHAIN_OK)
+		return 0;
+	return m_aResult[idxPath];
+}
+
+/**
+ * @brief	取得路徑狀態
+ * @param	[in] idxPath	路徑索引
+ * @return	@c 型別: int \n
+ *			PTRCHAIN_OK: 解析成功 \n
+ *			PTRCHAIN_REMOVED: 已移除或索引錯誤 \n
+ *			零或正值: 路徑中斷, 數值為讀取失敗的層 (第幾個偏移量)
+ */
+int CxFramePointerChain::GetStatus(size_t idxPath)
+{
+	return idxPath < m_aStatus.size() ? m_aStatus[idxPath] : PTRCHAIN_REMOVED;
+}
+
+/**
+ * @brief	取得中斷的路徑
+ * @param	[out] aPathPtr	路徑索引存放位址, 索引會附加於尾端
+ * @return	@c 型別: size_t \n 中斷的路徑數量
+ */
+size_t CxFramePointerChain::GetBroken(std::vector<size_t>* aPathPtr)
+{
+	size_t nCount = 0;
+
+	for (size_t p = 0; p < m_aStatus.size(); ++p) {
+		if (m_aStatus[p] < 0)
+			continue;
+		if (aPathPtr != NULL) aPathPtr->push_back(p);
+		++nCount;
+	}
+	return nCount;
+}
+
+//! 下次 Resolve 時重新解析全部中斷的路徑
+void CxFramePointerChain::RetryBroken()
+{
+	for (size_t p = 0; p < m_aStatus.size(); ++p) {
+		if (m_aStatus[p] >= 0)
+			m_aRetry[p] = m_dwTick;
+	}
+}
+
+/**
+ * @brief	設定中間指標快取有效次數
+ * @param	[in] nTicks	Resolve 次數, 零(zero) 表示不使用快取
+ */
+void CxFramePointerChain::SetCacheTicks(DWORD nTicks)
+{
+	m_nCacheTicks = nTicks;
+	if (nTicks == 0) m_mapCache.clear();
+}
+
+/**
+ * @brief	設定中斷路徑重試間隔
+ * @param	[in] nTicks	Resolve 次數, 零(zero) 表示每次都重試
+ */
+void CxFramePointerChain::SetRetryTicks(DWORD nTicks) { m_nRetryTicks = nTicks; }
+
+//! 清除全部中間指標快取
+void CxFramePointerChain::Invalidate() { m_mapCache.clear(); }
+
+/**
+ * @brief	清除指定範圍的中間指標快取
+ * @param	[in] uBase	起始位址
+ * @param	[in] uSize	範圍長度 (in Byte)
+ * @remark	用於已知某結構被重新配置 (如場景切換) 時.
+ */
+void CxFramePointerChain::Invalidate(ULONG_PTR uBase, SIZE_T uSize)
+{
+	for (auto it = m_mapCache.begin(); it != m_mapCache.end();) {
+		if (it->first >= uBase && it->first - uBase < uSize) {
+			it = m_mapCache.erase(it);
+			continue;
+		}
+		++it;
+	}
+}
+
+/**
+ * @brief	取得統計資訊
+ * @param	[out] statPtr	統計資訊存放位址
+ */
+void CxFramePointerChain::GetStats(LPSSPTRCHAINSTAT statPtr)
+{
+	if (statPtr != NULL) *statPtr = m_stat;
+}
+
+//! 重設統計資訊
+void CxFramePointerChain::ResetStats() { ::memset(&m_stat, 0, sizeof(m_stat)); }
+
+/**
+ * @brief	以一次 ReadMemoryV 讀取本層全部指標
+ * @remark	讀取位址為 m_aRequest, 結果存入 m_aValue (讀取失敗為零), 成功的指標存入快取.
+ */
+void CxFramePointerChain::ReadLevel()
+{
+	size_t nCount = m_aRequest.size();
+
+	m_aValue.assign(nCount, 0);
+	m_aRange.resize(nCount);
+	for (size_t i = 0; i < nCount; ++i) {
+		m_aRange[i].aBasePtr = reinterpret_cast<LPVOID>(m_aRequest[i]);
+		m_aRange[i].aBuffPtr = &m_aValue[i];
+		m_aRange[i].uSize = m_uPtrSize;
+		m_aRange[i].cbDone = 0;
+	}
+	m_procPtr->ReadMemoryV(m_aRange.data(), nCount);
+	++m_stat.nRead;
+	m_stat.nPointer += nCount;
+
+	// 快取項目過多時移除已過期的項目
+	if (m_nCacheTicks != 0 && m_mapCache.size() > m_aOffset.size() * 2 + BUFF_SIZE_1024) {
+		for (auto it = m_mapCache.begin(); it != m_mapCache.end();) {
+			if (m_dwTick - it->second.dwTick >= m_nCacheTicks) {
+				it = m_mapCache.erase(it);
+				continue;
+			}
+			++it;
+		}
+	}
+
+	for (size_t i = 0; i < nCount; ++i) {
+		if (m_aRange[i].cbDone != m_uPtrSize)
+			m_aValue[i] = 0;
+		else if (m_nCacheTicks != 0 && m_aValue[i] != 0) {
+			SSCACHE& cache = m_mapCache[m_aRequest[i]];
+			cache.uValue = m_aValue[i];
+			cache.dwTick = m_dwTick;
+		}
+	}
+}
+
+/**
+ * @brief	標示路徑中斷
+ * @param	[in] idxPath	路徑索引
+ * @param	[in] iLevel		讀取失敗的層
+ * @remark	若路徑使用了快取指標, 中斷可能是快取過期所致, 清除此路徑使用的快取並於下次 Resolve 重試.
+ */
+void CxFramePointerChain::BreakPath(size_t idxPath, int iLevel)
+{
+	m_aStatus[idxPath] = iLevel;
+	m_aResult[idxPath] = 0;
+	++m_stat.nBroken;
+
+	if (m_aCached[idxPath]) {
+		for (int i = 0; i < iLevel; ++i)
+			m_mapCache.erase(m_aTrail[m_aFirst[idxPath] + i]);
+		m_aRetry[idxPath] = m_dwTick + 1;
+		return;
+	}
+	m_aRetry[idxPath] = m_dwTick + m_nRetryTicks;
+}
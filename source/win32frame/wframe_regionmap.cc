@@ -0,0 +1,329 @@
+﻿/**************************************************************************//**
+ * @file	wframe_regionmap.cc
+ * @brief	程序記憶體區域對照表類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_regionmap.hh"
+
+//! CxFrameRegionMap 建構式
+CxFrameRegionMap::CxFrameRegionMap() : m_hProcess(NULL) { }
+
+//! CxFrameRegionMap 解構式
+CxFrameRegionMap::~CxFrameRegionMap() { this->Clear(); }
+
+/**
+ * @brief	載入目標程序全部記憶體區域
+ * @param	[in] procPtr	已開啟的目標程序物件
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			函數操作失敗返回零(zero)
+ */
+BOOL CxFrameRegionMap::Load(CxFrameProcess* procPtr)
+{
+	if (procPtr == NULL)
+		return FALSE;
+	return this->Load(procPtr->GetProcessHandle());
+}
+
+/**
+ * @brief	載入目標程序全部記憶體區域
+ * @param	[in] hProcess	目標程序 handle, 需具備 PROCESS_QUERY_INFORMATION 權限
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			函數操作失敗返回零(zero)
+ * @remark	handle 由調用者管理, 對照表存在期間不可關閉.
+ */
+BOOL CxFrameRegionMap::Load(HANDLE hProcess)
+{
+	this->Clear();
+	if (hProcess == NULL)
+		return FALSE;
+
+	m_hProcess = hProcess;
+	return this->QueryRange(0, static_cast<ULONG_PTR>(-1), &m_aRegion);
+}
+
+/**
+ * @brief	更新指定位址範圍的記憶體區域
+ * @param	[in] uStart	起始位址
+ * @param	[in] uEnd	結束位址 (不包含)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			尚未載入或參數錯誤返回零(zero)
+ * @remark	範圍會擴展至涵蓋既有區域的邊界, 只重新查詢此範圍, 其餘區域維持不變.
+ */
+BOOL CxFrameRegionMap::Refresh(ULONG_PTR uStart, ULONG_PTR uEnd)
+{
+	std::vector<SSMEMREGION> aRegion;
+	size_t idx;
+
+	if (m_hProcess == NULL || uStart >= uEnd)
+		return FALSE;
+
+	// 擴展起始位址至既有區域的起點
+	idx = this->LowerIndex(uStart);
+	if (idx < m_aRegion.size() && m_aRegion[idx].uBase < uStart)
+		uStart = m_aRegion[idx].uBase;
+
+	// 重新查詢, 直到結束位址不落在既有區域中間
+	ULONG_PTR uQuery = uStart;
+	for (;;) {
+		this->QueryRange(uQuery, uEnd, &aRegion);
+		if (!aRegion.empty()) {
+			ULONG_PTR uLast = aRegion.back().uBase + aRegion.back().uSize;
+			if (uLast > uEnd) uEnd = uLast;
+		}
+
+		idx = this->LowerIndex(uEnd - 1);
+		if (idx < m_aRegion.size() && m_aRegion[idx].uBase < uEnd && m_aRegion[idx].uBase + m_aRegion[idx].uSize > uEnd) {
+			uQuery = uEnd;
+			uEnd = m_aRegion[idx].uBase + m_aRegion[idx].uSize;
+			continue;
+		}
+		break;
+	}
+	if (!aRegion.empty() && aRegion.front().uBase < uStart)
+		uStart = aRegion.front().uBase;
+
+	// 以新查詢結果取代範圍內的既有區域
+	auto itFirst = m_aRegion.begin() + this->LowerIndex(uStart);
+	auto itLast = std::lower_bound(itFirst, m_aRegion.end(), uEnd, [](const SSMEMREGION& rg, ULONG_PTR uAddress) {
+		return rg.uBase < uAddress;
+	});
+	itFirst = m_aRegion.erase(itFirst, itLast);
+	m_aRegion.insert(itFirst, aRegion.begin(), aRegion.end());
+	return TRUE;
+}
+
+//! 清除對照表內容
+void CxFrameRegionMap::Clear()
+{
+	m_aRegion.clear();
+	m_aModule.clear();
+	m_mapModule.clear();
+	m_hProcess = NULL;
+}
+
+/**
+ * @brief	查詢位址所在的記憶體區域
+ * @param	[in] uAddress	目標位址
+ * @return	@c 型別: const SSMEMREGION* \n
+ *			返回所在區域資訊, 位址不在任何已配置區域中返回 NULL
+ * @remark	返回的指標於下次 Load, Refresh 或 Clear 後失效.
+ */
+const SSMEMREGION* CxFrameRegionMap::Find(ULONG_PTR uAddress)
+{
+	size_t idx = this->LowerIndex(uAddress);
+
+	if (idx < m_aRegion.size() && m_aRegion[idx].uBase <= uAddress)
+		return &m_aRegion[idx];
+	return NULL;
+}
+
+/**
+ * @brief	檢查位址範圍是否可讀取
+ * @param	[in] uAddress	起始位址
+ * @param	[in] uSize		長度 (in Byte)
+ * @return	@c 型別: BOOL \n
+ *			範圍完整落在相連的可讀取區域中返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameRegionMap::IsReadable(ULONG_PTR uAddress, SIZE_T uSize)
+{
+	size_t idx = this->LowerIndex(uAddress);
+	ULONG_PTR uEnd = uAddress + uSize;
+
+	while (idx < m_aRegion.size()) {
+		const SSMEMREGION* rgPtr = &m_aRegion[idx];
+		if (rgPtr->uBase > uAddress || !IsReadableRegion(rgPtr))
+			return FALSE;
+
+		uAddress = rgPtr->uBase + rgPtr->uSize;
+		if (uAddress >= uEnd)
+			return TRUE;
+		++idx;
+	}
+	return FALSE;
+}
+
+/**
+ * @brief	取得可讀取的記憶體區域
+ * @param	[out] aRegionPtr	區域存放位址, 找到的區域會附加於尾端
+ * @param	[in]  uStart		起始位址
+ * @param	[in]  uEnd			結束位址 (不包含)
+ * @return	@c 型別: size_t \n 找到的區域數量
+ * @remark	與範圍部分重疊的區域, 起始位址與長度會裁切至範圍內.
+ */
+size_t CxFrameRegionMap::GetReadable(std::vector<SSMEMREGION>* aRegionPtr, ULONG_PTR uStart, ULONG_PTR uEnd)
+{
+	size_t nCount = 0;
+
+	if (aRegionPtr == NULL)
+		return 0;
+
+	for (size_t idx = this->LowerIndex(uStart); idx < m_aRegion.size(); ++idx) {
+		SSMEMREGION rg = m_aRegion[idx];
+		if (rg.uBase >= uEnd)
+			break;
+		if (!IsReadableRegion(&rg))
+			continue;
+
+		ULONG_PTR uLow = rg.uBase < uStart ? uStart : rg.uBase;
+		ULONG_PTR uHigh = rg.uBase + rg.uSize;
+		if (uHigh > uEnd) uHigh = uEnd;
+
+		rg.uBase = uLow;
+		rg.uSize = static_cast<SIZE_T>(uHigh - uLow);
+		aRegionPtr->push_back(rg);
+		++nCount;
+	}
+	return nCount;
+}
+
+/**
+ * @brief	取得區域數量
+ * @return	@c 型別: size_t \n 對照表中的區域數量
+ */
+size_t CxFrameRegionMap::GetCount() { return m_aRegion.size(); }
+
+/**
+ * @brief	取得指定索引的區域
+ * @param	[in] idx	區域索引 (依起始位址排序)
+ * @return	@c 型別: const SSMEMREGION* \n 區域資訊, 索引超出範圍返回 NULL
+ */
+const SSMEMREGION* CxFrameRegionMap::GetRegion(size_t idx)
+{
+	if (idx >= m_aRegion.size())
+		return NULL;
+	return &m_aRegion[idx];
+}
+
+/**
+ * @brief	取得模組完整路徑
+ * @param	[in] idxModule	模組索引 (SSMEMREGION::idxModule)
+ * @return	@c 型別: LPCTSTR \n 模組路徑 (裝置路徑格式, 如 \\Device\\HarddiskVolume1\\...), 索引無效返回 NULL
+ */
+LPCTSTR CxFrameRegionMap::GetModulePath(int idxModule)
+{
+	if (idxModule < 0 || static_cast<size_t>(idxModule) >= m_aModule.size())
+		return NULL;
+	return m_aModule[idxModule].c_str();
+}
+
+/**
+ * @brief	取得模組檔案名稱
+ * @param	[in] idxModule	模組索引 (SSMEMREGION::idxModule)
+ * @return	@c 型別: LPCTSTR \n 模組檔案名稱 (不含路徑), 索引無效返回 NULL
+ */
+LPCTSTR CxFrameRegionMap::GetModuleName(int idxModule)
+{
+	LPCTSTR szPathPtr = this->GetModulePath(idxModule);
+
+	if (szPathPtr != NULL) {
+		LPCTSTR szNamePtr = _tcsrchr(szPathPtr, TEXT('\\'));
+		if (szNamePtr != NULL)
+			return szNamePtr + 1;
+	}
+	return szPathPtr;
+}
+
+/**
+ * @brief	區域是否可讀取
+ * @param	[in] rgPtr	區域資訊
+ * @return	@c 型別: BOOL \n 已提交且非 PAGE_NOACCESS, PAGE_GUARD 返回非零值(non-zero)
+ */
+BOOL CxFrameRegionMap::IsReadableRegion(const SSMEMREGION* rgPtr)
+{
+	return rgPtr->dwState == MEM_COMMIT && rgPtr->dwProtect != 0 &&
+		(rgPtr->dwProtect & (PAGE_NOACCESS | PAGE_GUARD)) == 0;
+}
+
+/**
+ * @brief	區域是否可寫入
+ * @param	[in] rgPtr	區域資訊
+ * @return	@c 型別: BOOL \n 已提交且具備寫入權限 (不含 PAGE_GUARD) 返回非零值(non-zero)
+ */
+BOOL CxFrameRegionMap::IsWritableRegion(const SSMEMREGION* rgPtr)
+{
+	const DWORD dwWrite = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+	return IsReadableRegion(rgPtr) && (rgPtr->dwProtect & dwWrite) != 0;
+}
+
+/**
+ * @brief	取得位址所在或之後的第一個區域索引
+ * @param	[in] uAddress	目標位址
+ * @return	@c 型別: size_t \n 區域索引, 沒有符合區域時返回 GetCount()
+ */
+size_t CxFrameRegionMap::LowerIndex(ULONG_PTR uAddress)
+{
+	auto it = std::upper_bound(m_aRegion.begin(), m_aRegion.end(), uAddress, [](ULONG_PTR uAddr, const SSMEMREGION& rg) {
+		return uAddr < rg.uBase;
+	});
+	size_t idx = static_cast<size_t>(it - m_aRegion.begin());
+
+	if (idx > 0 && m_aRegion[idx - 1].uBase + m_aRegion[idx - 1].uSize > uAddress)
+		return idx - 1;
+	return idx;
+}
+
+/**
+ * @brief	查詢位址範圍內的記憶體區域
+ * @param	[in]  uStart		起始位址
+ * @param	[in]  uEnd			結束位址 (不包含)
+ * @param	[out] aRegionPtr	區域存放位址, 找到的區域會附加於尾端 (略過 MEM_FREE)
+ * @return	@c 型別: BOOL \n 至少查詢成功一次返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameRegionMap::QueryRange(ULONG_PTR uStart, ULONG_PTR uEnd, std::vector<SSMEMREGION>* aRegionPtr)
+{
+	MEMORY_BASIC_INFORMATION mbi;
+	ULONG_PTR uAddress = uStart;
+	auto err = BOOL(FALSE);
+
+	while (uAddress < uEnd) {
+		if (::VirtualQueryEx(m_hProcess, reinterpret_cast<LPCVOID>(uAddress), &mbi, sizeof(mbi)) != sizeof(mbi))
+			break;
+		err = TRUE;
+
+		ULONG_PTR uBase = reinterpret_cast<ULONG_PTR>(mbi.BaseAddress);
+		ULONG_PTR uNext = uBase + mbi.RegionSize;
+		if (uNext <= uAddress)
+			break;
+
+		if (mbi.State != MEM_FREE) {
+			SSMEMREGION rg;
+			rg.uBase = uBase;
+			rg.uSize = mbi.RegionSize;
+			rg.uAllocBase = reinterpret_cast<ULONG_PTR>(mbi.AllocationBase);
+			rg.dwState = mbi.State;
+			rg.dwProtect = mbi.State == MEM_COMMIT ? mbi.Protect : 0;
+			rg.dwType = mbi.Type;
+			rg.idxModule = (mbi.Type == MEM_IMAGE || mbi.Type == MEM_MAPPED) ? this->QueryModule(rg.uAllocBase) : -1;
+			aRegionPtr->push_back(rg);
+		}
+		uAddress = uNext;
+	}
+	return err;
+}
+
+/**
+ * @brief	查詢配置起始位址對應的模組
+ * @param	[in] uAllocBase	配置起始位址
+ * @return	@c 型別: int \n 模組索引, 無法取得模組名稱返回 -1
+ * @remark	同一配置的各區域共用查詢結果, 每個模組只調用一次 GetMappedFileName.
+ */
+int CxFrameRegionMap::QueryModule(ULONG_PTR uAllocBase)
+{
+	auto it = m_mapModule.find(uAllocBase);
+	if (it != m_mapModule.end())
+		return it->second;
+
+	TCHAR szPath[MAX_PATH];
+	int idxModule = -1;
+	if (::GetMappedFileName(m_hProcess, reinterpret_cast<LPVOID>(uAllocBase), szPath, MAX_PATH) != 0) {
+		idxModule = static_cast<int>(m_aModule.size());
+		m_aModule.push_back(szPath);
+	}
+	m_mapModule[uAllocBase] = idxModule;
+	return idxModule;
+}
@@ -0,0 +1,494 @@
+﻿/**************************************************************************//**
+ * @file	wframe_scanner.cc
+ * @brief	程序記憶體特徵碼 (AOB) 搜尋類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_scanner.hh"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#	include <intrin.h>
+#	define PATTERN_SCAN_SIMD	1		//!< 支援 x86/x64 SIMD 錨點搜尋
+#endif
+
+//! CxFramePatternScan 建構式
+CxFramePatternScan::CxFramePatternScan()
+	: m_idxAnchor(0)
+	, m_bAnchor(FALSE)
+	, m_fnFindPtr(SelectFindByte())
+	, m_mapPtr(NULL)
+	, m_hProcess(NULL)
+	, m_poolPtr(NULL)
+	, m_fnScanPtr(NULL)
+	, m_aParamPtr(NULL)
+	, m_nMatch(0)
+	, m_bStop(FALSE)
+{
+	::InitializeCriticalSection(&m_csEmit);
+}
+
+//! CxFramePatternScan 解構式
+CxFramePatternScan::~CxFramePatternScan() { ::DeleteCriticalSection(&m_csEmit); }
+
+/**
+ * @brief	設定特徵碼 (IDA 格式字串)
+ * @param	[in] szPatternPtr	特徵碼字串, 如: "48 8B ?? ?5 E8"
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			字串格式錯誤或長度超過 PATTERN_SCAN_MAXLEN 返回零(zero)
+ */
+BOOL CxFramePatternScan::SetPattern(LPCTSTR szPatternPtr)
+{
+	BYTE aValue[PATTERN_SCAN_MAXLEN];
+	BYTE aMask[PATTERN_SCAN_MAXLEN];
+	size_t uSize = 0;
+
+	if (szPatternPtr == NULL)
+		return FALSE;
+
+	LPCTSTR szPtr = szPatternPtr;
+	for (;;) {
+		// 略過空白
+		while (*szPtr == TEXT(' ') || *szPtr == TEXT('\t'))
+			++szPtr;
+		if (*szPtr == 0)
+			break;
+
+		// 取得一個位元組 (1 或 2 個字元)
+		TCHAR chHex[2] = { szPtr[0], TEXT('?') };
+		if (szPtr[1] != 0 && szPtr[1] != TEXT(' ') && szPtr[1] != TEXT('\t')) {
+			chHex[1] = szPtr[1];
+			szPtr += 2;
+		}
+		else {
+			// 單一字元只接受 "?"
+			if (chHex[0] != TEXT('?')) return FALSE;
+			szPtr += 1;
+		}
+		if (*szPtr != 0 && *szPtr != TEXT(' ') && *szPtr != TEXT('\t'))
+			return FALSE;
+		if (uSize >= PATTERN_SCAN_MAXLEN)
+			return FALSE;
+
+		BYTE chValue = 0, chMask = 0;
+		for (int i = 0; i < 2; ++i) {
+			TCHAR ch = chHex[i];
+			BYTE nibble;
+
+			chValue <<= 4;
+			chMask <<= 4;
+			if (ch == TEXT('?')) continue;
+			if (ch >= TEXT('0') && ch <= TEXT('9')) nibble = static_cast<BYTE>(ch - TEXT('0'));
+			else if (ch >= TEXT('A') && ch <= TEXT('F')) nibble = static_cast<BYTE>(ch - TEXT('A') + 10);
+			else if (ch >= TEXT('a') && ch <= TEXT('f')) nibble = static_cast<BYTE>(ch - TEXT('a') + 10);
+			else return FALSE;
+			chValue |= nibble;
+			chMask |= 0x0F;
+		}
+		aValue[uSize] = chValue;
+		aMask[uSize] = chMask;
+		++uSize;
+	}
+	return this->SetPattern(aValue, aMask, uSize);
+}
+
+/**
+ * @brief	設定特徵碼 (數值與遮罩)
+ * @param	[in] aValuePtr	特徵碼數值陣列
+ * @param	[in] aMaskPtr	特徵碼遮罩陣列, 為 NULL 表示全部位元組完整比對
+ * @param	[in] uSize		特徵碼長度 (in Byte)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			長度為零或超過 PATTERN_SCAN_MAXLEN 返回零(zero)
+ */
+BOOL CxFramePatternScan::SetPattern(const BYTE* aValuePtr, const BYTE* aMaskPtr, size_t uSize)
+{
+	if (aValuePtr == NULL || uSize == 0 || uSize > PATTERN_SCAN_MAXLEN)
+		return FALSE;
+
+	m_aValue.resize(uSize);
+	m_aMask.resize(uSize);
+	for (size_t i = 0; i < uSize; ++i) {
+		m_aMask[i] = aMaskPtr != NULL ? aMaskPtr[i] : 0xFF;
+		m_aValue[i] = aValuePtr[i] & m_aMask[i];
+	}
+	this->SelectAnchor();
+	return TRUE;
+}
+
+/**
+ * @brief	取得特徵碼長度
+ * @return	@c 型別: size_t \n 特徵碼長度 (in Byte), 未設定返回零(zero)
+ */
+size_t CxFramePatternScan::GetPatternSize() { return m_aValue.size(); }
+
+/**
+ * @brief	指定外部區域對照表
+ * @param	[in] mapPtr	已載入目標程序的區域對照表, 為 NULL 表示每次 Scan 時自行載入
+ * @remark	多次搜尋同一程序時, 共用已載入的對照表可省略重複的 VirtualQueryEx 查詢. \n
+ *			對照表由調用者管理, 區域配置改變時需自行調用 CxFrameRegionMap::Refresh.
+ */
+void CxFramePatternScan::SetRegionMap(CxFrameRegionMap* mapPtr) { m_mapPtr = mapPtr; }
+
+/**
+ * @brief	搜尋目標程序記憶體
+ * @param	[in] procPtr	已開啟的目標程序物件
+ * @param	[in] fnScanPtr	找到符合特徵碼時的回呼函數 (可為 NULL, 只計算數量)
+ * @param	[in] aParamPtr	傳遞給回呼函數的參數
+ * @param	[in] poolPtr	工作執行緒池, 為 NULL 時於調用端執行緒依序搜尋
+ * @param	[in] uStart		搜尋起始位址
+ * @param	[in] uEnd		搜尋結束位址 (不包含)
+ * @return	@c 型別: size_t \n 找到的符合數量
+ * @remark	只搜尋已提交 (MEM_COMMIT) 且可讀取的記憶體區域, 位址相連的區域視為一體, 可找到跨越區域邊界的特徵碼.
+ */
+size_t CxFramePatternScan::Scan(CxFrameProcess* procPtr, LPFNSCANPROC fnScanPtr, LPVOID aParamPtr, CxFrameWorkPool* poolPtr,
+	ULONG_PTR uStart, ULONG_PTR uEnd)
+{
+	if (procPtr == NULL || procPtr->GetProcessHandle() == NULL || m_aValue.empty())
+		return 0;
+	CxFrameRegionMap* mapPtr = m_mapPtr;
+	if (mapPtr == NULL) {
+		mapPtr = &m_regionMap;
+		if (!mapPtr->Load(procPtr)) return 0;
+	}
+	if (!this->LoadChunks(mapPtr, uStart, uEnd))
+		return 0;
+
+	m_hProcess = procPtr->GetProcessHandle();
+	m_poolPtr = poolPtr != NULL && poolPtr->GetThreadCount() != 0 ? poolPtr : NULL;
+	m_fnScanPtr = fnScanPtr;
+	m_aParamPtr = aParamPtr;
+	m_nMatch = 0;
+	m_bStop = FALSE;
+
+	// 各工作執行緒專屬讀取緩衝區
+	size_t nBuffer = m_poolPtr != NULL ? m_poolPtr->GetThreadCount() : 1;
+	if (m_aBuffer.size() < nBuffer)
+		m_aBuffer.resize(nBuffer);
+
+	if (m_poolPtr != NULL) {
+		m_poolPtr->Run(StaticScanProc, this, m_aChunk.size());
+	}
+	else {
+		for (size_t i = 0; i < m_aChunk.size() && !m_bStop; ++i)
+			this->ScanChunk(i, 0);
+	}
+
+	m_hProcess = NULL;
+	m_poolPtr = NULL;
+	m_fnScanPtr = NULL;
+	m_aParamPtr = NULL;
+	return static_cast<size_t>(m_nMatch);
+}
+
+/**
+ * @brief	選擇錨點位元組
+ * @remark	於完整遮罩的位元組中, 優先選擇非常見值 (00, FF, CC, 90) 的位元組, 以減少錨點誤判次數.
+ */
+void CxFramePatternScan::SelectAnchor()
+{
+	m_bAnchor = FALSE;
+	m_idxAnchor = 0;
+
+	for (size_t i = 0; i < m_aValue.size(); ++i) {
+		if (m_aMask[i] != 0xFF)
+			continue;
+
+		BYTE ch = m_aValue[i];
+		BOOL bCommon = ch == 0x00 || ch == 0xFF || ch == 0xCC || ch == 0x90;
+		if (!m_bAnchor) {
+			m_bAnchor = TRUE;
+			m_idxAnchor = i;
+			if (!bCommon) break;
+		}
+		else if (!bCommon) {
+			m_idxAnchor = i;
+			break;
+		}
+	}
+}
+
+/**
+ * @brief	建立搜尋區塊列表
+ * @param	[in] mapPtr	目標程序區域對照表
+ * @param	[in] uStart	搜尋起始位址
+ * @param	[in] uEnd	搜尋結束位址 (不包含)
+ * @return	@c 型別: BOOL \n 有可搜尋的區塊返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFramePatternScan::LoadChunks(CxFrameRegionMap* mapPtr, ULONG_PTR uStart, ULONG_PTR uEnd)
+{
+	ULONG_PTR uRunBase = 0, uRunEnd = 0;
+
+	m_aChunk.clear();
+	m_aReadable.clear();
+	mapPtr->GetReadable(&m_aReadable, uStart, uEnd);
+
+	for (const SSMEMREGION& rg : m_aReadable) {
+		// 位址相連的可讀取區域合併處理
+		if (uRunEnd != 0 && rg.uBase == uRunEnd) {
+			uRunEnd = rg.uBase + rg.uSize;
+			continue;
+		}
+		if (uRunEnd != 0) this->AppendChunks(uRunBase, uRunEnd);
+		uRunBase = rg.uBase;
+		uRunEnd = rg.uBase + rg.uSize;
+	}
+	if (uRunEnd != 0)
+		this->AppendChunks(uRunBase, uRunEnd);
+	return !m_aChunk.empty();
+}
+
+/**
+ * @brief	將一段連續記憶體切割為搜尋區塊
+ * @param	[in] uBase	起始位址
+ * @param	[in] uEnd	結束位址 (不包含)
+ */
+void CxFramePatternScan::AppendChunks(ULONG_PTR uBase, ULONG_PTR uEnd)
+{
+	SIZE_T uOverlap = m_aValue.size() - 1;
+
+	if (uEnd - uBase < m_aValue.size())
+		return;
+
+	for (ULONG_PTR uAddress = uBase; uAddress < uEnd; uAddress += PATTERN_SCAN_CHUNK) {
+		SSCHUNK chunk;
+		SIZE_T uRemain = static_cast<SIZE_T>(uEnd - uAddress);
+
+		chunk.uBase = uAddress;
+		chunk.uStarts = uRemain < PATTERN_SCAN_CHUNK ? uRemain : PATTERN_SCAN_CHUNK;
+		chunk.uSize = uRemain < PATTERN_SCAN_CHUNK + uOverlap ? uRemain : PATTERN_SCAN_CHUNK + uOverlap;
+		if (chunk.uSize < m_aValue.size())
+			break;
+		m_aChunk.push_back(chunk);
+	}
+}
+
+/**
+ * @brief	搜尋一個區塊
+ * @param	[in] idxChunk	區塊索引
+ * @param	[in] idxWorker	工作執行緒索引
+ */
+void CxFramePatternScan::ScanChunk(size_t idxChunk, DWORD idxWorker)
+{
+	const SSCHUNK& chunk = m_aChunk[idxChunk];
+	std::vector<BYTE>& aBuffer = m_aBuffer[idxWorker];
+	SIZE_T cbReads = 0;
+
+	if (m_bStop)
+		return;
+	if (aBuffer.size() < PATTERN_SCAN_CHUNK + PATTERN_SCAN_MAXLEN)
+		aBuffer.resize(PATTERN_SCAN_CHUNK + PATTERN_SCAN_MAXLEN);
+
+	::ReadProcessMemory(m_hProcess, reinterpret_cast<LPCVOID>(chunk.uBase), aBuffer.data(), chunk.uSize, &cbReads);
+	if (cbReads < m_aValue.size())
+		return;
+
+	this->ScanBlock(aBuffer.data(), cbReads, chunk.uStarts, chunk.uBase);
+}
+
+/**
+ * @brief	搜尋緩衝區內容
+ * @param	[in] aBuffPtr	資料緩衝區
+ * @param	[in] uSize		資料長度 (in Byte)
+ * @param	[in] uStarts	可作為起始位置的長度 (in Byte)
+ * @param	[in] uBase		資料於目標程序中的起始位址
+ */
+void CxFramePatternScan::ScanBlock(const BYTE* aBuffPtr, SIZE_T uSize, SIZE_T uStarts, ULONG_PTR uBase)
+{
+	SIZE_T uLength = m_aValue.size();
+	SIZE_T uLast = uSize - uLength + 1;		// 最後可能的起始位置 + 1
+
+	if (uStarts < uLast)
+		uLast = uStarts;
+
+	if (!m_bAnchor) {
+		// 沒有完整位元組可作為錨點, 逐一比對
+		for (SIZE_T i = 0; i < uLast && !m_bStop; ++i) {
+			if (this->Compare(aBuffPtr + i))
+				this->Emit(uBase + i);
+		}
+		return;
+	}
+
+	const BYTE chAnchor = m_aValue[m_idxAnchor];
+	const BYTE* aCurPtr = aBuffPtr + m_idxAnchor;
+	const BYTE* aEndPtr = aBuffPtr + m_idxAnchor + uLast;
+
+	while (aCurPtr < aEndPtr && !m_bStop) {
+		const BYTE* aHitPtr = m_fnFindPtr(aCurPtr, aEndPtr, chAnchor);
+		if (aHitPtr == NULL)
+			break;
+
+		const BYTE* aDataPtr = aHitPtr - m_idxAnchor;
+		if (this->Compare(aDataPtr))
+			this->Emit(uBase + static_cast<ULONG_PTR>(aDataPtr - aBuffPtr));
+		aCurPtr = aHitPtr + 1;
+	}
+}
+
+/**
+ * @brief	比對特徵碼
+ * @param	[in] aDataPtr	資料位址 (長度至少為特徵碼長度)
+ * @return	@c 型別: BOOL \n 符合返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFramePatternScan::Compare(const BYTE* aDataPtr)
+{
+	const BYTE* aValuePtr = m_aValue.data();
+	const BYTE* aMaskPtr = m_aMask.data();
+
+	for (size_t i = 0, n = m_aValue.size(); i < n; ++i) {
+		if ((aDataPtr[i] & aMaskPtr[i]) != aValuePtr[i])
+			return FALSE;
+	}
+	return TRUE;
+}
+
+/**
+ * @brief	回報符合位址
+ * @param	[in] uAddress	符合的位址
+ * @return	@c 型別: BOOL \n 繼續搜尋返回非零值(non-zero), 停止搜尋返回零(zero)
+ */
+BOOL CxFramePatternScan::Emit(ULONG_PTR uAddress)
+{
+	::InterlockedIncrement64(&m_nMatch);
+	if (m_fnScanPtr == NULL)
+		return TRUE;
+
+	::EnterCriticalSection(&m_csEmit);
+	BOOL bContinue = m_bStop == FALSE && m_fnScanPtr(m_aParamPtr, uAddress);
+	if (!bContinue && !m_bStop) {
+		::InterlockedExchange(&m_bStop, TRUE);
+		if (m_poolPtr != NULL) m_poolPtr->Cancel();
+	}
+	::LeaveCriticalSection(&m_csEmit);
+	return bContinue;
+}
+
+/**
+ * @brief	工作執行緒回呼函數 (static)
+ * @param	[in] aParamPtr	CxFramePatternScan 物件指標
+ * @param	[in] idxItem	區塊索引
+ * @param	[in] idxWorker	工作執行緒索引
+ */
+void CALLBACK CxFramePatternScan::StaticScanProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker)
+{
+	reinterpret_cast<CxFramePatternScan*>(aParamPtr)->ScanChunk(idxItem, idxWorker);
+}
+
+/**
+ * @brief	依處理器支援指令集選擇錨點搜尋函數
+ * @return	@c 型別: LPFNFINDBYTE \n 錨點搜尋函數
+ * @remark	AVX2 需同時確認處理器支援及作業系統已啟用 YMM 暫存器保存 (XGETBV).
+ */
+CxFramePatternScan::LPFNFINDBYTE CxFramePatternScan::SelectFindByte()
+{
+#if defined(PATTERN_SCAN_SIMD)
+	int aInfo[4];
+
+	::__cpuid(aInfo, 0);
+	int nIds = aInfo[0];
+
+	::__cpuid(aInfo, 1);
+	BOOL bSSE2 = (aInfo[3] & (1 << 26)) != 0;
+	BOOL bOSXSave = (aInfo[2] & (1 << 27)) != 0;
+	BOOL bAVX = (aInfo[2] & (1 << 28)) != 0;
+
+	if (nIds >= 7 && bOSXSave && bAVX && (::_xgetbv(0) & 0x06) == 0x06) {
+		::__cpuidex(aInfo, 7, 0);
+		if (aInfo[1] & (1 << 5))
+			return FindByteAVX2;
+	}
+	if (bSSE2)
+		return FindByteSSE2;
+#endif
+	return FindByteScalar;
+}
+
+/**
+ * @brief	搜尋位元組 (一般版本)
+ * @param	[in] aBeginPtr	搜尋起始位址
+ * @param	[in] aEndPtr	搜尋結束位址 (不包含)
+ * @param	[in] chValue	目標值
+ * @return	@c 型別: const BYTE* \n 找到返回所在位址, 否則返回 NULL
+ */
+const BYTE* CxFramePatternScan::FindByteScalar(const BYTE* aBeginPtr, const BYTE* aEndPtr, BYTE chValue)
+{
+	if (aBeginPtr >= aEndPtr)
+		return NULL;
+	return reinterpret_cast<const BYTE*>(::memchr(aBeginPtr, chValue, static_cast<size_t>(aEndPtr - aBeginPtr)));
+}
+
+/**
+ * @brief	搜尋位元組 (SSE2 版本, 每次比對 16 bytes)
+ * @param	[in] aBeginPtr	搜尋起始位址
+ * @param	[in] aEndPtr	搜尋結束位址 (不包含)
+ * @param	[in] chValue	目標值
+ * @return	@c 型別: const BYTE* \n 找到返回所在位址, 否則返回 NULL
+ */
+const BYTE* CxFramePatternScan::FindByteSSE2(const BYTE* aBeginPtr, const BYTE* aEndPtr, BYTE chValue)
+{
+#if defined(PATTERN_SCAN_SIMD)
+	const __m128i xmmValue = _mm_set1_epi8(static_cast<char>(chValue));
+	const BYTE* aPtr = aBeginPtr;
+
+	while (aEndPtr - aPtr >= 16) {
+		__m128i xmmData = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aPtr));
+		unsigned long uMask = static_cast<unsigned long>(_mm_movemask_epi8(_mm_cmpeq_epi8(xmmData, xmmValue)));
+		if (uMask != 0) {
+			unsigned long idx;
+			_BitScanForward(&idx, uMask);
+			return aPtr + idx;
+		}
+		aPtr += 16;
+	}
+	return FindByteScalar(aPtr, aEndPtr, chValue);
+#else
+	return FindByteScalar(aBeginPtr, aEndPtr, chValue);
+#endif
+}
+
+/**
+ * @brief	搜尋位元組 (AVX2 版本, 每次比對 64 bytes)
+ * @param	[in] aBeginPtr	搜尋起始位址
+ * @param	[in] aEndPtr	搜尋結束位址 (不包含)
+ * @param	[in] chValue	目標值
+ * @return	@c 型別: const BYTE* \n 找到返回所在位址, 否則返回 NULL
+ */
+const BYTE* CxFramePatternScan::FindByteAVX2(const BYTE* aBeginPtr, const BYTE* aEndPtr, BYTE chValue)
+{
+#if defined(PATTERN_SCAN_SIMD)
+	const __m256i ymmValue = _mm256_set1_epi8(static_cast<char>(chValue));
+	const BYTE* aPtr = aBeginPtr;
+	unsigned long idx;
+
+	// 每次處理兩個 32 bytes, 沒有符合時只需一次判斷
+	while (aEndPtr - aPtr >= 64) {
+		__m256i ymmLow = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(aPtr)), ymmValue);
+		__m256i ymmHigh = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(aPtr + 32)), ymmValue);
+		if (!_mm256_testz_si256(_mm256_or_si256(ymmLow, ymmHigh), _mm256_or_si256(ymmLow, ymmHigh))) {
+			unsigned long uMask = static_cast<unsigned long>(static_cast<unsigned int>(_mm256_movemask_epi8(ymmLow)));
+			if (uMask != 0) {
+				_BitScanForward(&idx, uMask);
+				return aPtr + idx;
+			}
+			uMask = static_cast<unsigned long>(static_cast<unsigned int>(_mm256_movemask_epi8(ymmHigh)));
+			_BitScanForward(&idx, uMask);
+			return aPtr + 32 + idx;
+		}
+		aPtr += 64;
+	}
+	while (aEndPtr - aPtr >= 32) {
+		__m256i ymmData = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aPtr));
+		unsigned long uMask = static_cast<unsigned long>(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(ymmData, ymmValue))));
+		if (uMask != 0) {
+			_BitScanForward(&idx, uMask);
+			return aPtr + idx;
+		}
+		aPtr += 32;
+	}
+	return FindByteSSE2(aPtr, aEndPtr, chValue);
+#else
+	return FindByteScalar(aBeginPtr, aEndPtr, chValue);
+#endif
+}
@@ -0,0 +1,608 @@
+﻿/**************************************************************************//**
+ * @file	wframe_snapshot.cc
+ * @brief	程序記憶體快照檔案類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_snapshot.hh"
+
+//! CxFrameSnapshotWriter 建構式
+CxFrameSnapshotWriter::CxFrameSnapshotWriter()
+	: m_hFile(INVALID_HANDLE_VALUE)
+	, m_cbPayload(0)
+{
+	for (int i = 0; i < 2; ++i) {
+		::memset(&m_aSlot[i], 0, sizeof(SSSLOT));
+		m_aSlot[i].thisPtr = this;
+	}
+}
+
+//! CxFrameSnapshotWriter 解構式
+CxFrameSnapshotWriter::~CxFrameSnapshotWriter() { this->FreeBuffers(); }
+
+/**
+ * @brief	擷取目標程序記憶體至快照檔案
+ * @param	[in] procPtr	已開啟的目標程序物件
+ * @param	[in] szFilePtr	快照檔案名稱, 已存在時覆寫
+ * @param	[in] bHash		是否建立頁雜湊表 (供 CxFrameSnapshot::Diff 使用)
+ * @param	[in] mapPtr		已載入目標程序的區域對照表, 為 NULL 時自行載入
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			函數操作失敗返回零(zero), 不會留下不完整的快照檔案
+ * @remark	擷取期間無法讀取的頁面以零填入. \n
+ *			檔案標頭最後寫入, 中斷的擷取不會被視為有效快照.
+ */
+BOOL CxFrameSnapshotWriter::Capture(CxFrameProcess* procPtr, LPCTSTR szFilePtr, BOOL bHash, CxFrameRegionMap* mapPtr)
+{
+	auto err = BOOL(FALSE);
+	CxFrameRegionMap regionMap;
+	std::vector<SSSNAPREGION> aRegion;
+	std::vector<UINT64> aHash;
+	SSSNAPHEADER head;
+	ULONGLONG nPages = 0;
+	FILETIME ft;
+
+	if (procPtr == NULL || szFilePtr == NULL)
+		return FALSE;
+
+	if (mapPtr == NULL) {
+		mapPtr = &regionMap;
+		if (!mapPtr->Load(procPtr)) return FALSE;
+	}
+
+	// 建立區域索引並計算檔案配置
+	m_cbPayload = 0;
+	for (size_t i = 0; i < mapPtr->GetCount(); ++i) {
+		const SSMEMREGION* rgPtr = mapPtr->GetRegion(i);
+		if (!CxFrameRegionMap::IsReadableRegion(rgPtr))
+			continue;
+
+		SSSNAPREGION region;
+		region.uBase = rgPtr->uBase;
+		region.uSize = rgPtr->uSize;
+		region.uOffset = m_cbPayload;
+		region.idxHash = nPages;
+		region.dwProtect = rgPtr->dwProtect;
+		region.dwType = rgPtr->dwType;
+		aRegion.push_back(region);
+
+		m_cbPayload += region.uSize;
+		nPages += region.uSize / SNAPSHOT_PAGE_SIZE;
+	}
+
+	::memset(&head, 0, sizeof(head));
+	::GetSystemTimeAsFileTime(&ft);
+	head.dwMagic = SNAPSHOT_MAGIC;
+	head.dwVersion = SNAPSHOT_VERSION;
+	head.dwPageSize = SNAPSHOT_PAGE_SIZE;
+	head.dwFlags = bHash ? SNAPSHOT_FLAG_HASH : 0;
+	head.idProcess = procPtr->GetProcessID();
+	head.nRegions = static_cast<DWORD>(aRegion.size());
+	head.uIndexOffset = sizeof(SSSNAPHEADER);
+	head.uHashOffset = bHash ? head.uIndexOffset + aRegion.size() * sizeof(SSSNAPREGION) : 0;
+	head.uPayloadOffset = head.uIndexOffset + aRegion.size() * sizeof(SSSNAPREGION) + (bHash ? nPages * sizeof(UINT64) : 0);
+	head.uPayloadOffset = (head.uPayloadOffset + SNAPSHOT_PAGE_SIZE - 1) & ~static_cast<ULONGLONG>(SNAPSHOT_PAGE_SIZE - 1);
+	head.uFileSize = head.uPayloadOffset + m_cbPayload;
+	head.ftCapture = (static_cast<ULONGLONG>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+	if (bHash) aHash.resize(static_cast<size_t>(nPages));
+
+	for (;;) {
+		m_hFile = ::CreateFile(szFilePtr, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (m_hFile == INVALID_HANDLE_VALUE) break;
+
+		// 預先設定檔案大小 (預留磁碟空間, 資料區寫入仍會延伸有效資料長度)
+		LARGE_INTEGER li;
+		li.QuadPart = static_cast<LONGLONG>(head.uFileSize);
+		if (!::SetFilePointerEx(m_hFile, li, NULL, FILE_BEGIN) || !::SetEndOfFile(m_hFile)) break;
+		if (!this->CreateBuffers()) break;
+
+		// 資料區: 兩個緩衝區交替讀取與寫入
+		BOOL bFail = FALSE;
+		int idx = 0;
+		for (size_t r = 0; r < aRegion.size() && !bFail; ++r) {
+			const SSSNAPREGION& region = aRegion[r];
+			for (ULONGLONG uOffset = 0; uOffset < region.uSize; uOffset += SNAPSHOT_IO_BUFFER) {
+				DWORD cbChunk = static_cast<DWORD>(region.uSize - uOffset < SNAPSHOT_IO_BUFFER ? region.uSize - uOffset : SNAPSHOT_IO_BUFFER);
+
+				if (!this->WaitBuffer(idx)) { bFail = TRUE; break; }
+				this->FillBuffer(procPtr, region.uBase + uOffset, m_aSlot[idx].aBuffPtr, cbChunk);
+
+				if (bHash) {
+					size_t idxHash = static_cast<size_t>(region.idxHash + uOffset / SNAPSHOT_PAGE_SIZE);
+					for (DWORD cb = 0; cb < cbChunk; cb += SNAPSHOT_PAGE_SIZE)
+						aHash[idxHash++] = CxFrameSnapshot::HashPage(m_aSlot[idx].aBuffPtr + cb);
+				}
+
+				if (!this->WriteBuffer(idx, head.uPayloadOffset + region.uOffset + uOffset, cbChunk)) { bFail = TRUE; break; }
+				idx ^= 1;
+			}
+		}
+		if (bFail || !this->WaitBuffer(0) || !this->WaitBuffer(1)) break;
+
+		// 區域索引與頁雜湊表, 最後寫入檔案標頭
+		if (!aRegion.empty() && !this->WriteSync(head.uIndexOffset, aRegion.data(), static_cast<DWORD>(aRegion.size() * sizeof(SSSNAPREGION)))) break;
+		for (size_t i = 0; i < aHash.size() && !bFail; i += SNAPSHOT_IO_BUFFER / sizeof(UINT64)) {
+			size_t nCount = aHash.size() - i < SNAPSHOT_IO_BUFFER / sizeof(UINT64) ? aHash.size() - i : SNAPSHOT_IO_BUFFER / sizeof(UINT64);
+			bFail = !this->WriteSync(head.uHashOffset + i * sizeof(UINT64), &aHash[i], static_cast<DWORD>(nCount * sizeof(UINT64)));
+		}
+		if (bFail || !this->WriteSync(0, &head, sizeof(head))) break;
+
+		err = TRUE;
+		break;
+	}
+
+	this->FreeBuffers();
+	if (m_hFile != INVALID_HANDLE_VALUE) {
+		::CloseHandle(m_hFile);
+		m_hFile = INVALID_HANDLE_VALUE;
+		if (!err) ::DeleteFile(szFilePtr);
+	}
+	return err;
+}
+
+/**
+ * @brief	取得最近一次擷取的資料區大小
+ * @return	@c 型別: ULONGLONG \n 資料區大小 (in Byte)
+ */
+ULONGLONG CxFrameSnapshotWriter::GetPayloadSize() { return m_cbPayload; }
+
+/**
+ * @brief	配置寫入緩衝區, 完成事件與寫入工作
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ * @remark	緩衝區以 VirtualAlloc 配置, 起始位址對齊頁面.
+ */
+BOOL CxFrameSnapshotWriter::CreateBuffers()
+{
+	for (int i = 0; i < 2; ++i) {
+		SSSLOT* slotPtr = &m_aSlot[i];
+		if (slotPtr->aBuffPtr == NULL)
+			slotPtr->aBuffPtr = reinterpret_cast<BYTE*>(::VirtualAlloc(NULL, SNAPSHOT_IO_BUFFER, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+		if (slotPtr->overlap.hEvent == NULL)
+			slotPtr->overlap.hEvent = ::CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (slotPtr->tpWork == NULL)
+			slotPtr->tpWork = ::CreateThreadpoolWork(StaticWriteProc, slotPtr, NULL);
+		if (slotPtr->aBuffPtr == NULL || slotPtr->overlap.hEvent == NULL || slotPtr->tpWork == NULL)
+			return FALSE;
+		slotPtr->bPending = FALSE;
+	}
+	return TRUE;
+}
+
+//! 等待寫入完成並釋放寫入緩衝區
+void CxFrameSnapshotWriter::FreeBuffers()
+{
+	for (int i = 0; i < 2; ++i) {
+		SSSLOT* slotPtr = &m_aSlot[i];
+		this->WaitBuffer(i);
+		if (slotPtr->tpWork != NULL) {
+			::CloseThreadpoolWork(slotPtr->tpWork);
+			slotPtr->tpWork = NULL;
+		}
+		if (slotPtr->aBuffPtr != NULL) {
+			::VirtualFree(slotPtr->aBuffPtr, 0, MEM_RELEASE);
+			slotPtr->aBuffPtr = NULL;
+		}
+		if (slotPtr->overlap.hEvent != NULL) {
+			::CloseHandle(slotPtr->overlap.hEvent);
+			slotPtr->overlap.hEvent = NULL;
+		}
+	}
+}
+
+/**
+ * @brief	等待緩衝區的寫入工作完成
+ * @param	[in] idx	緩衝區索引
+ * @return	@c 型別: BOOL \n 沒有寫入中或寫入成功返回非零值(non-zero), 寫入失敗返回零(zero)
+ */
+BOOL CxFrameSnapshotWriter::WaitBuffer(int idx)
+{
+	SSSLOT* slotPtr = &m_aSlot[idx];
+
+	if (!slotPtr->bPending)
+		return TRUE;
+
+	::WaitForThreadpoolWorkCallbacks(slotPtr->tpWork, FALSE);
+	slotPtr->bPending = FALSE;
+	return slotPtr->bResult;
+}
+
+/**
+ * @brief	交由執行緒池寫入緩衝區
+ * @param	[in] idx		緩衝區索引
+ * @param	[in] uOffset	檔案位置
+ * @param	[in] cbSize		寫入長度 (in Byte)
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ * @remark	立即返回, 以 WaitBuffer 等待寫入完成並取得結果.
+ */
+BOOL CxFrameSnapshotWriter::WriteBuffer(int idx, ULONGLONG uOffset, DWORD cbSize)
+{
+	SSSLOT* slotPtr = &m_aSlot[idx];
+
+	slotPtr->overlap.Offset = static_cast<DWORD>(uOffset);
+	slotPtr->overlap.OffsetHigh = static_cast<DWORD>(uOffset >> 32);
+	slotPtr->cbSize = cbSize;
+	slotPtr->bResult = FALSE;
+	slotPtr->bPending = TRUE;
+	::SubmitThreadpoolWork(slotPtr->tpWork);
+	return TRUE;
+}
+
+/**
+ * @brief	寫入並等待完成
+ * @param	[in] uOffset	檔案位置
+ * @param	[in] aBuffPtr	資料位址
+ * @param	[in] cbSize		寫入長度 (in Byte)
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ * @remark	使用緩衝區 0 的完成事件, 調用前緩衝區 0 不可寫入中.
+ */
+BOOL CxFrameSnapshotWriter::WriteSync(ULONGLONG uOffset, LPCVOID aBuffPtr, DWORD cbSize)
+{
+	return this->WriteAt(&m_aSlot[0].overlap, uOffset, aBuffPtr, cbSize);
+}
+
+/**
+ * @brief	寫入指定檔案位置並等待完成
+ * @param	[in] ovPtr		寫入狀態 (須有完成事件)
+ * @param	[in] uOffset	檔案位置
+ * @param	[in] aBuffPtr	資料位址
+ * @param	[in] cbSize		寫入長度 (in Byte)
+ * @return	@c 型別: BOOL \n 全部寫入返回非零值(non-zero)
+ */
+BOOL CxFrameSnapshotWriter::WriteAt(OVERLAPPED* ovPtr, ULONGLONG uOffset, LPCVOID aBuffPtr, DWORD cbSize)
+{
+	DWORD cbWrite = 0;
+
+	ovPtr->Offset = static_cast<DWORD>(uOffset);
+	ovPtr->OffsetHigh = static_cast<DWORD>(uOffset >> 32);
+	if (!::WriteFile(m_hFile, aBuffPtr, cbSize, NULL, ovPtr) && ::GetLastError() != ERROR_IO_PENDING)
+		return FALSE;
+	return ::GetOverlappedResult(m_hFile, ovPtr, &cbWrite, TRUE) && cbWrite == cbSize;
+}
+
+/**
+ * @brief	讀取目標程序記憶體至緩衝區
+ * @param	[in]  procPtr	目標程序物件
+ * @param	[in]  uBase		目標程序位址
+ * @param	[out] aBuffPtr	緩衝區位址
+ * @param	[in]  uSize		讀取長度 (頁大小的倍數)
+ * @remark	整段讀取失敗時改為逐頁讀取, 無法讀取的頁面以零填入.
+ */
+void CxFrameSnapshotWriter::FillBuffer(CxFrameProcess* procPtr, ULONGLONG uBase, BYTE* aBuffPtr, SIZE_T uSize)
+{
+	SIZE_T cbReads = procPtr->ReadMemory(reinterpret_cast<LPCVOID>(static_cast<ULONG_PTR>(uBase)), aBuffPtr, uSize);
+
+	if (cbReads == uSize)
+		return;
+
+	for (SIZE_T uOffset = cbReads & ~static_cast<SIZE_T>(SNAPSHOT_PAGE_SIZE - 1); uOffset < uSize; uOffset += SNAPSHOT_PAGE_SIZE) {
+		cbReads = procPtr->ReadMemory(reinterpret_cast<LPCVOID>(static_cast<ULONG_PTR>(uBase + uOffset)), aBuffPtr + uOffset, SNAPSHOT_PAGE_SIZE);
+		if (cbReads < SNAPSHOT_PAGE_SIZE)
+			::memset(aBuffPtr + uOffset + cbReads, 0, SNAPSHOT_PAGE_SIZE - cbReads);
+	}
+}
+
+
+/**
+ * @brief	緩衝區寫入工作回呼函數 (static)
+ * @param	[in] tpInstance		回呼實體
+ * @param	[in] aContextPtr	SSSLOT 緩衝區指標
+ * @param	[in] tpWork			工作物件
+ */
+void CALLBACK CxFrameSnapshotWriter::StaticWriteProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_WORK tpWork)
+{
+	UNREFERENCED_PARAMETER(tpInstance);
+	UNREFERENCED_PARAMETER(tpWork);
+	SSSLOT* slotPtr = reinterpret_cast<SSSLOT*>(aContextPtr);
+	slotPtr->bResult = slotPtr->thisPtr->WriteAt(&slotPtr->overlap, (static_cast<ULONGLONG>(slotPtr->overlap.OffsetHigh) << 32) | slotPtr->overlap.Offset, slotPtr->aBuffPtr, slotPtr->cbSize);
+}
+
+
+//! CxFrameSnapshot 建構式
+CxFrameSnapshot::CxFrameSnapshot()
+	: m_hFile(INVALID_HANDLE_VALUE)
+	, m_hMapping(NULL)
+	, m_aViewPtr(NULL)
+	, m_headPtr(NULL)
+	, m_regionPtr(NULL)
+	, m_aHashPtr(NULL)
+{ }
+
+//! CxFrameSnapshot 解構式
+CxFrameSnapshot::~CxFrameSnapshot() { this->Close(); }
+
+/**
+ * @brief	開啟快照檔案
+ * @param	[in] szFilePtr	快照檔案名稱
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			檔案無法開啟或格式錯誤返回零(zero)
+ * @remark	檔案以唯讀方式對應至記憶體, 資料於存取時才由系統載入. \n
+ *			整個檔案一次對應, x86 組建的檔案超過 SNAPSHOT_MAP_LIMIT_X86 時返回零, GetLastError 為 ERROR_FILE_TOO_LARGE. \n
+ *			開啟時檢查標頭, 區域索引與頁雜湊表的範圍, 範圍超出檔案或互相重疊即視為格式錯誤.
+ */
+BOOL CxFrameSnapshot::Open(LPCTSTR szFilePtr)
+{
+	auto err = BOOL(FALSE);
+	LARGE_INTEGER liSize;
+
+	this->Close();
+	if (szFilePtr == NULL)
+		return FALSE;
+
+	for (;;) {
+		m_hFile = ::CreateFile(szFilePtr, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (m_hFile == INVALID_HANDLE_VALUE) break;
+		if (!::GetFileSizeEx(m_hFile, &liSize) || liSize.QuadPart < static_cast<LONGLONG>(sizeof(SSSNAPHEADER))) break;
+#ifndef __WIN64__
+		if (liSize.QuadPart > SNAPSHOT_MAP_LIMIT_X86) {
+			::SetLastError(ERROR_FILE_TOO_LARGE);
+			break;
+		}
+#endif
+
+		m_hMapping = ::CreateFileMapping(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (m_hMapping == NULL) break;
+		m_aViewPtr = reinterpret_cast<const BYTE*>(::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+		if (m_aViewPtr == NULL) break;
+
+		// 檢查標頭與各區段範圍, 加總皆先以差值比較避免溢位
+		ULONGLONG cbFile = static_cast<ULONGLONG>(liSize.QuadPart);
+		const SSSNAPHEADER* headPtr = reinterpret_cast<const SSSNAPHEADER*>(m_aViewPtr);
+		if (headPtr->dwMagic != SNAPSHOT_MAGIC || headPtr->dwVersion != SNAPSHOT_VERSION || headPtr->dwPageSize != SNAPSHOT_PAGE_SIZE) break;
+		if (headPtr->uFileSize > cbFile || headPtr->uPayloadOffset > headPtr->uFileSize) break;
+		if ((headPtr->uPayloadOffset % SNAPSHOT_PAGE_SIZE) != 0) break;
+
+		// 區域索引: 位於標頭之後, 資料區之前
+		if (headPtr->uIndexOffset < sizeof(SSSNAPHEADER) || headPtr->uIndexOffset > headPtr->uPayloadOffset) break;
+		if ((headPtr->uIndexOffset % sizeof(ULONGLONG)) != 0) break;
+		if (headPtr->nRegions > (headPtr->uPayloadOffset - headPtr->uIndexOffset) / sizeof(SSSNAPREGION)) break;
+		ULONGLONG uIndexEnd = headPtr->uIndexOffset + static_cast<ULONGLONG>(headPtr->nRegions) * sizeof(SSSNAPREGION);
+
+		// 頁雜湊表: 位於區域索引之後, 資料區之前
+		BOOL bHash = (headPtr->dwFlags & SNAPSHOT_FLAG_HASH) != 0;
+		ULONGLONG nHash = 0;
+		if (bHash) {
+			if (headPtr->uHashOffset < uIndexEnd || headPtr->uHashOffset > headPtr->uPayloadOffset) break;
+			if ((headPtr->uHashOffset % sizeof(UINT64)) != 0) break;
+			nHash = (headPtr->uPayloadOffset - headPtr->uHashOffset) / sizeof(UINT64);
+		}
+
+		// 各區域: 資料位於資料區內, 頁雜湊值位於雜湊表內, 位址由低至高且不重疊
+		const SSSNAPREGION* regionPtr = reinterpret_cast<const SSSNAPREGION*>(m_aViewPtr + headPtr->uIndexOffset);
+		ULONGLONG cbPayload = headPtr->uFileSize - headPtr->uPayloadOffset;
+		ULONGLONG uNextBase = 0;
+		DWORD i;
+		for (i = 0; i < headPtr->nRegions; ++i) {
+			const SSSNAPREGION& region = regionPtr[i];
+			if ((region.uOffset % SNAPSHOT_PAGE_SIZE) != 0 || (region.uSize % SNAPSHOT_PAGE_SIZE) != 0) break;
+			if (region.uOffset > cbPayload || region.uSize > cbPayload - region.uOffset) break;
+			if (region.uBase < uNextBase || region.uSize > ~static_cast<ULONGLONG>(0) - region.uBase) break;
+			if (bHash && (region.idxHash > nHash || region.uSize / SNAPSHOT_PAGE_SIZE > nHash - region.idxHash)) break;
+			uNextBase = region.uBase + region.uSize;
+		}
+		if (i != headPtr->nRegions) break;
+
+		m_headPtr = headPtr;
+		m_regionPtr = regionPtr;
+		m_aHashPtr = bHash ? reinterpret_cast<const UINT64*>(m_aViewPtr + headPtr->uHashOffset) : NULL;
+		err = TRUE;
+		break;
+	}
+
+	if (!err) this->Close();
+	return err;
+}
+
+//! 關閉快照檔案
+void CxFrameSnapshot::Close()
+{
+	if (m_aViewPtr != NULL) {
+		::UnmapViewOfFile(m_aViewPtr);
+		m_aViewPtr = NULL;
+	}
+	if (m_hMapping != NULL) {
+		::CloseHandle(m_hMapping);
+		m_hMapping = NULL;
+	}
+	if (m_hFile != INVALID_HANDLE_VALUE) {
+		::CloseHandle(m_hFile);
+		m_hFile = INVALID_HANDLE_VALUE;
+	}
+	m_headPtr = NULL;
+	m_regionPtr = NULL;
+	m_aHashPtr = NULL;
+}
+
+/**
+ * @brief	是否已開啟快照檔案
+ * @return	@c 型別: BOOL \n 已開啟返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameSnapshot::IsOpen() { return m_headPtr != NULL; }
+
+/**
+ * @brief	取得快照檔案標頭
+ * @return	@c 型別: const SSSNAPHEADER* \n 檔案標頭, 尚未開啟返回 NULL
+ */
+const SSSNAPHEADER* CxFrameSnapshot::GetHeader() { return m_headPtr; }
+
+/**
+ * @brief	取得區域數量
+ * @return	@c 型別: size_t \n 區域數量
+ */
+size_t CxFrameSnapshot::GetRegionCount() { return m_headPtr != NULL ? m_headPtr->nRegions : 0; }
+
+/**
+ * @brief	取得區域索引項目
+ * @param	[in] idx	區域索引
+ * @return	@c 型別: const SSSNAPREGION* \n 區域索引項目, 索引錯誤返回 NULL
+ */
+const SSSNAPREGION* CxFrameSnapshot::GetRegion(size_t idx)
+{
+	return idx < this->GetRegionCount() ? &m_regionPtr[idx] : NULL;
+}
+
+/**
+ * @brief	取得區域資料
+ * @param	[in] idx	區域索引
+ * @return	@c 型別: const BYTE* \n 區域資料起始位址 (對齊頁面), 索引錯誤返回 NULL
+ */
+const BYTE* CxFrameSnapshot::GetRegionData(size_t idx)
+{
+	if (idx >= this->GetRegionCount())
+		return NULL;
+	return m_aViewPtr + m_headPtr->uPayloadOffset + m_regionPtr[idx].uOffset;
+}
+
+/**
+ * @brief	取得區域的頁雜湊值
+ * @param	[in] idx	區域索引
+ * @return	@c 型別: const UINT64* \n 區域第一頁的雜湊值位址, 索引錯誤或無雜湊表返回 NULL
+ */
+const UINT64* CxFrameSnapshot::GetPageHash(size_t idx)
+{
+	if (m_aHashPtr == NULL || idx >= this->GetRegionCount())
+		return NULL;
+	return m_aHashPtr + m_regionPtr[idx].idxHash;
+}
+
+/**
+ * @brief	搜尋包含指定位址的區域
+ * @param	[in] uAddress	來源程序中的位址
+ * @return	@c 型別: int \n 區域索引, 快照中沒有此位址返回 -1
+ */
+int CxFrameSnapshot::Find(ULONGLONG uAddress)
+{
+	size_t idxLow = 0;
+	size_t idxHigh = this->GetRegionCount();
+
+	// 區域依起始位址由低至高排列
+	while (idxLow < idxHigh) {
+		size_t idxMid = (idxLow + idxHigh) / 2;
+		if (m_regionPtr[idxMid].uBase <= uAddress)
+			idxLow = idxMid + 1;
+		else
+			idxHigh = idxMid;
+	}
+	if (idxLow == 0)
+		return -1;
+
+	const SSSNAPREGION& region = m_regionPtr[idxLow - 1];
+	return uAddress < region.uBase + region.uSize ? static_cast<int>(idxLow - 1) : -1;
+}
+
+/**
+ * @brief	自快照讀取來源程序記憶體
+ * @param	[in]  uAddress	來源程序中的位址
+ * @param	[out] aBuffPtr	緩衝區位址
+ * @param	[in]  uSize		讀取長度 (in Byte)
+ * @return	@c 型別: SIZE_T \n 實際讀取長度, 遇到快照中沒有的位址即停止
+ */
+SIZE_T CxFrameSnapshot::ReadMemory(ULONGLONG uAddress, LPVOID aBuffPtr, SIZE_T uSize)
+{
+	BYTE* aDstPtr = reinterpret_cast<BYTE*>(aBuffPtr);
+	SIZE_T cbReads = 0;
+
+	while (cbReads < uSize) {
+		int idx = this->Find(uAddress);
+		if (idx < 0) break;
+
+		const SSSNAPREGION& region = m_regionPtr[idx];
+		ULONGLONG cbAvail = region.uBase + region.uSize - uAddress;
+		SIZE_T cbCopy = uSize - cbReads < cbAvail ? uSize - cbReads : static_cast<SIZE_T>(cbAvail);
+
+		::memcpy(aDstPtr + cbReads, this->GetRegionData(idx) + (uAddress - region.uBase), cbCopy);
+		cbReads += cbCopy;
+		uAddress += cbCopy;
+	}
+	return cbReads;
+}
+
+/**
+ * @brief	比較兩份快照, 找出內容不同的頁面 (static)
+ * @param	[in]  oldPtr	較早的快照
+ * @param	[in]  newPtr	較新的快照
+ * @param	[out] aPagePtr	內容不同的頁面位址存放位址 (可為 NULL), 位址會附加於尾端
+ * @return	@c 型別: size_t \n 內容不同的頁面數量
+ * @remark	只比較新快照中存在的頁面, 舊快照中沒有的頁面視為不同. \n
+ *			兩份快照皆有頁雜湊表時只比較雜湊值, 不存取頁面資料.
+ */
+size_t CxFrameSnapshot::Diff(CxFrameSnapshot* oldPtr, CxFrameSnapshot* newPtr, std::vector<ULONGLONG>* aPagePtr)
+{
+	size_t nChanged = 0;
+
+	if (oldPtr == NULL || newPtr == NULL || !oldPtr->IsOpen() || !newPtr->IsOpen())
+		return 0;
+
+	for (size_t r = 0; r < newPtr->GetRegionCount(); ++r) {
+		const SSSNAPREGION* newRgPtr = newPtr->GetRegion(r);
+		const UINT64* aNewHashPtr = newPtr->GetPageHash(r);
+		const BYTE* aNewDataPtr = newPtr->GetRegionData(r);
+		ULONGLONG nPages = newRgPtr->uSize / SNAPSHOT_PAGE_SIZE;
+
+		for (ULONGLONG p = 0; p < nPages; ) {
+			ULONGLONG uPage = newRgPtr->uBase + p * SNAPSHOT_PAGE_SIZE;
+			int idxOld = oldPtr->Find(uPage);
+
+			// 舊快照中沒有此頁面
+			if (idxOld < 0) {
+				if (aPagePtr != NULL) aPagePtr->push_back(uPage);
+				++nChanged;
+				++p;
+				continue;
+			}
+
+			// 與舊快照區域重疊的頁面
+			const SSSNAPREGION* oldRgPtr = oldPtr->GetRegion(idxOld);
+			const UINT64* aOldHashPtr = oldPtr->GetPageHash(idxOld);
+			const BYTE* aOldDataPtr = oldPtr->GetRegionData(idxOld);
+			ULONGLONG idxOldPage = (uPage - oldRgPtr->uBase) / SNAPSHOT_PAGE_SIZE;
+			ULONGLONG nOverlap = oldRgPtr->uSize / SNAPSHOT_PAGE_SIZE - idxOldPage;
+			if (nOverlap > nPages - p) nOverlap = nPages - p;
+
+			for (ULONGLONG k = 0; k < nOverlap; ++k, ++p, ++idxOldPage, uPage += SNAPSHOT_PAGE_SIZE) {
+				BOOL bSame;
+				if (aNewHashPtr != NULL && aOldHashPtr != NULL)
+					bSame = aNewHashPtr[p] == aOldHashPtr[idxOldPage];
+				else
+					bSame = ::memcmp(aNewDataPtr + p * SNAPSHOT_PAGE_SIZE, aOldDataPtr + idxOldPage * SNAPSHOT_PAGE_SIZE, SNAPSHOT_PAGE_SIZE) == 0;
+
+				if (!bSame) {
+					if (aPagePtr != NULL) aPagePtr->push_back(uPage);
+					++nChanged;
+				}
+			}
+		}
+	}
+	return nChanged;
+}
+
+/**
+ * @brief	計算頁面雜湊值 (static)
+ * @param	[in] aPagePtr	頁面資料 (SNAPSHOT_PAGE_SIZE bytes, 8 bytes 對齊)
+ * @return	@c 型別: UINT64 \n 64 位元雜湊值
+ * @remark	四組獨立累加以減少相依運算, 非加密用途.
+ */
+UINT64 CxFrameSnapshot::HashPage(const BYTE* aPagePtr)
+{
+	const UINT64 uPrime = 0x9E3779B97F4A7C15ULL;
+	const UINT64* aWordPtr = reinterpret_cast<const UINT64*>(aPagePtr);
+	UINT64 h0 = 0x243F6A8885A308D3ULL;
+	UINT64 h1 = 0x13198A2E03707344ULL;
+	UINT64 h2 = 0xA4093822299F31D0ULL;
+	UINT64 h3 = 0x082EFA98EC4E6C89ULL;
+
+	for (size_t i = 0; i < SNAPSHOT_PAGE_SIZE / sizeof(UINT64); i += 4) {
+		h0 = (h0 ^ aWordPtr[i + 0]) * uPrime;
+		h1 = (h1 ^ aWordPtr[i + 1]) * uPrime;
+		h2 = (h2 ^ aWordPtr[i + 2]) * uPrime;
+		h3 = (h3 ^ aWordPtr[i + 3]) * uPrime;
+	}
+
+	UINT64 h = h0 ^ (h1 << 16 | h1 >> 48) ^ (h2 << 32 | h2 >> 32) ^ (h3 << 48 | h3 >> 16);
+	h ^= h >> 29;
+	h *= uPrime;
+	h ^= h >> 32;
+	return h;
+}
@@ -0,0 +1,417 @@
+﻿/**************************************************************************//**
+ * @file	wframe_taskpool.cc
+ * @brief	工作竊取執行緒池類別 - 成員函數
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_taskpool.hh"
+
+//! 目前執行緒所屬的工作執行緒 (非工作執行緒為 NULL)
+static thread_local LPVOID s_workerPtr = NULL;
+
+//! CxFrameTaskPool 建構式
+CxFrameTaskPool::CxFrameTaskPool()
+	: m_hSemaphore(NULL)
+	, m_hIdle(NULL)
+	, m_nSleeping(0)
+	, m_bQuit(FALSE)
+	, m_idxNext(0)
+	, m_nQueued(0)
+	, m_nPending(0)
+	, m_nSubmitted(0)
+	, m_nLocal(0)
+{
+}
+
+//! CxFrameTaskPool 解構式
+CxFrameTaskPool::~CxFrameTaskPool() { this->Close(); }
+
+/**
+ * @brief	建立執行緒池
+ * @param	[in] nThreads	工作執行緒數量, 零(zero) 表示使用處理器數量 (GetProcessorCount)
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			函數操作失敗返回零(zero)
+ */
+BOOL CxFrameTaskPool::Create(DWORD nThreads)
+{
+	auto err = BOOL(FALSE);
+	DWORD i;
+
+	if (!m_aWorker.empty())
+		return TRUE;
+	if (nThreads == 0)
+		nThreads = CxFrameTaskPool::GetProcessorCount();
+
+	m_bQuit = FALSE;
+	for (;;) {
+		m_hSemaphore = ::CreateSemaphore(NULL, 0, MAXLONG, NULL);
+		if (m_hSemaphore == NULL) break;
+		m_hIdle = ::CreateEvent(NULL, TRUE, TRUE, NULL);
+		if (m_hIdle == NULL) break;
+
+		// 先配置全部工作執行緒資料再建立執行緒, 竊取時會存取其他工作執行緒的佇列
+		for (i = 0; i < nThreads; ++i) {
+			SSWORKER* workerPtr = new (std::nothrow) SSWORKER;
+			if (workerPtr == NULL) break;
+
+			workerPtr->poolPtr = this;
+			workerPtr->hThread = NULL;
+			workerPtr->idxWorker = i;
+			::InitializeSRWLock(&workerPtr->srwLock);
+			workerPtr->nCount = 0;
+			workerPtr->nExecuted = 0;
+			workerPtr->nStolen = 0;
+			workerPtr->nSleeps = 0;
+			m_aWorker.push_back(workerPtr);
+		}
+		if (i != nThreads) break;
+
+		for (i = 0; i < nThreads; ++i) {
+			m_aWorker[i]->hThread = ::CreateThread(NULL, 0, StaticWorkerProc, m_aWorker[i], 0, NULL);
+			if (m_aWorker[i]->hThread == NULL) break;
+		}
+		if (i != nThreads) break;
+
+		err = TRUE;
+		break;
+	}
+
+	if (!err) this->Close();
+	return err;
+}
+
+/**
+ * @brief	關閉執行緒池
+ * @remark	先以 Wait 等待已投遞的工作 (包含執行中產生的子工作) 全部完成, 之後才設定結束旗標並結束工作執行緒; \n
+ *			結束旗標設定後投遞的工作會被拒絕. \n
+ *			不可由工作執行緒調用.
+ */
+void CxFrameTaskPool::Close()
+{
+	// 子工作只能在工作執行中投遞, 未完成數量歸零後不會再產生
+	this->Wait(INFINITE);
+
+	::InterlockedExchange(&m_bQuit, TRUE);
+	if (m_hSemaphore != NULL && !m_aWorker.empty())
+		::ReleaseSemaphore(m_hSemaphore, static_cast<LONG>(m_aWorker.size()), NULL);
+
+	for (size_t i = 0; i < m_aWorker.size(); ++i) {
+		if (m_aWorker[i]->hThread != NULL) {
+			::WaitForSingleObject(m_aWorker[i]->hThread, INFINITE);
+			::CloseHandle(m_aWorker[i]->hThread);
+		}
+	}
+
+	// 工作執行緒建立失敗時可能留有未執行的工作
+	for (size_t i = 0; i < m_aWorker.size(); ++i) {
+		std::deque<SSTASK>& aTask = m_aWorker[i]->aTask;
+		for (size_t k = 0; k < aTask.size(); ++k) {
+			if (aTask[k].fnFreePtr != NULL)
+				aTask[k].fnFreePtr(aTask[k].aParamPtr);
+		}
+		delete m_aWorker[i];
+	}
+	m_aWorker.clear();
+
+	if (m_hIdle != NULL) {
+		::CloseHandle(m_hIdle);
+		m_hIdle = NULL;
+	}
+	if (m_hSemaphore != NULL) {
+		::CloseHandle(m_hSemaphore);
+		m_hSemaphore = NULL;
+	}
+	m_nSleeping = 0;
+	m_nQueued = 0;
+	m_nPending = 0;
+}
+
+/**
+ * @brief	執行緒池是否已建立
+ * @return	@c 型別: BOOL \n 已建立返回非零值(non-zero)
+ */
+BOOL CxFrameTaskPool::IsCreated() const { return !m_aWorker.empty(); }
+
+/**
+ * @brief	投遞工作
+ * @param	[in] fnTaskPtr	工作處理函數
+ * @param	[in] aParamPtr	工作處理函數參數
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			參數錯誤、執行緒池未建立或正在關閉返回零(zero)
+ * @remark	由工作執行緒調用時放入自己的佇列, 否則輪流放入各工作執行緒的佇列.
+ */
+BOOL CxFrameTaskPool::Submit(LPFNTASK fnTaskPtr, LPVOID aParamPtr)
+{
+	return this->PushTask(fnTaskPtr, NULL, aParamPtr);
+}
+
+/**
+ * @brief	等待全部工作完成
+ * @param	[in] dwTimeout	最長等待時間 (in ms), INFINITE 表示無限等待
+ * @return	@c 型別: BOOL \n
+ *			全部工作已完成返回非零值(non-zero) \n
+ *			逾時或由工作執行緒調用返回零(zero)
+ * @remark	等待期間其他執行緒仍可投遞工作, 此時一併等待.
+ */
+BOOL CxFrameTaskPool::Wait(DWORD dwTimeout)
+{
+	ULONGLONG ullDue = ::GetTickCount64() + dwTimeout;
+
+	if (this->GetWorkerIndex() >= 0 || m_hIdle == NULL)
+		return FALSE;
+
+	for (;;) {
+		if (m_nPending == 0)
+			return TRUE;
+
+		// 先重設再檢查, 最後一個工作於檢查後完成時事件仍會被設定
+		::ResetEvent(m_hIdle);
+		if (m_nPending == 0)
+			return TRUE;
+
+		DWORD dwWait = TASKPOOL_WAIT_SLICE;
+		if (dwTimeout != INFINITE) {
+			ULONGLONG ullNow = ::GetTickCount64();
+			if (ullNow >= ullDue)
+				return FALSE;
+			if (ullDue - ullNow < dwWait)
+				dwWait = static_cast<DWORD>(ullDue - ullNow);
+		}
+		::WaitForSingleObject(m_hIdle, dwWait);
+	}
+}
+
+/**
+ * @brief	取得工作執行緒數量
+ * @return	@c 型別: DWORD, 工作執行緒數量
+ */
+DWORD CxFrameTaskPool::GetThreadCount() const { return static_cast<DWORD>(m_aWorker.size()); }
+
+/**
+ * @brief	取得目前執行緒的工作執行緒索引
+ * @return	@c 型別: int \n 工作執行緒索引 (0 ~ GetThreadCount()-1), 不是此執行緒池的工作執行緒返回 -1
+ */
+int CxFrameTaskPool::GetWorkerIndex() const
+{
+	SSWORKER* workerPtr = static_cast<SSWORKER*>(s_workerPtr);
+
+	if (workerPtr == NULL || workerPtr->poolPtr != this)
+		return -1;
+	return static_cast<int>(workerPtr->idxWorker);
+}
+
+/**
+ * @brief	取得統計資訊
+ * @param	[out] statPtr	SSTASKPOOLSTAT 結構指標
+ * @remark	執行中取得時數值為近似值.
+ */
+void CxFrameTaskPool::GetStats(LPSSTASKPOOLSTAT statPtr)
+{
+	if (statPtr == NULL)
+		return;
+
+	::memset(statPtr, 0, sizeof(SSTASKPOOLSTAT));
+	statPtr->nThreads = this->GetThreadCount();
+	statPtr->nSubmitted = m_nSubmitted;
+	statPtr->nLocal = m_nLocal;
+	statPtr->nPending = m_nPending;
+	for (size_t i = 0; i < m_aWorker.size(); ++i) {
+		statPtr->nExecuted += m_aWorker[i]->nExecuted;
+		statPtr->nStolen += m_aWorker[i]->nStolen;
+		statPtr->nSleeps += m_aWorker[i]->nSleeps;
+	}
+}
+
+/**
+ * @brief	重設統計資訊
+ * @remark	應於沒有工作執行時調用.
+ */
+void CxFrameTaskPool::ResetStats()
+{
+	::InterlockedExchange64(&m_nSubmitted, 0);
+	::InterlockedExchange64(&m_nLocal, 0);
+	for (size_t i = 0; i < m_aWorker.size(); ++i) {
+		m_aWorker[i]->nExecuted = 0;
+		m_aWorker[i]->nStolen = 0;
+		m_aWorker[i]->nSleeps = 0;
+	}
+}
+
+/**
+ * @brief	取得處理器數量 (static)
+ * @return	@c 型別: DWORD, 目前處理器群組中的邏輯處理器數量, 至少為 1
+ */
+DWORD CxFrameTaskPool::GetProcessorCount()
+{
+	SYSTEM_INFO si;
+
+	::GetSystemInfo(&si);
+	return si.dwNumberOfProcessors != 0 ? si.dwNumberOfProcessors : 1;
+}
+
+/**
+ * @brief	工作放入佇列
+ * @param	[in] fnTaskPtr	工作處理函數
+ * @param	[in] fnFreePtr	未執行即捨棄時的釋放函數
+ * @param	[in] aParamPtr	工作處理函數參數
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ * @remark	佇列數量增加後才檢查等待中的工作執行緒, 與工作執行緒進入等待前的檢查順序相反, 不會遺漏喚醒.
+ */
+BOOL CxFrameTaskPool::PushTask(LPFNTASK fnTaskPtr, LPFNTASK fnFreePtr, LPVOID aParamPtr)
+{
+	SSWORKER* workerPtr = static_cast<SSWORKER*>(s_workerPtr);
+	SSTASK task;
+
+	if (fnTaskPtr == NULL || m_aWorker.empty() || m_bQuit)
+		return FALSE;
+
+	if (workerPtr != NULL && workerPtr->poolPtr == this) {
+		::InterlockedIncrement64(&m_nLocal);
+	}
+	else {
+		ULONG idxWorker = static_cast<ULONG>(::InterlockedIncrement(&m_idxNext));
+		workerPtr = m_aWorker[idxWorker % m_aWorker.size()];
+	}
+
+	task.fnTaskPtr = fnTaskPtr;
+	task.fnFreePtr = fnFreePtr;
+	task.aParamPtr = aParamPtr;
+	::InterlockedIncrement64(&m_nSubmitted);
+	::InterlockedIncrement64(&m_nPending);
+
+	::AcquireSRWLockExclusive(&workerPtr->srwLock);
+	workerPtr->aTask.push_back(task);
+	::InterlockedIncrement(&workerPtr->nCount);
+	::ReleaseSRWLockExclusive(&workerPtr->srwLock);
+
+	::InterlockedIncrement64(&m_nQueued);
+	if (m_nSleeping > 0)
+		::ReleaseSemaphore(m_hSemaphore, 1, NULL);
+	return TRUE;
+}
+
+/**
+ * @brief	由自己的佇列尾端取出工作 (LIFO)
+ * @param	[in] workerPtr	工作執行緒
+ * @param	[out] taskPtr	取出的工作
+ * @return	@c 型別: BOOL \n 取得工作返回非零值(non-zero)
+ */
+BOOL CxFrameTaskPool::PopTask(SSWORKER* workerPtr, SSTASK* taskPtr)
+{
+	BOOL bResult = FALSE;
+
+	if (workerPtr->nCount == 0)
+		return FALSE;
+
+	::AcquireSRWLockExclusive(&workerPtr->srwLock);
+	if (!workerPtr->aTask.empty()) {
+		*taskPtr = workerPtr->aTask.back();
+		workerPtr->aTask.pop_back();
+		::InterlockedDecrement(&workerPtr->nCount);
+		bResult = TRUE;
+	}
+	::ReleaseSRWLockExclusive(&workerPtr->srwLock);
+
+	if (bResult)
+		::InterlockedDecrement64(&m_nQueued);
+	return bResult;
+}
+
+/**
+ * @brief	由其他工作執行緒的佇列前端竊取工作 (FIFO)
+ * @param	[in] workerPtr	竊取的工作執行緒
+ * @param	[out] taskPtr	取出的工作
+ * @return	@c 型別: BOOL \n 取得工作返回非零值(non-zero)
+ * @remark	由下一個工作執行緒開始依序嘗試, 佇列為空時不鎖定.
+ */
+BOOL CxFrameTaskPool::StealTask(SSWORKER* workerPtr, SSTASK* taskPtr)
+{
+	const size_t nWorker = m_aWorker.size();
+
+	for (size_t i = 1; i < nWorker; ++i) {
+		SSWORKER* victimPtr = m_aWorker[(workerPtr->idxWorker + i) % nWorker];
+		BOOL bResult = FALSE;
+
+		if (victimPtr->nCount == 0)
+			continue;
+
+		::AcquireSRWLockExclusive(&victimPtr->srwLock);
+		if (!victimPtr->aTask.empty()) {
+			*taskPtr = victimPtr->aTask.front();
+			victimPtr->aTask.pop_front();
+			::InterlockedDecrement(&victimPtr->nCount);
+			bResult = TRUE;
+		}
+		::ReleaseSRWLockExclusive(&victimPtr->srwLock);
+
+		if (bResult) {
+			::InterlockedDecrement64(&m_nQueued);
+			++workerPtr->nStolen;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/**
+ * @brief	執行工作
+ * @param	[in] task	工作
+ */
+void CxFrameTaskPool::RunTask(const SSTASK& task)
+{
+	task.fnTaskPtr(task.aParamPtr);
+	if (::InterlockedDecrement64(&m_nPending) == 0)
+		::SetEvent(m_hIdle);
+}
+
+/**
+ * @brief	工作執行緒
+ * @param	[in] workerPtr	工作執行緒
+ * @remark	沒有工作時先短暫重試, 仍沒有工作才以號誌等待; 結束時先完成全部佇列中的工作.
+ */
+void CxFrameTaskPool::WorkerProc(SSWORKER* workerPtr)
+{
+	SSTASK task;
+
+	s_workerPtr = workerPtr;
+	for (;;) {
+		if (this->PopTask(workerPtr, &task) || this->StealTask(workerPtr, &task)) {
+			++workerPtr->nExecuted;
+			this->RunTask(task);
+			continue;
+		}
+
+		for (DWORD i = 0; i < TASKPOOL_SPIN_COUNT && m_nQueued == 0 && !m_bQuit; ++i)
+			::YieldProcessor();
+		if (m_nQueued != 0)
+			continue;
+		if (m_bQuit)
+			break;
+
+		// 先增加等待數量再檢查佇列, 投遞端增加佇列數量後才檢查等待數量
+		::InterlockedIncrement(&m_nSleeping);
+		if (m_nQueued != 0 || m_bQuit) {
+			::InterlockedDecrement(&m_nSleeping);
+			continue;
+		}
+		++workerPtr->nSleeps;
+		::WaitForSingleObject(m_hSemaphore, INFINITE);
+		::InterlockedDecrement(&m_nSleeping);
+	}
+	s_workerPtr = NULL;
+}
+
+/**
+ * @brief	工作執行緒進入點 (static)
+ * @param	[in] aParamPtr	SSWORKER 結構指標
+ * @return	@c 型別: DWORD, 結束碼
+ */
+DWORD WINAPI CxFrameTaskPool::StaticWorkerProc(LPVOID aParamPtr)
+{
+	SSWORKER* workerPtr = static_cast<SSWORKER*>(aParamPtr);
+	workerPtr->poolPtr->WorkerProc(workerPtr);
+	return 0;
+}
@@ -0,0 +1,245 @@
+﻿/**************************************************************************//**
+ * @file	wframe_thunk.cc
+ * @brief	可執行跳板 (thunk) 配置類別 - 成員函數
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_thunk.hh"
+
+//! CxFrameThunkPool 建構式
+CxFrameThunkPool::CxFrameThunkPool()
+	: m_uChunkSize(0)
+{
+	SYSTEM_INFO si;
+
+	::InitializeCriticalSection(&m_csPool);
+	::GetSystemInfo(&si);
+	m_uChunkSize = si.dwAllocationGranularity;
+	::memset(&m_stat, 0, sizeof(m_stat));
+}
+
+/**
+ * @brief	CxFrameThunkPool 解構式
+ * @remark	釋放全部區塊, 調用前必須確認沒有仍在使用的跳板.
+ */
+CxFrameThunkPool::~CxFrameThunkPool()
+{
+	for (size_t i = 0; i < m_aChunk.size(); ++i) {
+		::UnmapViewOfFile(m_aChunk[i].aExecPtr);
+		::UnmapViewOfFile(m_aChunk[i].aWritePtr);
+		::CloseHandle(m_aChunk[i].hSection);
+	}
+	m_aChunk.clear();
+	m_aFree.clear();
+	::DeleteCriticalSection(&m_csPool);
+}
+
+/**
+ * @brief	配置跳板
+ * @param	[in] aBindPtr		綁定的指標, 取代呼叫時的第一個參數
+ * @param	[in] fnTargetPtr	目標函數位址
+ * @return	@c 型別: LPVOID \n
+ *			跳板位址 (可轉型為與目標函數相同的函數指標型別) \n
+ *			參數錯誤, 配置失敗或不支援的平台返回 NULL
+ * @remark	目標函數的呼叫慣例必須與跳板呼叫者相同 (如 WNDPROC 為 CALLBACK).
+ */
+LPVOID CxFrameThunkPool::Alloc(LPVOID aBindPtr, LPCVOID fnTargetPtr)
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+	LPBYTE aExecPtr = NULL;
+
+	if (fnTargetPtr == NULL)
+		return NULL;
+
+	::EnterCriticalSection(&m_csPool);
+	if (m_aFree.empty())
+		this->AddChunk();
+	if (!m_aFree.empty()) {
+		aExecPtr = m_aFree.back();
+		m_aFree.pop_back();
+		this->WriteSlot(this->GetWritePtr(aExecPtr), aExecPtr, aBindPtr, fnTargetPtr);
+		++m_stat.nUsed;
+		++m_stat.nAlloc;
+	}
+	::LeaveCriticalSection(&m_csPool);
+	return aExecPtr;
+#else
+	UNREFERENCED_PARAMETER(aBindPtr);
+	UNREFERENCED_PARAMETER(fnTargetPtr);
+	return NULL;
+#endif
+}
+
+/**
+ * @brief	釋放跳板
+ * @param	[in] thunkPtr	Alloc 返回的跳板位址
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			不是由此物件配置的跳板返回零(zero)
+ * @remark	釋放前必須確認跳板不會再被呼叫 (如已還原視窗的 WNDPROC). \n
+ *			釋放的跳板寫入中斷指令, 誤呼叫時立即觸發例外而非跳至錯誤的目標.
+ */
+BOOL CxFrameThunkPool::Free(LPVOID thunkPtr)
+{
+	LPBYTE aExecPtr = static_cast<LPBYTE>(thunkPtr);
+	LPBYTE aWritePtr;
+	BOOL bResult = FALSE;
+
+	if (thunkPtr == NULL)
+		return FALSE;
+
+	::EnterCriticalSection(&m_csPool);
+	if ((aWritePtr = this->GetWritePtr(aExecPtr)) != NULL) {
+		this->ClearSlot(aWritePtr, aExecPtr);
+		m_aFree.push_back(aExecPtr);
+		--m_stat.nUsed;
+		++m_stat.nFree;
+		bResult = TRUE;
+	}
+	::LeaveCriticalSection(&m_csPool);
+	return bResult;
+}
+
+/**
+ * @brief	取得統計資訊
+ * @param	[out] statPtr	SSTHUNKSTAT 結構指標
+ */
+void CxFrameThunkPool::GetStats(LPSSTHUNKSTAT statPtr)
+{
+	if (statPtr == NULL)
+		return;
+
+	::EnterCriticalSection(&m_csPool);
+	*statPtr = m_stat;
+	::LeaveCriticalSection(&m_csPool);
+}
+
+/**
+ * @brief	取得共用的跳板配置物件 (static)
+ * @return	@c 型別: CxFrameThunkPool&, 程序內共用的物件, 於第一次調用時建立
+ */
+CxFrameThunkPool& CxFrameThunkPool::Shared()
+{
+	static CxFrameThunkPool s_pool;
+	return s_pool;
+}
+
+/**
+ * @brief	配置新區塊, 全部跳板加入可用清單
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ */
+BOOL CxFrameThunkPool::AddChunk()
+{
+	auto err = BOOL(TRUE);
+	SSCHUNK chunk;
+
+	::memset(&chunk, 0, sizeof(chunk));
+	for (;;) {
+		// 區段最大保護為可讀寫執行, 各視圖再分別限制為寫入或執行
+		chunk.hSection = ::CreateFileMapping(INVALID_HANDLE_VALUE, NULL, PAGE_EXECUTE_READWRITE, 0, static_cast<DWORD>(m_uChunkSize), NULL);
+		if (chunk.hSection == NULL)
+			break;
+		chunk.aWritePtr = static_cast<LPBYTE>(::MapViewOfFile(chunk.hSection, FILE_MAP_WRITE, 0, 0, m_uChunkSize));
+		if (chunk.aWritePtr == NULL)
+			break;
+		chunk.aExecPtr = static_cast<LPBYTE>(::MapViewOfFile(chunk.hSection, FILE_MAP_READ | FILE_MAP_EXECUTE, 0, 0, m_uChunkSize));
+		if (chunk.aExecPtr == NULL)
+			break;
+
+		for (size_t i = 0; i < m_uChunkSize; i += THUNK_SLOT_SIZE)
+			this->ClearSlot(chunk.aWritePtr + i, NULL);
+		::FlushInstructionCache(::GetCurrentProcess(), chunk.aExecPtr, m_uChunkSize);
+
+		// 反向加入, 由區塊開頭開始使用
+		for (size_t i = m_uChunkSize; i >= THUNK_SLOT_SIZE; i -= THUNK_SLOT_SIZE)
+			m_aFree.push_back(chunk.aExecPtr + i - THUNK_SLOT_SIZE);
+		m_aChunk.push_back(chunk);
+		m_stat.nChunks = m_aChunk.size();
+		m_stat.nSlots += m_uChunkSize / THUNK_SLOT_SIZE;
+		err = FALSE;
+		break;
+	}
+
+	if (err) {
+		if (chunk.aWritePtr != NULL)
+			::UnmapViewOfFile(chunk.aWritePtr);
+		if (chunk.hSection != NULL)
+			::CloseHandle(chunk.hSection);
+	}
+	return !err;
+}
+
+/**
+ * @brief	由執行視圖位址取得寫入視圖位址
+ * @param	[in] aExecPtr	執行視圖中的跳板位址
+ * @return	@c 型別: LPBYTE \n 寫入視圖位址, 不屬於任何區塊或未對齊返回 NULL
+ */
+LPBYTE CxFrameThunkPool::GetWritePtr(LPBYTE aExecPtr)
+{
+	for (size_t i = 0; i < m_aChunk.size(); ++i) {
+		const SSCHUNK& chunk = m_aChunk[i];
+		if (aExecPtr < chunk.aExecPtr || aExecPtr >= chunk.aExecPtr + m_uChunkSize)
+			continue;
+
+		SIZE_T uOffset = static_cast<SIZE_T>(aExecPtr - chunk.aExecPtr);
+		return (uOffset % THUNK_SLOT_SIZE) == 0 ? chunk.aWritePtr + uOffset : NULL;
+	}
+	return NULL;
+}
+
+/**
+ * @brief	寫入跳板機器碼
+ * @param	[in] aWritePtr		寫入視圖位址
+ * @param	[in] aExecPtr		執行視圖位址
+ * @param	[in] aBindPtr		綁定的指標
+ * @param	[in] fnTargetPtr	目標函數位址
+ */
+void CxFrameThunkPool::WriteSlot(LPBYTE aWritePtr, LPBYTE aExecPtr, LPVOID aBindPtr, LPCVOID fnTargetPtr)
+{
+#if defined(_M_X64)
+	// mov rcx, aBindPtr ; mov rax, fnTargetPtr ; jmp rax
+	ULONG_PTR uBind = reinterpret_cast<ULONG_PTR>(aBindPtr);
+	ULONG_PTR uTarget = reinterpret_cast<ULONG_PTR>(fnTargetPtr);
+	aWritePtr[0] = 0x48; aWritePtr[1] = 0xB9;
+	::memcpy(aWritePtr + 2, &uBind, sizeof(uBind));
+	aWritePtr[10] = 0x48; aWritePtr[11] = 0xB8;
+	::memcpy(aWritePtr + 12, &uTarget, sizeof(uTarget));
+	aWritePtr[20] = 0xFF; aWritePtr[21] = 0xE0;
+#elif defined(_M_IX86)
+	// mov dword ptr [esp+4], aBindPtr ; jmp fnTargetPtr
+	DWORD dwBind = reinterpret_cast<DWORD>(aBindPtr);
+	LONG lRelative = static_cast<LONG>(reinterpret_cast<ULONG_PTR>(fnTargetPtr) - reinterpret_cast<ULONG_PTR>(aExecPtr + 13));
+	aWritePtr[0] = 0xC7; aWritePtr[1] = 0x44; aWritePtr[2] = 0x24; aWritePtr[3] = 0x04;
+	::memcpy(aWritePtr + 4, &dwBind, sizeof(dwBind));
+	aWritePtr[8] = 0xE9;
+	::memcpy(aWritePtr + 9, &lRelative, sizeof(lRelative));
+#elif defined(_M_ARM64)
+	// ldr x0, [pc+16] ; ldr x16, [pc+20] ; br x16 ; nop ; .quad aBindPtr ; .quad fnTargetPtr
+	const DWORD aCode[] = { 0x58000080, 0x580000B0, 0xD61F0200, 0xD503201F };
+	ULONG_PTR uBind = reinterpret_cast<ULONG_PTR>(aBindPtr);
+	ULONG_PTR uTarget = reinterpret_cast<ULONG_PTR>(fnTargetPtr);
+	::memcpy(aWritePtr, aCode, sizeof(aCode));
+	::memcpy(aWritePtr + 16, &uBind, sizeof(uBind));
+	::memcpy(aWritePtr + 24, &uTarget, sizeof(uTarget));
+#endif
+	::FlushInstructionCache(::GetCurrentProcess(), aExecPtr, THUNK_SLOT_SIZE);
+}
+
+/**
+ * @brief	以中斷指令填滿跳板
+ * @param	[in] aWritePtr	寫入視圖位址
+ * @param	[in] aExecPtr	執行視圖位址, NULL 表示由調用者清除指令快取
+ */
+void CxFrameThunkPool::ClearSlot(LPBYTE aWritePtr, LPBYTE aExecPtr)
+{
+#if defined(_M_ARM64)
+	const DWORD dwBreak = 0xD4200000;	// brk #0
+	for (size_t i = 0; i < THUNK_SLOT_SIZE; i += sizeof(dwBreak))
+		::memcpy(aWritePtr + i, &dwBreak, sizeof(dwBreak));
+#else
+	::memset(aWritePtr, 0xCC, THUNK_SLOT_SIZE);	// int 3
+#endif
+	if (aExecPtr != NULL)
+		::FlushInstructionCache(::GetCurrentProcess(), aExecPtr, THUNK_SLOT_SIZE);
+}
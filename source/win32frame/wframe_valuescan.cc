@@ -0,0 +1,687 @@
+﻿/**************************************************************************//**
+ * @file	wframe_valuescan.cc
+ * @brief	程序記憶體數值搜尋類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_valuescan.hh"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#	include <intrin.h>
+#	define VALUESCAN_SIMD	1		//!< 使用 SSE2 比對
+#endif
+
+namespace {
+
+#if defined(VALUESCAN_SIMD)
+	// SSE2 比對操作, 每次處理 16 bytes, 返回每個數值位置的比對結果位元
+	struct ScanOpsI8 {
+		typedef INT8 T;
+		typedef __m128i V;
+		enum { LANES = 16 };
+		static V Load(const BYTE* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+		static V Set1(const BYTE* p) { return _mm_set1_epi8(*reinterpret_cast<const char*>(p)); }
+		static UINT Eq(V a, V b) { return static_cast<UINT>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))); }
+		static UINT Gt(V a, V b) { return static_cast<UINT>(_mm_movemask_epi8(_mm_cmpgt_epi8(a, b))); }
+		static UINT Ge(V a, V b) { return ~Gt(b, a) & 0xFFFF; }
+	};
+
+	struct ScanOpsI16 {
+		typedef INT16 T;
+		typedef __m128i V;
+		enum { LANES = 8 };
+		static V Load(const BYTE* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+		static V Set1(const BYTE* p) { T v; ::memcpy(&v, p, sizeof(v)); return _mm_set1_epi16(v); }
+		static UINT Mask(V m) { return static_cast<UINT>(_mm_movemask_epi8(_mm_packs_epi16(m, _mm_setzero_si128()))) & 0xFF; }
+		static UINT Eq(V a, V b) { return Mask(_mm_cmpeq_epi16(a, b)); }
+		static UINT Gt(V a, V b) { return Mask(_mm_cmpgt_epi16(a, b)); }
+		static UINT Ge(V a, V b) { return ~Gt(b, a) & 0xFF; }
+	};
+
+	struct ScanOpsI32 {
+		typedef INT32 T;
+		typedef __m128i V;
+		enum { LANES = 4 };
+		static V Load(const BYTE* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+		static V Set1(const BYTE* p) { T v; ::memcpy(&v, p, sizeof(v)); return _mm_set1_epi32(v); }
+		static UINT Eq(V a, V b) { return static_cast<UINT>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+		static UINT Gt(V a, V b) { return static_cast<UINT>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a, b)))); }
+		static UINT Ge(V a, V b) { return ~Gt(b, a) & 0x0F; }
+	};
+
+	struct ScanOpsI64 {
+		typedef INT64 T;
+		typedef __m128i V;
+		enum { LANES = 2 };
+		static V Load(const BYTE* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+		static V Set1(const BYTE* p) { T v; ::memcpy(&v, p, sizeof(v)); return _mm_set1_epi64x(v); }
+		static UINT Eq(V a, V b) {
+			// SSE2 沒有 64 位元比對, 以兩個 32 位元比對結果合併
+			__m128i m = _mm_cmpeq_epi32(a, b);
+			m = _mm_and_si128(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+			return static_cast<UINT>(_mm_movemask_pd(_mm_castsi128_pd(m)));
+		}
+		static UINT Gt(V a, V b) {
+			T x[2], y[2];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(x), a);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(y), b);
+			return (x[0] > y[0] ? 1u : 0u) | (x[1] > y[1] ? 2u : 0u);
+		}
+		static UINT Ge(V a, V b) { return ~Gt(b, a) & 0x03; }
+	};
+
+	struct ScanOpsF32 {
+		typedef float T;
+		typedef __m128 V;
+		enum { LANES = 4 };
+		static V Load(const BYTE* p) { return _mm_loadu_ps(reinterpret_cast<const float*>(p)); }
+		static V Set1(const BYTE* p) { T v; ::memcpy(&v, p, sizeof(v)); return _mm_set1_ps(v); }
+		static UINT Eq(V a, V b) { return static_cast<UINT>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+		static UINT Gt(V a, V b) { return static_cast<UINT>(_mm_movemask_ps(_mm_cmpgt_ps(a, b))); }
+		static UINT Ge(V a, V b) { return static_cast<UINT>(_mm_movemask_ps(_mm_cmpge_ps(a, b))); }
+	};
+
+	struct ScanOpsF64 {
+		typedef double T;
+		typedef __m128d V;
+		enum { LANES = 2 };
+		static V Load(const BYTE* p) { return _mm_loadu_pd(reinterpret_cast<const double*>(p)); }
+		static V Set1(const BYTE* p) { T v; ::memcpy(&v, p, sizeof(v)); return _mm_set1_pd(v); }
+		static UINT Eq(V a, V b) { return static_cast<UINT>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+		static UINT Gt(V a, V b) { return static_cast<UINT>(_mm_movemask_pd(_mm_cmpgt_pd(a, b))); }
+		static UINT Ge(V a, V b) { return static_cast<UINT>(_mm_movemask_pd(_mm_cmpge_pd(a, b))); }
+	};
+#else
+	// 一般比對操作, 每次處理一個數值
+	template <typename TYPE>
+	struct ScanOpsScalar {
+		typedef TYPE T;
+		typedef TYPE V;
+		enum { LANES = 1 };
+		static V Load(const BYTE* p) { T v; ::memcpy(&v, p, sizeof(v)); return v; }
+		static V Set1(const BYTE* p) { return Load(p); }
+		static UINT Eq(V a, V b) { return a == b ? 1u : 0u; }
+		static UINT Gt(V a, V b) { return a > b ? 1u : 0u; }
+		static UINT Ge(V a, V b) { return a >= b ? 1u : 0u; }
+	};
+	typedef ScanOpsScalar<INT8>		ScanOpsI8;
+	typedef ScanOpsScalar<INT16>	ScanOpsI16;
+	typedef ScanOpsScalar<INT32>	ScanOpsI32;
+	typedef ScanOpsScalar<INT64>	ScanOpsI64;
+	typedef ScanOpsScalar<float>	ScanOpsF32;
+	typedef ScanOpsScalar<double>	ScanOpsF64;
+#endif
+
+	//! 計算 64 位元中為 1 的位元數量
+	inline SIZE_T PopCount(UINT64 x)
+	{
+		x = x - ((x >> 1) & 0x5555555555555555ULL);
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return static_cast<SIZE_T>((x * 0x0101010101010101ULL) >> 56);
+	}
+
+	//! 寫入 varint (每位元組 7 bits, 最高位元表示後續還有資料)
+	inline void PutVarint(std::vector<BYTE>* aPtr, SIZE_T uValue)
+	{
+		while (uValue >= 0x80) {
+			aPtr->push_back(static_cast<BYTE>(uValue | 0x80));
+			uValue >>= 7;
+		}
+		aPtr->push_back(static_cast<BYTE>(uValue));
+	}
+
+	//! 讀取 varint
+	inline SIZE_T GetVarint(const BYTE** aPtr)
+	{
+		SIZE_T uValue = 0;
+		int iShift = 0;
+		const BYTE* p = *aPtr;
+
+		for (;;) {
+			BYTE ch = *p++;
+			uValue |= static_cast<SIZE_T>(ch & 0x7F) << iShift;
+			if ((ch & 0x80) == 0) break;
+			iShift += 7;
+		}
+		*aPtr = p;
+		return uValue;
+	}
+
+	/**
+	 * 比對密集區塊, CMP 於編譯時期決定, 內層迴圈不需判斷比對方式
+	 * aNewPtr, aOldPtr 長度需補齊至 64 個數值位置的倍數
+	 */
+	template <class OPS, int CMP>
+	SIZE_T CompareBlock(const BYTE* aNewPtr, const BYTE* aOldPtr, const BYTE* aValue1Ptr, const BYTE* aValue2Ptr,
+		SIZE_T nSlots, UINT64* aBitsPtr, BOOL bFirst)
+	{
+		const SIZE_T uSize = sizeof(typename OPS::T);
+		const UINT64 uLaneAll = (1ULL << OPS::LANES) - 1;
+		const typename OPS::V v1 = OPS::Set1(aValue1Ptr);
+		const typename OPS::V v2 = OPS::Set1(aValue2Ptr);
+		SIZE_T nWords = (nSlots + 63) / 64;
+		SIZE_T nCount = 0;
+
+		for (SIZE_T w = 0; w < nWords; ++w) {
+			UINT64 uIn = bFirst ? ~0ULL : aBitsPtr[w];
+			if (w == nWords - 1 && (nSlots & 63) != 0)
+				uIn &= (1ULL << (nSlots & 63)) - 1;
+
+			// 此 64 個位置都已不是候選, 不必比對
+			if (uIn == 0) {
+				aBitsPtr[w] = 0;
+				continue;
+			}
+
+			UINT64 uOut = 0;
+			if (CMP == EScanUnknown) {
+				uOut = ~0ULL;
+			}
+			else {
+				const BYTE* aNPtr = aNewPtr + w * 64 * uSize;
+				const BYTE* aOPtr = aOldPtr != NULL ? aOldPtr + w * 64 * uSize : NULL;
+				for (SIZE_T s = 0; s < 64; s += OPS::LANES) {
+					typename OPS::V a = OPS::Load(aNPtr + s * uSize);
+					UINT64 m;
+					switch (CMP) {
+					case EScanExact:		m = OPS::Eq(a, v1); break;
+					case EScanRange:		m = OPS::Ge(a, v1) & OPS::Ge(v2, a); break;
+					case EScanChanged:		m = ~static_cast<UINT64>(OPS::Eq(a, OPS::Load(aOPtr + s * uSize))) & uLaneAll; break;
+					case EScanUnchanged:	m = OPS::Eq(a, OPS::Load(aOPtr + s * uSize)); break;
+					case EScanIncreased:	m = OPS::Gt(a, OPS::Load(aOPtr + s * uSize)); break;
+					case EScanDecreased:	m = OPS::Gt(OPS::Load(aOPtr + s * uSize), a); break;
+					default:				m = 0; break;
+					}
+					uOut |= m << s;
+				}
+			}
+			uOut &= uIn;
+			aBitsPtr[w] = uOut;
+			nCount += PopCount(uOut);
+		}
+		return nCount;
+	}
+
+	//! 依比對方式選擇比對函數
+	template <class OPS>
+	SIZE_T CompareOps(EESCANCOMPARE eCompare, const BYTE* aNewPtr, const BYTE* aOldPtr, const BYTE* aValue1Ptr, const BYTE* aValue2Ptr,
+		SIZE_T nSlots, UINT64* aBitsPtr, BOOL bFirst)
+	{
+		switch (eCompare) {
+		case EScanExact:		return CompareBlock<OPS, EScanExact>(aNewPtr, aOldPtr, aValue1Ptr, aValue2Ptr, nSlots, aBitsPtr, bFirst);
+		case EScanRange:		return CompareBlock<OPS, EScanRange>(aNewPtr, aOldPtr, aValue1Ptr, aValue2Ptr, nSlots, aBitsPtr, bFirst);
+		case EScanUnknown:		return CompareBlock<OPS, EScanUnknown>(aNewPtr, aOldPtr, aValue1Ptr, aValue2Ptr, nSlots, aBitsPtr, bFirst);
+		case EScanChanged:		return CompareBlock<OPS, EScanChanged>(aNewPtr, aOldPtr, aValue1Ptr, aValue2Ptr, nSlots, aBitsPtr, bFirst);
+		case EScanUnchanged:	return CompareBlock<OPS, EScanUnchanged>(aNewPtr, aOldPtr, aValue1Ptr, aValue2Ptr, nSlots, aBitsPtr, bFirst);
+		case EScanIncreased:	return CompareBlock<OPS, EScanIncreased>(aNewPtr, aOldPtr, aValue1Ptr, aValue2Ptr, nSlots, aBitsPtr, bFirst);
+		case EScanDecreased:	return CompareBlock<OPS, EScanDecreased>(aNewPtr, aOldPtr, aValue1Ptr, aValue2Ptr, nSlots, aBitsPtr, bFirst);
+		default:				return 0;
+		}
+	}
+
+	//! 比對單一數值 (稀疏區塊使用)
+	template <typename T>
+	BOOL MatchValue(EESCANCOMPARE eCompare, const BYTE* aNewPtr, const BYTE* aOldPtr, const BYTE* aValue1Ptr, const BYTE* aValue2Ptr)
+	{
+		T n, o, v1, v2;
+
+		// 改變/未改變以位元內容判斷 (浮點數 NaN 也能正確處理)
+		if (eCompare == EScanChanged) return ::memcmp(aNewPtr, aOldPtr, sizeof(T)) != 0;
+		if (eCompare == EScanUnchanged) return ::memcmp(aNewPtr, aOldPtr, sizeof(T)) == 0;
+
+		::memcpy(&n, aNewPtr, sizeof(T));
+		switch (eCompare) {
+		case EScanExact:	::memcpy(&v1, aValue1Ptr, sizeof(T)); return n == v1;
+		case EScanRange:	::memcpy(&v1, aValue1Ptr, sizeof(T)); ::memcpy(&v2, aValue2Ptr, sizeof(T)); return n >= v1 && n <= v2;
+		case EScanIncreased:	::memcpy(&o, aOldPtr, sizeof(T)); return n > o;
+		case EScanDecreased:	::memcpy(&o, aOldPtr, sizeof(T)); return n < o;
+		default:			return FALSE;
+		}
+	}
+}
+
+//! CxFrameValueScan 建構式
+CxFrameValueScan::CxFrameValueScan()
+	: m_procPtr(NULL)
+	, m_eType(EValueInt32)
+	, m_uValueSize(4)
+	, m_eCompare(EScanExact)
+	, m_bFirst(FALSE)
+	, m_nCount(0)
+{
+	::memset(m_aValue1, 0, sizeof(m_aValue1));
+	::memset(m_aValue2, 0, sizeof(m_aValue2));
+}
+
+//! CxFrameValueScan 解構式
+CxFrameValueScan::~CxFrameValueScan() { this->Clear(); }
+
+/**
+ * @brief	首次搜尋
+ * @param	[in] procPtr	已開啟的目標程序物件
+ * @param	[in] eType		數值型別
+ * @param	[in] eCompare	比對方式, 只接受 EScanExact, EScanRange, EScanUnknown
+ * @param	[in] aValuePtr	比對值 (或範圍下限) 位址, 型別需與 eType 相同
+ * @param	[in] aValue2Ptr	範圍上限位址 (僅 EScanRange)
+ * @param	[in] poolPtr	工作執行緒池, 為 NULL 時於調用端執行緒依序搜尋
+ * @param	[in] mapPtr		已載入目標程序的區域對照表, 為 NULL 時自行載入
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 以 GetCount 取得候選數量 \n
+ *			參數錯誤或無法取得記憶體區域返回零(zero)
+ * @remark	只搜尋已提交且可寫入的記憶體區域, 會清除上次搜尋結果.
+ */
+BOOL CxFrameValueScan::FirstScan(CxFrameProcess* procPtr, EEVALUETYPE eType, EESCANCOMPARE eCompare, LPCVOID aValuePtr, LPCVOID aValue2Ptr,
+	CxFrameWorkPool* poolPtr, CxFrameRegionMap* mapPtr)
+{
+	CxFrameRegionMap regionMap;
+
+	if (procPtr == NULL || eType < EValueInt8 || eType >= EValueTypeEnd)
+		return FALSE;
+	if (eCompare != EScanExact && eCompare != EScanRange && eCompare != EScanUnknown)
+		return FALSE;
+	if ((eCompare != EScanUnknown && aValuePtr == NULL) || (eCompare == EScanRange && aValue2Ptr == NULL))
+		return FALSE;
+
+	if (mapPtr == NULL) {
+		mapPtr = &regionMap;
+		if (!mapPtr->Load(procPtr)) return FALSE;
+	}
+
+	this->Clear();
+	m_procPtr = procPtr;
+	m_eType = eType;
+	m_uValueSize = ValueSize(eType);
+	m_eCompare = eCompare;
+	if (aValuePtr != NULL) ::memcpy(m_aValue1, aValuePtr, m_uValueSize);
+	if (aValue2Ptr != NULL) ::memcpy(m_aValue2, aValue2Ptr, m_uValueSize);
+
+	// 可寫入區域切割為搜尋區塊
+	for (size_t i = 0; i < mapPtr->GetCount(); ++i) {
+		const SSMEMREGION* rgPtr = mapPtr->GetRegion(i);
+		if (!CxFrameRegionMap::IsWritableRegion(rgPtr))
+			continue;
+
+		for (SIZE_T uOffset = 0; uOffset < rgPtr->uSize; uOffset += VALUESCAN_BLOCK) {
+			SIZE_T uSize = rgPtr->uSize - uOffset;
+			if (uSize > VALUESCAN_BLOCK) uSize = VALUESCAN_BLOCK;
+
+			SSBLOCK block;
+			block.uBase = rgPtr->uBase + uOffset;
+			block.nSlots = uSize / m_uValueSize;
+			block.nCount = 0;
+			block.bSparse = FALSE;
+			block.idxFirst = 0;
+			block.idxLast = 0;
+			if (block.nSlots != 0)
+				m_aBlock.push_back(block);
+		}
+	}
+
+	m_bFirst = TRUE;
+	BOOL err = this->RunPass(poolPtr);
+	m_bFirst = FALSE;
+	return err;
+}
+
+/**
+ * @brief	再次搜尋, 縮小候選範圍
+ * @param	[in] eCompare	比對方式, EScanUnknown 除外
+ * @param	[in] aValuePtr	比對值 (或範圍下限) 位址 (僅 EScanExact, EScanRange)
+ * @param	[in] aValue2Ptr	範圍上限位址 (僅 EScanRange)
+ * @param	[in] poolPtr	工作執行緒池, 為 NULL 時於調用端執行緒依序搜尋
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero), 以 GetCount 取得候選數量 \n
+ *			尚未首次搜尋或參數錯誤返回零(zero)
+ * @remark	"上次數值" 為上一次搜尋時讀取的數值, 每次搜尋後都會更新.
+ */
+BOOL CxFrameValueScan::NextScan(EESCANCOMPARE eCompare, LPCVOID aValuePtr, LPCVOID aValue2Ptr, CxFrameWorkPool* poolPtr)
+{
+	if (m_procPtr == NULL || eCompare == EScanUnknown || eCompare < EScanExact || eCompare >= EScanCompareEnd)
+		return FALSE;
+	if ((eCompare == EScanExact || eCompare == EScanRange) && aValuePtr == NULL)
+		return FALSE;
+	if (eCompare == EScanRange && aValue2Ptr == NULL)
+		return FALSE;
+
+	m_eCompare = eCompare;
+	if (aValuePtr != NULL) ::memcpy(m_aValue1, aValuePtr, m_uValueSize);
+	if (aValue2Ptr != NULL) ::memcpy(m_aValue2, aValue2Ptr, m_uValueSize);
+	return this->RunPass(poolPtr);
+}
+
+//! 清除搜尋結果
+void CxFrameValueScan::Clear()
+{
+	m_aBlock.clear();
+	m_aBuffer.clear();
+	m_procPtr = NULL;
+	m_nCount = 0;
+}
+
+/**
+ * @brief	取得候選數量
+ * @return	@c 型別: ULONGLONG \n 目前候選位址數量
+ */
+ULONGLONG CxFrameValueScan::GetCount() { return static_cast<ULONGLONG>(m_nCount); }
+
+/**
+ * @brief	取得候選位址
+ * @param	[out] aAddressPtr	位址存放位址, 找到的位址會附加於尾端 (由低至高)
+ * @param	[in]  nMax			最多取得數量
+ * @return	@c 型別: size_t \n 取得的位址數量
+ */
+size_t CxFrameValueScan::GetResults(std::vector<ULONG_PTR>* aAddressPtr, size_t nMax)
+{
+	size_t nCount = 0;
+
+	if (aAddressPtr == NULL)
+		return 0;
+
+	for (size_t i = 0; i < m_aBlock.size() && nCount < nMax; ++i) {
+		const SSBLOCK& block = m_aBlock[i];
+
+		if (block.bSparse) {
+			const BYTE* aPtr = block.aDelta.data();
+			SIZE_T idxSlot = 0;
+			for (SIZE_T k = 0; k < block.nCount && nCount < nMax; ++k, ++nCount) {
+				idxSlot += GetVarint(&aPtr);
+				aAddressPtr->push_back(block.uBase + idxSlot * m_uValueSize);
+			}
+			continue;
+		}
+
+		for (SIZE_T w = 0; w < block.aBits.size() && nCount < nMax; ++w) {
+			UINT64 uBits = block.aBits[w];
+			while (uBits != 0 && nCount < nMax) {
+				SIZE_T idxBit = 0;
+				while ((uBits & (1ULL << idxBit)) == 0) ++idxBit;
+				uBits &= uBits - 1;
+				aAddressPtr->push_back(block.uBase + (w * 64 + idxBit) * m_uValueSize);
+				++nCount;
+			}
+		}
+	}
+	return nCount;
+}
+
+/**
+ * @brief	取得候選資料使用的記憶體大小
+ * @return	@c 型別: SIZE_T \n 候選位元集、差值編碼與上次數值佔用的記憶體 (in Byte)
+ */
+SIZE_T CxFrameValueScan::GetMemoryUsage()
+{
+	SIZE_T cbTotal = m_aBlock.capacity() * sizeof(SSBLOCK);
+
+	for (size_t i = 0; i < m_aBlock.size(); ++i) {
+		cbTotal += m_aBlock[i].aBits.capacity() * sizeof(UINT64);
+		cbTotal += m_aBlock[i].aDelta.capacity();
+		cbTotal += m_aBlock[i].aValue.capacity();
+	}
+	return cbTotal;
+}
+
+/**
+ * @brief	取得目前搜尋的數值型別
+ * @return	@c 型別: EEVALUETYPE \n 數值型別
+ */
+EEVALUETYPE CxFrameValueScan::GetValueType() { return m_eType; }
+
+/**
+ * @brief	執行一次搜尋
+ * @param	[in] poolPtr	工作執行緒池 (可為 NULL)
+ * @return	@c 型別: BOOL \n 函數操作成功返回非零值(non-zero)
+ * @remark	完成後移除已沒有候選的區塊.
+ */
+BOOL CxFrameValueScan::RunPass(CxFrameWorkPool* poolPtr)
+{
+	if (poolPtr != NULL && poolPtr->GetThreadCount() == 0)
+		poolPtr = NULL;
+
+	size_t nBuffer = poolPtr != NULL ? poolPtr->GetThreadCount() : 1;
+	if (m_aBuffer.size() < nBuffer)
+		m_aBuffer.resize(nBuffer);
+
+	m_nCount = 0;
+	if (poolPtr != NULL) {
+		poolPtr->Run(StaticScanProc, this, m_aBlock.size());
+	}
+	else {
+		for (size_t i = 0; i < m_aBlock.size(); ++i)
+			this->ScanBlock(i, 0);
+	}
+
+	// 移除已沒有候選的區塊
+	m_aBlock.erase(std::remove_if(m_aBlock.begin(), m_aBlock.end(), [](const SSBLOCK& block) {
+		return block.nCount == 0;
+	}), m_aBlock.end());
+	return TRUE;
+}
+
+/**
+ * @brief	搜尋一個區塊
+ * @param	[in] idxBlock	區塊索引
+ * @param	[in] idxWorker	工作執行緒索引
+ */
+void CxFrameValueScan::ScanBlock(size_t idxBlock, DWORD idxWorker)
+{
+	SSBLOCK* blockPtr = &m_aBlock[idxBlock];
+
+	if (!m_bFirst && blockPtr->nCount == 0)
+		return;
+
+	if (blockPtr->bSparse)
+		this->ScanSparse(blockPtr, &m_aBuffer[idxWorker]);
+	else
+		this->ScanDense(blockPtr, &m_aBuffer[idxWorker]);
+
+	if (blockPtr->nCount != 0)
+		::InterlockedExchangeAdd64(&m_nCount, static_cast<LONG64>(blockPtr->nCount));
+}
+
+/**
+ * @brief	搜尋密集區塊 (位元集)
+ * @param	[in,out] blockPtr	區塊
+ * @param	[in,out] aBuffPtr	工作執行緒讀取緩衝區, 完成後與區塊上次數值交換
+ */
+void CxFrameValueScan::ScanDense(SSBLOCK* blockPtr, std::vector<BYTE>* aBuffPtr)
+{
+	SIZE_T nWords = (blockPtr->nSlots + 63) / 64;
+	SIZE_T cbPadded = nWords * 64 * m_uValueSize;
+	SIZE_T cbReads;
+
+	// 緩衝區補齊至 64 個位置的倍數, 比對時不必處理尾端
+	if (aBuffPtr->size() < cbPadded)
+		aBuffPtr->resize(cbPadded);
+	cbReads = m_procPtr->ReadMemory(reinterpret_cast<LPCVOID>(blockPtr->uBase), aBuffPtr->data(), blockPtr->nSlots * m_uValueSize);
+
+	SIZE_T nValid = cbReads / m_uValueSize;
+	if (nValid == 0) {
+		// 區塊已無法讀取 (如已釋放)
+		blockPtr->nCount = 0;
+		std::vector<UINT64>().swap(blockPtr->aBits);
+		std::vector<BYTE>().swap(blockPtr->aValue);
+		return;
+	}
+
+	if (m_bFirst)
+		blockPtr->aBits.resize(nWords);
+
+	// 只讀取部分時, 未讀取的位置不再是候選
+	SIZE_T nCount = this->CompareDense(aBuffPtr->data(), m_bFirst ? NULL : blockPtr->aValue.data(), nValid, blockPtr->aBits.data());
+	for (SIZE_T w = (nValid + 63) / 64; w < nWords; ++w)
+		blockPtr->aBits[w] = 0;
+
+	blockPtr->nCount = nCount;
+	blockPtr->aValue.swap(*aBuffPtr);
+
+	if (nCount == 0) {
+		std::vector<UINT64>().swap(blockPtr->aBits);
+		std::vector<BYTE>().swap(blockPtr->aValue);
+	}
+	else if (nCount * VALUESCAN_SPARSE_RATIO < blockPtr->nSlots) {
+		this->MakeSparse(blockPtr, blockPtr->aValue.data());
+	}
+}
+
+/**
+ * @brief	搜尋稀疏區塊 (差值編碼)
+ * @param	[in,out] blockPtr	區塊
+ * @param	[in,out] aBuffPtr	工作執行緒讀取緩衝區
+ * @remark	只讀取第一個至最後一個候選之間的記憶體.
+ */
+void CxFrameValueScan::ScanSparse(SSBLOCK* blockPtr, std::vector<BYTE>* aBuffPtr)
+{
+	SIZE_T cbSpan = (blockPtr->idxLast - blockPtr->idxFirst + 1) * m_uValueSize;
+	std::vector<BYTE> aDelta, aValue;
+
+	if (aBuffPtr->size() < cbSpan)
+		aBuffPtr->resize(cbSpan);
+	SIZE_T cbReads = m_procPtr->ReadMemory(reinterpret_cast<LPCVOID>(blockPtr->uBase + blockPtr->idxFirst * m_uValueSize), aBuffPtr->data(), cbSpan);
+	SIZE_T nValid = cbReads / m_uValueSize;
+
+	const BYTE* aPtr = blockPtr->aDelta.data();
+	const BYTE* aOldPtr = blockPtr->aValue.data();
+	SIZE_T idxSlot = 0, idxPrev = 0, nCount = 0;
+	SIZE_T idxFirst = 0, idxLast = 0;
+
+	aDelta.reserve(blockPtr->aDelta.size());
+	aValue.reserve(blockPtr->aValue.size());
+	for (SIZE_T k = 0; k < blockPtr->nCount; ++k, aOldPtr += m_uValueSize) {
+		idxSlot += GetVarint(&aPtr);
+		if (idxSlot - blockPtr->idxFirst >= nValid)
+			continue;
+
+		const BYTE* aNewPtr = aBuffPtr->data() + (idxSlot - blockPtr->idxFirst) * m_uValueSize;
+		if (!this->MatchScalar(aNewPtr, aOldPtr))
+			continue;
+
+		if (nCount == 0) idxFirst = idxSlot;
+		idxLast = idxSlot;
+		PutVarint(&aDelta, idxSlot - idxPrev);
+		aValue.insert(aValue.end(), aNewPtr, aNewPtr + m_uValueSize);
+		idxPrev = idxSlot;
+		++nCount;
+	}
+
+	blockPtr->nCount = nCount;
+	blockPtr->idxFirst = idxFirst;
+	blockPtr->idxLast = idxLast;
+	blockPtr->aDelta.swap(aDelta);
+	blockPtr->aValue.swap(aValue);
+}
+
+/**
+ * @brief	將密集區塊轉換為稀疏區塊
+ * @param	[in,out] blockPtr	區塊
+ * @param	[in]     aDataPtr	區塊目前數值 (整個區塊)
+ */
+void CxFrameValueScan::MakeSparse(SSBLOCK* blockPtr, const BYTE* aDataPtr)
+{
+	std::vector<BYTE> aDelta, aValue;
+	SIZE_T idxPrev = 0;
+	BOOL bFirst = TRUE;
+
+	aDelta.reserve(blockPtr->nCount * 2);
+	aValue.reserve(blockPtr->nCount * m_uValueSize);
+	for (SIZE_T w = 0; w < blockPtr->aBits.size(); ++w) {
+		UINT64 uBits = blockPtr->aBits[w];
+		for (SIZE_T idxBit = 0; uBits != 0; ++idxBit, uBits >>= 1) {
+			if ((uBits & 1) == 0)
+				continue;
+
+			SIZE_T idxSlot = w * 64 + idxBit;
+			if (bFirst) {
+				blockPtr->idxFirst = idxSlot;
+				bFirst = FALSE;
+			}
+			blockPtr->idxLast = idxSlot;
+			PutVarint(&aDelta, idxSlot - idxPrev);
+			aValue.insert(aValue.end(), aDataPtr + idxSlot * m_uValueSize, aDataPtr + (idxSlot + 1) * m_uValueSize);
+			idxPrev = idxSlot;
+		}
+	}
+
+	blockPtr->bSparse = TRUE;
+	blockPtr->aDelta.swap(aDelta);
+	blockPtr->aValue.swap(aValue);
+	std::vector<UINT64>().swap(blockPtr->aBits);
+}
+
+/**
+ * @brief	比對單一數值
+ * @param	[in] aNewPtr	目前數值位址
+ * @param	[in] aOldPtr	上次數值位址
+ * @return	@c 型別: BOOL \n 符合返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameValueScan::MatchScalar(const BYTE* aNewPtr, const BYTE* aOldPtr)
+{
+	switch (m_eType) {
+	case EValueInt8:	return MatchValue<INT8>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2);
+	case EValueInt16:	return MatchValue<INT16>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2);
+	case EValueInt32:	return MatchValue<INT32>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2);
+	case EValueInt64:	return MatchValue<INT64>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2);
+	case EValueFloat:	return MatchValue<float>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2);
+	case EValueDouble:	return MatchValue<double>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2);
+	default:			return FALSE;
+	}
+}
+
+/**
+ * @brief	比對密集區塊
+ * @param	[in]     aNewPtr	目前數值 (補齊至 64 個位置的倍數)
+ * @param	[in]     aOldPtr	上次數值 (首次搜尋為 NULL)
+ * @param	[in]     nSlots		比對的位置數量
+ * @param	[in,out] aBitsPtr	候選位元集, 比對結果與原候選取交集
+ * @return	@c 型別: SIZE_T \n 比對後的候選數量
+ * @remark	浮點數的改變/未改變以相同大小的整數比對位元內容.
+ */
+SIZE_T CxFrameValueScan::CompareDense(const BYTE* aNewPtr, const BYTE* aOldPtr, SIZE_T nSlots, UINT64* aBitsPtr)
+{
+	BOOL bBitwise = m_eCompare == EScanChanged || m_eCompare == EScanUnchanged;
+
+	switch (m_eType) {
+	case EValueInt8:	return CompareOps<ScanOpsI8>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2, nSlots, aBitsPtr, m_bFirst);
+	case EValueInt16:	return CompareOps<ScanOpsI16>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2, nSlots, aBitsPtr, m_bFirst);
+	case EValueInt32:	return CompareOps<ScanOpsI32>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2, nSlots, aBitsPtr, m_bFirst);
+	case EValueInt64:	return CompareOps<ScanOpsI64>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2, nSlots, aBitsPtr, m_bFirst);
+	case EValueFloat:
+		if (bBitwise) return CompareOps<ScanOpsI32>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2, nSlots, aBitsPtr, m_bFirst);
+		return CompareOps<ScanOpsF32>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2, nSlots, aBitsPtr, m_bFirst);
+	case EValueDouble:
+		if (bBitwise) return CompareOps<ScanOpsI64>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2, nSlots, aBitsPtr, m_bFirst);
+		return CompareOps<ScanOpsF64>(m_eCompare, aNewPtr, aOldPtr, m_aValue1, m_aValue2, nSlots, aBitsPtr, m_bFirst);
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief	工作執行緒回呼函數 (static)
+ * @param	[in] aParamPtr	CxFrameValueScan 物件指標
+ * @param	[in] idxItem	區塊索引
+ * @param	[in] idxWorker	工作執行緒索引
+ */
+void CALLBACK CxFrameValueScan::StaticScanProc(LPVOID aParamPtr, size_t idxItem, DWORD idxWorker)
+{
+	reinterpret_cast<CxFrameValueScan*>(aParamPtr)->ScanBlock(idxItem, idxWorker);
+}
+
+/**
+ * @brief	取得數值型別大小
+ * @param	[in] eType	數值型別
+ * @return	@c 型別: SIZE_T \n 數值大小 (in Byte)
+ */
+SIZE_T CxFrameValueScan::ValueSize(EEVALUETYPE eType)
+{
+	switch (eType) {
+	case EValueInt8:	return sizeof(INT8);
+	case EValueInt16:	return sizeof(INT16);
+	case EValueInt32:	return sizeof(INT32);
+	case EValueInt64:	return sizeof(INT64);
+	case EValueFloat:	return sizeof(float);
+	case EValueDouble:	return sizeof(double);
+	default:			return 0;
+	}
+}
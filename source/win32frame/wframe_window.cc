@@ -6,6 +6,7 @@
  * @author	Swang
  *****************************************************************************/
 #include "win32frame/wframe_window.hh"
+#include "axeen/axeen_profile.hh"
 
 /**
  * @brief	視窗訊息處理 Callback function
@@ -21,6 +22,8 @@ LRESULT CALLBACK CxFrameWindow::WndProc(HWND hWnd, UINT uMessage, WPARAM wParam,
 {
 	CxFrameWindow* fmObj = NULL;
 
+	AXEEN_PROFILE_MESSAGE(hWnd, uMessage, wParam);
+
 	// Is Window create message?
 	if (uMessage == WM_CREATE) {
 		fmObj = (CxFrameWindow*)((LPCREATESTRUCT)lParam)->lpCreateParams;
@@ -88,28 +91,100 @@ LRESULT CxFrameWindow::DefaultWindowProc(UINT uMessage, WPARAM wParam, LPARAM lP
 }
 
 
+/**
+ * @brief	閒置處理
+ * @param	[in] dwBudget	本次可用時間 (in µs)
+ * @return	@c BOOL \n
+ *			尚有工作返回非零值(non-zero), 會於時間上限內再次調用 \n
+ *			沒有工作返回零值(zero), 訊息迴圈進入等待直到下一個訊息
+ * @remark	此為虛擬函數，由衍生類別處理動作項目 (如動態 UI，計時或遊戲)，\n
+ *			工作應切分為小段並於 dwBudget 用完前返回.
+ */
+BOOL CxFrameWindow::IdleDispose(DWORD dwBudget)
+{
+	UNREFERENCED_PARAMETER(dwBudget);
+	return FALSE;
+}
+
+
+/**
+ * @brief	於時間上限 (DEFAULT_SWND_IDLE) 內重複調用 IdleDispose
+ * @return	@c BOOL \n 尚有工作返回非零值(non-zero), 否則返回零值(zero)
+ */
+BOOL CxFrameWindow::RunIdle()
+{
+	LARGE_INTEGER liFrequency, liStart, liNow;
+	LONGLONG llBudget, llUsed = 0;
+	BOOL bMore = TRUE;
+
+	::QueryPerformanceFrequency(&liFrequency);
+	::QueryPerformanceCounter(&liStart);
+	llBudget = DEFAULT_SWND_IDLE * liFrequency.QuadPart / 1000000;
+
+	while (bMore && llUsed < llBudget) {
+		bMore = this->IdleDispose(static_cast<DWORD>((llBudget - llUsed) * 1000000 / liFrequency.QuadPart));
+
+		// 有新訊息時優先處理訊息
+		if (HIWORD(::GetQueueStatus(QS_ALLINPUT)) != 0)
+			break;
+
+		::QueryPerformanceCounter(&liNow);
+		llUsed = liNow.QuadPart - liStart.QuadPart;
+	}
+	return bMore;
+}
+
+
 /**
  * @brief	視窗訊息處理迴圈，採用 Peek message 機制
  * @return	@c int 視窗結束狀態碼
+ * @remark	處理完訊息後執行閒置處理 (IdleDispose)，閒置處理沒有工作時 \n
+ *			以 MsgWaitForMultipleObjectsEx 等待下一個訊息，閒置時不佔用 CPU.
  */
 int CxFrameWindow::RunPeekMessage()
 {
 	MSG message = { 0 };
+	BOOL bIdle = TRUE;
 
 	while (TRUE)
 	{
 		while (::PeekMessage(&message, NULL, 0, 0, PM_REMOVE)) {
+			if (message.message == WM_QUIT)
+				return (int)message.wParam;
+
 			//::TranslateMessage(&message);
 			::DispatchMessage(&message);
+			bIdle = TRUE;
 		}
 
-		if (message.message == WM_QUIT)
-			break;
-
-		// TODO: 要處理動作項目 (如動態 UI，計時或遊戲)
-		// ...
+		// 有訊息處理過或閒置處理尚有工作時執行閒置處理, 否則等待訊息
+		if (bIdle)
+			bIdle = this->RunIdle();
+		if (!bIdle)
+			::MsgWaitForMultipleObjectsEx(0, NULL, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
 	}
-	return (int)message.wParam;
+}
+
+
+/**
+ * @brief	固定步進更新
+ * @param	[in] dStep	步進時間 (in 秒), 每次調用皆相同
+ * @remark	此為虛擬函數，由衍生類別更新狀態 (RunFrame 模式).
+ */
+void CxFrameWindow::FrameUpdate(double dStep)
+{
+	UNREFERENCED_PARAMETER(dStep);
+}
+
+
+/**
+ * @brief	繪製訊框
+ * @param	[in] dAlpha	內插比例 (0.0 ~ 1.0), 上一次與下一次更新之間的位置
+ * @remark	此為虛擬函數，由衍生類別繪製畫面 (RunFrame 模式).
+ */
+void CxFrameWindow::FrameRender(double dAlpha)
+{
+	UNREFERENCED_PARAMETER(dAlpha);
 }
 
 
@@ -151,6 +226,54 @@ int CxFrameWindow::Run(BOOL bPeek)
 }
 
 
+/**
+ * @brief	固定步進訊框迴圈 (動態 UI，計時或遊戲)
+ * @param	[in] nUpdateHz	固定步進更新頻率 (每秒次數)
+ * @param	[in] nRenderHz	繪製頻率 (每秒次數), 零(zero) 表示與更新頻率相同
+ * @return	@c int	視窗結束狀態碼, 頻率錯誤返回 -1
+ * @remark	每個訊框處理訊息後, 調用 FrameUpdate 零或多次及 FrameRender 一次, \n
+ *			再以休眠加忙等的方式等待至下一個訊框期限, 等待期間仍處理訊息. \n
+ *			訊框時間統計由 GetPacer()->GetStats 取得.
+ */
+int CxFrameWindow::RunFrame(DWORD nUpdateHz, DWORD nRenderHz)
+{
+	MSG message = { 0 };
+
+	if (!m_pacer.Create(nUpdateHz, nRenderHz))
+		return -1;
+
+	m_pacer.Start();
+	for (;;) {
+		while (::PeekMessage(&message, NULL, 0, 0, PM_REMOVE)) {
+			if (message.message == WM_QUIT) {
+				m_pacer.Stop();
+				return (int)message.wParam;
+			}
+			if (!::IsDialogMessage(m_hWnd, &message)) {
+				::TranslateMessage(&message);
+				::DispatchMessage(&message);
+			}
+		}
+
+		// 提前返回的等待繼續完成, 不重新更新與繪製
+		if (!m_pacer.IsWaiting()) {
+			DWORD nSteps = m_pacer.BeginFrame();
+			while (nSteps-- != 0)
+				this->FrameUpdate(m_pacer.GetStep());
+			this->FrameRender(m_pacer.GetAlpha());
+		}
+		m_pacer.WaitFrame(TRUE);
+	}
+}
+
+
+/**
+ * @brief	取得訊框迴圈節拍物件
+ * @return	@c CxFramePacer* 節拍物件, 可取得訊框時間統計 (GetStats)
+ */
+CxFramePacer* CxFrameWindow::GetPacer() { return &m_pacer; }
+
+
 /**
  * @brief	建立一個視窗
  * @param	[in] swndPtr SSFRAMEWINDOW 結構資料位址
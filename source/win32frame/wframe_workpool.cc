@@ -0,0 +1,165 @@
+﻿/**************************************************************************//**
+ * @file	wframe_workpool.cc
+ * @brief	工作執行緒池類別，成員函式
+ * @date	2026-10-17
+ * @date	2026-10-17
+ * @author	Swang
+ *****************************************************************************/
+#include "win32frame/wframe_workpool.hh"
+
+//! CxFrameWorkPool 建構式
+CxFrameWorkPool::CxFrameWorkPool()
+	: m_tpPool(NULL)
+	, m_tpWork(NULL)
+	, m_nThreads(0)
+	, m_fnWorkPtr(NULL)
+	, m_aParamPtr(NULL)
+	, m_nItems(0)
+	, m_idxNext(0)
+	, m_idxWorker(0)
+	, m_bCancel(FALSE)
+{
+	::memset(&m_tpEnv, 0, sizeof(m_tpEnv));
+}
+
+//! CxFrameWorkPool 解構式
+CxFrameWorkPool::~CxFrameWorkPool() { this->Close(); }
+
+/**
+ * @brief	建立工作執行緒池
+ * @param	[in] nThreads	工作執行緒數量, 零(zero) 表示使用系統處理器數量
+ * @return	@c 型別: BOOL \n
+ *			函數操作成功返回非零值(non-zero) \n
+ *			函數操作失敗返回零(zero)
+ * @remark	執行緒最小與最大數量皆設為 nThreads, 執行緒建立後常駐至 Close 為止.
+ */
+BOOL CxFrameWorkPool::Create(DWORD nThreads)
+{
+	auto err = BOOL(FALSE);
+
+	if (m_tpPool != NULL)
+		return TRUE;
+
+	if (nThreads == 0) {
+		SYSTEM_INFO si;
+		::GetSystemInfo(&si);
+		nThreads = si.dwNumberOfProcessors;
+	}
+
+	for (;;) {
+		m_tpPool = ::CreateThreadpool(NULL);
+		if (m_tpPool == NULL) break;
+
+		::SetThreadpoolThreadMaximum(m_tpPool, nThreads);
+		if (!::SetThreadpoolThreadMinimum(m_tpPool, nThreads)) break;
+
+		::InitializeThreadpoolEnvironment(&m_tpEnv);
+		::SetThreadpoolCallbackPool(&m_tpEnv, m_tpPool);
+
+		m_tpWork = ::CreateThreadpoolWork(StaticWorkProc, this, &m_tpEnv);
+		if (m_tpWork == NULL) break;
+
+		m_nThreads = nThreads;
+		err = TRUE;
+		break;
+	}
+
+	if (!err) this->Close();
+	return err;
+}
+
+//! 關閉工作執行緒池
+void CxFrameWorkPool::Close()
+{
+	if (m_tpWork != NULL) {
+		::WaitForThreadpoolWorkCallbacks(m_tpWork, FALSE);
+		::CloseThreadpoolWork(m_tpWork);
+		m_tpWork = NULL;
+	}
+	if (m_tpPool != NULL) {
+		::DestroyThreadpoolEnvironment(&m_tpEnv);
+		::CloseThreadpool(m_tpPool);
+		m_tpPool = NULL;
+	}
+	m_nThreads = 0;
+}
+
+/**
+ * @brief	執行工作並等待完成
+ * @param	[in] fnWorkPtr	工作項目處理函數
+ * @param	[in] aParamPtr	傳遞給處理函數的參數
+ * @param	[in] nItems		工作項目數量
+ * @return	@c 型別: BOOL \n
+ *			全部工作項目完成返回非零值(non-zero) \n
+ *			執行緒池未建立、或工作被取消返回零(zero)
+ * @remark	各工作執行緒以原子操作依序取得工作項目, 處理時間不同的項目會自動平衡. \n
+ *			同一時間只能有一個 Run 在執行, 調用端不可在處理函數內再次調用 Run.
+ */
+BOOL CxFrameWorkPool::Run(LPFNWORKPROC fnWorkPtr, LPVOID aParamPtr, size_t nItems)
+{
+	if (m_tpWork == NULL || fnWorkPtr == NULL)
+		return FALSE;
+
+	m_fnWorkPtr = fnWorkPtr;
+	m_aParamPtr = aParamPtr;
+	m_nItems = static_cast<LONG64>(nItems);
+	m_idxNext = 0;
+	m_idxWorker = 0;
+	m_bCancel = FALSE;
+
+	// 工作項目少於執行緒數量時, 不必喚醒全部執行緒
+	DWORD nSubmit = m_nThreads;
+	if (nItems < nSubmit) nSubmit = static_cast<DWORD>(nItems);
+
+	for (DWORD i = 0; i < nSubmit; ++i)
+		::SubmitThreadpoolWork(m_tpWork);
+	::WaitForThreadpoolWorkCallbacks(m_tpWork, FALSE);
+
+	m_fnWorkPtr = NULL;
+	m_aParamPtr = NULL;
+	return m_bCancel == FALSE;
+}
+
+/**
+ * @brief	取消目前工作
+ * @remark	可於處理函數內調用, 尚未開始的工作項目不再處理, 已在處理中的項目會執行完畢.
+ */
+void CxFrameWorkPool::Cancel() { ::InterlockedExchange(&m_bCancel, TRUE); }
+
+/**
+ * @brief	目前工作是否已被取消
+ * @return	@c 型別: BOOL \n 已取消返回非零值(non-zero), 否則返回零(zero)
+ */
+BOOL CxFrameWorkPool::IsCancel() { return m_bCancel != FALSE; }
+
+/**
+ * @brief	取得工作執行緒數量
+ * @return	@c 型別: DWORD \n 工作執行緒數量, 執行緒池未建立返回零(zero)
+ */
+DWORD CxFrameWorkPool::GetThreadCount() { return m_nThreads; }
+
+/**
+ * @brief	執行緒池回呼函數 (static)
+ * @param	[in] tpInstance		回呼實體
+ * @param	[in] aContextPtr	CxFrameWorkPool 物件指標
+ * @param	[in] tpWork			工作物件
+ */
+void CALLBACK CxFrameWorkPool::StaticWorkProc(PTP_CALLBACK_INSTANCE tpInstance, PVOID aContextPtr, PTP_WORK tpWork)
+{
+	UNREFERENCED_PARAMETER(tpInstance);
+	UNREFERENCED_PARAMETER(tpWork);
+	reinterpret_cast<CxFrameWorkPool*>(aContextPtr)->WorkProc();
+}
+
+//! 工作執行緒處理程序, 持續取得工作項目直到全部完成或取消
+void CxFrameWorkPool::WorkProc()
+{
+	DWORD idxWorker = static_cast<DWORD>(::InterlockedIncrement(&m_idxWorker) - 1);
+
+	while (m_bCancel == FALSE) {
+		LONG64 idxItem = ::InterlockedIncrement64(&m_idxNext) - 1;
+		if (idxItem >= m_nItems)
+			break;
+		m_fnWorkPtr(m_aParamPtr, static_cast<size_t>(idxItem), idxWorker);
+	}
+}